@@ -0,0 +1,424 @@
+#! /bin/bash
+
+set -euo pipefail
+
+BASE_PATH="$(dirname "$0")/../.."
+cd "$BASE_PATH"
+
+SCENARIO="${1:-all}"
+WORKSPACE="$(mktemp --directory)"
+trap 'rm --force --recursive "$WORKSPACE"' EXIT
+
+# Runs the compiler over an input file (redirected to the standard input), with
+# the remaining arguments, and prints the wall-clock time (in
+# seconds) and the peak resident set size (in KiB), separated by a space. The
+# exit status of the compiler is kept in the "status" file of the workspace.
+function measure() {
+	local INPUT="$1"
+	shift 1
+	local STATUS=0
+	/usr/bin/time --format="%e %M" --output="$WORKSPACE/time" build/Compiler "$@" < "$INPUT" >/dev/null 2>&1 || STATUS="$?"
+	echo "$STATUS" > "$WORKSPACE/status"
+	cat "$WORKSPACE/time"
+}
+
+# Scans a multi-megabyte program, full of ignored lexemes, and reports the
+# throughput of the lexical-analyzer.
+function lexer() {
+	local CHUNKS="${LEXER_CHUNKS:-200}"
+	local STATEMENTS="${LEXER_STATEMENTS:-5000}"
+	awk -v chunks="$CHUNKS" -v statements="$STATEMENTS" 'BEGIN {
+		print "PROGRAM {";
+		for (c = 0; c < chunks; ++c) {
+			print "    IF (TRUE) {";
+			for (s = 0; s < statements; ++s) {
+				print "        /* Statement number " s ". */";
+				print "        INT value = 12345 + 678 * 9;";
+			}
+			print "    } ELSE {";
+			print "        INT value = 0;";
+			print "    }";
+		}
+		print "}";
+	}' > "$WORKSPACE/lexer"
+	# Tokens per chunk: "IF ( TRUE ) {" + statements + "} ELSE { INT value = 0 ; }".
+	local TOKENS=$(( 3 + CHUNKS * (5 + 9 * STATEMENTS + 9) ))
+	read -r SECONDS_ELAPSED PEAK_RSS <<< "$(measure "$WORKSPACE/lexer")"
+	echo "lexer: $(du --human-readable "$WORKSPACE/lexer" | cut --fields=1) input, $TOKENS tokens in $SECONDS_ELAPSED s" \
+		"($(awk -v t="$TOKENS" -v s="$SECONDS_ELAPSED" 'BEGIN { printf "%.0f", (s > 0 ? t / s : 0) }') tokens/s)," \
+		"peak RSS $PEAK_RSS KiB"
+}
+
+# Scans a single multi-megabyte string literal with dense escape sequences,
+# a workload that must remain linear in the size of the literal.
+function strings() {
+	local FRAGMENTS="${STRINGS_FRAGMENTS:-1000000}"
+	awk -v fragments="$FRAGMENTS" 'BEGIN {
+		printf "PROGRAM {\n    STRING value = \"";
+		for (f = 0; f < fragments; ++f) {
+			printf "ab\\ncd\\t";
+		}
+		printf "\";\n}\n";
+	}' > "$WORKSPACE/strings"
+	read -r SECONDS_ELAPSED PEAK_RSS <<< "$(measure "$WORKSPACE/strings")"
+	echo "strings: $(du --human-readable "$WORKSPACE/strings" | cut --fields=1) literal, $(( 2 * FRAGMENTS )) escapes in $SECONDS_ELAPSED s," \
+		"peak RSS $PEAK_RSS KiB"
+}
+
+# Compiles the same large program twice: piped through the standard input
+# (read incrementally by Flex), and by path (memory-mapped and scanned in
+# place), and reports the time saved by the latter.
+function input() {
+	local MEGABYTES="${INPUT_MEGABYTES:-100}"
+	awk -v megabytes="$MEGABYTES" 'BEGIN {
+		print "PROGRAM {";
+		line = "    /* Padding to be skipped by the lexical-analyzer, without building any AST node. */";
+		for (size = 0; size < megabytes * 1048576; size += 1 + length(line)) {
+			print line;
+		}
+		print "    INT value = 0;";
+		print "}";
+	}' > "$WORKSPACE/input"
+	read -r PIPE_SECONDS PIPE_PEAK_RSS <<< "$(measure <(cat "$WORKSPACE/input"))"
+	read -r MAPPED_SECONDS MAPPED_PEAK_RSS <<< "$(measure /dev/null "$WORKSPACE/input")"
+	echo "input: $(du --human-readable "$WORKSPACE/input" | cut --fields=1) program," \
+		"piped in $PIPE_SECONDS s (peak RSS $PIPE_PEAK_RSS KiB)," \
+		"memory-mapped in $MAPPED_SECONDS s (peak RSS $MAPPED_PEAK_RSS KiB)," \
+		"$(awk -v p="$PIPE_SECONDS" -v m="$MAPPED_SECONDS" 'BEGIN { printf "%.2f", p - m }') s saved"
+}
+
+# Compiles many small programs, first with one process per program, and then
+# with a single batch invocation, that compiles them concurrently on every
+# available processor.
+function batch() {
+	local FILES="${BATCH_FILES:-1000}"
+	mkdir "$WORKSPACE/batch"
+	for (( k = 0; k < FILES; ++k )); do
+		printf 'PROGRAM {\n    STRING value = "Program number %d.";\n}\n' "$k" > "$WORKSPACE/batch/$k"
+	done
+	local START="$(date +%s.%N)"
+	for PROGRAM in "$WORKSPACE"/batch/*; do
+		build/Compiler "$PROGRAM" >/dev/null 2>&1 || true
+	done
+	local SEQUENTIAL_SECONDS="$(awk -v start="$START" -v end="$(date +%s.%N)" 'BEGIN { printf "%.2f", end - start }')"
+	read -r BATCH_SECONDS BATCH_PEAK_RSS <<< "$(measure /dev/null "$WORKSPACE"/batch/*)"
+	echo "batch: $FILES programs, one process per program in $SEQUENTIAL_SECONDS s," \
+		"one batch on $(nproc) processors in $BATCH_SECONDS s (peak RSS $BATCH_PEAK_RSS KiB)"
+}
+
+# Parses a single block with millions of statements, a regression test for the
+# depth of the parser stack, which must not grow with the length of a list.
+function statements() {
+	local STATEMENTS="${STATEMENTS_COUNT:-10000000}"
+	awk -v statements="$STATEMENTS" 'BEGIN {
+		print "PROGRAM {";
+		for (s = 0; s < statements; ++s) {
+			print "    STRING value = \"x\";";
+		}
+		print "}";
+	}' > "$WORKSPACE/statements"
+	read -r SECONDS_ELAPSED PEAK_RSS <<< "$(measure /dev/null "$WORKSPACE/statements")"
+	echo "statements: $STATEMENTS statements in a single block, parsed in $SECONDS_ELAPSED s," \
+		"peak RSS $PEAK_RSS KiB, $([ "$(cat "$WORKSPACE/status")" == "0" ] && echo "accepted" || echo "REJECTED")"
+}
+
+# Compiles the same large program twice: from its source (lexing and parsing
+# it), and from its serialized AST (mapped and walked in place).
+function ast() {
+	local STATEMENTS="${AST_STATEMENTS:-1000000}"
+	awk -v statements="$STATEMENTS" 'BEGIN {
+		print "PROGRAM {";
+		for (s = 0; s < statements; ++s) {
+			print "    INT value = " (s % 1000) " + 2 * 3;";
+		}
+		print "}";
+	}' > "$WORKSPACE/ast"
+	build/Compiler --emit-ast "$WORKSPACE/ast.bin" "$WORKSPACE/ast" >/dev/null 2>&1
+	read -r PARSE_SECONDS PARSE_PEAK_RSS <<< "$(measure /dev/null "$WORKSPACE/ast")"
+	read -r LOAD_SECONDS LOAD_PEAK_RSS <<< "$(measure /dev/null --load-ast "$WORKSPACE/ast.bin")"
+	echo "ast: $(du --human-readable "$WORKSPACE/ast" | cut --fields=1) program," \
+		"$(du --human-readable "$WORKSPACE/ast.bin" | cut --fields=1) AST," \
+		"lexed and parsed in $PARSE_SECONDS s (peak RSS $PARSE_PEAK_RSS KiB)," \
+		"loaded in $LOAD_SECONDS s (peak RSS $LOAD_PEAK_RSS KiB)"
+}
+
+# Compiles the same batch of programs twice with the parse cache enabled: the
+# first time every program is lexed, parsed and stored in the cache, and the
+# second time every AST is loaded from it.
+function cache() {
+	local FILES="${CACHE_FILES:-1000}"
+	local STATEMENTS="${CACHE_STATEMENTS:-1000}"
+	mkdir "$WORKSPACE/cache" "$WORKSPACE/cache-directory"
+	for (( k = 0; k < FILES; ++k )); do
+		awk -v program="$k" -v statements="$STATEMENTS" 'BEGIN {
+			print "PROGRAM {";
+			for (s = 0; s < statements; ++s) {
+				print "    INT value = " program " + " s " * 3;";
+			}
+			print "}";
+		}' > "$WORKSPACE/cache/$k"
+	done
+	read -r COLD_SECONDS COLD_PEAK_RSS <<< "$(PARSE_CACHE_DIRECTORY="$WORKSPACE/cache-directory" measure /dev/null "$WORKSPACE"/cache/*)"
+	read -r WARM_SECONDS WARM_PEAK_RSS <<< "$(PARSE_CACHE_DIRECTORY="$WORKSPACE/cache-directory" measure /dev/null "$WORKSPACE"/cache/*)"
+	echo "cache: $FILES programs of $STATEMENTS statements," \
+		"$(du --human-readable --summarize "$WORKSPACE/cache-directory" | cut --fields=1) cached," \
+		"cold in $COLD_SECONDS s (peak RSS $COLD_PEAK_RSS KiB)," \
+		"warm in $WARM_SECONDS s (peak RSS $WARM_PEAK_RSS KiB)"
+}
+
+# Traverses a wide tree (about a million nodes) and a deep one (a single chain
+# of additions), by flattening their ASTs, which walks every expression with
+# an explicit stack (the deep one used to overflow the C stack).
+function traversal() {
+	local STATEMENTS="${TRAVERSAL_STATEMENTS:-100000}"
+	local DEPTH="${TRAVERSAL_DEPTH:-100000}"
+	awk -v statements="$STATEMENTS" 'BEGIN {
+		print "PROGRAM {";
+		for (s = 0; s < statements; ++s) {
+			print "    INT value = " s " + 2 * 3 - " s " / 7;";
+		}
+		print "}";
+	}' > "$WORKSPACE/wide"
+	awk -v depth="$DEPTH" 'BEGIN {
+		printf "PROGRAM {\n    INT value = 1";
+		for (d = 1; d < depth; ++d) {
+			printf " + %d", d % 100;
+		}
+		print ";\n}";
+	}' > "$WORKSPACE/deep"
+	for TREE in wide deep; do
+		read -r PARSE_SECONDS PARSE_PEAK_RSS <<< "$(measure /dev/null "$WORKSPACE/$TREE")"
+		read -r TRAVERSAL_SECONDS TRAVERSAL_PEAK_RSS <<< "$(measure /dev/null --emit-ast "$WORKSPACE/$TREE.ast" "$WORKSPACE/$TREE")"
+		echo "traversal: $TREE tree, parsed in $PARSE_SECONDS s (peak RSS $PARSE_PEAK_RSS KiB)," \
+			"parsed and traversed in $TRAVERSAL_SECONDS s (peak RSS $TRAVERSAL_PEAK_RSS KiB)," \
+			"$([ "$(cat "$WORKSPACE/status")" == "0" ] && echo "succeed" || echo "FAILED")"
+	done
+}
+
+# Compiles a program with tens of millions of top-level instructions, read
+# from a pipe, in streaming mode (each instruction is released after being
+# processed), so the peak memory must not grow with the length of the program.
+function streaming() {
+	local STATEMENTS="${STREAMING_STATEMENTS:-20000000}"
+	awk -v statements="$STATEMENTS" 'BEGIN {
+		print "PROGRAM {";
+		for (s = 0; s < statements; ++s) {
+			print "    INT value" (s % 1000) " = " s " + 2 * 3;";
+		}
+		print "}";
+	}' > "$WORKSPACE/streaming"
+	read -r SECONDS_ELAPSED PEAK_RSS <<< "$(measure <(cat "$WORKSPACE/streaming") --stream -)"
+	echo "streaming: $STATEMENTS top-level instructions, streamed in $SECONDS_ELAPSED s," \
+		"peak RSS $PEAK_RSS KiB, $([ "$(cat "$WORKSPACE/status")" == "0" ] && echo "accepted" || echo "REJECTED")"
+}
+
+# Compiles many functions made of tight nested FOR loops, whose every variable
+# reference is resolved to a slot of a frame while it's scanned (the cost that
+# replaces looking up names when the loops run).
+function slots() {
+	local FUNCTIONS="${SLOTS_FUNCTIONS:-20000}"
+	awk -v functions="$FUNCTIONS" 'BEGIN {
+		print "PROGRAM {";
+		print "    INT total = 0;";
+		for (f = 0; f < functions; ++f) {
+			print "    INT loops" f "(INT n) {";
+			print "        INT sum = 0;";
+			print "        FOR i IN (1, n) {";
+			print "            FOR j IN (i, n) {";
+			print "                INT product = i * j;";
+			print "                sum = sum + product - i / j + total;";
+			print "            }";
+			print "        }";
+			print "        RETURN sum;";
+			print "    }";
+			print "    total = total + loops" f "(" f % 100 ");";
+		}
+		print "}";
+	}' > "$WORKSPACE/slots"
+	# Variables per function: 5 declared (including the parameter and the loop
+	# variables), 12 used or assigned inside it, and 2 at its call site.
+	local REFERENCES=$(( 1 + FUNCTIONS * 19 ))
+	read -r SECONDS_ELAPSED PEAK_RSS <<< "$(measure "$WORKSPACE/slots")"
+	echo "slots: $FUNCTIONS functions with nested FOR loops, $REFERENCES variables resolved in $SECONDS_ELAPSED s," \
+		"peak RSS $PEAK_RSS KiB, $([ "$(cat "$WORKSPACE/status")" == "0" ] && echo "accepted" || echo "REJECTED")"
+}
+
+# Analyzes the call graph of a program with many functions: each one calls the
+# previous one (so the depth-first search over the graph goes through all of
+# them), and encloses a function that calls it back (so both are recursive).
+# Some of them print, or write a global variable. Reports the time of the
+# analysis alone, and of the whole compilation.
+function callgraph() {
+	local FUNCTIONS="${CALLGRAPH_FUNCTIONS:-100000}"
+	awk -v functions="$FUNCTIONS" 'BEGIN {
+		print "PROGRAM {";
+		print "    INT total = 0;";
+		for (f = 0; 2 * f < functions; ++f) {
+			print "    INT outer" f "(INT n) {";
+			print "        INT inner" f "(INT k) {";
+			print "            IF (k > 0) {";
+			print "                RETURN outer" f "(k - 1);";
+			print "            } ELSE {";
+			print "                RETURN k;";
+			print "            }";
+			print "        }";
+			if (f % 10 == 0) {
+				print "        PRINT(n);";
+			}
+			if (f % 7 == 0) {
+				print "        total = n;";
+			}
+			print "        RETURN inner" f "(n)" (f == 0 ? "" : " + outer" (f - 1) "(n)") ";";
+			print "    }";
+		}
+		print "    total = outer" (int((functions - 1) / 2)) "(3);";
+		print "}";
+	}' > "$WORKSPACE/callgraph"
+	read -r SECONDS_ELAPSED PEAK_RSS <<< "$(measure "$WORKSPACE/callgraph")"
+	local REPORT="$(build/Compiler --call-graph "$WORKSPACE/callgraph" 2>&1 | grep --only-matching "Analyzed.*" || true)"
+	echo "callgraph: ${REPORT:-analysis FAILED}" \
+		"(compiled in $SECONDS_ELAPSED s, peak RSS $PEAK_RSS KiB, $([ "$(cat "$WORKSPACE/status")" == "0" ] && echo "accepted" || echo "REJECTED"))"
+}
+
+# Estimates the costs of a program with many functions, each one with two
+# nested loops of unknown bounds (so it's quadratic) that call the previous
+# one, and a loop of constant bounds. The last function has a third nested
+# loop, so the program is cubic, and the report must reject it. Reports the
+# time of the analysis, and whether the compilation failed as expected.
+function costs() {
+	local FUNCTIONS="${COSTS_FUNCTIONS:-10000}"
+	awk -v functions="$FUNCTIONS" 'BEGIN {
+		print "PROGRAM {";
+		for (f = 0; f < functions; ++f) {
+			print "    INT cost" f "(INT n) {";
+			print "        INT total = 0;";
+			print "        FOR i IN (1, n) {";
+			print "            FOR j IN (i, n) {";
+			if (f + 1 == functions) {
+				print "                FOR k IN (j, n) {";
+				print "                    total = total + k;";
+				print "                }";
+			}
+			else {
+				print "                total = total + i * j;";
+			}
+			print "            }";
+			print "        }";
+			print "        FOR k IN (1, 8) {";
+			print "            total = total + " (f == 0 ? "k" : "cost" (f - 1) "(k)") ";";
+			print "        }";
+			print "        RETURN total;";
+			print "    }";
+		}
+		print "    PRINT(cost" (functions - 1) "(100));";
+		print "}";
+	}' > "$WORKSPACE/costs"
+	read -r SECONDS_ELAPSED PEAK_RSS <<< "$(measure "$WORKSPACE/costs" --cost-report)"
+	local REPORT="$(build/Compiler --cost-report "$WORKSPACE/costs" 2>&1 | grep --only-matching "Estimated.*in [0-9.]* s" || true)"
+	echo "costs: ${REPORT:-analysis FAILED}" \
+		"(compiled in $SECONDS_ELAPSED s, peak RSS $PEAK_RSS KiB, $([ "$(cat "$WORKSPACE/status")" == "0" ] && echo "ACCEPTED" || echo "rejected as cubic"))"
+}
+
+# Reports how many runtime checks of the arithmetic operations are removed by
+# the analysis of their value ranges, on the accepted test programs, and on
+# the programs of the scenarios that ran before (if any).
+function ranges() {
+	for PROGRAM in src/test/c/accept/* "$WORKSPACE"/{statements,wide,deep,slots,callgraph}; do
+		if [ -f "$PROGRAM" ]; then
+			local REPORT="$(build/Compiler --range-report "$PROGRAM" 2>&1 | grep --only-matching "Analyzed.*" || true)"
+			echo "ranges: $(basename "$PROGRAM"), ${REPORT:-analysis FAILED}"
+		fi
+	done
+}
+
+# Runs a program with nested loops of arithmetic, a naive recursive fibonacci,
+# and a loop that prints strings, with every engine (the interpreter first, as
+# the baseline), and reports the time of each execution and how many
+# instructions and calls it ran.
+function runtime() {
+	local ITERATIONS="${RUNTIME_ITERATIONS:-300}"
+	local FIBONACCI="${RUNTIME_FIBONACCI:-22}"
+	local LINES="${RUNTIME_LINES:-20000}"
+	awk -v iterations="$ITERATIONS" -v fibonacci="$FIBONACCI" -v lines="$LINES" 'BEGIN {
+		print "PROGRAM {";
+		print "    INT fibonacci(INT n) {";
+		print "        IF (n < 2) {";
+		print "            RETURN n;";
+		print "        } ELSE {";
+		print "            RETURN fibonacci(n - 1) + fibonacci(n - 2);";
+		print "        }";
+		print "    }";
+		print "    STRING label(INT k) {";
+		print "        IF (k / 2 * 2 == k) {";
+		print "            RETURN \"even\";";
+		print "        } ELSE {";
+		print "            RETURN \"odd\";";
+		print "        }";
+		print "    }";
+		print "    INT total = 0;";
+		print "    FOR i IN (1, " iterations ") {";
+		print "        FOR j IN (1, " iterations ") {";
+		print "            total = (total + i * j - j / 3) / 2;";
+		print "        }";
+		print "    }";
+		print "    PRINT(total);";
+		print "    PRINT(fibonacci(" fibonacci "));";
+		print "    FOR k IN (1, " lines ") {";
+		print "        PRINT(label(k));";
+		print "    }";
+		print "}";
+	}' > "$WORKSPACE/runtime"
+	for ENGINE in --run --run-bytecode --run-jit; do
+		read -r SECONDS_ELAPSED PEAK_RSS <<< "$(measure "$WORKSPACE/runtime" "$ENGINE")"
+		local REPORT="$(LOGGING_LEVEL=DEBUGGING build/Compiler "$ENGINE" "$WORKSPACE/runtime" 2>&1 | grep --only-matching "Ran .* s" || true)"
+		echo "runtime ($ENGINE): ${REPORT:-execution FAILED}" \
+			"(compiled and ran in $SECONDS_ELAPSED s, peak RSS $PEAK_RSS KiB)"
+	done
+	for ENGINE in --native --assemble; do
+		read -r SECONDS_ELAPSED PEAK_RSS <<< "$(measure "$WORKSPACE/runtime" "$ENGINE" "$WORKSPACE/native")"
+		local STATUS="ran"
+		/usr/bin/time --format="%e" --output="$WORKSPACE/time" "$WORKSPACE/native" > /dev/null 2>&1 || STATUS="execution FAILED"
+		echo "runtime ($ENGINE): $STATUS in $(cat "$WORKSPACE/time") s" \
+			"(built in $SECONDS_ELAPSED s, peak RSS $PEAK_RSS KiB)"
+	done
+}
+
+# Runs every accepted test program with the interpreter, with the virtual
+# machine (without and with native code), and as an executable (built through
+# C, and through assembly), and reports whether their outputs
+# (and statuses) are the same.
+function engines() {
+	for PROGRAM in src/test/c/accept/*; do
+		local EXPECTED="$(build/Compiler --run "$PROGRAM" 2>/dev/null; echo "status $?")"
+		for ENGINE in --run-bytecode --run-jit; do
+			local ACTUAL="$(build/Compiler "$ENGINE" "$PROGRAM" 2>/dev/null; echo "status $?")"
+			echo "engines ($ENGINE): $(basename "$PROGRAM"), $([ "$EXPECTED" == "$ACTUAL" ] && echo "same output" || echo "DIFFERENT output")"
+		done
+		for ENGINE in --native --assemble; do
+			local ACTUAL="$(build/Compiler "$ENGINE" "$WORKSPACE/native" "$PROGRAM" > /dev/null 2>&1 && "$WORKSPACE/native" 2>/dev/null; echo "status $?")"
+			echo "engines ($ENGINE): $(basename "$PROGRAM"), $([ "$EXPECTED" == "$ACTUAL" ] && echo "same output" || echo "DIFFERENT output")"
+		done
+	done
+}
+
+if [ "$SCENARIO" == "all" ]; then
+	lexer
+	strings
+	input
+	statements
+	ast
+	batch
+	cache
+	traversal
+	streaming
+	slots
+	callgraph
+	ranges
+	costs
+	runtime
+	engines
+else
+	"$SCENARIO"
+fi
+
+echo "All done."
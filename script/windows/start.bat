@@ -6,6 +6,6 @@
 
 @set INPUT=%1
 @shift /1
-@type %INPUT% | %BASE_PATH%\build\Debug\Compiler.exe %1 %2 %3 %4 %5 %6 %7 %8 %9
+@%BASE_PATH%\build\Debug\Compiler.exe %INPUT% %1 %2 %3 %4 %5 %6 %7 %8 %9
 
 @ENDLOCAL
@@ -1,14 +1,74 @@
+#include "backend/code-generation/AssemblyGenerator.h"
 #include "backend/code-generation/Generator.h"
+#include "backend/domain-specific/Bytecode.h"
 #include "backend/domain-specific/Calculator.h"
+#include "backend/domain-specific/JustInTimeCompiler.h"
+#include "backend/domain-specific/VirtualMachine.h"
+#include "backend/semantic-analysis/CallGraph.h"
+#include "backend/semantic-analysis/CostAnalysis.h"
+#include "backend/semantic-analysis/RangeAnalysis.h"
+#include "driver/CompilationDriver.h"
 #include "frontend/lexical-analysis/FlexActions.h"
 #include "frontend/syntactic-analysis/AbstractSyntaxTree.h"
 #include "frontend/syntactic-analysis/BisonActions.h"
+#include "frontend/syntactic-analysis/FlatAbstractSyntaxTree.h"
+#include "frontend/syntactic-analysis/FlatAbstractSyntaxTreeFile.h"
+#include "frontend/syntactic-analysis/ParseCache.h"
 #include "frontend/syntactic-analysis/SyntacticAnalyzer.h"
 #include "shared/CompilerState.h"
 #include "shared/Environment.h"
 #include "shared/Logger.h"
 #include "shared/String.h"
 
+/**
+ * The forms in which the application can be invoked (see "doc/readme").
+ */
+static const char * const _usage[] = {
+	"Usage: Compiler [<program>]",
+	"       Compiler <program> <program> [<program> ...]",
+	"       Compiler --emit-ast <ast> [<program>]",
+	"       Compiler --load-ast <ast>",
+	"       Compiler --stream <program>",
+	"       Compiler --call-graph [<program>]",
+	"       Compiler --range-report [<program>]",
+	"       Compiler --cost-report [<program>]",
+	"       Compiler --run [<program>]",
+	"       Compiler --run-bytecode [<program>]",
+	"       Compiler --run-jit [<program>]",
+	"       Compiler --emit-c [<program>]",
+	"       Compiler --native <executable> [<program>]",
+	"       Compiler --emit-asm [<program>]",
+	"       Compiler --assemble <executable> [<program>]",
+	"       Compiler --disassemble [<program>]",
+	NULL
+};
+
+/**
+ * Returns the first argument from the specified one that looks like an option
+ * (i.e., it starts with "--"), so it's never taken as the path of a program,
+ * or NULL if none does.
+ */
+static const char * _optionOf(const int first, const int count, const char ** arguments) {
+	for (int k = first; k < count; ++k) {
+		if (strncmp(arguments[k], "--", 2) == 0) {
+			return arguments[k];
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Rejects an unknown option (or a known one with the wrong amount of
+ * arguments), and prints the usage of the application.
+ */
+static CompilationStatus _reject(const Logger * logger, const char * option) {
+	logError(logger, "Unknown option, or wrong amount of arguments: \"%s\".", option);
+	for (int k = 0; _usage[k] != NULL; ++k) {
+		fprintf(stderr, "%s\n", _usage[k]);
+	}
+	return FAILED;
+}
+
 /**
  * The main entry-point of the entire application. If you use "strtok" to
  * parse anything inside this project instead of using Flex and Bison, I will
@@ -20,54 +80,103 @@ const int main(const int count, const char ** arguments) {
 	initializeBisonActionsModule();
 	initializeSyntacticAnalyzerModule();
 	initializeAbstractSyntaxTreeModule();
-	// initializeCalculatorModule();
-	// initializeGeneratorModule();
+	initializeFlatAbstractSyntaxTreeModule();
+	initializeFlatAbstractSyntaxTreeFileModule();
+	initializeParseCacheModule();
+	initializeCallGraphModule();
+	initializeRangeAnalysisModule();
+	initializeCostAnalysisModule();
+	initializeCompilationDriverModule();
+	initializeCalculatorModule();
+	initializeBytecodeModule();
+	initializeVirtualMachineModule();
+	initializeJustInTimeCompilerModule();
+	initializeGeneratorModule();
+	initializeAssemblyGeneratorModule();
 
 	// Logs the arguments of the application.
 	for (int k = 0; k < count; ++k) {
 		logDebugging(logger, "Argument %d: \"%s\"", k, arguments[k]);
 	}
 
-	// Begin compilation process.
-	CompilerState compilerState = {
-		.abstractSyntaxtTree = NULL,
-		.succeed = false,
-		.value = 0
-	};
-	const SyntacticAnalysisStatus syntacticAnalysisStatus = parse(&compilerState);
+	// Begin compilation process (a single program, or a batch of them).
 	CompilationStatus compilationStatus = SUCCEED;
-	if (syntacticAnalysisStatus == ACCEPT) {
-		// ----------------------------------------------------------------------------------------
-		// Beginning of the Backend... ------------------------------------------------------------
-		// logDebugging(logger, "Computing expression value...");
-		// Program * program = compilerState.abstractSyntaxtTree;
-		// ComputationResult computationResult = computeExpression(program->expression);
-		// if (computationResult.succeed) {
-		// 	compilerState.value = computationResult.value;
-		// 	generate(&compilerState);
-		// }
-		// else {
-		// 	logError(logger, "The computation phase rejects the input program.");
-		// 	compilationStatus = FAILED;
-		// }
-		// ...end of the Backend. -----------------------------------------------------------------
-		// ----------------------------------------------------------------------------------------
-		// logDebugging(logger, "Releasing AST resources...");
-		// releaseProgram(program);
+	// Only the first argument can be an option.
+	const char * option = _optionOf(2, count, arguments);
+	if (option != NULL) {
+		compilationStatus = _reject(logger, option);
+	}
+	else if (count == 3 && strcmp(arguments[1], "--load-ast") == 0) {
+		compilationStatus = compileFromAbstractSyntaxTreeFile(arguments[2]);
+	}
+	else if ((count == 3 || count == 4) && strcmp(arguments[1], "--emit-ast") == 0) {
+		compilationStatus = compileToAbstractSyntaxTreeFile(count == 4 ? arguments[3] : NULL, arguments[2]);
+	}
+	else if ((count == 2 || count == 3) && strcmp(arguments[1], "--call-graph") == 0) {
+		compilationStatus = compileWithCallGraphReport(count == 3 ? arguments[2] : NULL);
+	}
+	else if ((count == 2 || count == 3) && strcmp(arguments[1], "--range-report") == 0) {
+		compilationStatus = compileWithRangeReport(count == 3 ? arguments[2] : NULL);
+	}
+	else if ((count == 2 || count == 3) && strcmp(arguments[1], "--cost-report") == 0) {
+		compilationStatus = compileWithCostReport(count == 3 ? arguments[2] : NULL);
+	}
+	else if ((count == 2 || count == 3) && strcmp(arguments[1], "--run") == 0) {
+		compilationStatus = compileAndRun(count == 3 ? arguments[2] : NULL);
+	}
+	else if ((count == 2 || count == 3) && strcmp(arguments[1], "--run-bytecode") == 0) {
+		compilationStatus = compileAndRunBytecode(count == 3 ? arguments[2] : NULL);
+	}
+	else if ((count == 2 || count == 3) && strcmp(arguments[1], "--run-jit") == 0) {
+		compilationStatus = compileAndRunNative(count == 3 ? arguments[2] : NULL);
+	}
+	else if ((count == 2 || count == 3) && strcmp(arguments[1], "--emit-c") == 0) {
+		compilationStatus = compileToC(count == 3 ? arguments[2] : NULL);
+	}
+	else if ((count == 3 || count == 4) && strcmp(arguments[1], "--native") == 0) {
+		compilationStatus = compileToExecutable(count == 4 ? arguments[3] : NULL, arguments[2]);
+	}
+	else if ((count == 2 || count == 3) && strcmp(arguments[1], "--emit-asm") == 0) {
+		compilationStatus = compileToAssembly(count == 3 ? arguments[2] : NULL);
+	}
+	else if ((count == 3 || count == 4) && strcmp(arguments[1], "--assemble") == 0) {
+		compilationStatus = compileToAssembledExecutable(count == 4 ? arguments[3] : NULL, arguments[2]);
+	}
+	else if ((count == 2 || count == 3) && strcmp(arguments[1], "--disassemble") == 0) {
+		compilationStatus = compileWithBytecodeListing(count == 3 ? arguments[2] : NULL);
+	}
+	else if (count == 3 && strcmp(arguments[1], "--stream") == 0) {
+		compilationStatus = compileStreaming(strcmp(arguments[2], "-") == 0 ? NULL : arguments[2]);
+	}
+	else if ((option = _optionOf(1, count, arguments)) != NULL) {
+		compilationStatus = _reject(logger, option);
+	}
+	else if (count <= 2) {
+		compilationStatus = compile(count == 2 ? arguments[1] : NULL);
 	}
 	else {
-		logError(logger, "The syntactic-analysis phase rejects the input program.");
-		compilationStatus = FAILED;
+		compilationStatus = compileAll(count - 1, arguments + 1);
 	}
 
 	logDebugging(logger, "Releasing modules resources...");
-	// shutdownGeneratorModule();
-	// shutdownCalculatorModule();
+	shutdownAssemblyGeneratorModule();
+	shutdownGeneratorModule();
+	shutdownJustInTimeCompilerModule();
+	shutdownVirtualMachineModule();
+	shutdownBytecodeModule();
+	shutdownCalculatorModule();
+	shutdownCompilationDriverModule();
+	shutdownCostAnalysisModule();
+	shutdownRangeAnalysisModule();
+	shutdownCallGraphModule();
+	shutdownParseCacheModule();
+	shutdownFlatAbstractSyntaxTreeFileModule();
+	shutdownFlatAbstractSyntaxTreeModule();
 	shutdownAbstractSyntaxTreeModule();
 	shutdownSyntacticAnalyzerModule();
 	shutdownBisonActionsModule();
 	shutdownFlexActionsModule();
 	logDebugging(logger, "Compilation is done.");
 	destroyLogger(logger);
-	return 0;
+	return compilationStatus;
 }
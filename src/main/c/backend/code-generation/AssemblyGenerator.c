@@ -0,0 +1,1588 @@
+#include "AssemblyGenerator.h"
+
+/**
+ * A text in heap-memory, that grows as it's appended.
+ */
+typedef struct {
+	char * text;
+	size_t size;
+	size_t capacity;
+} Text;
+
+/**
+ * The operations of the intermediate representation. The fields of an
+ * operation used by each one are "target", "left" and "right" (virtual
+ * registers or immediate integers), "argument", "label" and "slot".
+ */
+typedef enum {
+	MOVE_IR,      // target = left
+	STRING_IR,    // target = the address of the string "argument"
+	LOAD_IR,      // target = the variable of "slot"
+	STORE_IR,     // the variable of "slot" = left
+	ADD_IR,       // target = left + right (with the checks of "argument")
+	SUB_IR,       // target = left - right (with the checks of "argument")
+	MUL_IR,       // target = left * right (with the checks of "argument")
+	DIV_IR,       // target = left / right (with the checks of "argument")
+	INCREMENT_IR, // ++target (never checked)
+	SET_IR,       // target = left "argument" right (a compare operator)
+	BRANCH_IR,    // jumps to "label" if left "argument" right
+	JUMP_IR,      // jumps to "label"
+	LABEL_IR,     // "label":
+	ENTER_IR,     // checks the stack, before a recursive call
+	ARGUMENT_IR,  // pushes left
+	LINK_IR,      // pushes the frame "argument" links above (the static link)
+	CALL_IR,      // target = the result of the function "argument"
+	RETURN_IR,    // returns left
+	PRINT_IR      // prints left, of the expression type "argument"
+} Opcode;
+
+/**
+ * An operand of an operation: none, a virtual register, or an immediate
+ * integer.
+ */
+typedef struct {
+	enum { NO_OPERAND = 0, REGISTER_OPERAND, IMMEDIATE_OPERAND } kind;
+	int value;
+} Operand;
+
+/**
+ * An operation of the intermediate representation, with the line of its
+ * instruction.
+ */
+typedef struct {
+	Opcode opcode;
+	Operand target;
+	Operand left;
+	Operand right;
+	unsigned int argument;
+	unsigned int label;
+	Slot slot;
+	unsigned int line;
+} Operation;
+
+/**
+ * The label of Sethi-Ullman of an arithmetic expression (i.e., how many
+ * registers its evaluation needs), whether it calls a function, and whether
+ * it can fail.
+ */
+typedef struct {
+	unsigned int registers;
+	boolean calls;
+	boolean fails;
+} Demand;
+
+/**
+ * The demand of an operation. An empty entry has a NULL expression.
+ */
+typedef struct {
+	const ArithmeticExpression * expression;
+	Demand demand;
+} DemandEntry;
+
+/**
+ * The kinds of pending work of the lowering of an expression. Evaluating an
+ * expression pushes the operand of its value in the stack of operands, and
+ * applying an operator pops the ones of its operands.
+ */
+typedef enum {
+	APPLY_ARITHMETIC,
+	APPLY_COMPARISON,
+	APPLY_NOT,
+	ARGUMENTS,
+	ARITHMETIC,
+	BOOLEAN,
+	BRANCH,
+	BRANCH_ON_COMPARISON,
+	BRANCH_ON_VALUE,
+	CALL,
+	EXPRESSION,
+	INVOKE,
+	LABEL,
+	MATERIALIZE,
+	PUSH_ARGUMENT
+} TaskKind;
+
+/**
+ * A pending work over a node (or over the rest of a list of arguments): the
+ * label of its jumps, the register of its value (of an "AND" or an "OR"),
+ * whether its jumps are taken on true, and whether its right operand is
+ * evaluated first.
+ */
+typedef struct {
+	const void * node;
+	unsigned int label;
+	Operand target;
+	uint8_t kind;
+	boolean when;
+	boolean swapped;
+} Task;
+
+/**
+ * The state of the generation. The functions are indexed as the nodes of the
+ * call graph, and the program goes last. The operations, the live intervals
+ * and the locations of the virtual registers (a machine register, or a spill
+ * slot if negative) belong to the function being generated, whose failures
+ * jump to stubs at its end. The demands of the operations are memoized (in an
+ * open-addressing hash table indexed by address), because the expressions
+ * are shared.
+ *
+ * The expressions are lowered with explicit stacks in heap-memory (of
+ * pending work, of operands, and of pending operations of the demands), so
+ * deeply nested expressions can't overflow the C stack.
+ */
+typedef struct {
+	const CallGraph * callGraph;
+	const RangeAnalysis * rangeAnalysis;
+	unsigned int program;
+	unsigned int * parents;
+	Operation * operations;
+	unsigned int size;
+	unsigned int capacity;
+	unsigned int registers;
+	unsigned int * starts;
+	unsigned int * ends;
+	int * locations;
+	unsigned int locationCapacity;
+	unsigned int spills;
+	unsigned int savedRegisters;
+	DemandEntry * demands;
+	unsigned int demandCapacity;
+	unsigned int demandSize;
+	Task * tasks;
+	unsigned int taskSize;
+	unsigned int taskCapacity;
+	Operand * operands;
+	unsigned int operandSize;
+	unsigned int operandCapacity;
+	const ArithmeticExpression ** pending;
+	unsigned int pendingCapacity;
+	unsigned int function;
+	unsigned int frameSize;
+	unsigned int line;
+	unsigned int labels;
+	unsigned int strings;
+	unsigned int virtualRegisters;
+	unsigned int spilledRegisters;
+	Text text;
+	Text data;
+	Text failures;
+	boolean succeed;
+} AssemblyGenerator;
+
+/* MODULE INTERNAL STATE */
+
+// The initial capacity of every text, stack and table (must be a power of 2).
+static const unsigned int _initialCapacity = 256;
+
+// The machine registers that hold the virtual registers (in their 64-bit and
+// 32-bit names), which every generated function preserves.
+static const char * const _registers[] = {"rbx", "rsi", "rdi", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15"};
+static const char * const _registers32[] = {"ebx", "esi", "edi", "r8d", "r9d", "r10d", "r11d", "r12d", "r13d", "r14d", "r15d"};
+static const unsigned int _machineRegisters = sizeof(_registers) / sizeof(_registers[0]);
+
+// The condition code of every compare operator, and its negation.
+static const char * const _conditions[] = {
+	[GREATER_THAN_T] = "g",
+	[LESS_THAN_T] = "l",
+	[EQUALS_EQUALS_T] = "e",
+	[NOT_EQUALS_T] = "ne",
+	[GREATER_EQUALS_T] = "ge",
+	[LESS_EQUALS_T] = "le"
+};
+static const unsigned int _negations[] = {
+	[GREATER_THAN_T] = LESS_EQUALS_T,
+	[LESS_THAN_T] = GREATER_EQUALS_T,
+	[EQUALS_EQUALS_T] = NOT_EQUALS_T,
+	[NOT_EQUALS_T] = EQUALS_EQUALS_T,
+	[GREATER_EQUALS_T] = LESS_THAN_T,
+	[LESS_EQUALS_T] = GREATER_THAN_T
+};
+
+// The routine of the runtime that prints the value of each kind of
+// expression.
+static const char * const _printers[] = {[ARITHMETIC_EXPR_T] = "rt_printInt", [BOOLEAN_EXPR_T] = "rt_printBool", [STRING_EXPR_T] = "rt_printString"};
+
+// The runtime of every generated program, over the system calls of Linux: the
+// buffered output, the exit, and the failures (whose line is in "edx"). Its
+// routines only clobber "rax", "rcx" and "rdx", as the generated functions.
+static const char * const _runtime =
+	"\t.intel_syntax noprefix\n"
+	"\n"
+	"\t.ifndef STACK_BUDGET\n"
+	"\t.set STACK_BUDGET, 6291456\n"
+	"\t.endif\n"
+	"\t.set RT_CAPACITY, 65536\n"
+	"\n"
+	"\t.lcomm rt_buffer, RT_CAPACITY\n"
+	"\t.lcomm rt_size, 8\n"
+	"\t.lcomm rt_stackLimit, 8\n"
+	"\n"
+	"\t.section .rodata\n"
+	"rt_true:\n"
+	"\t.ascii \"TRUE\\n\"\n"
+	"rt_false:\n"
+	"\t.ascii \"FALSE\\n\"\n"
+	"rt_newline:\n"
+	"\t.ascii \"\\n\"\n"
+	"rt_onLine:\n"
+	"\t.ascii \" (on line \"\n"
+	"rt_overflowError:\n"
+	"\t.quad 16\n"
+	"\t.ascii \"Integer overflow\"\n"
+	"rt_divisionError:\n"
+	"\t.quad 16\n"
+	"\t.ascii \"Division by zero\"\n"
+	"rt_stackError:\n"
+	"\t.quad 21\n"
+	"\t.ascii \"Too many nested calls\"\n"
+	"\n"
+	"\t.text\n"
+	"\t.globl _start\n"
+	"\n"
+	"# Writes the buffer into the standard output.\n"
+	"rt_flush:\n"
+	"\tpush rcx\n"
+	"\tpush rdx\n"
+	"\tpush rsi\n"
+	"\tpush rdi\n"
+	"\tpush r11\n"
+	"\tlea rsi, [rip + rt_buffer]\n"
+	"\tmov rdx, qword ptr [rip + rt_size]\n"
+	"1:\n"
+	"\ttest rdx, rdx\n"
+	"\tjz 2f\n"
+	"\tmov eax, 1\n"
+	"\tmov edi, 1\n"
+	"\tsyscall\n"
+	"\ttest rax, rax\n"
+	"\tjle 2f\n"
+	"\tadd rsi, rax\n"
+	"\tsub rdx, rax\n"
+	"\tjmp 1b\n"
+	"2:\n"
+	"\tmov qword ptr [rip + rt_size], 0\n"
+	"\tpop r11\n"
+	"\tpop rdi\n"
+	"\tpop rsi\n"
+	"\tpop rdx\n"
+	"\tpop rcx\n"
+	"\tret\n"
+	"\n"
+	"# Appends \"rdx\" bytes from \"rcx\" to the buffer.\n"
+	"rt_write:\n"
+	"\tpush rsi\n"
+	"\tpush rdi\n"
+	"\tmov rsi, rcx\n"
+	"1:\n"
+	"\ttest rdx, rdx\n"
+	"\tjz 3f\n"
+	"\tmov rax, qword ptr [rip + rt_size]\n"
+	"\tcmp rax, RT_CAPACITY\n"
+	"\tjb 2f\n"
+	"\tcall rt_flush\n"
+	"\txor eax, eax\n"
+	"2:\n"
+	"\tmov rcx, RT_CAPACITY\n"
+	"\tsub rcx, rax\n"
+	"\tcmp rcx, rdx\n"
+	"\tcmova rcx, rdx\n"
+	"\tsub rdx, rcx\n"
+	"\tlea rdi, [rip + rt_buffer]\n"
+	"\tadd rdi, rax\n"
+	"\tadd rax, rcx\n"
+	"\tmov qword ptr [rip + rt_size], rax\n"
+	"\trep movsb\n"
+	"\tjmp 1b\n"
+	"3:\n"
+	"\tpop rdi\n"
+	"\tpop rsi\n"
+	"\tret\n"
+	"\n"
+	"# Prints the integer in \"rax\".\n"
+	"rt_printInt:\n"
+	"\tpush rbx\n"
+	"\tpush rsi\n"
+	"\tsub rsp, 24\n"
+	"\tlea rcx, [rsp + 23]\n"
+	"\tmov byte ptr [rcx], 10\n"
+	"\tmov rsi, rax\n"
+	"\ttest rax, rax\n"
+	"\tjns 1f\n"
+	"\tneg rax\n"
+	"1:\n"
+	"\tmov ebx, 10\n"
+	"2:\n"
+	"\txor edx, edx\n"
+	"\tdiv rbx\n"
+	"\tadd dl, 48\n"
+	"\tdec rcx\n"
+	"\tmov byte ptr [rcx], dl\n"
+	"\ttest rax, rax\n"
+	"\tjnz 2b\n"
+	"\ttest rsi, rsi\n"
+	"\tjns 3f\n"
+	"\tdec rcx\n"
+	"\tmov byte ptr [rcx], 45\n"
+	"3:\n"
+	"\tlea rdx, [rsp + 24]\n"
+	"\tsub rdx, rcx\n"
+	"\tcall rt_write\n"
+	"\tadd rsp, 24\n"
+	"\tpop rsi\n"
+	"\tpop rbx\n"
+	"\tret\n"
+	"\n"
+	"# Prints the boolean in \"rax\".\n"
+	"rt_printBool:\n"
+	"\ttest rax, rax\n"
+	"\tjz 1f\n"
+	"\tlea rcx, [rip + rt_true]\n"
+	"\tmov edx, 5\n"
+	"\tjmp rt_write\n"
+	"1:\n"
+	"\tlea rcx, [rip + rt_false]\n"
+	"\tmov edx, 6\n"
+	"\tjmp rt_write\n"
+	"\n"
+	"# Prints the string in \"rax\".\n"
+	"rt_printString:\n"
+	"\ttest rax, rax\n"
+	"\tjz 1f\n"
+	"\tlea rcx, [rax + 8]\n"
+	"\tmov rdx, qword ptr [rax]\n"
+	"\tcall rt_write\n"
+	"1:\n"
+	"\tlea rcx, [rip + rt_newline]\n"
+	"\tmov edx, 1\n"
+	"\tjmp rt_write\n"
+	"\n"
+	"# Flushes the output, and exits successfully.\n"
+	"rt_exit:\n"
+	"\tcall rt_flush\n"
+	"\tmov eax, 60\n"
+	"\txor edi, edi\n"
+	"\tsyscall\n"
+	"\n"
+	"rt_overflow:\n"
+	"\tlea rcx, [rip + rt_overflowError]\n"
+	"\tjmp rt_fail\n"
+	"\n"
+	"rt_divisionByZero:\n"
+	"\tlea rcx, [rip + rt_divisionError]\n"
+	"\tjmp rt_fail\n"
+	"\n"
+	"rt_tooManyCalls:\n"
+	"\tlea rcx, [rip + rt_stackError]\n"
+	"\tjmp rt_fail\n"
+	"\n"
+	"# Flushes the output, prints the error in \"rcx\" (on the line in \"edx\")\n"
+	"# into the standard error, and exits with a failure.\n"
+	"rt_fail:\n"
+	"\tmov r12, rcx\n"
+	"\tmov r13d, edx\n"
+	"\tcall rt_flush\n"
+	"\tmov eax, 1\n"
+	"\tmov edi, 2\n"
+	"\tlea rsi, [r12 + 8]\n"
+	"\tmov rdx, qword ptr [r12]\n"
+	"\tsyscall\n"
+	"\tmov eax, 1\n"
+	"\tmov edi, 2\n"
+	"\tlea rsi, [rip + rt_onLine]\n"
+	"\tmov edx, 10\n"
+	"\tsyscall\n"
+	"\tsub rsp, 16\n"
+	"\tlea rsi, [rsp + 13]\n"
+	"\tmov byte ptr [rsi], 41\n"
+	"\tmov byte ptr [rsi + 1], 46\n"
+	"\tmov byte ptr [rsi + 2], 10\n"
+	"\tmov eax, r13d\n"
+	"\tmov ecx, 10\n"
+	"1:\n"
+	"\txor edx, edx\n"
+	"\tdiv ecx\n"
+	"\tadd dl, 48\n"
+	"\tdec rsi\n"
+	"\tmov byte ptr [rsi], dl\n"
+	"\ttest eax, eax\n"
+	"\tjnz 1b\n"
+	"\tlea rdx, [rsp + 16]\n"
+	"\tsub rdx, rsi\n"
+	"\tmov eax, 1\n"
+	"\tmov edi, 2\n"
+	"\tsyscall\n"
+	"\tmov eax, 60\n"
+	"\tmov edi, 1\n"
+	"\tsyscall\n";
+
+static Logger * _logger = NULL;
+
+void initializeAssemblyGeneratorModule() {
+	_logger = createLogger("AssemblyGenerator");
+}
+
+void shutdownAssemblyGeneratorModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+static const char * _address(AssemblyGenerator * generator, const Slot slot, const char * scratch, char * buffer);
+static void _allocate(AssemblyGenerator * generator);
+static void _append(Text * text, const char * const format, ...);
+static void _arithmetic(AssemblyGenerator * generator, const ArithmeticExpression * arithmeticExpression);
+static void _block(AssemblyGenerator * generator, const Block * block);
+static void _boolean(AssemblyGenerator * generator, const BooleanExpression * booleanExpression);
+static void _branch(AssemblyGenerator * generator, const BooleanExpression * booleanExpression, const unsigned int label, const boolean when);
+static void _call(AssemblyGenerator * generator, const FunctionCall * functionCall);
+static void _compare(AssemblyGenerator * generator, const Operation * operation);
+static void _condition(AssemblyGenerator * generator, const BooleanExpression * booleanExpression, const unsigned int label, const boolean when);
+static DemandEntry * _demandEntryOf(const AssemblyGenerator * generator, const ArithmeticExpression * arithmeticExpression);
+static Demand _demandOf(AssemblyGenerator * generator, const ArithmeticExpression * arithmeticExpression);
+static Operation * _emit(AssemblyGenerator * generator, const Opcode opcode);
+static Operand _evaluate(AssemblyGenerator * generator, const TaskKind kind, const void * node);
+static void _expression(AssemblyGenerator * generator, const Expression * expression);
+static unsigned int _failure(AssemblyGenerator * generator, const char * routine, const unsigned int line);
+static void _function(AssemblyGenerator * generator, const unsigned int index, const Block * block, const Function * function);
+static boolean _inMemory(const AssemblyGenerator * generator, const Operand operand);
+static void _instruction(AssemblyGenerator * generator, const Instruction * instruction);
+static unsigned int _levelOf(const AssemblyGenerator * generator, const unsigned int index);
+static Operand _load(AssemblyGenerator * generator, const Slot slot);
+static void _lower(AssemblyGenerator * generator);
+static void _memoizeDemand(AssemblyGenerator * generator, const ArithmeticExpression * arithmeticExpression, const Demand demand);
+static void _operands(AssemblyGenerator * generator, Task apply, const ArithmeticExpression * left, const ArithmeticExpression * right);
+static const char * _place(const AssemblyGenerator * generator, const Operand operand, const boolean wide, char * buffer);
+static Operand _popOperand(AssemblyGenerator * generator);
+static void _popOperands(AssemblyGenerator * generator, const boolean swapped, Operand * left, Operand * right);
+static void _pushOperand(AssemblyGenerator * generator, const Operand operand);
+static void _pushTask(AssemblyGenerator * generator, const Task task);
+static Operand _register(AssemblyGenerator * generator);
+static void _result(AssemblyGenerator * generator, const Operand target);
+static void _scan(AssemblyGenerator * generator, const Block * block, const unsigned int index);
+static void _select(AssemblyGenerator * generator, const Operation * operation, const unsigned int returnLabel, const boolean last);
+static void _string(AssemblyGenerator * generator, const StringExpression * stringExpression);
+
+/**
+ * Appends the loads of the frame of a variable (through the static links,
+ * into a scratch register), and returns the address of the variable: a
+ * global (in the program), or a quadword of a frame.
+ */
+static const char * _address(AssemblyGenerator * generator, const Slot slot, const char * scratch, char * buffer) {
+	if (_levelOf(generator, generator->function) == slot.depth) {
+		snprintf(buffer, 64, "qword ptr [rip + rt_globals + %u]", 8 * slot.index);
+		return buffer;
+	}
+	if (slot.depth == 0) {
+		snprintf(buffer, 64, "qword ptr [rbp - %u]", 8 * (slot.index + 1));
+		return buffer;
+	}
+	_append(&generator->text, "\tmov %s, qword ptr [rbp + 16]\n", scratch);
+	for (unsigned int k = 1; k < slot.depth; ++k) {
+		_append(&generator->text, "\tmov %s, qword ptr [%s + 16]\n", scratch, scratch);
+	}
+	snprintf(buffer, 64, "qword ptr [%s - %u]", scratch, 8 * (slot.index + 1));
+	return buffer;
+}
+
+/**
+ * Allocates the virtual registers of the current function into machine
+ * registers, with a linear scan over their live intervals (from their first
+ * to their last operation). The virtual registers are numbered in the order
+ * of their first definitions, so their intervals are already sorted by start.
+ * When every machine register is taken, the interval that ends last is
+ * spilled into its own slot of the frame.
+ *
+ * Every value that lives across a loop (i.e., its counter and its last
+ * value) is used by the test at the bottom of the loop, so its interval
+ * covers the whole loop.
+ */
+static void _allocate(AssemblyGenerator * generator) {
+	const unsigned int registers = generator->registers;
+	if (generator->locationCapacity < registers) {
+		generator->locationCapacity = registers < _initialCapacity ? _initialCapacity : 2 * registers;
+		generator->starts = realloc(generator->starts, generator->locationCapacity * sizeof(unsigned int));
+		generator->ends = realloc(generator->ends, generator->locationCapacity * sizeof(unsigned int));
+		generator->locations = realloc(generator->locations, generator->locationCapacity * sizeof(int));
+	}
+	for (unsigned int k = 0; k < registers; ++k) {
+		generator->starts[k] = UINT_MAX;
+		generator->ends[k] = 0;
+	}
+	for (unsigned int position = 0; position < generator->size; ++position) {
+		const Operand operands[] = {generator->operations[position].target, generator->operations[position].left, generator->operations[position].right};
+		for (unsigned int k = 0; k < 3; ++k) {
+			if (operands[k].kind == REGISTER_OPERAND) {
+				const unsigned int virtualRegister = operands[k].value;
+				generator->starts[virtualRegister] = position < generator->starts[virtualRegister] ? position : generator->starts[virtualRegister];
+				generator->ends[virtualRegister] = generator->ends[virtualRegister] < position ? position : generator->ends[virtualRegister];
+			}
+		}
+	}
+	// The active intervals, sorted by end.
+	unsigned int active[sizeof(_registers) / sizeof(_registers[0])];
+	unsigned int actives = 0;
+	unsigned int available = (1u << _machineRegisters) - 1;
+	generator->spills = 0;
+	generator->savedRegisters = 0;
+	for (unsigned int virtualRegister = 0; virtualRegister < registers; ++virtualRegister) {
+		const unsigned int start = generator->starts[virtualRegister];
+		const unsigned int end = generator->ends[virtualRegister];
+		// An operation reads its operands before it writes its target, so an
+		// interval that ends where another one starts can share its register.
+		unsigned int expired = 0;
+		while (expired < actives && generator->ends[active[expired]] <= start) {
+			available |= 1u << generator->locations[active[expired++]];
+		}
+		actives -= expired;
+		memmove(active, active + expired, actives * sizeof(unsigned int));
+		if (available == 0 && end < generator->ends[active[actives - 1]]) {
+			const unsigned int spilled = active[--actives];
+			available |= 1u << generator->locations[spilled];
+			generator->locations[spilled] = -(int) ++generator->spills;
+		}
+		if (available == 0) {
+			generator->locations[virtualRegister] = -(int) ++generator->spills;
+			continue;
+		}
+		unsigned int machineRegister = 0;
+		while (!(available & (1u << machineRegister))) {
+			++machineRegister;
+		}
+		available &= ~(1u << machineRegister);
+		generator->savedRegisters |= 1u << machineRegister;
+		generator->locations[virtualRegister] = machineRegister;
+		unsigned int k = actives++;
+		for (; 0 < k && end < generator->ends[active[k - 1]]; --k) {
+			active[k] = active[k - 1];
+		}
+		active[k] = virtualRegister;
+	}
+	generator->virtualRegisters += registers;
+	generator->spilledRegisters += generator->spills;
+}
+
+/**
+ * Appends a formatted string to a text, doubling its capacity as needed.
+ */
+static void _append(Text * text, const char * const format, ...) {
+	va_list arguments;
+	va_list copy;
+	va_start(arguments, format);
+	va_copy(copy, arguments);
+	const size_t length = vsnprintf(NULL, 0, format, arguments);
+	va_end(arguments);
+	while (text->capacity < text->size + length + 1) {
+		text->capacity = text->capacity == 0 ? _initialCapacity : 2 * text->capacity;
+		text->text = realloc(text->text, text->capacity);
+	}
+	vsnprintf(text->text + text->size, length + 1, format, copy);
+	va_end(copy);
+	text->size += length;
+}
+
+/**
+ * Lowers an arithmetic expression (i.e., the pending work of an operation).
+ * An integer literal becomes an immediate operand.
+ */
+static void _arithmetic(AssemblyGenerator * generator, const ArithmeticExpression * arithmeticExpression) {
+	switch (arithmeticExpression->type) {
+		case INT_LITERAL_T:
+			_pushOperand(generator, (Operand) {IMMEDIATE_OPERAND, arithmeticExpression->value});
+			break;
+		case VAR_ARITH_T:
+			_pushOperand(generator, _load(generator, arithmeticExpression->slot));
+			break;
+		case FUNC_CALL_ARITH_T:
+			_call(generator, arithmeticExpression->functionCall);
+			break;
+		default:
+			_operands(generator, (Task) {.node = arithmeticExpression, .kind = APPLY_ARITHMETIC}, arithmeticExpression->left, arithmeticExpression->right);
+			break;
+	}
+}
+
+/**
+ * Lowers the instructions of a block (except the functions).
+ */
+static void _block(AssemblyGenerator * generator, const Block * block) {
+	for (const Instruction * instruction = block->instructions; instruction != NULL; instruction = instruction->next) {
+		_instruction(generator, instruction);
+	}
+}
+
+/**
+ * Lowers a boolean expression into a value (0 or 1), or the pending work of
+ * an operation. "AND" and "OR" short-circuit through jumps.
+ */
+static void _boolean(AssemblyGenerator * generator, const BooleanExpression * booleanExpression) {
+	switch (booleanExpression->type) {
+		case AND_T:
+		case OR_T: {
+			const unsigned int end = generator->labels++;
+			const Operand target = _register(generator);
+			Operation * operation = _emit(generator, MOVE_IR);
+			operation->target = target;
+			operation->left = (Operand) {IMMEDIATE_OPERAND, 0};
+			_pushTask(generator, (Task) {.label = end, .target = target, .kind = MATERIALIZE});
+			_branch(generator, booleanExpression, end, false);
+			break;
+		}
+		case NOT_T:
+			_pushTask(generator, (Task) {.kind = APPLY_NOT});
+			_pushTask(generator, (Task) {.node = booleanExpression->notExpr, .kind = BOOLEAN});
+			break;
+		case COMPARISON_T:
+			_operands(generator, (Task) {.node = booleanExpression, .kind = APPLY_COMPARISON}, booleanExpression->leftArith, booleanExpression->rightArith);
+			break;
+		case VAR_BOOL_T:
+			_pushOperand(generator, _load(generator, booleanExpression->slot));
+			break;
+		case BOOL_LITERAL_T:
+			_pushOperand(generator, (Operand) {IMMEDIATE_OPERAND, booleanExpression->value ? 1 : 0});
+			break;
+		case FUNC_CALL_BOOL_T:
+			_call(generator, booleanExpression->functionCall);
+			break;
+		default:
+			_pushOperand(generator, (Operand) {IMMEDIATE_OPERAND, 0});
+			break;
+	}
+}
+
+/**
+ * Lowers a boolean expression into jumps (or the pending work of them): to
+ * the label if its value is "when", or to the next operation otherwise.
+ */
+static void _branch(AssemblyGenerator * generator, const BooleanExpression * booleanExpression, const unsigned int label, const boolean when) {
+	switch (booleanExpression->type) {
+		case AND_T:
+		case OR_T: {
+			// The left operand decides the expression if it's false (in an
+			// "AND") or true (in an "OR").
+			const boolean decisive = booleanExpression->type == OR_T;
+			if (when == decisive) {
+				_pushTask(generator, (Task) {.node = booleanExpression->right, .label = label, .kind = BRANCH, .when = when});
+				_pushTask(generator, (Task) {.node = booleanExpression->left, .label = label, .kind = BRANCH, .when = when});
+			}
+			else {
+				const unsigned int skip = generator->labels++;
+				_pushTask(generator, (Task) {.label = skip, .kind = LABEL});
+				_pushTask(generator, (Task) {.node = booleanExpression->right, .label = label, .kind = BRANCH, .when = when});
+				_pushTask(generator, (Task) {.node = booleanExpression->left, .label = skip, .kind = BRANCH, .when = decisive});
+			}
+			break;
+		}
+		case NOT_T:
+			_pushTask(generator, (Task) {.node = booleanExpression->notExpr, .label = label, .kind = BRANCH, .when = !when});
+			break;
+		case COMPARISON_T:
+			_operands(generator, (Task) {.node = booleanExpression, .label = label, .kind = BRANCH_ON_COMPARISON, .when = when},
+				booleanExpression->leftArith, booleanExpression->rightArith);
+			break;
+		case BOOL_LITERAL_T:
+			if (booleanExpression->value == when) {
+				_emit(generator, JUMP_IR)->label = label;
+			}
+			break;
+		default:
+			_pushTask(generator, (Task) {.label = label, .kind = BRANCH_ON_VALUE, .when = when});
+			_boolean(generator, booleanExpression);
+			break;
+	}
+}
+
+/**
+ * Lowers a call (i.e., its pending work). A recursive callee checks the stack
+ * first. Every argument is pushed as soon as it's evaluated, and a nested
+ * callee receives the frame of the function that encloses it.
+ */
+static void _call(AssemblyGenerator * generator, const FunctionCall * functionCall) {
+	const CallGraphNode * callee = calleeOf(generator->callGraph, functionCall);
+	if (callee == NULL) {
+		logError(_logger, "The function \"%s\" cannot be resolved (on line %u).", functionCall->functionName, generator->line);
+		generator->succeed = false;
+		_pushOperand(generator, (Operand) {IMMEDIATE_OPERAND, 0});
+		return;
+	}
+	if (callee->recursive) {
+		_emit(generator, ENTER_IR);
+	}
+	_pushTask(generator, (Task) {.node = callee, .kind = INVOKE});
+	if (functionCall->arguments != NULL) {
+		_pushTask(generator, (Task) {.node = functionCall->arguments, .kind = ARGUMENTS});
+	}
+}
+
+/**
+ * Appends the comparison of the operands of an operation, with at most one
+ * of them in memory (through "rax").
+ */
+static void _compare(AssemblyGenerator * generator, const Operation * operation) {
+	char left[64];
+	char right[64];
+	_place(generator, operation->left, true, left);
+	_place(generator, operation->right, true, right);
+	if (operation->left.kind == IMMEDIATE_OPERAND || (_inMemory(generator, operation->left) && _inMemory(generator, operation->right))) {
+		_append(&generator->text, "\tmov rax, %s\n\tcmp rax, %s\n", left, right);
+	}
+	else {
+		_append(&generator->text, "\tcmp %s, %s\n", left, right);
+	}
+}
+
+/**
+ * Lowers a condition into jumps: to the label if its value is "when" (see
+ * "_branch").
+ */
+static void _condition(AssemblyGenerator * generator, const BooleanExpression * booleanExpression, const unsigned int label, const boolean when) {
+	_branch(generator, booleanExpression, label, when);
+	_lower(generator);
+}
+
+/**
+ * The entry of an operation in the table of demands, or the empty entry
+ * where it belongs.
+ */
+static DemandEntry * _demandEntryOf(const AssemblyGenerator * generator, const ArithmeticExpression * arithmeticExpression) {
+	const unsigned int mask = generator->demandCapacity - 1;
+	unsigned int k = hashAddress(arithmeticExpression) & mask;
+	while (generator->demands[k].expression != NULL && generator->demands[k].expression != arithmeticExpression) {
+		k = (k + 1) & mask;
+	}
+	return &generator->demands[k];
+}
+
+/**
+ * The demand of an arithmetic expression. The label of an operation is the
+ * highest one of its operands, or one more if both are equal; an immediate
+ * operand needs no register. The operations are walked in post-order, on an
+ * explicit stack, and each one is memoized.
+ */
+static Demand _demandOf(AssemblyGenerator * generator, const ArithmeticExpression * arithmeticExpression) {
+	switch (arithmeticExpression->type) {
+		case INT_LITERAL_T:
+			return (Demand) {0, false, false};
+		case VAR_ARITH_T:
+			return (Demand) {1, false, false};
+		case FUNC_CALL_ARITH_T:
+			return (Demand) {1, true, true};
+		default:
+			break;
+	}
+	unsigned int size = 0;
+	generator->pending[size++] = arithmeticExpression;
+	while (0 < size) {
+		const ArithmeticExpression * operation = generator->pending[size - 1];
+		if (_demandEntryOf(generator, operation)->expression != NULL) {
+			--size;
+			continue;
+		}
+		const ArithmeticExpression * children[] = {operation->left, operation->right};
+		Demand demands[2];
+		boolean known = true;
+		for (unsigned int k = 0; k < 2; ++k) {
+			switch (children[k]->type) {
+				case INT_LITERAL_T:
+				case VAR_ARITH_T:
+				case FUNC_CALL_ARITH_T:
+					demands[k] = _demandOf(generator, children[k]);
+					break;
+				default: {
+					const DemandEntry * entry = _demandEntryOf(generator, children[k]);
+					if (entry->expression != NULL) {
+						demands[k] = entry->demand;
+					}
+					else {
+						if (size == generator->pendingCapacity) {
+							generator->pendingCapacity *= 2;
+							generator->pending = realloc(generator->pending, generator->pendingCapacity * sizeof(const ArithmeticExpression *));
+						}
+						generator->pending[size++] = children[k];
+						known = false;
+					}
+					break;
+				}
+			}
+		}
+		if (known) {
+			const Demand left = demands[0];
+			const Demand right = demands[1];
+			const unsigned int registers = left.registers == right.registers ? left.registers + 1
+				: left.registers < right.registers ? right.registers : left.registers;
+			_memoizeDemand(generator, operation, (Demand) {
+				.registers = registers < 1 ? 1 : registers,
+				.calls = left.calls || right.calls,
+				.fails = left.fails || right.fails || rangeChecksOf(generator->rangeAnalysis, operation) != NO_CHECK
+			});
+			--size;
+		}
+	}
+	return _demandEntryOf(generator, arithmeticExpression)->demand;
+}
+
+/**
+ * Appends a new operation to the current function, on the current line, and
+ * returns it (only valid until the next one).
+ */
+static Operation * _emit(AssemblyGenerator * generator, const Opcode opcode) {
+	if (generator->size == generator->capacity) {
+		generator->capacity = generator->capacity == 0 ? _initialCapacity : 2 * generator->capacity;
+		generator->operations = realloc(generator->operations, generator->capacity * sizeof(Operation));
+	}
+	Operation * operation = &generator->operations[generator->size++];
+	*operation = (Operation) {.opcode = opcode, .line = generator->line};
+	return operation;
+}
+
+/**
+ * Lowers an expression (or a call), given the kind of its pending work, and
+ * returns the operand of its value.
+ */
+static Operand _evaluate(AssemblyGenerator * generator, const TaskKind kind, const void * node) {
+	_pushTask(generator, (Task) {.node = node, .kind = kind});
+	_lower(generator);
+	return _popOperand(generator);
+}
+
+/**
+ * Lowers an expression of any type (i.e., its pending work).
+ */
+static void _expression(AssemblyGenerator * generator, const Expression * expression) {
+	switch (expression->type) {
+		case ARITHMETIC_EXPR_T:
+			_arithmetic(generator, expression->arithmeticExpression);
+			break;
+		case BOOLEAN_EXPR_T:
+			_boolean(generator, expression->booleanExpression);
+			break;
+		default:
+			_string(generator, expression->stringExpression);
+			break;
+	}
+}
+
+/**
+ * Appends a stub to the end of the current function, that stops the program
+ * with a routine of the runtime on a line, and returns its label.
+ */
+static unsigned int _failure(AssemblyGenerator * generator, const char * routine, const unsigned int line) {
+	const unsigned int label = generator->labels++;
+	_append(&generator->failures, ".L%u:\n\tmov edx, %u\n\tjmp %s\n", label, line, routine);
+	return label;
+}
+
+/**
+ * Generates a function (or the program, if the function is NULL): lowers its
+ * block, allocates its registers, and appends its code. A function saves the
+ * machine registers that it uses, clears its variables, copies its arguments
+ * into the slots of its parameters, and returns the default value of its
+ * type (i.e., 0), unless its body ends with a return.
+ */
+static void _function(AssemblyGenerator * generator, const unsigned int index, const Block * block, const Function * function) {
+	generator->function = index;
+	generator->frameSize = function == NULL ? 0 : function->frameSize;
+	generator->size = 0;
+	generator->registers = 0;
+	_block(generator, block);
+	_allocate(generator);
+	Text * text = &generator->text;
+	const unsigned int locals = 8 * (generator->frameSize + generator->spills);
+	unsigned int saved = 0;
+	if (function == NULL) {
+		_append(text, "\n_start:\n\tmov rbp, rsp\n\tlea rax, [rsp - STACK_BUDGET]\n\tmov qword ptr [rip + rt_stackLimit], rax\n");
+		if (locals != 0) {
+			_append(text, "\tsub rsp, %u\n", locals);
+		}
+	}
+	else {
+		_append(text, "\nf%u_%s:\n\tpush rbp\n\tmov rbp, rsp\n", index, function->functionName);
+		if (locals != 0) {
+			_append(text, "\tsub rsp, %u\n", locals);
+		}
+		for (unsigned int k = 0; k < _machineRegisters; ++k) {
+			if (generator->savedRegisters & (1u << k)) {
+				_append(text, "\tpush %s\n", _registers[k]);
+				++saved;
+			}
+		}
+		if (generator->frameSize <= 8) {
+			for (unsigned int slot = 0; slot < generator->frameSize; ++slot) {
+				_append(text, "\tmov qword ptr [rbp - %u], 0\n", 8 * (slot + 1));
+			}
+		}
+		else {
+			_append(text, "\tlea rdx, [rbp - %u]\n\tmov ecx, %u\n\txor eax, eax\n1:\n\tmov qword ptr [rdx + rcx * 8 - 8], rax\n\tdec ecx\n\tjnz 1b\n",
+				8 * generator->frameSize, generator->frameSize);
+		}
+		unsigned int parameters = 0;
+		for (const Parameters * parameter = function->parameters; parameter != NULL; parameter = parameter->next) {
+			++parameters;
+		}
+		// The arguments were pushed in order, followed by the static link.
+		unsigned int offset = 16 + 8 * parameters + (1 < _levelOf(generator, index) ? 8 : 0);
+		for (const Parameters * parameter = function->parameters; parameter != NULL; parameter = parameter->next) {
+			offset -= 8;
+			_append(text, "\tmov rax, qword ptr [rbp + %u]\n\tmov qword ptr [rbp - %u], rax\n", offset, 8 * (parameter->parameter->slot.index + 1));
+		}
+	}
+	const unsigned int returnLabel = generator->labels++;
+	for (unsigned int k = 0; k < generator->size; ++k) {
+		_select(generator, &generator->operations[k], returnLabel, k + 1 == generator->size);
+	}
+	const boolean returns = generator->size != 0 && generator->operations[generator->size - 1].opcode == RETURN_IR;
+	if (function == NULL) {
+		_append(text, returns ? "" : "\tjmp rt_exit\n");
+	}
+	else {
+		_append(text, returns ? "" : "\txor eax, eax\n");
+		_append(text, ".L%u:\n", returnLabel);
+		if (saved != 0) {
+			_append(text, "\tlea rsp, [rbp - %u]\n", locals + 8 * saved);
+			for (unsigned int k = _machineRegisters; 0 < k; --k) {
+				if (generator->savedRegisters & (1u << (k - 1))) {
+					_append(text, "\tpop %s\n", _registers[k - 1]);
+				}
+			}
+		}
+		_append(text, "\tleave\n\tret\n");
+	}
+	if (generator->failures.size != 0) {
+		_append(text, "%s", generator->failures.text);
+		generator->failures.size = 0;
+	}
+}
+
+/**
+ * Whether an operand is a virtual register spilled into the frame.
+ */
+static boolean _inMemory(const AssemblyGenerator * generator, const Operand operand) {
+	return operand.kind == REGISTER_OPERAND && generator->locations[operand.value] < 0;
+}
+
+/**
+ * Lowers an instruction. A "FOR" keeps its counter (which never overflows,
+ * since it's a quadword) and its last value in virtual registers, and tests
+ * them at the bottom of the loop, so the bounds are evaluated only once.
+ */
+static void _instruction(AssemblyGenerator * generator, const Instruction * instruction) {
+	const Assignation * assignation = NULL;
+	generator->line = instruction->line;
+	switch (instruction->type) {
+		case DECLARATION_INSTRUCTION_T:
+			assignation = instruction->declaration->assignation;
+			break;
+		case ASSIGNATION_INSTRUCTION_T:
+			assignation = instruction->assignation;
+			break;
+		case EXPRESSION_INSTRUCTION_T:
+			_evaluate(generator, EXPRESSION, instruction->expression);
+			break;
+		case PRINT_INSTRUCTION_T: {
+			const Operand value = _evaluate(generator, EXPRESSION, instruction->print->expression);
+			Operation * operation = _emit(generator, PRINT_IR);
+			operation->left = value;
+			operation->argument = instruction->print->expression->type;
+			break;
+		}
+		case FUNCTION_CALL_INSTRUCTION_T:
+			_evaluate(generator, CALL, instruction->functionCall);
+			break;
+		case RETURN_STATEMENT_INSTRUCTION_T: {
+			const Operand value = _evaluate(generator, EXPRESSION, instruction->returnStatement->expression);
+			_emit(generator, RETURN_IR)->left = value;
+			break;
+		}
+		case CONDITIONAL_INSTRUCTION_T: {
+			const Conditional * conditional = instruction->conditional;
+			const unsigned int otherwise = generator->labels++;
+			_condition(generator, conditional->condition, otherwise, false);
+			_block(generator, conditional->ifBlock);
+			if (conditional->elseBlock != NULL) {
+				const unsigned int end = generator->labels++;
+				_emit(generator, JUMP_IR)->label = end;
+				_emit(generator, LABEL_IR)->label = otherwise;
+				_block(generator, conditional->elseBlock);
+				_emit(generator, LABEL_IR)->label = end;
+			}
+			else {
+				_emit(generator, LABEL_IR)->label = otherwise;
+			}
+			break;
+		}
+		case LOOP_INSTRUCTION_T: {
+			const Loop * loop = instruction->loop;
+			const Operand start = _evaluate(generator, ARITHMETIC, loop->start);
+			const Operand end = _evaluate(generator, ARITHMETIC, loop->end);
+			const Operand counter = _register(generator);
+			const unsigned int body = generator->labels++;
+			const unsigned int test = generator->labels++;
+			Operation * operation = _emit(generator, MOVE_IR);
+			operation->target = counter;
+			operation->left = start;
+			_emit(generator, JUMP_IR)->label = test;
+			_emit(generator, LABEL_IR)->label = body;
+			operation = _emit(generator, STORE_IR);
+			operation->left = counter;
+			operation->slot = loop->slot;
+			_block(generator, loop->block);
+			generator->line = instruction->line;
+			_emit(generator, INCREMENT_IR)->target = counter;
+			_emit(generator, LABEL_IR)->label = test;
+			operation = _emit(generator, BRANCH_IR);
+			operation->left = counter;
+			operation->right = end;
+			operation->argument = LESS_EQUALS_T;
+			operation->label = body;
+			break;
+		}
+		default:
+			break;
+	}
+	if (assignation != NULL) {
+		const Operand value = _evaluate(generator, EXPRESSION, assignation->expression);
+		Operation * operation = _emit(generator, STORE_IR);
+		operation->left = value;
+		operation->slot = assignation->slot;
+	}
+}
+
+/**
+ * The level of a function (see "CallGraph.h"), or 0 for the program.
+ */
+static unsigned int _levelOf(const AssemblyGenerator * generator, const unsigned int index) {
+	return index == generator->program ? 0 : generator->callGraph->nodes[index].level;
+}
+
+/**
+ * Lowers the read of a variable, and returns the operand of its value.
+ */
+static Operand _load(AssemblyGenerator * generator, const Slot slot) {
+	const Operand target = _register(generator);
+	Operation * operation = _emit(generator, LOAD_IR);
+	operation->target = target;
+	operation->slot = slot;
+	return target;
+}
+
+/**
+ * Runs the pending work of the lowering of an expression, until it's done.
+ */
+static void _lower(AssemblyGenerator * generator) {
+	static const Opcode opcodes[] = {[ADD_T] = ADD_IR, [SUB_T] = SUB_IR, [MUL_T] = MUL_IR, [DIV_T] = DIV_IR};
+	while (0 < generator->taskSize) {
+		const Task task = generator->tasks[--generator->taskSize];
+		switch (task.kind) {
+			case APPLY_ARITHMETIC: {
+				const ArithmeticExpression * arithmeticExpression = task.node;
+				Operand left;
+				Operand right;
+				_popOperands(generator, task.swapped, &left, &right);
+				const Operand target = _register(generator);
+				Operation * operation = _emit(generator, opcodes[arithmeticExpression->type]);
+				operation->target = target;
+				operation->left = left;
+				operation->right = right;
+				operation->argument = rangeChecksOf(generator->rangeAnalysis, arithmeticExpression);
+				_pushOperand(generator, target);
+				break;
+			}
+			case APPLY_COMPARISON: {
+				const BooleanExpression * booleanExpression = task.node;
+				Operand left;
+				Operand right;
+				_popOperands(generator, task.swapped, &left, &right);
+				const Operand target = _register(generator);
+				Operation * operation = _emit(generator, SET_IR);
+				operation->target = target;
+				operation->left = left;
+				operation->right = right;
+				operation->argument = booleanExpression->op->type;
+				_pushOperand(generator, target);
+				break;
+			}
+			case APPLY_NOT: {
+				const Operand value = _popOperand(generator);
+				if (value.kind == IMMEDIATE_OPERAND) {
+					_pushOperand(generator, (Operand) {IMMEDIATE_OPERAND, !value.value});
+					break;
+				}
+				const Operand target = _register(generator);
+				Operation * operation = _emit(generator, SET_IR);
+				operation->target = target;
+				operation->left = value;
+				operation->right = (Operand) {IMMEDIATE_OPERAND, 0};
+				operation->argument = EQUALS_EQUALS_T;
+				_pushOperand(generator, target);
+				break;
+			}
+			case ARGUMENTS: {
+				const Arguments * arguments = task.node;
+				if (arguments->next != NULL) {
+					_pushTask(generator, (Task) {.node = arguments->next, .kind = ARGUMENTS});
+				}
+				_pushTask(generator, (Task) {.kind = PUSH_ARGUMENT});
+				_expression(generator, arguments->argument->expression);
+				break;
+			}
+			case ARITHMETIC:
+				_arithmetic(generator, task.node);
+				break;
+			case BOOLEAN:
+				_boolean(generator, task.node);
+				break;
+			case BRANCH:
+				_branch(generator, task.node, task.label, task.when);
+				break;
+			case BRANCH_ON_COMPARISON: {
+				const BooleanExpression * booleanExpression = task.node;
+				Operand left;
+				Operand right;
+				_popOperands(generator, task.swapped, &left, &right);
+				Operation * operation = _emit(generator, BRANCH_IR);
+				operation->left = left;
+				operation->right = right;
+				operation->argument = task.when ? booleanExpression->op->type : _negations[booleanExpression->op->type];
+				operation->label = task.label;
+				break;
+			}
+			case BRANCH_ON_VALUE: {
+				const Operand value = _popOperand(generator);
+				Operation * operation = _emit(generator, BRANCH_IR);
+				operation->left = value;
+				operation->right = (Operand) {IMMEDIATE_OPERAND, 0};
+				operation->argument = task.when ? NOT_EQUALS_T : EQUALS_EQUALS_T;
+				operation->label = task.label;
+				break;
+			}
+			case CALL:
+				_call(generator, task.node);
+				break;
+			case EXPRESSION:
+				_expression(generator, task.node);
+				break;
+			case INVOKE: {
+				const CallGraphNode * callee = task.node;
+				if (1 < callee->level) {
+					_emit(generator, LINK_IR)->argument = _levelOf(generator, generator->function) + 1 - callee->level;
+				}
+				const Operand target = _register(generator);
+				Operation * operation = _emit(generator, CALL_IR);
+				operation->target = target;
+				operation->argument = callee - generator->callGraph->nodes;
+				_pushOperand(generator, target);
+				break;
+			}
+			case LABEL:
+				_emit(generator, LABEL_IR)->label = task.label;
+				break;
+			case MATERIALIZE: {
+				Operation * operation = _emit(generator, MOVE_IR);
+				operation->target = task.target;
+				operation->left = (Operand) {IMMEDIATE_OPERAND, 1};
+				_emit(generator, LABEL_IR)->label = task.label;
+				_pushOperand(generator, task.target);
+				break;
+			}
+			case PUSH_ARGUMENT: {
+				const Operand argument = _popOperand(generator);
+				_emit(generator, ARGUMENT_IR)->left = argument;
+				break;
+			}
+			default:
+				break;
+		}
+	}
+}
+
+/**
+ * Memoizes the demand of an operation, doubling the capacity of the table if
+ * it's half full.
+ */
+static void _memoizeDemand(AssemblyGenerator * generator, const ArithmeticExpression * arithmeticExpression, const Demand demand) {
+	if (generator->demandCapacity <= 2 * (generator->demandSize + 1)) {
+		DemandEntry * demands = generator->demands;
+		const unsigned int capacity = generator->demandCapacity;
+		generator->demandCapacity *= 2;
+		generator->demands = calloc(generator->demandCapacity, sizeof(DemandEntry));
+		for (unsigned int k = 0; k < capacity; ++k) {
+			if (demands[k].expression != NULL) {
+				*_demandEntryOf(generator, demands[k].expression) = demands[k];
+			}
+		}
+		free(demands);
+	}
+	*_demandEntryOf(generator, arithmeticExpression) = (DemandEntry) {arithmeticExpression, demand};
+	++generator->demandSize;
+}
+
+/**
+ * Lowers the operands of an operation (i.e., their pending work, followed by
+ * the one that applies the operation), in the order of Sethi-Ullman (i.e.,
+ * the one with the highest label first, so fewer registers are live at
+ * once), unless the order of the source could be observed: if either operand
+ * calls a function (which could print, or write the variables of the other
+ * one), or if both can fail (with different errors).
+ */
+static void _operands(AssemblyGenerator * generator, Task apply, const ArithmeticExpression * left, const ArithmeticExpression * right) {
+	const Demand leftDemand = _demandOf(generator, left);
+	const Demand rightDemand = _demandOf(generator, right);
+	apply.swapped = !leftDemand.calls && !rightDemand.calls && !(leftDemand.fails && rightDemand.fails) && leftDemand.registers < rightDemand.registers;
+	_pushTask(generator, apply);
+	_pushTask(generator, (Task) {.node = apply.swapped ? left : right, .kind = ARITHMETIC});
+	_pushTask(generator, (Task) {.node = apply.swapped ? right : left, .kind = ARITHMETIC});
+}
+
+/**
+ * Writes an operand in a buffer (as a quadword or, if it isn't wide, as a
+ * doubleword), and returns it: an immediate, a machine register, or a spill
+ * slot (below the variables of the frame).
+ */
+static const char * _place(const AssemblyGenerator * generator, const Operand operand, const boolean wide, char * buffer) {
+	if (operand.kind == IMMEDIATE_OPERAND) {
+		snprintf(buffer, 64, "%d", operand.value);
+		return buffer;
+	}
+	const int location = generator->locations[operand.value];
+	if (0 <= location) {
+		snprintf(buffer, 64, "%s", wide ? _registers[location] : _registers32[location]);
+		return buffer;
+	}
+	snprintf(buffer, 64, "%s ptr [rbp - %u]", wide ? "qword" : "dword", 8 * (generator->frameSize - location));
+	return buffer;
+}
+
+/**
+ * Pops the operand of the value of the last expression evaluated.
+ */
+static Operand _popOperand(AssemblyGenerator * generator) {
+	return generator->operands[--generator->operandSize];
+}
+
+/**
+ * Pops the operands of an operation, given whether its right operand was
+ * evaluated first.
+ */
+static void _popOperands(AssemblyGenerator * generator, const boolean swapped, Operand * left, Operand * right) {
+	const Operand last = _popOperand(generator);
+	const Operand first = _popOperand(generator);
+	*left = swapped ? last : first;
+	*right = swapped ? first : last;
+}
+
+/**
+ * Pushes the operand of the value of an expression, doubling the capacity of
+ * the stack as needed.
+ */
+static void _pushOperand(AssemblyGenerator * generator, const Operand operand) {
+	if (generator->operandSize == generator->operandCapacity) {
+		generator->operandCapacity *= 2;
+		generator->operands = realloc(generator->operands, generator->operandCapacity * sizeof(Operand));
+	}
+	generator->operands[generator->operandSize++] = operand;
+}
+
+/**
+ * Pushes a pending work on the stack, doubling its capacity as needed.
+ */
+static void _pushTask(AssemblyGenerator * generator, const Task task) {
+	if (generator->taskSize == generator->taskCapacity) {
+		generator->taskCapacity *= 2;
+		generator->tasks = realloc(generator->tasks, generator->taskCapacity * sizeof(Task));
+	}
+	generator->tasks[generator->taskSize++] = task;
+}
+
+/**
+ * A new virtual register of the current function.
+ */
+static Operand _register(AssemblyGenerator * generator) {
+	return (Operand) {REGISTER_OPERAND, generator->registers++};
+}
+
+/**
+ * Appends the sign-extension of the 32-bit result in "eax" into a target.
+ */
+static void _result(AssemblyGenerator * generator, const Operand target) {
+	char buffer[64];
+	if (_inMemory(generator, target)) {
+		_append(&generator->text, "\tcdqe\n\tmov %s, rax\n", _place(generator, target, true, buffer));
+	}
+	else {
+		_append(&generator->text, "\tmovsxd %s, eax\n", _place(generator, target, true, buffer));
+	}
+}
+
+/**
+ * Finds the function that encloses every function declared in a block (and
+ * in the blocks nested in it), given the function of the block.
+ */
+static void _scan(AssemblyGenerator * generator, const Block * block, const unsigned int index) {
+	for (const Instruction * instruction = block->instructions; instruction != NULL; instruction = instruction->next) {
+		switch (instruction->type) {
+			case FUNCTION_INSTRUCTION_T: {
+				const CallGraphNode * node = callGraphNodeOf(generator->callGraph, instruction->function);
+				if (node != NULL) {
+					const unsigned int function = node - generator->callGraph->nodes;
+					generator->parents[function] = index;
+					_scan(generator, instruction->function->block, function);
+				}
+				break;
+			}
+			case CONDITIONAL_INSTRUCTION_T:
+				_scan(generator, instruction->conditional->ifBlock, index);
+				if (instruction->conditional->elseBlock != NULL) {
+					_scan(generator, instruction->conditional->elseBlock, index);
+				}
+				break;
+			case LOOP_INSTRUCTION_T:
+				_scan(generator, instruction->loop->block, index);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+/**
+ * Appends the machine code of an operation (i.e., the instruction
+ * selection), with "rax", "rcx" and "rdx" as scratch registers. The integer
+ * operations are 32-bit wide, so the overflow flag checks them.
+ */
+static void _select(AssemblyGenerator * generator, const Operation * operation, const unsigned int returnLabel, const boolean last) {
+	static const char * const mnemonics[] = {[ADD_IR] = "add", [SUB_IR] = "sub", [MUL_IR] = "imul"};
+	Text * text = &generator->text;
+	char target[64];
+	char left[64];
+	char right[64];
+	switch (operation->opcode) {
+		case MOVE_IR:
+			_place(generator, operation->target, true, target);
+			_place(generator, operation->left, true, left);
+			if (_inMemory(generator, operation->target) && _inMemory(generator, operation->left)) {
+				_append(text, "\tmov rax, %s\n\tmov %s, rax\n", left, target);
+			}
+			else {
+				_append(text, "\tmov %s, %s\n", target, left);
+			}
+			break;
+		case STRING_IR:
+			if (_inMemory(generator, operation->target)) {
+				_append(text, "\tlea rax, [rip + .LS%u]\n\tmov %s, rax\n", operation->argument, _place(generator, operation->target, true, target));
+			}
+			else {
+				_append(text, "\tlea %s, [rip + .LS%u]\n", _place(generator, operation->target, true, target), operation->argument);
+			}
+			break;
+		case LOAD_IR:
+			_address(generator, operation->slot, "rax", left);
+			if (_inMemory(generator, operation->target)) {
+				_append(text, "\tmov rax, %s\n\tmov %s, rax\n", left, _place(generator, operation->target, true, target));
+			}
+			else {
+				_append(text, "\tmov %s, %s\n", _place(generator, operation->target, true, target), left);
+			}
+			break;
+		case STORE_IR:
+			_place(generator, operation->left, true, left);
+			if (_inMemory(generator, operation->left)) {
+				_append(text, "\tmov rax, %s\n", left);
+				strcpy(left, "rax");
+			}
+			_address(generator, operation->slot, "rcx", target);
+			_append(text, "\tmov %s, %s\n", target, left);
+			break;
+		case ADD_IR:
+		case SUB_IR:
+		case MUL_IR:
+			_append(text, "\tmov eax, %s\n", _place(generator, operation->left, false, left));
+			_place(generator, operation->right, false, right);
+			if (operation->opcode == MUL_IR && operation->right.kind == IMMEDIATE_OPERAND) {
+				_append(text, "\timul eax, eax, %s\n", right);
+			}
+			else {
+				_append(text, "\t%s eax, %s\n", mnemonics[operation->opcode], right);
+			}
+			if (operation->argument & OVERFLOW_CHECK) {
+				_append(text, "\tjo .L%u\n", _failure(generator, "rt_overflow", operation->line));
+			}
+			_result(generator, operation->target);
+			break;
+		case DIV_IR:
+			_append(text, "\tmov eax, %s\n", _place(generator, operation->left, false, left));
+			_append(text, "\tmov ecx, %s\n", _place(generator, operation->right, false, right));
+			if (operation->argument & DIVISION_BY_ZERO_CHECK) {
+				_append(text, "\ttest ecx, ecx\n\tjz .L%u\n", _failure(generator, "rt_divisionByZero", operation->line));
+			}
+			if (operation->argument & OVERFLOW_CHECK) {
+				// Only INT_MIN / -1 overflows (and it would trap).
+				const unsigned int label = generator->labels++;
+				_append(text, "\tcmp ecx, -1\n\tjne .L%u\n\tcmp eax, %d\n\tje .L%u\n.L%u:\n",
+					label, INT_MIN, _failure(generator, "rt_overflow", operation->line), label);
+			}
+			_append(text, "\tcdq\n\tidiv ecx\n");
+			_result(generator, operation->target);
+			break;
+		case INCREMENT_IR:
+			_append(text, "\tadd %s, 1\n", _place(generator, operation->target, true, target));
+			break;
+		case SET_IR:
+			_compare(generator, operation);
+			if (_inMemory(generator, operation->target)) {
+				_append(text, "\tset%s al\n\tmovzx eax, al\n\tmov %s, rax\n", _conditions[operation->argument],
+					_place(generator, operation->target, true, target));
+			}
+			else {
+				_append(text, "\tset%s al\n\tmovzx %s, al\n", _conditions[operation->argument], _place(generator, operation->target, false, target));
+			}
+			break;
+		case BRANCH_IR:
+			_compare(generator, operation);
+			_append(text, "\tj%s .L%u\n", _conditions[operation->argument], operation->label);
+			break;
+		case JUMP_IR:
+			_append(text, "\tjmp .L%u\n", operation->label);
+			break;
+		case LABEL_IR:
+			_append(text, ".L%u:\n", operation->label);
+			break;
+		case ENTER_IR:
+			_append(text, "\tcmp rsp, qword ptr [rip + rt_stackLimit]\n\tjb .L%u\n", _failure(generator, "rt_tooManyCalls", operation->line));
+			break;
+		case ARGUMENT_IR:
+			_append(text, "\tpush %s\n", _place(generator, operation->left, true, left));
+			break;
+		case LINK_IR:
+			if (operation->argument == 0) {
+				_append(text, "\tpush rbp\n");
+			}
+			else {
+				_append(text, "\tmov rax, qword ptr [rbp + 16]\n");
+				for (unsigned int k = 1; k < operation->argument; ++k) {
+					_append(text, "\tmov rax, qword ptr [rax + 16]\n");
+				}
+				_append(text, "\tpush rax\n");
+			}
+			break;
+		case CALL_IR: {
+			const CallGraphNode * callee = &generator->callGraph->nodes[operation->argument];
+			unsigned int pushes = 1 < callee->level ? 1 : 0;
+			for (const Parameters * parameters = callee->function->parameters; parameters != NULL; parameters = parameters->next) {
+				++pushes;
+			}
+			_append(text, "\tcall f%u_%s\n", operation->argument, callee->function->functionName);
+			if (pushes != 0) {
+				_append(text, "\tadd rsp, %u\n", 8 * pushes);
+			}
+			_append(text, "\tmov %s, rax\n", _place(generator, operation->target, true, target));
+			break;
+		}
+		case RETURN_IR:
+			_append(text, "\tmov rax, %s\n", _place(generator, operation->left, true, left));
+			if (generator->function == generator->program) {
+				_append(text, "\tjmp rt_exit\n");
+			}
+			else if (!last) {
+				_append(text, "\tjmp .L%u\n", returnLabel);
+			}
+			break;
+		case PRINT_IR:
+			_append(text, "\tmov rax, %s\n\tcall %s\n", _place(generator, operation->left, true, left), _printers[operation->argument]);
+			break;
+		default:
+			break;
+	}
+}
+
+/**
+ * Lowers a string expression (or the pending work of a call). A literal is
+ * stored with its length, and its characters are escaped in octal unless
+ * they're printable (and not special inside a string of the assembler).
+ */
+static void _string(AssemblyGenerator * generator, const StringExpression * stringExpression) {
+	switch (stringExpression->type) {
+		case STRING_LITERAL_T: {
+			Text * data = &generator->data;
+			_append(data, ".LS%u:\n\t.quad %zu\n\t.ascii \"", generator->strings, strlen(stringExpression->value));
+			for (const unsigned char * character = (const unsigned char *) stringExpression->value; *character != '\0'; ++character) {
+				if (*character == '"' || *character == '\\' || !isprint(*character)) {
+					_append(data, "\\%03o", *character);
+				}
+				else {
+					_append(data, "%c", *character);
+				}
+			}
+			_append(data, "\"\n");
+			const Operand target = _register(generator);
+			Operation * operation = _emit(generator, STRING_IR);
+			operation->target = target;
+			operation->argument = generator->strings++;
+			_pushOperand(generator, target);
+			break;
+		}
+		case VAR_STRING_T:
+			_pushOperand(generator, _load(generator, stringExpression->slot));
+			break;
+		case FUNC_CALL_STRING_T:
+			_call(generator, stringExpression->functionCall);
+			break;
+		default:
+			_pushOperand(generator, (Operand) {IMMEDIATE_OPERAND, 0});
+			break;
+	}
+}
+
+/* PUBLIC FUNCTIONS */
+
+boolean generateAssembly(const CompilerState * compilerState, FILE * output) {
+	const Program * program = compilerState->abstractSyntaxtTree;
+	const CallGraph * callGraph = compilerState->callGraph;
+	AssemblyGenerator generator = {
+		.callGraph = callGraph,
+		.rangeAnalysis = compilerState->rangeAnalysis,
+		.program = callGraph->size,
+		.parents = calloc(callGraph->size + 1, sizeof(unsigned int)),
+		.demands = calloc(_initialCapacity, sizeof(DemandEntry)),
+		.demandCapacity = _initialCapacity,
+		.tasks = malloc(_initialCapacity * sizeof(Task)),
+		.taskCapacity = _initialCapacity,
+		.operands = malloc(_initialCapacity * sizeof(Operand)),
+		.operandCapacity = _initialCapacity,
+		.pending = malloc(_initialCapacity * sizeof(const ArithmeticExpression *)),
+		.pendingCapacity = _initialCapacity,
+		.succeed = true
+	};
+	for (unsigned int k = 0; k <= callGraph->size; ++k) {
+		generator.parents[k] = generator.program;
+	}
+	_scan(&generator, program->block, generator.program);
+	_append(&generator.text, "%s", _runtime);
+	for (unsigned int k = 0; k < callGraph->size; ++k) {
+		_function(&generator, k, callGraph->nodes[k].function->block, callGraph->nodes[k].function);
+	}
+	_function(&generator, generator.program, program->block, NULL);
+	_append(&generator.text, "\n\t.lcomm rt_globals, %u\n", 8 * (program->frameSize == 0 ? 1 : program->frameSize));
+	if (generator.data.size != 0) {
+		_append(&generator.text, "\n\t.section .rodata\n%s", generator.data.text);
+	}
+	if (generator.succeed) {
+		fwrite(generator.text.text, sizeof(char), generator.text.size, output);
+		fflush(output);
+		logDebugging(_logger, "Allocated %u virtual registers into %u machine registers, and spilled %u of them.",
+			generator.virtualRegisters, _machineRegisters, generator.spilledRegisters);
+	}
+	free(generator.text.text);
+	free(generator.data.text);
+	free(generator.failures.text);
+	free(generator.pending);
+	free(generator.operands);
+	free(generator.tasks);
+	free(generator.demands);
+	free(generator.locations);
+	free(generator.ends);
+	free(generator.starts);
+	free(generator.operations);
+	free(generator.parents);
+	return generator.succeed;
+}
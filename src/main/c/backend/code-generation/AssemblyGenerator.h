@@ -0,0 +1,61 @@
+#ifndef ASSEMBLY_GENERATOR_HEADER
+#define ASSEMBLY_GENERATOR_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/CompilerState.h"
+#include "../../shared/Hash.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "../semantic-analysis/CallGraph.h"
+#include "../semantic-analysis/RangeAnalysis.h"
+#include <ctype.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializeAssemblyGeneratorModule();
+
+/** Shutdown module's internal state. */
+void shutdownAssemblyGeneratorModule();
+
+/**
+ * A backend that translates a compiled program straight into x86-64 assembly
+ * for the GNU assembler (in Intel syntax), with the same output and errors as
+ * the interpreter (see "Calculator.h"), so it can be assembled and linked
+ * into a static Linux executable without a C compiler, nor a C library.
+ *
+ * Every function is lowered into a linear intermediate representation over
+ * an unbounded set of virtual registers, with labels and jumps. The operands
+ * of an arithmetic operation (or of a comparison) are evaluated in the order
+ * of Sethi-Ullman, the one that needs more registers first, as long as it
+ * doesn't change the behavior of the program (i.e., neither operand calls a
+ * function, and they can't both fail). Then, the virtual registers are
+ * allocated by a linear scan over their live intervals into eleven machine
+ * registers, and the rest are spilled into the frame.
+ *
+ * The generated functions preserve every register but "rax", "rcx" and "rdx"
+ * (which are scratch). Their arguments are pushed in order, followed by the
+ * frame of the enclosing function (the static link) if they're nested, and
+ * their result is returned in "rax". Every variable lives in the frame of its
+ * function (or in a global, in the program), as a quadword: the integers are
+ * sign-extended, the booleans are 0 or 1, and the strings are the address of
+ * their length followed by their characters (or 0, for the empty one).
+ *
+ * Only the arithmetic checks that the analysis of the value ranges couldn't
+ * remove (see "RangeAnalysis.h") are emitted. The output is buffered, and a
+ * recursion that exhausts the stack budget of the executable (i.e.,
+ * "STACK_BUDGET" bytes) stops it with an error.
+ */
+
+/**
+ * Generates the assembly of a program, given the analyses of the compiler
+ * state, and prints it in a stream. Returns false if it cannot be generated
+ * (i.e., a call cannot be resolved).
+ */
+boolean generateAssembly(const CompilerState * compilerState, FILE * output);
+
+#endif
@@ -1,174 +1,1184 @@
-// #include "Generator.h"
-
-// /* MODULE INTERNAL STATE */
-
-// const char _indentationCharacter = ' ';
-// const char _indentationSize = 4;
-// static Logger * _logger = NULL;
-
-// void initializeGeneratorModule() {
-// 	_logger = createLogger("Generator");
-// }
-
-// void shutdownGeneratorModule() {
-// 	if (_logger != NULL) {
-// 		destroyLogger(_logger);
-// 	}
-// }
-
-// /** PRIVATE FUNCTIONS */
-
-// static const char _expressionTypeToCharacter(const ExpressionType type);
-// static void _generateConstant(const unsigned int indentationLevel, Constant * constant);
-// static void _generateEpilogue(const int value);
-// static void _generateExpression(const unsigned int indentationLevel, Expression * expression);
-// static void _generateFactor(const unsigned int indentationLevel, Factor * factor);
-// static void _generateProgram(Program * program);
-// static void _generatePrologue(void);
-// static char * _indentation(const unsigned int indentationLevel);
-// static void _output(const unsigned int indentationLevel, const char * const format, ...);
-
-// /**
-//  * Converts and expression type to the proper character of the operation
-//  * involved, or returns '\0' if that's not possible.
-//  */
-// static const char _expressionTypeToCharacter(const ExpressionType type) {
-// 	switch (type) {
-// 		case ADDITION: return '+';
-// 		case DIVISION: return '/';
-// 		case MULTIPLICATION: return '*';
-// 		case SUBTRACTION: return '-';
-// 		default:
-// 			logError(_logger, "The specified expression type cannot be converted into character: %d", type);
-// 			return '\0';
-// 	}
-// }
-
-// /**
-//  * Generates the output of a constant.
-//  */
-// static void _generateConstant(const unsigned int indentationLevel, Constant * constant) {
-// 	_output(indentationLevel, "%s", "[ $C$, circle, draw, black!20\n");
-// 	_output(1 + indentationLevel, "%s%d%s", "[ $", constant->value, "$, circle, draw ]\n");
-// 	_output(indentationLevel, "%s", "]\n");
-// }
-
-// /**
-//  * Creates the epilogue of the generated output, that is, the final lines that
-//  * completes a valid Latex document.
-//  */
-// static void _generateEpilogue(const int value) {
-// 	_output(0, "%s%d%s",
-// 		"            [ $", value, "$, circle, draw, blue ]\n"
-// 		"        ]\n"
-// 		"    \\end{forest}\n"
-// 		"\\end{document}\n\n"
-// 	);
-// }
-
-// /**
-//  * Generates the output of an expression.
-//  */
-// static void _generateExpression(const unsigned int indentationLevel, Expression * expression) {
-// 	_output(indentationLevel, "%s", "[ $E$, circle, draw, black!20\n");
-// 	switch (expression->type) {
-// 		case ADDITION:
-// 		case DIVISION:
-// 		case MULTIPLICATION:
-// 		case SUBTRACTION:
-// 			_generateExpression(1 + indentationLevel, expression->leftExpression);
-// 			_output(1 + indentationLevel, "%s%c%s", "[ $", _expressionTypeToCharacter(expression->type), "$, circle, draw, purple ]\n");
-// 			_generateExpression(1 + indentationLevel, expression->rightExpression);
-// 			break;
-// 		case FACTOR:
-// 			_generateFactor(1 + indentationLevel, expression->factor);
-// 			break;
-// 		default:
-// 			logError(_logger, "The specified expression type is unknown: %d", expression->type);
-// 			break;
-// 	}
-// 	_output(indentationLevel, "%s", "]\n");
-// }
-
-// /**
-//  * Generates the output of a factor.
-//  */
-// static void _generateFactor(const unsigned int indentationLevel, Factor * factor) {
-// 	_output(indentationLevel, "%s", "[ $F$, circle, draw, black!20\n");
-// 	switch (factor->type) {
-// 		case CONSTANT:
-// 			_generateConstant(1 + indentationLevel, factor->constant);
-// 			break;
-// 		case EXPRESSION:
-// 			_output(1 + indentationLevel, "%s", "[ $($, circle, draw, purple ]\n");
-// 			_generateExpression(1 + indentationLevel, factor->expression);
-// 			_output(1 + indentationLevel, "%s", "[ $)$, circle, draw, purple ]\n");
-// 			break;
-// 		default:
-// 			logError(_logger, "The specified factor type is unknown: %d", factor->type);
-// 			break;
-// 	}
-// 	_output(indentationLevel, "%s", "]\n");
-// }
-
-// /**
-//  * Generates the output of the program.
-//  */
-// static void _generateProgram(Program * program) {
-// 	_generateExpression(3, program->expression);
-// }
-
-// /**
-//  * Creates the prologue of the generated output, a Latex document that renders
-//  * a tree thanks to the Forest package.
-//  *
-//  * @see https://ctan.dcc.uchile.cl/graphics/pgf/contrib/forest/forest-doc.pdf
-//  */
-// static void _generatePrologue(void) {
-// 	_output(0, "%s",
-// 		"\\documentclass{standalone}\n\n"
-// 		"\\usepackage[utf8]{inputenc}\n"
-// 		"\\usepackage[T1]{fontenc}\n"
-// 		"\\usepackage{amsmath}\n"
-// 		"\\usepackage{forest}\n"
-// 		"\\usepackage{microtype}\n\n"
-// 		"\\begin{document}\n"
-// 		"    \\centering\n"
-// 		"    \\begin{forest}\n"
-// 		"        [ \\text{$=$}, circle, draw, purple\n"
-// 	);
-// }
-
-// /**
-//  * Generates an indentation string for the specified level.
-//  */
-// static char * _indentation(const unsigned int level) {
-// 	return indentation(_indentationCharacter, level, _indentationSize);
-// }
-
-// /**
-//  * Outputs a formatted string to standard output. The "fflush" instruction
-//  * allows to see the output even close to a failure, because it drops the
-//  * buffering.
-//  */
-// static void _output(const unsigned int indentationLevel, const char * const format, ...) {
-// 	va_list arguments;
-// 	va_start(arguments, format);
-// 	char * indentation = _indentation(indentationLevel);
-// 	char * effectiveFormat = concatenate(2, indentation, format);
-// 	vfprintf(stdout, effectiveFormat, arguments);
-// 	fflush(stdout);
-// 	free(effectiveFormat);
-// 	free(indentation);
-// 	va_end(arguments);
-// }
-
-// /** PUBLIC FUNCTIONS */
-
-// void generate(CompilerState * compilerState) {
-// 	logDebugging(_logger, "Generating final output...");
-// 	_generatePrologue();
-// 	_generateProgram(compilerState->abstractSyntaxtTree);
-// 	_generateEpilogue(compilerState->value);
-// 	logDebugging(_logger, "Generation is done.");
-// }
+#include "Generator.h"
+
+/**
+ * A text in heap-memory, that grows as it's appended.
+ */
+typedef struct {
+	char * text;
+	size_t size;
+	size_t capacity;
+} Text;
+
+/**
+ * The kinds of pending work of the generation of an expression. A step of a
+ * chain appends an operation of a long chain of operations (see
+ * "_chainLimit"), whose left operand is the temporary of the chain, and
+ * "OPERATE" applies an operator to the temporaries of its operands.
+ */
+typedef enum {
+	APPEND,
+	ARITHMETIC,
+	ARITHMETIC_STEP,
+	ASSIGN_ARGUMENTS,
+	BOOLEAN,
+	BOOLEAN_STEP,
+	CALL,
+	CALLEE,
+	EXPRESSION,
+	OPERATE,
+	PASS_ARGUMENTS
+} TaskKind;
+
+/**
+ * The texts of an operation: before, between and after its operands (the
+ * latter receives the line).
+ */
+typedef struct {
+	const char * before;
+	const char * between;
+	const char * after;
+} Operator;
+
+/**
+ * A pending work over a node (or over the rest of a list of arguments), or a
+ * text to append (a format, that receives the number). The number is also
+ * the temporary of a chain or of an operation, or of the next argument.
+ */
+typedef struct {
+	const void * node;
+	const char * text;
+	const Operator * operator;
+	unsigned int number;
+	uint8_t kind;
+} Task;
+
+/**
+ * Whether an operation (arithmetic, or boolean) calls a function. An empty
+ * entry has a NULL expression.
+ */
+typedef struct {
+	const void * expression;
+	boolean calls;
+} CallEntry;
+
+/**
+ * The state of the generation. The functions are indexed as the nodes of the
+ * call graph, and the program goes last. Every function knows the one that
+ * encloses it, whether it encloses others (i.e., whether its variables live
+ * in a frame), the types used by every variable of its frame (a bitmask,
+ * that also marks the parameters), the declarations of its temporaries, and
+ * its body. The state of the function being generated is the current one.
+ *
+ * The expressions are generated with an explicit stack of pending work in
+ * heap-memory, so deeply nested expressions can't overflow the C stack.
+ * Whether an operation calls a function is memoized (in an open-addressing
+ * hash table indexed by address), because the expressions are shared.
+ */
+typedef struct {
+	const CallGraph * callGraph;
+	const RangeAnalysis * rangeAnalysis;
+	unsigned int program;
+	unsigned int * parents;
+	boolean * frames;
+	unsigned int * frameSizes;
+	uint8_t ** variables;
+	Text * declarations;
+	Text * bodies;
+	unsigned int function;
+	Text * body;
+	unsigned int temporaries;
+	unsigned int loops;
+	unsigned int indentation;
+	unsigned int line;
+	Task * tasks;
+	unsigned int taskSize;
+	unsigned int taskCapacity;
+	CallEntry * calls;
+	unsigned int callSize;
+	unsigned int callCapacity;
+	const void ** pending;
+	unsigned int pendingSize;
+	unsigned int pendingCapacity;
+	boolean succeed;
+} Generator;
+
+/* MODULE INTERNAL STATE */
+
+// The initial capacity of every text, stack and table (must be a power of 2).
+static const size_t _initialCapacity = 256;
+
+// The longest chain of operations (through their left operands, as in
+// "1 + 2 + 3") that's generated as nested C expressions. A longer one is
+// evaluated in sequence into a temporary, because a C compiler parses nested
+// expressions recursively.
+static const unsigned int _chainLimit = 64;
+
+// The mark of a parameter, in the bitmask of a variable (after the types).
+static const uint8_t _parameterMark = 1 << 3;
+
+// The prefix of the name of a variable of each type, its C type, and its
+// default value.
+static const char _prefixes[] = {[INT_T] = 'i', [BOOL_T] = 'b', [STRING_T] = 's'};
+static const char * const _types[] = {[INT_T] = "int", [BOOL_T] = "int", [STRING_T] = "const char *"};
+static const char * const _defaults[] = {[INT_T] = "0", [BOOL_T] = "0", [STRING_T] = "\"\""};
+
+// The texts of each arithmetic operation (checked through the runtime, or
+// unchecked), and of each comparison.
+static const Operator _checked[] = {
+	[ADD_T] = {"rt_add(", ", ", ", %u)"},
+	[SUB_T] = {"rt_sub(", ", ", ", %u)"},
+	[MUL_T] = {"rt_mul(", ", ", ", %u)"},
+	[DIV_T] = {"rt_div(", ", ", ", %u)"}
+};
+static const Operator _unchecked[] = {
+	[ADD_T] = {"(", " + ", ")"},
+	[SUB_T] = {"(", " - ", ")"},
+	[MUL_T] = {"(", " * ", ")"},
+	[DIV_T] = {"(", " / ", ")"}
+};
+static const Operator _comparisons[] = {
+	[GREATER_THAN_T] = {"(", " > ", ")"},
+	[LESS_THAN_T] = {"(", " < ", ")"},
+	[EQUALS_EQUALS_T] = {"(", " == ", ")"},
+	[NOT_EQUALS_T] = {"(", " != ", ")"},
+	[GREATER_EQUALS_T] = {"(", " >= ", ")"},
+	[LESS_EQUALS_T] = {"(", " <= ", ")"}
+};
+
+// The type of the value of each kind of expression, and the function of the
+// runtime that prints it.
+static const enum DataType _expressionTypes[] = {[ARITHMETIC_EXPR_T] = INT_T, [BOOLEAN_EXPR_T] = BOOL_T, [STRING_EXPR_T] = STRING_T};
+static const char * const _printers[] = {[ARITHMETIC_EXPR_T] = "rt_printInt", [BOOLEAN_EXPR_T] = "rt_printBool", [STRING_EXPR_T] = "rt_printString"};
+
+// The runtime of every generated program: the checks of the arithmetic
+// operations, the check of the stack (whose budget can be redefined), and
+// the output. An error stops the program, as in the interpreter.
+static const char * const _runtime =
+	"#include <limits.h>\n"
+	"#include <stdint.h>\n"
+	"#include <stdio.h>\n"
+	"#include <stdlib.h>\n"
+	"\n"
+	"#ifndef STACK_BUDGET\n"
+	"#define STACK_BUDGET (6 * 1024 * 1024)\n"
+	"#endif\n"
+	"\n"
+	"static uintptr_t rt_stackLimit = 0;\n"
+	"\n"
+	"static void rt_fail(const char * error, const unsigned int line) {\n"
+	"\tfflush(stdout);\n"
+	"\tfprintf(stderr, \"%s (on line %u).\\n\", error, line);\n"
+	"\texit(EXIT_FAILURE);\n"
+	"}\n"
+	"\n"
+	"static int rt_checked(const long long value, const unsigned int line) {\n"
+	"\tif (value < INT_MIN || INT_MAX < value) {\n"
+	"\t\trt_fail(\"Integer overflow\", line);\n"
+	"\t}\n"
+	"\treturn (int) value;\n"
+	"}\n"
+	"\n"
+	"static int rt_add(const int left, const int right, const unsigned int line) {\n"
+	"\treturn rt_checked((long long) left + right, line);\n"
+	"}\n"
+	"\n"
+	"static int rt_sub(const int left, const int right, const unsigned int line) {\n"
+	"\treturn rt_checked((long long) left - right, line);\n"
+	"}\n"
+	"\n"
+	"static int rt_mul(const int left, const int right, const unsigned int line) {\n"
+	"\treturn rt_checked((long long) left * right, line);\n"
+	"}\n"
+	"\n"
+	"static int rt_div(const int left, const int right, const unsigned int line) {\n"
+	"\tif (right == 0) {\n"
+	"\t\trt_fail(\"Division by zero\", line);\n"
+	"\t}\n"
+	"\treturn rt_checked((long long) left / right, line);\n"
+	"}\n"
+	"\n"
+	"static void rt_enter(const unsigned int line) {\n"
+	"\tchar probe;\n"
+	"\tif ((uintptr_t) &probe < rt_stackLimit) {\n"
+	"\t\trt_fail(\"Too many nested calls\", line);\n"
+	"\t}\n"
+	"}\n"
+	"\n"
+	"static void rt_printInt(const int value) {\n"
+	"\tprintf(\"%d\\n\", value);\n"
+	"}\n"
+	"\n"
+	"static void rt_printBool(const int value) {\n"
+	"\tputs(value ? \"TRUE\" : \"FALSE\");\n"
+	"}\n"
+	"\n"
+	"static void rt_printString(const char * value) {\n"
+	"\tputs(value == NULL ? \"\" : value);\n"
+	"}\n"
+	"\n";
+
+static Logger * _logger = NULL;
+
+void initializeGeneratorModule() {
+	_logger = createLogger("Generator");
+}
+
+void shutdownGeneratorModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+static void _access(Generator * generator, const Slot slot, const enum DataType type);
+static void _append(Text * text, const char * const format, ...);
+static void _arithmetic(Generator * generator, const ArithmeticExpression * arithmeticExpression);
+static boolean _arithmeticCalls(Generator * generator, const ArithmeticExpression * arithmeticExpression);
+static void _block(Generator * generator, const Block * block);
+static void _boolean(Generator * generator, const BooleanExpression * booleanExpression);
+static boolean _booleanCalls(Generator * generator, const BooleanExpression * booleanExpression);
+static void _call(Generator * generator, const FunctionCall * functionCall);
+static void _callee(Generator * generator, const FunctionCall * functionCall, const CallGraphNode * callee, const unsigned int count);
+static CallEntry * _callEntryOf(const Generator * generator, const void * expression);
+static void _expression(Generator * generator, const Expression * expression);
+static boolean _expressionCalls(Generator * generator, const Expression * expression);
+static void _function(Generator * generator, const unsigned int index, const Block * block, const Function * function);
+static void _generate(Generator * generator, const TaskKind kind, const void * node);
+static void _indent(Generator * generator);
+static void _instruction(Generator * generator, const Instruction * instruction);
+static unsigned int _levelOf(const Generator * generator, const unsigned int index);
+static void _link(Generator * generator, const unsigned int distance);
+static void _literal(Text * text, const char * string);
+static void _memoizeCall(Generator * generator, const void * expression, const boolean calls);
+static void _operation(Generator * generator, const Operator * operator, const ArithmeticExpression * left, const ArithmeticExpression * right);
+static const Operator * _operatorOf(const Generator * generator, const ArithmeticExpression * operation);
+static void _pushPending(Generator * generator, const void * expression);
+static Task * _pushTask(Generator * generator, const TaskKind kind, const void * node, const unsigned int number);
+static void _scan(Generator * generator, const Block * block, const unsigned int index);
+static void _signature(const Generator * generator, Text * text, const unsigned int index);
+static void _string(Generator * generator, const StringExpression * stringExpression);
+static unsigned int _temporary(Generator * generator, const enum DataType type);
+
+/**
+ * Appends a variable of a type, in the frame of the current function or of
+ * one that encloses it: a global (in the program), a local or a member of
+ * the own frame, or a member of the frame reached through the links.
+ */
+static void _access(Generator * generator, const Slot slot, const enum DataType type) {
+	unsigned int frame = generator->function;
+	for (unsigned int k = 0; k < slot.depth; ++k) {
+		frame = generator->parents[frame];
+	}
+	generator->variables[frame][slot.index] |= 1 << type;
+	if (frame == generator->program) {
+		_append(generator->body, "g%c%u", _prefixes[type], slot.index);
+	}
+	else if (slot.depth == 0) {
+		_append(generator->body, generator->frames[frame] ? "frame.%c%u" : "%c%u", _prefixes[type], slot.index);
+	}
+	else {
+		_link(generator, slot.depth);
+		_append(generator->body, "->%c%u", _prefixes[type], slot.index);
+	}
+}
+
+/**
+ * Appends a formatted string to a text, doubling its capacity as needed.
+ */
+static void _append(Text * text, const char * const format, ...) {
+	va_list arguments;
+	va_list copy;
+	va_start(arguments, format);
+	va_copy(copy, arguments);
+	const size_t length = vsnprintf(NULL, 0, format, arguments);
+	va_end(arguments);
+	while (text->capacity < text->size + length + 1) {
+		text->capacity = text->capacity == 0 ? _initialCapacity : 2 * text->capacity;
+		text->text = realloc(text->text, text->capacity);
+	}
+	vsnprintf(text->text + text->size, length + 1, format, copy);
+	va_end(copy);
+	text->size += length;
+}
+
+/**
+ * Appends an arithmetic expression (i.e., the pending work of an operation).
+ * A long chain of operations (see "_chainLimit") is evaluated in sequence
+ * into a temporary, as in "(t0 = 1, t0 = t0 + 2, t0 = t0 + 3, t0)".
+ */
+static void _arithmetic(Generator * generator, const ArithmeticExpression * arithmeticExpression) {
+	switch (arithmeticExpression->type) {
+		case INT_LITERAL_T:
+			if (arithmeticExpression->value == INT_MIN) {
+				_append(generator->body, "(%d - 1)", INT_MIN + 1);
+			}
+			else {
+				_append(generator->body, arithmeticExpression->value < 0 ? "(%d)" : "%d", arithmeticExpression->value);
+			}
+			break;
+		case VAR_ARITH_T:
+			_access(generator, arithmeticExpression->slot, INT_T);
+			break;
+		case FUNC_CALL_ARITH_T:
+			_call(generator, arithmeticExpression->functionCall);
+			break;
+		default: {
+			unsigned int length = 0;
+			const ArithmeticExpression * first = arithmeticExpression;
+			while (first->type <= DIV_T && length <= _chainLimit) {
+				first = first->left;
+				++length;
+			}
+			if (length <= _chainLimit) {
+				_operation(generator, _operatorOf(generator, arithmeticExpression), arithmeticExpression->left, arithmeticExpression->right);
+				break;
+			}
+			const unsigned int temporary = _temporary(generator, INT_T);
+			_append(generator->body, "(t%u = ", temporary);
+			_pushTask(generator, APPEND, NULL, temporary)->text = ", t%u)";
+			for (first = arithmeticExpression; first->type <= DIV_T; first = first->left) {
+				_pushTask(generator, ARITHMETIC_STEP, first, temporary)->operator = _operatorOf(generator, first);
+			}
+			_pushTask(generator, ARITHMETIC, first, 0);
+			break;
+		}
+	}
+}
+
+/**
+ * Whether an arithmetic expression calls any function. The operations are
+ * walked in post-order, on the stack of pending operations (above its
+ * current top), and each one is memoized, so a shared subexpression is only
+ * walked once.
+ */
+static boolean _arithmeticCalls(Generator * generator, const ArithmeticExpression * arithmeticExpression) {
+	switch (arithmeticExpression->type) {
+		case INT_LITERAL_T:
+		case VAR_ARITH_T:
+			return false;
+		case FUNC_CALL_ARITH_T:
+			return true;
+		default:
+			break;
+	}
+	const unsigned int base = generator->pendingSize;
+	_pushPending(generator, arithmeticExpression);
+	while (base < generator->pendingSize) {
+		const ArithmeticExpression * operation = generator->pending[generator->pendingSize - 1];
+		if (_callEntryOf(generator, operation)->expression != NULL) {
+			--generator->pendingSize;
+			continue;
+		}
+		const ArithmeticExpression * children[] = {operation->left, operation->right};
+		boolean calls = false;
+		boolean known = true;
+		for (unsigned int k = 0; k < 2; ++k) {
+			switch (children[k]->type) {
+				case INT_LITERAL_T:
+				case VAR_ARITH_T:
+					break;
+				case FUNC_CALL_ARITH_T:
+					calls = true;
+					break;
+				default: {
+					const CallEntry * entry = _callEntryOf(generator, children[k]);
+					if (entry->expression != NULL) {
+						calls = calls || entry->calls;
+					}
+					else {
+						_pushPending(generator, children[k]);
+						known = false;
+					}
+					break;
+				}
+			}
+		}
+		if (known) {
+			_memoizeCall(generator, operation, calls);
+			--generator->pendingSize;
+		}
+	}
+	return _callEntryOf(generator, arithmeticExpression)->calls;
+}
+
+/**
+ * Appends the instructions of a block (except the functions).
+ */
+static void _block(Generator * generator, const Block * block) {
+	for (const Instruction * instruction = block->instructions; instruction != NULL; instruction = instruction->next) {
+		_instruction(generator, instruction);
+	}
+}
+
+/**
+ * Appends a boolean expression (i.e., the pending work of an operation).
+ * "AND" and "OR" short-circuit, as in C, and a long chain of them (see
+ * "_chainLimit") is evaluated in sequence into a temporary, as in
+ * "(t0 = b0, t0 = t0 && b1, t0 = t0 || b2, t0)".
+ */
+static void _boolean(Generator * generator, const BooleanExpression * booleanExpression) {
+	switch (booleanExpression->type) {
+		case AND_T:
+		case OR_T: {
+			unsigned int length = 0;
+			const BooleanExpression * first = booleanExpression;
+			while (first->type <= OR_T && length <= _chainLimit) {
+				first = first->left;
+				++length;
+			}
+			if (length <= _chainLimit) {
+				_append(generator->body, "(");
+				_pushTask(generator, APPEND, NULL, 0)->text = ")";
+				_pushTask(generator, BOOLEAN, booleanExpression->right, 0);
+				_pushTask(generator, APPEND, NULL, 0)->text = booleanExpression->type == AND_T ? " && " : " || ";
+				_pushTask(generator, BOOLEAN, booleanExpression->left, 0);
+				break;
+			}
+			const unsigned int temporary = _temporary(generator, BOOL_T);
+			_append(generator->body, "(t%u = ", temporary);
+			_pushTask(generator, APPEND, NULL, temporary)->text = ", t%u)";
+			for (first = booleanExpression; first->type <= OR_T; first = first->left) {
+				_pushTask(generator, BOOLEAN_STEP, first, temporary);
+			}
+			_pushTask(generator, BOOLEAN, first, 0);
+			break;
+		}
+		case NOT_T:
+			_append(generator->body, "!");
+			_pushTask(generator, BOOLEAN, booleanExpression->notExpr, 0);
+			break;
+		case COMPARISON_T:
+			_operation(generator, &_comparisons[booleanExpression->op->type], booleanExpression->leftArith, booleanExpression->rightArith);
+			break;
+		case VAR_BOOL_T:
+			_access(generator, booleanExpression->slot, BOOL_T);
+			break;
+		case BOOL_LITERAL_T:
+			_append(generator->body, booleanExpression->value ? "1" : "0");
+			break;
+		case FUNC_CALL_BOOL_T:
+			_call(generator, booleanExpression->functionCall);
+			break;
+		default:
+			break;
+	}
+}
+
+/**
+ * Whether a boolean expression calls any function. The operations are
+ * walked as in "_arithmeticCalls", and the comparisons through it.
+ */
+static boolean _booleanCalls(Generator * generator, const BooleanExpression * booleanExpression) {
+	switch (booleanExpression->type) {
+		case AND_T:
+		case OR_T:
+		case NOT_T:
+			break;
+		case COMPARISON_T:
+			return _arithmeticCalls(generator, booleanExpression->leftArith) || _arithmeticCalls(generator, booleanExpression->rightArith);
+		case FUNC_CALL_BOOL_T:
+			return true;
+		default:
+			return false;
+	}
+	const unsigned int base = generator->pendingSize;
+	_pushPending(generator, booleanExpression);
+	while (base < generator->pendingSize) {
+		const BooleanExpression * operation = generator->pending[generator->pendingSize - 1];
+		if (_callEntryOf(generator, operation)->expression != NULL) {
+			--generator->pendingSize;
+			continue;
+		}
+		const boolean negation = operation->type == NOT_T;
+		const BooleanExpression * children[] = {negation ? operation->notExpr : operation->left, negation ? NULL : operation->right};
+		boolean calls = false;
+		boolean known = true;
+		for (unsigned int k = 0; k < 2 && children[k] != NULL; ++k) {
+			switch (children[k]->type) {
+				case AND_T:
+				case OR_T:
+				case NOT_T: {
+					const CallEntry * entry = _callEntryOf(generator, children[k]);
+					if (entry->expression != NULL) {
+						calls = calls || entry->calls;
+					}
+					else {
+						_pushPending(generator, children[k]);
+						known = false;
+					}
+					break;
+				}
+				case COMPARISON_T:
+					calls = calls || _arithmeticCalls(generator, children[k]->leftArith) || _arithmeticCalls(generator, children[k]->rightArith);
+					break;
+				case FUNC_CALL_BOOL_T:
+					calls = true;
+					break;
+				default:
+					break;
+			}
+		}
+		if (known) {
+			_memoizeCall(generator, operation, calls);
+			--generator->pendingSize;
+		}
+	}
+	return _callEntryOf(generator, booleanExpression)->calls;
+}
+
+/**
+ * Appends a call (i.e., its pending work). A nested function receives the
+ * frame of the function that encloses it, and a recursive one checks the
+ * stack first. If an argument calls a function, every argument is evaluated
+ * first into a temporary, in order.
+ */
+static void _call(Generator * generator, const FunctionCall * functionCall) {
+	const CallGraphNode * callee = calleeOf(generator->callGraph, functionCall);
+	if (callee == NULL) {
+		logError(_logger, "The function \"%s\" cannot be resolved (on line %u).", functionCall->functionName, generator->line);
+		generator->succeed = false;
+		_append(generator->body, "0");
+		return;
+	}
+	unsigned int count = 0;
+	boolean calls = false;
+	for (const Arguments * arguments = functionCall->arguments; arguments != NULL; arguments = arguments->next) {
+		calls = calls || _expressionCalls(generator, arguments->argument->expression);
+		++count;
+	}
+	const boolean sequenced = 1 < count && calls;
+	if (callee->recursive || sequenced) {
+		_append(generator->body, "(");
+		_pushTask(generator, APPEND, NULL, 0)->text = ")";
+	}
+	if (callee->recursive) {
+		_append(generator->body, "rt_enter(%u), ", generator->line);
+	}
+	if (sequenced) {
+		const unsigned int first = generator->temporaries;
+		for (const Arguments * arguments = functionCall->arguments; arguments != NULL; arguments = arguments->next) {
+			_temporary(generator, _expressionTypes[arguments->argument->expression->type]);
+		}
+		_pushTask(generator, CALLEE, functionCall, first);
+		_pushTask(generator, ASSIGN_ARGUMENTS, functionCall->arguments, first);
+	}
+	else {
+		_callee(generator, functionCall, callee, count);
+		_pushTask(generator, APPEND, NULL, 0)->text = ")";
+		if (functionCall->arguments != NULL) {
+			_pushTask(generator, PASS_ARGUMENTS, functionCall->arguments, 0);
+		}
+	}
+}
+
+/**
+ * Appends the callee of a call, up to its first argument: its name, and the
+ * frame of the function that encloses it (if it's nested).
+ */
+static void _callee(Generator * generator, const FunctionCall * functionCall, const CallGraphNode * callee, const unsigned int count) {
+	_append(generator->body, "f%u_%s(", (unsigned int) (callee - generator->callGraph->nodes), functionCall->functionName);
+	if (1 < callee->level) {
+		_link(generator, _levelOf(generator, generator->function) + 1 - callee->level);
+		_append(generator->body, count == 0 ? "" : ", ");
+	}
+}
+
+/**
+ * The entry of an operation in the table of calls, or the empty entry where
+ * it belongs.
+ */
+static CallEntry * _callEntryOf(const Generator * generator, const void * expression) {
+	const unsigned int mask = generator->callCapacity - 1;
+	unsigned int k = hashAddress(expression) & mask;
+	while (generator->calls[k].expression != NULL && generator->calls[k].expression != expression) {
+		k = (k + 1) & mask;
+	}
+	return &generator->calls[k];
+}
+
+/**
+ * Appends an expression of any type (i.e., its pending work).
+ */
+static void _expression(Generator * generator, const Expression * expression) {
+	switch (expression->type) {
+		case ARITHMETIC_EXPR_T:
+			_arithmetic(generator, expression->arithmeticExpression);
+			break;
+		case BOOLEAN_EXPR_T:
+			_boolean(generator, expression->booleanExpression);
+			break;
+		case STRING_EXPR_T:
+			_string(generator, expression->stringExpression);
+			break;
+		default:
+			break;
+	}
+}
+
+/**
+ * Whether an expression of any type calls any function.
+ */
+static boolean _expressionCalls(Generator * generator, const Expression * expression) {
+	switch (expression->type) {
+		case ARITHMETIC_EXPR_T:
+			return _arithmeticCalls(generator, expression->arithmeticExpression);
+		case BOOLEAN_EXPR_T:
+			return _booleanCalls(generator, expression->booleanExpression);
+		default:
+			return expression->stringExpression->type == FUNC_CALL_STRING_T;
+	}
+}
+
+/**
+ * Generates the body of a function (or of the program, if the function is
+ * NULL). A function returns the default value of its type, unless its body
+ * ends with a return.
+ */
+static void _function(Generator * generator, const unsigned int index, const Block * block, const Function * function) {
+	generator->function = index;
+	generator->body = &generator->bodies[index];
+	generator->temporaries = 0;
+	generator->loops = 0;
+	generator->indentation = 1;
+	if (function != NULL) {
+		for (const Parameters * parameters = function->parameters; parameters != NULL; parameters = parameters->next) {
+			const Parameter * parameter = parameters->parameter;
+			generator->variables[index][parameter->slot.index] |= (1 << parameter->type->type) | _parameterMark;
+		}
+	}
+	_block(generator, block);
+	const Instruction * last = block->instructions;
+	while (last != NULL && last->next != NULL) {
+		last = last->next;
+	}
+	if (function != NULL && (last == NULL || last->type != RETURN_STATEMENT_INSTRUCTION_T)) {
+		_append(generator->body, "\treturn %s;\n", _defaults[function->returnType->type]);
+	}
+}
+
+/**
+ * Appends an expression (or a call), given the kind of its pending work, and
+ * runs the pending work until it's done.
+ */
+static void _generate(Generator * generator, const TaskKind kind, const void * node) {
+	_pushTask(generator, kind, node, 0);
+	while (0 < generator->taskSize) {
+		const Task task = generator->tasks[--generator->taskSize];
+		switch (task.kind) {
+			case APPEND:
+				_append(generator->body, task.text, task.number);
+				break;
+			case ARITHMETIC:
+				_arithmetic(generator, task.node);
+				break;
+			case ARITHMETIC_STEP: {
+				const ArithmeticExpression * operation = task.node;
+				_append(generator->body, ", t%u = %st%u%s", task.number, task.operator->before, task.number, task.operator->between);
+				_pushTask(generator, APPEND, NULL, generator->line)->text = task.operator->after;
+				_pushTask(generator, ARITHMETIC, operation->right, 0);
+				break;
+			}
+			case ASSIGN_ARGUMENTS: {
+				const Arguments * arguments = task.node;
+				if (arguments->next != NULL) {
+					_pushTask(generator, ASSIGN_ARGUMENTS, arguments->next, task.number + 1);
+				}
+				_pushTask(generator, APPEND, NULL, 0)->text = ", ";
+				_pushTask(generator, EXPRESSION, arguments->argument->expression, 0);
+				_append(generator->body, "t%u = ", task.number);
+				break;
+			}
+			case BOOLEAN:
+				_boolean(generator, task.node);
+				break;
+			case BOOLEAN_STEP: {
+				const BooleanExpression * operation = task.node;
+				_append(generator->body, ", t%u = t%u%s", task.number, task.number, operation->type == AND_T ? " && " : " || ");
+				_pushTask(generator, BOOLEAN, operation->right, 0);
+				break;
+			}
+			case CALL:
+				_call(generator, task.node);
+				break;
+			case CALLEE: {
+				const FunctionCall * functionCall = task.node;
+				unsigned int count = 0;
+				for (const Arguments * arguments = functionCall->arguments; arguments != NULL; arguments = arguments->next) {
+					++count;
+				}
+				_callee(generator, functionCall, calleeOf(generator->callGraph, functionCall), count);
+				for (unsigned int k = 0; k < count; ++k) {
+					_append(generator->body, k + 1 < count ? "t%u, " : "t%u", task.number + k);
+				}
+				_append(generator->body, ")");
+				break;
+			}
+			case EXPRESSION:
+				_expression(generator, task.node);
+				break;
+			case OPERATE:
+				_append(generator->body, ", %st%u%st%u", task.operator->before, task.number, task.operator->between, task.number + 1);
+				_append(generator->body, task.operator->after, generator->line);
+				_append(generator->body, ")");
+				break;
+			case PASS_ARGUMENTS: {
+				const Arguments * arguments = task.node;
+				if (arguments->next != NULL) {
+					_pushTask(generator, PASS_ARGUMENTS, arguments->next, 0);
+					_pushTask(generator, APPEND, NULL, 0)->text = ", ";
+				}
+				_pushTask(generator, EXPRESSION, arguments->argument->expression, 0);
+				break;
+			}
+			default:
+				break;
+		}
+	}
+}
+
+/**
+ * Appends the indentation of the current instruction.
+ */
+static void _indent(Generator * generator) {
+	for (unsigned int k = 0; k < generator->indentation; ++k) {
+		_append(generator->body, "\t");
+	}
+}
+
+/**
+ * Appends an instruction. A "FOR" becomes a counted loop over a hidden
+ * counter (wide enough to never overflow), from which the variable of the
+ * loop is set on every iteration, so the bounds are evaluated only once.
+ */
+static void _instruction(Generator * generator, const Instruction * instruction) {
+	const Assignation * assignation = NULL;
+	generator->line = instruction->line;
+	switch (instruction->type) {
+		case DECLARATION_INSTRUCTION_T:
+			assignation = instruction->declaration->assignation;
+			break;
+		case ASSIGNATION_INSTRUCTION_T:
+			assignation = instruction->assignation;
+			break;
+		case EXPRESSION_INSTRUCTION_T:
+			_indent(generator);
+			_append(generator->body, "(void) ");
+			_generate(generator, EXPRESSION, instruction->expression);
+			_append(generator->body, ";\n");
+			break;
+		case PRINT_INSTRUCTION_T:
+			_indent(generator);
+			_append(generator->body, "%s(", _printers[instruction->print->expression->type]);
+			_generate(generator, EXPRESSION, instruction->print->expression);
+			_append(generator->body, ");\n");
+			break;
+		case FUNCTION_CALL_INSTRUCTION_T:
+			_indent(generator);
+			_append(generator->body, "(void) ");
+			_generate(generator, CALL, instruction->functionCall);
+			_append(generator->body, ";\n");
+			break;
+		case RETURN_STATEMENT_INSTRUCTION_T:
+			_indent(generator);
+			if (generator->function == generator->program) {
+				_append(generator->body, "(void) ");
+				_generate(generator, EXPRESSION, instruction->returnStatement->expression);
+				_append(generator->body, ";\n");
+				_indent(generator);
+				_append(generator->body, "return EXIT_SUCCESS;\n");
+			}
+			else {
+				_append(generator->body, "return ");
+				_generate(generator, EXPRESSION, instruction->returnStatement->expression);
+				_append(generator->body, ";\n");
+			}
+			break;
+		case CONDITIONAL_INSTRUCTION_T:
+			_indent(generator);
+			_append(generator->body, "if (");
+			_generate(generator, BOOLEAN, instruction->conditional->condition);
+			_append(generator->body, ") {\n");
+			++generator->indentation;
+			_block(generator, instruction->conditional->ifBlock);
+			--generator->indentation;
+			_indent(generator);
+			_append(generator->body, "}\n");
+			if (instruction->conditional->elseBlock != NULL) {
+				_indent(generator);
+				_append(generator->body, "else {\n");
+				++generator->indentation;
+				_block(generator, instruction->conditional->elseBlock);
+				--generator->indentation;
+				_indent(generator);
+				_append(generator->body, "}\n");
+			}
+			break;
+		case LOOP_INSTRUCTION_T: {
+			const Loop * loop = instruction->loop;
+			const unsigned int depth = generator->loops++;
+			_indent(generator);
+			_append(generator->body, "for (long long c%u = ", depth);
+			_generate(generator, ARITHMETIC, loop->start);
+			_append(generator->body, ", l%u = ", depth);
+			_generate(generator, ARITHMETIC, loop->end);
+			_append(generator->body, "; c%u <= l%u; ++c%u) {\n", depth, depth, depth);
+			++generator->indentation;
+			_indent(generator);
+			_access(generator, loop->slot, INT_T);
+			_append(generator->body, " = (int) c%u;\n", depth);
+			_block(generator, loop->block);
+			--generator->indentation;
+			_indent(generator);
+			_append(generator->body, "}\n");
+			--generator->loops;
+			break;
+		}
+		default:
+			break;
+	}
+	if (assignation != NULL) {
+		_indent(generator);
+		_access(generator, assignation->slot, _expressionTypes[assignation->expression->type]);
+		_append(generator->body, " = ");
+		_generate(generator, EXPRESSION, assignation->expression);
+		_append(generator->body, ";\n");
+	}
+}
+
+/**
+ * The level of a function (see "CallGraph.h"), or 0 for the program.
+ */
+static unsigned int _levelOf(const Generator * generator, const unsigned int index) {
+	return index == generator->program ? 0 : generator->callGraph->nodes[index].level;
+}
+
+/**
+ * Appends the frame of a function that encloses the current one, at a
+ * distance (i.e., 0 is the own frame, and 1 is the one of the enclosing
+ * function).
+ */
+static void _link(Generator * generator, const unsigned int distance) {
+	if (distance == 0) {
+		_append(generator->body, "&frame");
+		return;
+	}
+	_append(generator->body, "link");
+	for (unsigned int k = 1; k < distance; ++k) {
+		_append(generator->body, "->link");
+	}
+}
+
+/**
+ * Appends a string as a C literal, with octal escapes for every character
+ * that isn't printable (or that's special inside a literal).
+ */
+static void _literal(Text * text, const char * string) {
+	_append(text, "\"");
+	for (const unsigned char * character = (const unsigned char *) string; *character != '\0'; ++character) {
+		if (*character == '"' || *character == '\\' || *character == '?' || !isprint(*character)) {
+			_append(text, "\\%03o", *character);
+		}
+		else {
+			_append(text, "%c", *character);
+		}
+	}
+	_append(text, "\"");
+}
+
+/**
+ * Memoizes whether an operation calls a function, doubling the capacity of
+ * the table if it's half full.
+ */
+static void _memoizeCall(Generator * generator, const void * expression, const boolean calls) {
+	if (generator->callCapacity <= 2 * (generator->callSize + 1)) {
+		CallEntry * entries = generator->calls;
+		const unsigned int capacity = generator->callCapacity;
+		generator->callCapacity *= 2;
+		generator->calls = calloc(generator->callCapacity, sizeof(CallEntry));
+		for (unsigned int k = 0; k < capacity; ++k) {
+			if (entries[k].expression != NULL) {
+				*_callEntryOf(generator, entries[k].expression) = entries[k];
+			}
+		}
+		free(entries);
+	}
+	*_callEntryOf(generator, expression) = (CallEntry) {
+		.expression = expression,
+		.calls = calls
+	};
+	++generator->callSize;
+}
+
+/**
+ * Appends an operation over two arithmetic operands (i.e., its pending work).
+ * C leaves the order of the evaluation of the operands unspecified, so if
+ * either one calls a function (which could write the variables of the other
+ * one), both are evaluated first into temporaries, in order.
+ */
+static void _operation(Generator * generator, const Operator * operator, const ArithmeticExpression * left, const ArithmeticExpression * right) {
+	if (_arithmeticCalls(generator, left) || _arithmeticCalls(generator, right)) {
+		const unsigned int leftTemporary = _temporary(generator, INT_T);
+		const unsigned int rightTemporary = _temporary(generator, INT_T);
+		_append(generator->body, "(t%u = ", leftTemporary);
+		_pushTask(generator, OPERATE, NULL, leftTemporary)->operator = operator;
+		_pushTask(generator, ARITHMETIC, right, 0);
+		_pushTask(generator, APPEND, NULL, rightTemporary)->text = ", t%u = ";
+		_pushTask(generator, ARITHMETIC, left, 0);
+	}
+	else {
+		_append(generator->body, "%s", operator->before);
+		_pushTask(generator, APPEND, NULL, generator->line)->text = operator->after;
+		_pushTask(generator, ARITHMETIC, right, 0);
+		_pushTask(generator, APPEND, NULL, 0)->text = operator->between;
+		_pushTask(generator, ARITHMETIC, left, 0);
+	}
+}
+
+/**
+ * The texts of an arithmetic operation. An operation is checked through the
+ * runtime, unless the analysis of the value ranges removed its checks.
+ */
+static const Operator * _operatorOf(const Generator * generator, const ArithmeticExpression * operation) {
+	const RangeCheck checks = rangeChecksOf(generator->rangeAnalysis, operation);
+	const enum ArithmeticExpressionType type = operation->type;
+	return (type == DIV_T ? checks != NO_CHECK : (checks & OVERFLOW_CHECK) != 0) ? &_checked[type] : &_unchecked[type];
+}
+
+/**
+ * Pushes an operation on the stack of pending operations (of the walks of
+ * the calls), doubling its capacity as needed.
+ */
+static void _pushPending(Generator * generator, const void * expression) {
+	if (generator->pendingSize == generator->pendingCapacity) {
+		generator->pendingCapacity *= 2;
+		generator->pending = realloc(generator->pending, generator->pendingCapacity * sizeof(const void *));
+	}
+	generator->pending[generator->pendingSize++] = expression;
+}
+
+/**
+ * Pushes a pending work on the stack, doubling its capacity as needed, and
+ * returns it.
+ */
+static Task * _pushTask(Generator * generator, const TaskKind kind, const void * node, const unsigned int number) {
+	if (generator->taskSize == generator->taskCapacity) {
+		generator->taskCapacity *= 2;
+		generator->tasks = realloc(generator->tasks, generator->taskCapacity * sizeof(Task));
+	}
+	generator->tasks[generator->taskSize] = (Task) {
+		.node = node,
+		.text = NULL,
+		.operator = NULL,
+		.number = number,
+		.kind = kind
+	};
+	return &generator->tasks[generator->taskSize++];
+}
+
+/**
+ * Finds the function that encloses every function declared in a block (and
+ * in the blocks nested in it), given the function of the block.
+ */
+static void _scan(Generator * generator, const Block * block, const unsigned int index) {
+	for (const Instruction * instruction = block->instructions; instruction != NULL; instruction = instruction->next) {
+		switch (instruction->type) {
+			case FUNCTION_INSTRUCTION_T: {
+				const CallGraphNode * node = callGraphNodeOf(generator->callGraph, instruction->function);
+				if (node != NULL) {
+					const unsigned int function = node - generator->callGraph->nodes;
+					generator->parents[function] = index;
+					generator->frames[index] = index != generator->program;
+					_scan(generator, instruction->function->block, function);
+				}
+				break;
+			}
+			case CONDITIONAL_INSTRUCTION_T:
+				_scan(generator, instruction->conditional->ifBlock, index);
+				if (instruction->conditional->elseBlock != NULL) {
+					_scan(generator, instruction->conditional->elseBlock, index);
+				}
+				break;
+			case LOOP_INSTRUCTION_T:
+				_scan(generator, instruction->loop->block, index);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+/**
+ * Appends the signature of a function: its result, its name, the frame of
+ * the function that encloses it (if it's nested), and its parameters.
+ */
+static void _signature(const Generator * generator, Text * text, const unsigned int index) {
+	const Function * function = generator->callGraph->nodes[index].function;
+	_append(text, "static %s f%u_%s(", _types[function->returnType->type], index, function->functionName);
+	if (1 < generator->callGraph->nodes[index].level) {
+		_append(text, "struct frame%u * link%s", generator->parents[index], function->parameters == NULL ? "" : ", ");
+	}
+	else if (function->parameters == NULL) {
+		_append(text, "void");
+	}
+	for (const Parameters * parameters = function->parameters; parameters != NULL; parameters = parameters->next) {
+		const Parameter * parameter = parameters->parameter;
+		_append(text, "%s %c%u%s", _types[parameter->type->type], _prefixes[parameter->type->type], parameter->slot.index,
+			parameters->next == NULL ? "" : ", ");
+	}
+	_append(text, ")");
+}
+
+/**
+ * Appends a string expression.
+ */
+static void _string(Generator * generator, const StringExpression * stringExpression) {
+	switch (stringExpression->type) {
+		case STRING_LITERAL_T:
+			_literal(generator->body, stringExpression->value);
+			break;
+		case VAR_STRING_T:
+			_access(generator, stringExpression->slot, STRING_T);
+			break;
+		case FUNC_CALL_STRING_T:
+			_call(generator, stringExpression->functionCall);
+			break;
+		default:
+			break;
+	}
+}
+
+/**
+ * Declares a new temporary of a type in the current function, and returns
+ * its number.
+ */
+static unsigned int _temporary(Generator * generator, const enum DataType type) {
+	_append(&generator->declarations[generator->function], "\t%s t%u;\n", _types[type], generator->temporaries);
+	return generator->temporaries++;
+}
+
+/* PUBLIC FUNCTIONS */
+
+boolean generate(const CompilerState * compilerState, FILE * output) {
+	const Program * program = compilerState->abstractSyntaxtTree;
+	const CallGraph * callGraph = compilerState->callGraph;
+	const unsigned int size = callGraph->size + 1;
+	Generator generator = {
+		.callGraph = callGraph,
+		.rangeAnalysis = compilerState->rangeAnalysis,
+		.program = callGraph->size,
+		.parents = calloc(size, sizeof(unsigned int)),
+		.frames = calloc(size, sizeof(boolean)),
+		.frameSizes = calloc(size, sizeof(unsigned int)),
+		.variables = calloc(size, sizeof(uint8_t *)),
+		.declarations = calloc(size, sizeof(Text)),
+		.bodies = calloc(size, sizeof(Text)),
+		.tasks = malloc(_initialCapacity * sizeof(Task)),
+		.taskSize = 0,
+		.taskCapacity = _initialCapacity,
+		.calls = calloc(_initialCapacity, sizeof(CallEntry)),
+		.callSize = 0,
+		.callCapacity = _initialCapacity,
+		.pending = malloc(_initialCapacity * sizeof(const void *)),
+		.pendingSize = 0,
+		.pendingCapacity = _initialCapacity,
+		.succeed = true
+	};
+	for (unsigned int k = 0; k < size; ++k) {
+		generator.parents[k] = generator.program;
+		generator.frameSizes[k] = k == generator.program ? program->frameSize : callGraph->nodes[k].function->frameSize;
+		generator.variables[k] = calloc(generator.frameSizes[k] + 1, sizeof(uint8_t));
+	}
+	_scan(&generator, program->block, generator.program);
+	for (unsigned int k = 0; k < callGraph->size; ++k) {
+		_function(&generator, k, callGraph->nodes[k].function->block, callGraph->nodes[k].function);
+	}
+	_function(&generator, generator.program, program->block, NULL);
+	if (generator.succeed) {
+		Text text = {NULL, 0, 0};
+		_append(&text, "%s", _runtime);
+		for (unsigned int slot = 0; slot < generator.frameSizes[generator.program]; ++slot) {
+			for (enum DataType type = INT_T; type <= STRING_T; ++type) {
+				if (generator.variables[generator.program][slot] & (1 << type)) {
+					_append(&text, "static %s g%c%u;\n", _types[type], _prefixes[type], slot);
+				}
+			}
+		}
+		for (unsigned int k = 0; k < callGraph->size; ++k) {
+			if (generator.frames[k]) {
+				// A struct needs a member, even if no variable of the frame is used.
+				_append(&text, "\nstruct frame%u {\n", k);
+				if (1 < callGraph->nodes[k].level) {
+					_append(&text, "\tstruct frame%u * link;\n", generator.parents[k]);
+				}
+				for (unsigned int slot = 0; slot < generator.frameSizes[k]; ++slot) {
+					for (enum DataType type = INT_T; type <= STRING_T; ++type) {
+						if (generator.variables[k][slot] & (1 << type)) {
+							_append(&text, "\t%s %c%u;\n", _types[type], _prefixes[type], slot);
+						}
+					}
+				}
+				_append(&text, "\tchar unused;\n};\n");
+			}
+		}
+		_append(&text, "\n");
+		for (unsigned int k = 0; k < callGraph->size; ++k) {
+			_signature(&generator, &text, k);
+			_append(&text, ";\n");
+		}
+		for (unsigned int k = 0; k < size; ++k) {
+			if (k == generator.program) {
+				_append(&text, "\nint main(void) {\n\tchar base;\n");
+			}
+			else {
+				_append(&text, "\n");
+				_signature(&generator, &text, k);
+				_append(&text, " {\n");
+			}
+			if (generator.frames[k]) {
+				_append(&text, "\tstruct frame%u frame = {0};\n", k);
+			}
+			for (unsigned int slot = 0; k != generator.program && !generator.frames[k] && slot < generator.frameSizes[k]; ++slot) {
+				for (enum DataType type = INT_T; type <= STRING_T; ++type) {
+					if ((generator.variables[k][slot] & (1 << type)) && !(generator.variables[k][slot] & _parameterMark)) {
+						_append(&text, "\t%s %c%u = 0;\n", _types[type], _prefixes[type], slot);
+					}
+				}
+			}
+			_append(&text, "%s", generator.declarations[k].size == 0 ? "" : generator.declarations[k].text);
+			if (generator.frames[k] && 1 < callGraph->nodes[k].level) {
+				_append(&text, "\tframe.link = link;\n");
+			}
+			for (unsigned int slot = 0; generator.frames[k] && slot < generator.frameSizes[k]; ++slot) {
+				for (enum DataType type = INT_T; type <= STRING_T; ++type) {
+					if ((generator.variables[k][slot] & (1 << type)) && (generator.variables[k][slot] & _parameterMark)) {
+						_append(&text, "\tframe.%c%u = %c%u;\n", _prefixes[type], slot, _prefixes[type], slot);
+					}
+				}
+			}
+			if (k == generator.program) {
+				_append(&text, "\trt_stackLimit = (uintptr_t) &base - STACK_BUDGET;\n");
+			}
+			_append(&text, "%s", generator.bodies[k].size == 0 ? "" : generator.bodies[k].text);
+			_append(&text, k == generator.program ? "\treturn EXIT_SUCCESS;\n}\n" : "}\n");
+		}
+		fwrite(text.text, sizeof(char), text.size, output);
+		fflush(output);
+		free(text.text);
+	}
+	for (unsigned int k = 0; k < size; ++k) {
+		free(generator.bodies[k].text);
+		free(generator.declarations[k].text);
+		free(generator.variables[k]);
+	}
+	free(generator.pending);
+	free(generator.calls);
+	free(generator.tasks);
+	free(generator.bodies);
+	free(generator.declarations);
+	free(generator.variables);
+	free(generator.frameSizes);
+	free(generator.frames);
+	free(generator.parents);
+	return generator.succeed;
+}
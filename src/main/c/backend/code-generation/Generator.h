@@ -1,22 +1,54 @@
-// #ifndef GENERATOR_HEADER
-// #define GENERATOR_HEADER
+#ifndef GENERATOR_HEADER
+#define GENERATOR_HEADER
 
-// #include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
-// #include "../../shared/CompilerState.h"
-// #include "../../shared/Logger.h"
-// #include "../../shared/String.h"
-// #include <stdarg.h>
-// #include <stdio.h>
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/CompilerState.h"
+#include "../../shared/Hash.h"
+#include "../../shared/Logger.h"
+#include "../../shared/String.h"
+#include "../../shared/Type.h"
+#include "../semantic-analysis/CallGraph.h"
+#include "../semantic-analysis/RangeAnalysis.h"
+#include <limits.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-// /** Initialize module's internal state. */
-// void initializeGeneratorModule();
+/** Initialize module's internal state. */
+void initializeGeneratorModule();
 
-// /** Shutdown module's internal state. */
-// void shutdownGeneratorModule();
+/** Shutdown module's internal state. */
+void shutdownGeneratorModule();
 
-// /**
-//  * Generates the final output using the current compiler state.
-//  */
-// void generate(CompilerState * compilerState);
+/**
+ * A backend that translates a compiled program into portable C (C99), with
+ * the same output and errors as the interpreter (see "Calculator.h"), so a C
+ * compiler can build it into an executable.
+ *
+ * The types map directly ("INT" and "BOOL" into "int", and "STRING" into
+ * "const char *"), every function becomes a static C function, and every
+ * "FOR" becomes a counted loop. The variables of the program are globals, and
+ * the ones of a function are locals, except in a function that encloses
+ * others: its variables live in a frame (a struct), that its nested functions
+ * reach through a chain of links, as the static links of the interpreter.
+ *
+ * The operations keep the order of evaluation of the interpreter (through
+ * temporaries, where C leaves it unspecified), and only the arithmetic checks
+ * that the analysis of the value ranges couldn't remove (see
+ * "RangeAnalysis.h") are emitted. A long chain of operations (as in
+ * "1 + 2 + ... + n") is evaluated in sequence into a temporary, so the C
+ * compiler never parses deeply nested expressions. A recursion that exhausts
+ * the stack budget of the executable (i.e., "STACK_BUDGET" bytes) stops it
+ * with an error.
+ */
 
-// #endif
+/**
+ * Generates the C source of a program, given the analyses of the compiler
+ * state, and prints it in a stream. Returns false if it cannot be generated
+ * (i.e., a call cannot be resolved).
+ */
+boolean generate(const CompilerState * compilerState, FILE * output);
+
+#endif
@@ -0,0 +1,1097 @@
+#include "Bytecode.h"
+
+/**
+ * The kinds of pending work of the lowering of an expression. Evaluating an
+ * expression pushes the register that holds its value in the stack of
+ * operands, and applying an operator pops the registers of its operands. A
+ * branch adds its jumps to a chain of the stack of chains.
+ */
+typedef enum {
+	APPLY_ARITHMETIC,
+	APPLY_COMPARISON,
+	APPLY_IMMEDIATE,
+	APPLY_NOT,
+	BRANCH,
+	BRANCH_ON_COMPARISON,
+	BRANCH_ON_VALUE,
+	COPY_IF_CALLED,
+	EVALUATE_ARGUMENTS,
+	EVALUATE_ARITHMETIC,
+	EVALUATE_BOOLEAN,
+	INVOKE,
+	MATERIALIZE,
+	PATCH
+} TaskKind;
+
+/**
+ * A pending work over a node: the register it writes, the chain of its
+ * jumps (or the callee of a call), the top of the temporary registers to
+ * restore once it's done, and whether its jumps are taken on true.
+ */
+typedef struct {
+	const void * node;
+	int32_t target;
+	unsigned int index;
+	unsigned int mark;
+	uint8_t kind;
+	boolean jumpIf;
+} Task;
+
+/**
+ * Whether an arithmetic operation calls a function. An empty entry has a
+ * NULL expression.
+ */
+typedef struct {
+	const ArithmeticExpression * expression;
+	boolean calls;
+} CallEntry;
+
+/**
+ * The state of the lowering of a function: its registers of variables, the
+ * next free temporary register, and the line of the current instruction. A
+ * chain of pending jumps (whose target is still unknown) is linked through
+ * their targets, and ends with -1.
+ *
+ * The expressions are lowered with explicit stacks in heap-memory (of
+ * pending work, of operands, and of chains), so deeply nested expressions
+ * can't overflow the C stack. Whether an operation calls a function is
+ * memoized (in an open-addressing hash table indexed by address), because
+ * the expressions are shared.
+ */
+typedef struct {
+	Bytecode * bytecode;
+	const CallGraph * callGraph;
+	const RangeAnalysis * rangeAnalysis;
+	BytecodeFunction * function;
+	boolean program;
+	unsigned int variables;
+	unsigned int top;
+	unsigned int line;
+	Task * tasks;
+	unsigned int taskSize;
+	unsigned int taskCapacity;
+	int32_t * operands;
+	unsigned int operandSize;
+	unsigned int operandCapacity;
+	int32_t * chains;
+	unsigned int chainSize;
+	unsigned int chainCapacity;
+	CallEntry * calls;
+	unsigned int callSize;
+	unsigned int callCapacity;
+	const ArithmeticExpression ** pending;
+	unsigned int pendingCapacity;
+	boolean succeed;
+} BytecodeCompiler;
+
+/* MODULE INTERNAL STATE */
+
+// The initial capacity of the code of every function, of the strings, and
+// of every stack and table of the lowering (must be a power of 2).
+static const unsigned int _initialCapacity = 16;
+
+// The end of a chain of pending jumps.
+static const int32_t _endOfChain = -1;
+
+// The names of the operations.
+static const char * const _names[BYTECODE_OPERATIONS] = {
+	[MOVE_OP] = "MOVE",
+	[LOAD_INT_OP] = "LOAD_INT",
+	[LOAD_STRING_OP] = "LOAD_STRING",
+	[LOAD_OUTER_OP] = "LOAD_OUTER",
+	[STORE_OUTER_OP] = "STORE_OUTER",
+	[ADD_OP] = "ADD",
+	[SUB_OP] = "SUB",
+	[MUL_OP] = "MUL",
+	[DIV_OP] = "DIV",
+	[ADD_IMMEDIATE_OP] = "ADD_IMMEDIATE",
+	[UNCHECKED_ADD_OP] = "UNCHECKED_ADD",
+	[UNCHECKED_SUB_OP] = "UNCHECKED_SUB",
+	[UNCHECKED_MUL_OP] = "UNCHECKED_MUL",
+	[UNCHECKED_DIV_OP] = "UNCHECKED_DIV",
+	[UNCHECKED_ADD_IMMEDIATE_OP] = "UNCHECKED_ADD_IMMEDIATE",
+	[LESS_THAN_OP] = "LESS_THAN",
+	[LESS_EQUALS_OP] = "LESS_EQUALS",
+	[GREATER_THAN_OP] = "GREATER_THAN",
+	[GREATER_EQUALS_OP] = "GREATER_EQUALS",
+	[EQUALS_OP] = "EQUALS",
+	[NOT_EQUALS_OP] = "NOT_EQUALS",
+	[NOT_OP] = "NOT",
+	[JUMP_OP] = "JUMP",
+	[JUMP_IF_TRUE_OP] = "JUMP_IF_TRUE",
+	[JUMP_IF_FALSE_OP] = "JUMP_IF_FALSE",
+	[JUMP_IF_LESS_THAN_OP] = "JUMP_IF_LESS_THAN",
+	[JUMP_IF_LESS_EQUALS_OP] = "JUMP_IF_LESS_EQUALS",
+	[JUMP_IF_GREATER_THAN_OP] = "JUMP_IF_GREATER_THAN",
+	[JUMP_IF_GREATER_EQUALS_OP] = "JUMP_IF_GREATER_EQUALS",
+	[JUMP_IF_EQUALS_OP] = "JUMP_IF_EQUALS",
+	[JUMP_IF_NOT_EQUALS_OP] = "JUMP_IF_NOT_EQUALS",
+	[LOOP_OP] = "LOOP",
+	[CALL_OP] = "CALL",
+	[RETURN_OP] = "RETURN",
+	[PRINT_INT_OP] = "PRINT_INT",
+	[PRINT_BOOL_OP] = "PRINT_BOOL",
+	[PRINT_STRING_OP] = "PRINT_STRING",
+	[HALT_OP] = "HALT"
+};
+
+// The kinds of the operands of each operation (see "BytecodeOperation").
+static const char * const _operandKinds[BYTECODE_OPERATIONS] = {
+	[MOVE_OP] = "rr",
+	[LOAD_INT_OP] = "ri",
+	[LOAD_STRING_OP] = "rs",
+	[LOAD_OUTER_OP] = "rdi",
+	[STORE_OUTER_OP] = "rdi",
+	[ADD_OP ... DIV_OP] = "rrr",
+	[ADD_IMMEDIATE_OP] = "rri",
+	[UNCHECKED_ADD_OP ... UNCHECKED_DIV_OP] = "rrr",
+	[UNCHECKED_ADD_IMMEDIATE_OP] = "rri",
+	[LESS_THAN_OP ... NOT_EQUALS_OP] = "rrr",
+	[NOT_OP] = "rr",
+	[JUMP_OP] = "t",
+	[JUMP_IF_TRUE_OP ... JUMP_IF_FALSE_OP] = "tr",
+	[JUMP_IF_LESS_THAN_OP ... JUMP_IF_NOT_EQUALS_OP] = "trr",
+	[LOOP_OP] = "rrt",
+	[CALL_OP] = "rfr",
+	[RETURN_OP ... PRINT_STRING_OP] = "r",
+	[HALT_OP] = ""
+};
+
+static Logger * _logger = NULL;
+
+void initializeBytecodeModule() {
+	_logger = createLogger("Bytecode");
+}
+
+void shutdownBytecodeModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+static void _arithmetic(BytecodeCompiler * compiler, const ArithmeticExpression * arithmeticExpression);
+static void _arithmeticInto(BytecodeCompiler * compiler, const ArithmeticExpression * arithmeticExpression, const int32_t target);
+static void _block(BytecodeCompiler * compiler, const Block * block);
+static void _boolean(BytecodeCompiler * compiler, const BooleanExpression * booleanExpression);
+static void _booleanInto(BytecodeCompiler * compiler, const BooleanExpression * booleanExpression, const int32_t target);
+static void _branch(BytecodeCompiler * compiler, const BooleanExpression * booleanExpression, const boolean jumpIf, const unsigned int chain);
+static void _call(BytecodeCompiler * compiler, const FunctionCall * functionCall, const int32_t target);
+static CallEntry * _callEntryOf(const BytecodeCompiler * compiler, const ArithmeticExpression * arithmeticExpression);
+static int32_t _condition(BytecodeCompiler * compiler, const BooleanExpression * booleanExpression, const boolean jumpIf);
+static boolean _containsCall(BytecodeCompiler * compiler, const ArithmeticExpression * arithmeticExpression);
+static int32_t _emit(BytecodeCompiler * compiler, const BytecodeOperation operation, const int32_t a, const int32_t b, const int32_t c);
+static int32_t _expression(BytecodeCompiler * compiler, const Expression * expression);
+static void _expressionInto(BytecodeCompiler * compiler, const Expression * expression, const int32_t target);
+static void _function(BytecodeCompiler * compiler, const unsigned int index, const Function * function, const Block * block);
+static void _instruction(BytecodeCompiler * compiler, const Instruction * instruction);
+static void _lower(BytecodeCompiler * compiler);
+static void _memoizeCall(BytecodeCompiler * compiler, const ArithmeticExpression * arithmeticExpression, const boolean calls);
+static void _operands(BytecodeCompiler * compiler, const ArithmeticExpression * left, const ArithmeticExpression * right);
+static void _patch(BytecodeCompiler * compiler, int32_t chain, const int32_t target);
+static int32_t _popOperand(BytecodeCompiler * compiler);
+static void _printString(const char * string, FILE * output);
+static unsigned int _pushChain(BytecodeCompiler * compiler);
+static void _pushOperand(BytecodeCompiler * compiler, const int32_t operand);
+static Task * _pushTask(BytecodeCompiler * compiler, const TaskKind kind, const void * node, const int32_t target);
+static int32_t _string(BytecodeCompiler * compiler, const char * string);
+static void _stringInto(BytecodeCompiler * compiler, const StringExpression * stringExpression, const int32_t target);
+static int32_t _temporary(BytecodeCompiler * compiler);
+static void _variableInto(BytecodeCompiler * compiler, const Slot slot, const int32_t target);
+
+/**
+ * Evaluates an arithmetic expression into a register: the one of the
+ * variable, if it's in the current frame, or a new temporary one. The
+ * register is pushed in the stack of operands right away, and its value is
+ * written once the pending work is done.
+ */
+static void _arithmetic(BytecodeCompiler * compiler, const ArithmeticExpression * arithmeticExpression) {
+	if (arithmeticExpression->type == VAR_ARITH_T && arithmeticExpression->slot.depth == 0) {
+		_pushOperand(compiler, arithmeticExpression->slot.index);
+	}
+	else {
+		const int32_t target = _temporary(compiler);
+		_pushOperand(compiler, target);
+		_arithmeticInto(compiler, arithmeticExpression, target);
+	}
+}
+
+/**
+ * Evaluates an arithmetic expression into a specific register. An addition
+ * (or a subtraction) of a literal uses it as an immediate operand. Unless
+ * the range analysis proves otherwise, the operations are checked (see
+ * "_lower").
+ */
+static void _arithmeticInto(BytecodeCompiler * compiler, const ArithmeticExpression * arithmeticExpression, const int32_t target) {
+	switch (arithmeticExpression->type) {
+		case INT_LITERAL_T:
+			_emit(compiler, LOAD_INT_OP, target, arithmeticExpression->value, 0);
+			return;
+		case VAR_ARITH_T:
+			_variableInto(compiler, arithmeticExpression->slot, target);
+			return;
+		case FUNC_CALL_ARITH_T:
+			_call(compiler, arithmeticExpression->functionCall, target);
+			return;
+		default:
+			break;
+	}
+	const unsigned int mark = compiler->top;
+	const ArithmeticExpression * right = arithmeticExpression->right;
+	if (right->type == INT_LITERAL_T && (arithmeticExpression->type == ADD_T
+			|| (arithmeticExpression->type == SUB_T && right->value != INT_MIN))) {
+		_pushTask(compiler, APPLY_IMMEDIATE, arithmeticExpression, target)->mark = mark;
+		_pushTask(compiler, EVALUATE_ARITHMETIC, arithmeticExpression->left, 0);
+	}
+	else {
+		_pushTask(compiler, APPLY_ARITHMETIC, arithmeticExpression, target)->mark = mark;
+		_operands(compiler, arithmeticExpression->left, right);
+	}
+}
+
+/**
+ * Lowers the instructions of a block.
+ */
+static void _block(BytecodeCompiler * compiler, const Block * block) {
+	for (const Instruction * instruction = block->instructions; instruction != NULL; instruction = instruction->next) {
+		_instruction(compiler, instruction);
+	}
+}
+
+/**
+ * Evaluates a boolean expression into a register (see "_arithmetic").
+ */
+static void _boolean(BytecodeCompiler * compiler, const BooleanExpression * booleanExpression) {
+	if (booleanExpression->type == VAR_BOOL_T && booleanExpression->slot.depth == 0) {
+		_pushOperand(compiler, booleanExpression->slot.index);
+	}
+	else {
+		const int32_t target = _temporary(compiler);
+		_pushOperand(compiler, target);
+		_booleanInto(compiler, booleanExpression, target);
+	}
+}
+
+/**
+ * Evaluates a boolean expression into a specific register. "AND" and "OR"
+ * are lowered into jumps, so the register is written only once the result
+ * is known.
+ */
+static void _booleanInto(BytecodeCompiler * compiler, const BooleanExpression * booleanExpression, const int32_t target) {
+	const unsigned int mark = compiler->top;
+	switch (booleanExpression->type) {
+		case BOOL_LITERAL_T:
+			_emit(compiler, LOAD_INT_OP, target, booleanExpression->value ? true : false, 0);
+			break;
+		case VAR_BOOL_T:
+			_variableInto(compiler, booleanExpression->slot, target);
+			break;
+		case FUNC_CALL_BOOL_T:
+			_call(compiler, booleanExpression->functionCall, target);
+			break;
+		case NOT_T:
+			_pushTask(compiler, APPLY_NOT, booleanExpression, target)->mark = mark;
+			_pushTask(compiler, EVALUATE_BOOLEAN, booleanExpression->notExpr, 0);
+			break;
+		case COMPARISON_T:
+			_pushTask(compiler, APPLY_COMPARISON, booleanExpression, target)->mark = mark;
+			_operands(compiler, booleanExpression->leftArith, booleanExpression->rightArith);
+			break;
+		default: {
+			const unsigned int chain = _pushChain(compiler);
+			Task * task = _pushTask(compiler, MATERIALIZE, booleanExpression, target);
+			task->index = chain;
+			task->mark = mark;
+			_branch(compiler, booleanExpression, false, chain);
+			break;
+		}
+	}
+}
+
+/**
+ * Lowers a condition into jumps, that are taken if its value is "jumpIf",
+ * and added to a chain of the stack of chains. Otherwise, the execution
+ * continues after the lowered condition. A comparison compares and jumps in
+ * a single instruction.
+ */
+static void _branch(BytecodeCompiler * compiler, const BooleanExpression * booleanExpression, const boolean jumpIf, const unsigned int chain) {
+	Task * task = NULL;
+	switch (booleanExpression->type) {
+		case AND_T:
+		case OR_T: {
+			// If the left operand decides the result, the right one is skipped.
+			const boolean decisive = booleanExpression->type == OR_T;
+			if (jumpIf == decisive) {
+				task = _pushTask(compiler, BRANCH, booleanExpression->right, 0);
+				task->index = chain;
+				task->jumpIf = jumpIf;
+				task = _pushTask(compiler, BRANCH, booleanExpression->left, 0);
+				task->index = chain;
+				task->jumpIf = jumpIf;
+			}
+			else {
+				const unsigned int skip = _pushChain(compiler);
+				_pushTask(compiler, PATCH, booleanExpression, 0)->index = skip;
+				task = _pushTask(compiler, BRANCH, booleanExpression->right, 0);
+				task->index = chain;
+				task->jumpIf = jumpIf;
+				task = _pushTask(compiler, BRANCH, booleanExpression->left, 0);
+				task->index = skip;
+				task->jumpIf = decisive;
+			}
+			break;
+		}
+		case NOT_T:
+			task = _pushTask(compiler, BRANCH, booleanExpression->notExpr, 0);
+			task->index = chain;
+			task->jumpIf = !jumpIf;
+			break;
+		case BOOL_LITERAL_T:
+			if ((booleanExpression->value ? true : false) == jumpIf) {
+				compiler->chains[chain] = _emit(compiler, JUMP_OP, compiler->chains[chain], 0, 0);
+			}
+			break;
+		case COMPARISON_T:
+			task = _pushTask(compiler, BRANCH_ON_COMPARISON, booleanExpression, 0);
+			task->index = chain;
+			task->mark = compiler->top;
+			task->jumpIf = jumpIf;
+			_operands(compiler, booleanExpression->leftArith, booleanExpression->rightArith);
+			break;
+		default:
+			task = _pushTask(compiler, BRANCH_ON_VALUE, booleanExpression, 0);
+			task->index = chain;
+			task->mark = compiler->top;
+			task->jumpIf = jumpIf;
+			_pushTask(compiler, EVALUATE_BOOLEAN, booleanExpression, 0);
+			break;
+	}
+}
+
+/**
+ * Calls a function into a register. The arguments are evaluated, from left
+ * to right, into consecutive temporary registers.
+ */
+static void _call(BytecodeCompiler * compiler, const FunctionCall * functionCall, const int32_t target) {
+	const CallGraphNode * callee = calleeOf(compiler->callGraph, functionCall);
+	if (callee == NULL) {
+		logError(_logger, "Cannot resolve the call to \"%s\" (on line %u).", functionCall->functionName, compiler->line);
+		compiler->succeed = false;
+		return;
+	}
+	const unsigned int mark = compiler->top;
+	Task * task = _pushTask(compiler, INVOKE, functionCall, target);
+	task->index = callee - compiler->callGraph->nodes;
+	task->mark = mark;
+	for (const Arguments * arguments = functionCall->arguments; arguments != NULL; arguments = arguments->next) {
+		_temporary(compiler);
+	}
+	_pushTask(compiler, EVALUATE_ARGUMENTS, functionCall->arguments, mark);
+}
+
+/**
+ * The entry of an operation in the table of calls, or the empty entry where
+ * it belongs.
+ */
+static CallEntry * _callEntryOf(const BytecodeCompiler * compiler, const ArithmeticExpression * arithmeticExpression) {
+	const unsigned int mask = compiler->callCapacity - 1;
+	unsigned int k = hashAddress(arithmeticExpression) & mask;
+	while (compiler->calls[k].expression != NULL && compiler->calls[k].expression != arithmeticExpression) {
+		k = (k + 1) & mask;
+	}
+	return &compiler->calls[k];
+}
+
+/**
+ * Lowers a condition into jumps, that are taken if its value is "jumpIf"
+ * (see "_branch"), and returns their chain.
+ */
+static int32_t _condition(BytecodeCompiler * compiler, const BooleanExpression * booleanExpression, const boolean jumpIf) {
+	const unsigned int chain = _pushChain(compiler);
+	_branch(compiler, booleanExpression, jumpIf, chain);
+	_lower(compiler);
+	compiler->chainSize = chain;
+	return compiler->chains[chain];
+}
+
+/**
+ * Whether an arithmetic expression calls a function (which could write a
+ * variable read before the call). The operations are walked in post-order,
+ * on an explicit stack, and each one is memoized, so a shared subexpression
+ * is only walked once.
+ */
+static boolean _containsCall(BytecodeCompiler * compiler, const ArithmeticExpression * arithmeticExpression) {
+	switch (arithmeticExpression->type) {
+		case INT_LITERAL_T:
+		case VAR_ARITH_T:
+			return false;
+		case FUNC_CALL_ARITH_T:
+			return true;
+		default:
+			break;
+	}
+	unsigned int size = 0;
+	compiler->pending[size++] = arithmeticExpression;
+	while (0 < size) {
+		const ArithmeticExpression * operation = compiler->pending[size - 1];
+		if (_callEntryOf(compiler, operation)->expression != NULL) {
+			--size;
+			continue;
+		}
+		const ArithmeticExpression * children[] = {operation->left, operation->right};
+		boolean calls = false;
+		boolean known = true;
+		for (unsigned int k = 0; k < 2; ++k) {
+			switch (children[k]->type) {
+				case INT_LITERAL_T:
+				case VAR_ARITH_T:
+					break;
+				case FUNC_CALL_ARITH_T:
+					calls = true;
+					break;
+				default: {
+					const CallEntry * entry = _callEntryOf(compiler, children[k]);
+					if (entry->expression != NULL) {
+						calls = calls || entry->calls;
+					}
+					else {
+						if (size == compiler->pendingCapacity) {
+							compiler->pendingCapacity *= 2;
+							compiler->pending = realloc(compiler->pending, compiler->pendingCapacity * sizeof(const ArithmeticExpression *));
+						}
+						compiler->pending[size++] = children[k];
+						known = false;
+					}
+					break;
+				}
+			}
+		}
+		if (known) {
+			_memoizeCall(compiler, operation, calls);
+			--size;
+		}
+	}
+	return _callEntryOf(compiler, arithmeticExpression)->calls;
+}
+
+/**
+ * Appends an instruction to the current function, at the current line, and
+ * returns its index.
+ */
+static int32_t _emit(BytecodeCompiler * compiler, const BytecodeOperation operation, const int32_t a, const int32_t b, const int32_t c) {
+	BytecodeFunction * function = compiler->function;
+	if (function->size == function->capacity) {
+		function->capacity *= 2;
+		function->code = realloc(function->code, function->capacity * sizeof(BytecodeInstruction));
+		function->lines = realloc(function->lines, function->capacity * sizeof(unsigned int));
+	}
+	function->code[function->size] = (BytecodeInstruction) {
+		.operation = operation,
+		.a = a,
+		.b = b,
+		.c = c
+	};
+	function->lines[function->size] = compiler->line;
+	++compiler->bytecode->instructions;
+	return function->size++;
+}
+
+/**
+ * The register that holds the value of an expression, once lowered (see
+ * "_arithmetic").
+ */
+static int32_t _expression(BytecodeCompiler * compiler, const Expression * expression) {
+	switch (expression->type) {
+		case ARITHMETIC_EXPR_T:
+			_arithmetic(compiler, expression->arithmeticExpression);
+			break;
+		case BOOLEAN_EXPR_T:
+			_boolean(compiler, expression->booleanExpression);
+			break;
+		default: {
+			const StringExpression * stringExpression = expression->stringExpression;
+			if (stringExpression->type == VAR_STRING_T && stringExpression->slot.depth == 0) {
+				_pushOperand(compiler, stringExpression->slot.index);
+			}
+			else {
+				const int32_t target = _temporary(compiler);
+				_pushOperand(compiler, target);
+				_stringInto(compiler, stringExpression, target);
+			}
+			break;
+		}
+	}
+	_lower(compiler);
+	return _popOperand(compiler);
+}
+
+/**
+ * Evaluates an expression into a specific register.
+ */
+static void _expressionInto(BytecodeCompiler * compiler, const Expression * expression, const int32_t target) {
+	switch (expression->type) {
+		case ARITHMETIC_EXPR_T:
+			_arithmeticInto(compiler, expression->arithmeticExpression, target);
+			break;
+		case BOOLEAN_EXPR_T:
+			_booleanInto(compiler, expression->booleanExpression, target);
+			break;
+		case STRING_EXPR_T:
+			_stringInto(compiler, expression->stringExpression, target);
+			break;
+	}
+}
+
+/**
+ * Lowers the block of a function (or of the program, if the function is
+ * NULL). Its parameters live in the registers of their slots, and the end of
+ * its block returns the default value of its type (i.e., zero, false, or an
+ * empty string).
+ */
+static void _function(BytecodeCompiler * compiler, const unsigned int index, const Function * function, const Block * block) {
+	BytecodeFunction * bytecodeFunction = &compiler->bytecode->functions[index];
+	bytecodeFunction->code = malloc(_initialCapacity * sizeof(BytecodeInstruction));
+	bytecodeFunction->lines = malloc(_initialCapacity * sizeof(unsigned int));
+	bytecodeFunction->capacity = _initialCapacity;
+	compiler->function = bytecodeFunction;
+	compiler->program = function == NULL;
+	compiler->variables = bytecodeFunction->registers;
+	compiler->top = bytecodeFunction->registers;
+	compiler->line = bytecodeFunction->line;
+	if (function != NULL) {
+		for (const Parameters * parameters = function->parameters; parameters != NULL; parameters = parameters->next) {
+			++bytecodeFunction->parameterCount;
+		}
+		bytecodeFunction->parameters = calloc(bytecodeFunction->parameterCount + 1, sizeof(unsigned int));
+		unsigned int k = 0;
+		for (const Parameters * parameters = function->parameters; parameters != NULL; parameters = parameters->next) {
+			bytecodeFunction->parameters[k++] = parameters->parameter->slot.index;
+		}
+	}
+	_block(compiler, block);
+	if (function == NULL) {
+		_emit(compiler, HALT_OP, 0, 0, 0);
+	}
+	else {
+		const int32_t value = _temporary(compiler);
+		if (function->returnType->type == STRING_T) {
+			_emit(compiler, LOAD_STRING_OP, value, _string(compiler, ""), 0);
+		}
+		else {
+			_emit(compiler, LOAD_INT_OP, value, 0, 0);
+		}
+		_emit(compiler, RETURN_OP, value, 0, 0);
+	}
+}
+
+/**
+ * Lowers an instruction. Its temporary registers are released afterwards,
+ * except the ones of a loop, which live while its block runs.
+ */
+static void _instruction(BytecodeCompiler * compiler, const Instruction * instruction) {
+	const unsigned int mark = compiler->top;
+	compiler->line = instruction->line;
+	const Assignation * assignation = NULL;
+	switch (instruction->type) {
+		case DECLARATION_INSTRUCTION_T:
+			assignation = instruction->declaration->assignation;
+			break;
+		case ASSIGNATION_INSTRUCTION_T:
+			assignation = instruction->assignation;
+			break;
+		case EXPRESSION_INSTRUCTION_T:
+			_expressionInto(compiler, instruction->expression, _temporary(compiler));
+			_lower(compiler);
+			break;
+		case PRINT_INSTRUCTION_T: {
+			static const BytecodeOperation operations[] = {
+				[ARITHMETIC_EXPR_T] = PRINT_INT_OP,
+				[BOOLEAN_EXPR_T] = PRINT_BOOL_OP,
+				[STRING_EXPR_T] = PRINT_STRING_OP
+			};
+			const Expression * expression = instruction->print->expression;
+			_emit(compiler, operations[expression->type], _expression(compiler, expression), 0, 0);
+			break;
+		}
+		case FUNCTION_CALL_INSTRUCTION_T:
+			_call(compiler, instruction->functionCall, _temporary(compiler));
+			_lower(compiler);
+			break;
+		case RETURN_STATEMENT_INSTRUCTION_T: {
+			const int32_t value = _expression(compiler, instruction->returnStatement->expression);
+			_emit(compiler, compiler->program ? HALT_OP : RETURN_OP, value, 0, 0);
+			break;
+		}
+		case FUNCTION_INSTRUCTION_T: {
+			const CallGraphNode * node = callGraphNodeOf(compiler->callGraph, instruction->function);
+			if (node != NULL) {
+				compiler->bytecode->functions[node - compiler->callGraph->nodes].line = instruction->line;
+			}
+			break;
+		}
+		case CONDITIONAL_INSTRUCTION_T: {
+			const int32_t chain = _condition(compiler, instruction->conditional->condition, false);
+			_block(compiler, instruction->conditional->ifBlock);
+			const int32_t end = _emit(compiler, JUMP_OP, _endOfChain, 0, 0);
+			_patch(compiler, chain, compiler->function->size);
+			_block(compiler, instruction->conditional->elseBlock);
+			_patch(compiler, end, compiler->function->size);
+			break;
+		}
+		case LOOP_INSTRUCTION_T: {
+			const Loop * loop = instruction->loop;
+			const int32_t counter = _temporary(compiler);
+			const int32_t last = _temporary(compiler);
+			_arithmeticInto(compiler, loop->start, counter);
+			_lower(compiler);
+			_arithmeticInto(compiler, loop->end, last);
+			_lower(compiler);
+			const int32_t exit = _emit(compiler, JUMP_IF_GREATER_THAN_OP, _endOfChain, counter, last);
+			const int32_t body = compiler->function->size;
+			if (loop->slot.depth == 0) {
+				_emit(compiler, MOVE_OP, loop->slot.index, counter, 0);
+			}
+			else {
+				_emit(compiler, STORE_OUTER_OP, counter, loop->slot.depth, loop->slot.index);
+			}
+			_block(compiler, loop->block);
+			compiler->line = instruction->line;
+			_emit(compiler, LOOP_OP, counter, last, body);
+			_patch(compiler, exit, compiler->function->size);
+			break;
+		}
+		default:
+			break;
+	}
+	if (assignation != NULL) {
+		if (assignation->slot.depth == 0) {
+			_expressionInto(compiler, assignation->expression, assignation->slot.index);
+			_lower(compiler);
+		}
+		else {
+			const int32_t value = _expression(compiler, assignation->expression);
+			_emit(compiler, STORE_OUTER_OP, value, assignation->slot.depth, assignation->slot.index);
+		}
+	}
+	compiler->top = mark;
+}
+
+/**
+ * Runs the pending work of the lowering of an expression, until there's
+ * nothing left. An operator pops the registers of its operands, and then
+ * releases the temporary registers of its evaluation.
+ */
+static void _lower(BytecodeCompiler * compiler) {
+	static const BytecodeOperation comparisons[] = {
+		[GREATER_THAN_T] = GREATER_THAN_OP,
+		[LESS_THAN_T] = LESS_THAN_OP,
+		[EQUALS_EQUALS_T] = EQUALS_OP,
+		[NOT_EQUALS_T] = NOT_EQUALS_OP,
+		[GREATER_EQUALS_T] = GREATER_EQUALS_OP,
+		[LESS_EQUALS_T] = LESS_EQUALS_OP
+	};
+	static const BytecodeOperation jumps[] = {
+		[GREATER_THAN_T] = JUMP_IF_GREATER_THAN_OP,
+		[LESS_THAN_T] = JUMP_IF_LESS_THAN_OP,
+		[EQUALS_EQUALS_T] = JUMP_IF_EQUALS_OP,
+		[NOT_EQUALS_T] = JUMP_IF_NOT_EQUALS_OP,
+		[GREATER_EQUALS_T] = JUMP_IF_GREATER_EQUALS_OP,
+		[LESS_EQUALS_T] = JUMP_IF_LESS_EQUALS_OP
+	};
+	static const BytecodeOperation negations[] = {
+		[GREATER_THAN_T] = JUMP_IF_LESS_EQUALS_OP,
+		[LESS_THAN_T] = JUMP_IF_GREATER_EQUALS_OP,
+		[EQUALS_EQUALS_T] = JUMP_IF_NOT_EQUALS_OP,
+		[NOT_EQUALS_T] = JUMP_IF_EQUALS_OP,
+		[GREATER_EQUALS_T] = JUMP_IF_LESS_THAN_OP,
+		[LESS_EQUALS_T] = JUMP_IF_GREATER_THAN_OP
+	};
+	while (0 < compiler->taskSize) {
+		const Task task = compiler->tasks[--compiler->taskSize];
+		switch (task.kind) {
+			case APPLY_ARITHMETIC: {
+				const ArithmeticExpression * arithmeticExpression = task.node;
+				const RangeCheck checks = rangeChecksOf(compiler->rangeAnalysis, arithmeticExpression);
+				const boolean checked = (checks & OVERFLOW_CHECK) != 0;
+				const int32_t right = _popOperand(compiler);
+				const int32_t left = _popOperand(compiler);
+				switch (arithmeticExpression->type) {
+					case ADD_T:
+						_emit(compiler, checked ? ADD_OP : UNCHECKED_ADD_OP, task.target, left, right);
+						break;
+					case SUB_T:
+						_emit(compiler, checked ? SUB_OP : UNCHECKED_SUB_OP, task.target, left, right);
+						break;
+					case MUL_T:
+						_emit(compiler, checked ? MUL_OP : UNCHECKED_MUL_OP, task.target, left, right);
+						break;
+					default:
+						_emit(compiler, checks == NO_CHECK ? UNCHECKED_DIV_OP : DIV_OP, task.target, left, right);
+						break;
+				}
+				compiler->top = task.mark;
+				break;
+			}
+			case APPLY_COMPARISON: {
+				const int32_t right = _popOperand(compiler);
+				const int32_t left = _popOperand(compiler);
+				_emit(compiler, comparisons[((const BooleanExpression *) task.node)->op->type], task.target, left, right);
+				compiler->top = task.mark;
+				break;
+			}
+			case APPLY_IMMEDIATE: {
+				const ArithmeticExpression * arithmeticExpression = task.node;
+				const boolean checked = (rangeChecksOf(compiler->rangeAnalysis, arithmeticExpression) & OVERFLOW_CHECK) != 0;
+				const int32_t value = arithmeticExpression->right->value;
+				const int32_t immediate = arithmeticExpression->type == ADD_T ? value : -value;
+				_emit(compiler, checked ? ADD_IMMEDIATE_OP : UNCHECKED_ADD_IMMEDIATE_OP, task.target, _popOperand(compiler), immediate);
+				compiler->top = task.mark;
+				break;
+			}
+			case APPLY_NOT:
+				_emit(compiler, NOT_OP, task.target, _popOperand(compiler), 0);
+				compiler->top = task.mark;
+				break;
+			case BRANCH:
+				_branch(compiler, task.node, task.jumpIf, task.index);
+				break;
+			case BRANCH_ON_COMPARISON: {
+				const int type = ((const BooleanExpression *) task.node)->op->type;
+				const int32_t right = _popOperand(compiler);
+				const int32_t left = _popOperand(compiler);
+				compiler->chains[task.index] = _emit(compiler, task.jumpIf ? jumps[type] : negations[type], compiler->chains[task.index], left, right);
+				compiler->top = task.mark;
+				break;
+			}
+			case BRANCH_ON_VALUE: {
+				const int32_t value = _popOperand(compiler);
+				compiler->chains[task.index] = _emit(compiler, task.jumpIf ? JUMP_IF_TRUE_OP : JUMP_IF_FALSE_OP, compiler->chains[task.index], value, 0);
+				compiler->top = task.mark;
+				break;
+			}
+			case COPY_IF_CALLED: {
+				const int32_t left = compiler->operands[compiler->operandSize - 1];
+				if ((unsigned int) left < compiler->variables && _containsCall(compiler, task.node)) {
+					const int32_t copy = _temporary(compiler);
+					_emit(compiler, MOVE_OP, copy, left, 0);
+					compiler->operands[compiler->operandSize - 1] = copy;
+				}
+				break;
+			}
+			case EVALUATE_ARGUMENTS: {
+				const Arguments * arguments = task.node;
+				if (arguments != NULL) {
+					_pushTask(compiler, EVALUATE_ARGUMENTS, arguments->next, task.target + 1);
+					_expressionInto(compiler, arguments->argument->expression, task.target);
+				}
+				break;
+			}
+			case EVALUATE_ARITHMETIC:
+				_arithmetic(compiler, task.node);
+				break;
+			case EVALUATE_BOOLEAN:
+				_boolean(compiler, task.node);
+				break;
+			case INVOKE:
+				_emit(compiler, CALL_OP, task.target, task.index, task.mark);
+				compiler->top = task.mark;
+				break;
+			case MATERIALIZE: {
+				_emit(compiler, LOAD_INT_OP, task.target, true, 0);
+				const int32_t end = _emit(compiler, JUMP_OP, _endOfChain, 0, 0);
+				_patch(compiler, compiler->chains[task.index], compiler->function->size);
+				compiler->chainSize = task.index;
+				_emit(compiler, LOAD_INT_OP, task.target, false, 0);
+				_patch(compiler, end, compiler->function->size);
+				compiler->top = task.mark;
+				break;
+			}
+			case PATCH:
+				_patch(compiler, compiler->chains[task.index], compiler->function->size);
+				compiler->chainSize = task.index;
+				break;
+		}
+	}
+}
+
+/**
+ * Memoizes whether an operation calls a function, doubling the capacity of
+ * the table if it's half full.
+ */
+static void _memoizeCall(BytecodeCompiler * compiler, const ArithmeticExpression * arithmeticExpression, const boolean calls) {
+	if (compiler->callCapacity <= 2 * (compiler->callSize + 1)) {
+		CallEntry * entries = compiler->calls;
+		const unsigned int capacity = compiler->callCapacity;
+		compiler->callCapacity *= 2;
+		compiler->calls = calloc(compiler->callCapacity, sizeof(CallEntry));
+		for (unsigned int k = 0; k < capacity; ++k) {
+			if (entries[k].expression != NULL) {
+				*_callEntryOf(compiler, entries[k].expression) = entries[k];
+			}
+		}
+		free(entries);
+	}
+	*_callEntryOf(compiler, arithmeticExpression) = (CallEntry) {
+		.expression = arithmeticExpression,
+		.calls = calls
+	};
+	++compiler->callSize;
+}
+
+/**
+ * Evaluates the operands of a binary operation, from left to right, into
+ * the stack of operands. If the left one is a variable and the right one
+ * calls a function, the variable is copied first, because the call could
+ * write it.
+ */
+static void _operands(BytecodeCompiler * compiler, const ArithmeticExpression * left, const ArithmeticExpression * right) {
+	_pushTask(compiler, EVALUATE_ARITHMETIC, right, 0);
+	_pushTask(compiler, COPY_IF_CALLED, right, 0);
+	_pushTask(compiler, EVALUATE_ARITHMETIC, left, 0);
+}
+
+/**
+ * Sets the target of every jump of a chain.
+ */
+static void _patch(BytecodeCompiler * compiler, int32_t chain, const int32_t target) {
+	while (chain != _endOfChain) {
+		const int32_t next = compiler->function->code[chain].a;
+		compiler->function->code[chain].a = target;
+		chain = next;
+	}
+}
+
+/**
+ * Pops the register of an operand.
+ */
+static int32_t _popOperand(BytecodeCompiler * compiler) {
+	return compiler->operands[--compiler->operandSize];
+}
+
+/**
+ * Prints a string as a literal, with its special characters escaped.
+ */
+static void _printString(const char * string, FILE * output) {
+	fputc('"', output);
+	for (const char * character = string; *character != '\0'; ++character) {
+		switch (*character) {
+			case '\n': fputs("\\n", output); break;
+			case '\r': fputs("\\r", output); break;
+			case '\t': fputs("\\t", output); break;
+			case '"': fputs("\\\"", output); break;
+			case '\\': fputs("\\\\", output); break;
+			default: fputc(*character, output); break;
+		}
+	}
+	fputc('"', output);
+}
+
+/**
+ * Pushes an empty chain of pending jumps, and returns its index in the stack
+ * of chains.
+ */
+static unsigned int _pushChain(BytecodeCompiler * compiler) {
+	if (compiler->chainSize == compiler->chainCapacity) {
+		compiler->chainCapacity *= 2;
+		compiler->chains = realloc(compiler->chains, compiler->chainCapacity * sizeof(int32_t));
+	}
+	compiler->chains[compiler->chainSize] = _endOfChain;
+	return compiler->chainSize++;
+}
+
+/**
+ * Pushes the register of an operand.
+ */
+static void _pushOperand(BytecodeCompiler * compiler, const int32_t operand) {
+	if (compiler->operandSize == compiler->operandCapacity) {
+		compiler->operandCapacity *= 2;
+		compiler->operands = realloc(compiler->operands, compiler->operandCapacity * sizeof(int32_t));
+	}
+	compiler->operands[compiler->operandSize++] = operand;
+}
+
+/**
+ * Pushes a pending work, doubling the capacity of the stack if it's full,
+ * and returns it (which is valid until the next push).
+ */
+static Task * _pushTask(BytecodeCompiler * compiler, const TaskKind kind, const void * node, const int32_t target) {
+	if (compiler->taskSize == compiler->taskCapacity) {
+		compiler->taskCapacity *= 2;
+		compiler->tasks = realloc(compiler->tasks, compiler->taskCapacity * sizeof(Task));
+	}
+	compiler->tasks[compiler->taskSize] = (Task) {
+		.node = node,
+		.target = target,
+		.index = 0,
+		.mark = 0,
+		.kind = kind,
+		.jumpIf = false
+	};
+	return &compiler->tasks[compiler->taskSize++];
+}
+
+/**
+ * The index of a string of the bytecode. The strings of the literals are
+ * interned by the frontend, so each one is stored as many times as it's used.
+ */
+static int32_t _string(BytecodeCompiler * compiler, const char * string) {
+	Bytecode * bytecode = compiler->bytecode;
+	if (bytecode->stringSize == bytecode->stringCapacity) {
+		bytecode->stringCapacity *= 2;
+		bytecode->strings = realloc(bytecode->strings, bytecode->stringCapacity * sizeof(const char *));
+	}
+	bytecode->strings[bytecode->stringSize] = string;
+	return bytecode->stringSize++;
+}
+
+/**
+ * Evaluates a string expression into a register.
+ */
+static void _stringInto(BytecodeCompiler * compiler, const StringExpression * stringExpression, const int32_t target) {
+	switch (stringExpression->type) {
+		case STRING_LITERAL_T:
+			_emit(compiler, LOAD_STRING_OP, target, _string(compiler, stringExpression->value), 0);
+			break;
+		case VAR_STRING_T:
+			_variableInto(compiler, stringExpression->slot, target);
+			break;
+		case FUNC_CALL_STRING_T:
+			_call(compiler, stringExpression->functionCall, target);
+			break;
+	}
+}
+
+/**
+ * A new temporary register, which is free again when the instruction (or
+ * the expression) that asked for it is lowered.
+ */
+static int32_t _temporary(BytecodeCompiler * compiler) {
+	const int32_t temporary = compiler->top++;
+	if (compiler->function->registers < compiler->top) {
+		compiler->function->registers = compiler->top;
+	}
+	return temporary;
+}
+
+/**
+ * Copies a variable into a register: straight from the current frame, or
+ * through the static links.
+ */
+static void _variableInto(BytecodeCompiler * compiler, const Slot slot, const int32_t target) {
+	if (slot.depth != 0) {
+		_emit(compiler, LOAD_OUTER_OP, target, slot.depth, slot.index);
+	}
+	else if ((int32_t) slot.index != target) {
+		_emit(compiler, MOVE_OP, target, slot.index, 0);
+	}
+}
+
+/* PUBLIC FUNCTIONS */
+
+Bytecode * createBytecode(const Program * program, const CallGraph * callGraph, const RangeAnalysis * rangeAnalysis) {
+	Bytecode * bytecode = calloc(1, sizeof(Bytecode));
+	bytecode->size = callGraph->size + 1;
+	bytecode->functions = calloc(bytecode->size, sizeof(BytecodeFunction));
+	bytecode->strings = malloc(_initialCapacity * sizeof(const char *));
+	bytecode->stringCapacity = _initialCapacity;
+	BytecodeCompiler compiler = {
+		.bytecode = bytecode,
+		.callGraph = callGraph,
+		.rangeAnalysis = rangeAnalysis,
+		.function = NULL,
+		.program = false,
+		.variables = 0,
+		.top = 0,
+		.line = 0,
+		.tasks = malloc(_initialCapacity * sizeof(Task)),
+		.taskSize = 0,
+		.taskCapacity = _initialCapacity,
+		.operands = malloc(_initialCapacity * sizeof(int32_t)),
+		.operandSize = 0,
+		.operandCapacity = _initialCapacity,
+		.chains = malloc(_initialCapacity * sizeof(int32_t)),
+		.chainSize = 0,
+		.chainCapacity = _initialCapacity,
+		.calls = calloc(_initialCapacity, sizeof(CallEntry)),
+		.callSize = 0,
+		.callCapacity = _initialCapacity,
+		.pending = malloc(_initialCapacity * sizeof(const ArithmeticExpression *)),
+		.pendingCapacity = _initialCapacity,
+		.succeed = true
+	};
+	// The program is lowered first, and then each function in pre-order, so
+	// the line of a function is known (from its declaration) before it's
+	// lowered.
+	BytecodeFunction * programFunction = &bytecode->functions[callGraph->size];
+	programFunction->name = NULL;
+	programFunction->level = 0;
+	programFunction->registers = program->frameSize;
+	_function(&compiler, callGraph->size, NULL, program->block);
+	for (unsigned int k = 0; k < callGraph->size; ++k) {
+		const CallGraphNode * node = &callGraph->nodes[k];
+		bytecode->functions[k].name = node->function->functionName;
+		bytecode->functions[k].level = node->level;
+		bytecode->functions[k].registers = node->function->frameSize;
+		_function(&compiler, k, node->function, node->function->block);
+	}
+	free(compiler.tasks);
+	free(compiler.operands);
+	free(compiler.chains);
+	free(compiler.calls);
+	free(compiler.pending);
+	if (!compiler.succeed) {
+		destroyBytecode(bytecode);
+		return NULL;
+	}
+	return bytecode;
+}
+
+void destroyBytecode(Bytecode * bytecode) {
+	if (bytecode != NULL) {
+		for (unsigned int k = 0; k < bytecode->size; ++k) {
+			free(bytecode->functions[k].code);
+			free(bytecode->functions[k].lines);
+			free(bytecode->functions[k].parameters);
+		}
+		free(bytecode->functions);
+		free(bytecode->strings);
+		free(bytecode);
+	}
+}
+
+const BytecodeFunction * bytecodeProgramOf(const Bytecode * bytecode) {
+	return &bytecode->functions[bytecode->size - 1];
+}
+
+void disassembleBytecode(const Bytecode * bytecode, FILE * output) {
+	for (unsigned int k = 0; k < bytecode->size; ++k) {
+		// The program is listed first, as it's where the execution begins.
+		const BytecodeFunction * function = &bytecode->functions[(k + bytecode->size - 1) % bytecode->size];
+		if (function->name == NULL) {
+			fprintf(output, "PROGRAM: %u registers, %u instructions.\n", function->registers, function->size);
+		}
+		else {
+			fprintf(output, "\nFUNCTION %s (line %u, level %u): %u parameters, %u registers, %u instructions.\n",
+				function->name, function->line, function->level, function->parameterCount, function->registers, function->size);
+		}
+		for (unsigned int pc = 0; pc < function->size; ++pc) {
+			const BytecodeInstruction * instruction = &function->code[pc];
+			const int32_t operands[] = {instruction->a, instruction->b, instruction->c};
+			const char * kinds = _operandKinds[instruction->operation];
+			fprintf(output, "    %04u  %-24s", pc, _names[instruction->operation]);
+			for (unsigned int o = 0; kinds[o] != '\0'; ++o) {
+				fputs(o == 0 ? "" : ", ", output);
+				switch (kinds[o]) {
+					case 'r': fprintf(output, "r%d", operands[o]); break;
+					case 's': _printString(bytecode->strings[operands[o]], output); break;
+					case 'd': fprintf(output, "^%d", operands[o]); break;
+					case 'f': fputs(bytecode->functions[operands[o]].name, output); break;
+					case 't': fprintf(output, "@%04d", operands[o]); break;
+					default: fprintf(output, "%d", operands[o]); break;
+				}
+			}
+			fprintf(output, "  ; line %u\n", function->lines[pc]);
+		}
+	}
+}
@@ -0,0 +1,156 @@
+#ifndef BYTECODE_HEADER
+#define BYTECODE_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Hash.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "../semantic-analysis/CallGraph.h"
+#include "../semantic-analysis/RangeAnalysis.h"
+#include "Calculator.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializeBytecodeModule();
+
+/** Shutdown module's internal state. */
+void shutdownBytecodeModule();
+
+/**
+ * A register-based bytecode, lowered from the AST of a whole program, and
+ * run by the virtual machine (see "VirtualMachine.h").
+ *
+ * Every function (and the program) has its own code, and a frame of
+ * registers: the first ones are the slots of its variables (see
+ * "AbstractSyntaxTree.h"), and the rest hold temporary values. So a variable
+ * of the current frame is read straight from its register, and only the
+ * variables of the enclosing frames need a load (or a store) through the
+ * static links. The operands of an instruction are registers, immediate
+ * integers, indexes of strings, functions, or targets of jumps, depending on
+ * its operation.
+ *
+ * The conditions of "IF" and "AND"/"OR" are lowered into jumps (comparing
+ * and jumping in a single instruction when possible), and "FOR" keeps its
+ * counter and its last value in two temporary registers, so an iteration is
+ * a single instruction. The arithmetic operations whose checks are removed
+ * by the range analysis (see "RangeAnalysis.h") become unchecked ones.
+ */
+
+/**
+ * The operations of the bytecode. The operands of each one are "a", "b" and
+ * "c", in that order ("r" is a register, "i" an immediate integer, "s" the
+ * index of a string, "d" a depth, "f" the index of a function, and "t" the
+ * target of a jump).
+ */
+typedef enum {
+	MOVE_OP,                    // r r: a = b
+	LOAD_INT_OP,                // r i: a = b
+	LOAD_STRING_OP,             // r s: a = strings[b]
+	LOAD_OUTER_OP,              // r d i: a = register c of the frame "b" links above
+	STORE_OUTER_OP,             // r d i: register c of the frame "b" links above = a
+	ADD_OP,                     // r r r: a = b + c (checked)
+	SUB_OP,                     // r r r: a = b - c (checked)
+	MUL_OP,                     // r r r: a = b * c (checked)
+	DIV_OP,                     // r r r: a = b / c (checked)
+	ADD_IMMEDIATE_OP,           // r r i: a = b + c (checked)
+	UNCHECKED_ADD_OP,           // r r r: a = b + c
+	UNCHECKED_SUB_OP,           // r r r: a = b - c
+	UNCHECKED_MUL_OP,           // r r r: a = b * c
+	UNCHECKED_DIV_OP,           // r r r: a = b / c
+	UNCHECKED_ADD_IMMEDIATE_OP, // r r i: a = b + c
+	LESS_THAN_OP,               // r r r: a = b < c
+	LESS_EQUALS_OP,             // r r r: a = b <= c
+	GREATER_THAN_OP,            // r r r: a = b > c
+	GREATER_EQUALS_OP,          // r r r: a = b >= c
+	EQUALS_OP,                  // r r r: a = b == c
+	NOT_EQUALS_OP,              // r r r: a = b != c
+	NOT_OP,                     // r r: a = !b
+	JUMP_OP,                    // t: jumps to a
+	JUMP_IF_TRUE_OP,            // t r: jumps to a if b
+	JUMP_IF_FALSE_OP,           // t r: jumps to a if !b
+	JUMP_IF_LESS_THAN_OP,       // t r r: jumps to a if b < c
+	JUMP_IF_LESS_EQUALS_OP,     // t r r: jumps to a if b <= c
+	JUMP_IF_GREATER_THAN_OP,    // t r r: jumps to a if b > c
+	JUMP_IF_GREATER_EQUALS_OP,  // t r r: jumps to a if b >= c
+	JUMP_IF_EQUALS_OP,          // t r r: jumps to a if b == c
+	JUMP_IF_NOT_EQUALS_OP,      // t r r: jumps to a if b != c
+	LOOP_OP,                    // r r t: if a < b, increments a and jumps to c
+	CALL_OP,                    // r f r: a = the function b, called with the arguments from c on
+	RETURN_OP,                  // r: returns a
+	PRINT_INT_OP,               // r: prints a
+	PRINT_BOOL_OP,              // r: prints a
+	PRINT_STRING_OP,            // r: prints a
+	HALT_OP                     // ends the program
+} BytecodeOperation;
+
+/** The amount of operations of the bytecode. */
+#define BYTECODE_OPERATIONS (HALT_OP + 1)
+
+/**
+ * An instruction of the bytecode.
+ */
+typedef struct {
+	int32_t operation;
+	int32_t a;
+	int32_t b;
+	int32_t c;
+} BytecodeInstruction;
+
+/**
+ * The code of a function (or of the program, whose name is NULL), the line
+ * of each instruction, the amount of registers of its frame, and the
+ * registers of its parameters (in order). The level is the one of the call
+ * graph (see "CallGraph.h").
+ */
+typedef struct {
+	const char * name;
+	unsigned int line;
+	unsigned int level;
+	BytecodeInstruction * code;
+	unsigned int * lines;
+	unsigned int size;
+	unsigned int capacity;
+	unsigned int registers;
+	unsigned int * parameters;
+	unsigned int parameterCount;
+} BytecodeFunction;
+
+/**
+ * The bytecode of a program: its functions, indexed as the nodes of the call
+ * graph, followed by the program itself, and the strings of its literals.
+ */
+typedef struct {
+	BytecodeFunction * functions;
+	unsigned int size;
+	const char ** strings;
+	unsigned int stringSize;
+	unsigned int stringCapacity;
+	unsigned int instructions;
+} Bytecode;
+
+/**
+ * Lowers a program into bytecode, given its call graph and the checks that
+ * its arithmetic operations need (see "RangeAnalysis.h"). Returns NULL if a
+ * call can't be resolved.
+ */
+Bytecode * createBytecode(const Program * program, const CallGraph * callGraph, const RangeAnalysis * rangeAnalysis);
+
+/**
+ * Destroy a bytecode.
+ */
+void destroyBytecode(Bytecode * bytecode);
+
+/**
+ * The function of the program itself, where the execution begins.
+ */
+const BytecodeFunction * bytecodeProgramOf(const Bytecode * bytecode);
+
+/**
+ * Prints a human-readable listing of every function of a bytecode.
+ */
+void disassembleBytecode(const Bytecode * bytecode, FILE * output);
+
+#endif
@@ -1,136 +1,629 @@
-// #include "Calculator.h"
-
-// /* MODULE INTERNAL STATE */
-
-// static Logger * _logger = NULL;
-
-// void initializeCalculatorModule() {
-// 	_logger = createLogger("Calculator");
-// }
-
-// void shutdownCalculatorModule() {
-// 	if (_logger != NULL) {
-// 		destroyLogger(_logger);
-// 	}
-// }
-
-// /** PRIVATE FUNCTIONS */
-
-// static BinaryOperator _expressionTypeToBinaryOperator(const ExpressionType type);
-// static ComputationResult _invalidBinaryOperator(const int x, const int y);
-// static ComputationResult _invalidComputation();
-
-// /**
-//  * Converts and expression type to the proper binary operator. If that's not
-//  * possible, returns a binary operator that always returns an invalid
-//  * computation result.
-//  */
-// static BinaryOperator _expressionTypeToBinaryOperator(const ExpressionType type) {
-// 	switch (type) {
-// 		case ADDITION: return add;
-// 		case DIVISION: return divide;
-// 		case MULTIPLICATION: return multiply;
-// 		case SUBTRACTION: return subtract;
-// 		default:
-// 			logError(_logger, "The specified expression type cannot be converted into character: %d", type);
-// 			return _invalidBinaryOperator;
-// 	}
-// }
-
-// /**
-//  * A binary operator that always returns an invalid computation result.
-//  */
-// static ComputationResult _invalidBinaryOperator(const int x, const int y) {
-// 	return _invalidComputation();
-// }
-
-// /**
-//  * A computation that always returns an invalid result.
-//  */
-// static ComputationResult _invalidComputation() {
-// 	ComputationResult computationResult = {
-// 		.succeed = false,
-// 		.value = 0
-// 	};
-// 	return computationResult;
-// }
-
-// /** PUBLIC FUNCTIONS */
-
-// ComputationResult add(const int leftAddend, const int rightAddend) {
-// 	ComputationResult computationResult = {
-// 		.succeed = true,
-// 		.value = leftAddend + rightAddend
-// 	};
-// 	return computationResult;
-// }
-
-// ComputationResult divide(const int dividend, const int divisor) {
-// 	const int sign = dividend < 0 ? -1 : +1;
-// 	const boolean divisionByZero = divisor == 0 ? true : false;
-// 	if (divisionByZero) {
-// 		logError(_logger, "The divisor cannot be zero (the computation was %d/%d).", dividend, divisor);
-// 	}
-// 	ComputationResult computationResult = {
-// 		.succeed = divisionByZero ? false : true,
-// 		.value = divisionByZero ? (sign * INT_MAX) : (dividend / divisor)
-// 	};
-// 	return computationResult;
-// }
-
-// ComputationResult multiply(const int multiplicand, const int multiplier) {
-// 	ComputationResult computationResult = {
-// 		.succeed = true,
-// 		.value = multiplicand * multiplier
-// 	};
-// 	return computationResult;
-// }
-
-// ComputationResult subtract(const int minuend, const int subtract) {
-// 	ComputationResult computationResult = {
-// 		.succeed = true,
-// 		.value = minuend - subtract
-// 	};
-// 	return computationResult;
-// }
-
-// ComputationResult computeConstant(Constant * constant) {
-// 	ComputationResult computationResult = {
-// 		.succeed = true,
-// 		.value = constant->value
-// 	};
-// 	return computationResult;
-// }
-
-// ComputationResult computeExpression(Expression * expression) {
-// 	switch (expression->type) {
-// 		case ADDITION:
-// 		case DIVISION:
-// 		case MULTIPLICATION:
-// 		case SUBTRACTION:
-// 			ComputationResult leftResult = computeExpression(expression->leftExpression);
-// 			ComputationResult rightResult = computeExpression(expression->rightExpression);
-// 			if (leftResult.succeed && rightResult.succeed) {
-// 				BinaryOperator binaryOperator = _expressionTypeToBinaryOperator(expression->type);
-// 				return binaryOperator(leftResult.value, rightResult.value);
-// 			}
-// 			else {
-// 				return _invalidComputation();
-// 			}
-// 		case FACTOR:
-// 			return computeFactor(expression->factor);
-// 		default:
-// 			return _invalidComputation();
-// 	}
-// }
-
-// ComputationResult computeFactor(Factor * factor) {
-// 	switch (factor->type) {
-// 		case CONSTANT:
-// 			return computeConstant(factor->constant);
-// 		case EXPRESSION:
-// 			return computeExpression(factor->expression);
-// 		default:
-// 			return _invalidComputation();
-// 	}
-// }
+#include "Calculator.h"
+
+/**
+ * The kinds of pending work of an execution. Evaluating an expression pushes
+ * its value in the stack of values, and applying an operator pops its
+ * operands and pushes its result.
+ */
+typedef enum {
+	APPLY_AND,
+	APPLY_ARITHMETIC,
+	APPLY_COMPARISON,
+	APPLY_NOT,
+	APPLY_OR,
+	BRANCH,
+	DISCARD,
+	EVALUATE_ARGUMENTS,
+	EVALUATE_ARITHMETIC,
+	EVALUATE_BOOLEAN,
+	EVALUATE_EXPRESSION,
+	EVALUATE_STRING,
+	EXECUTE_INSTRUCTIONS,
+	INVOKE,
+	ITERATE,
+	PRINT_VALUE,
+	RETURN_DEFAULT,
+	RETURN_VALUE,
+	START_LOOP,
+	STORE
+} TaskKind;
+
+/**
+ * A pending work (i.e., a continuation) over a node. An iteration also
+ * carries the next value of the variable of its loop, and the last one. A
+ * print carries the type of its expression.
+ */
+typedef struct {
+	const void * node;
+	int64_t current;
+	int end;
+	uint8_t kind;
+	uint8_t type;
+} Task;
+
+/**
+ * The frame of a call (or of the program): where its slots begin in the
+ * stack of variables, the frame of the enclosing function, the level of the
+ * function (see "CallGraph.h"), and the line of its current instruction.
+ */
+typedef struct {
+	size_t base;
+	unsigned int staticLink;
+	unsigned int level;
+	unsigned int line;
+} Frame;
+
+/**
+ * The state of an execution: the stacks of pending work, of values being
+ * computed, of variables (i.e., the slots of every frame), and of frames.
+ */
+typedef struct {
+	const CallGraph * callGraph;
+	FILE * output;
+	Task * tasks;
+	size_t taskSize;
+	size_t taskCapacity;
+	Value * values;
+	size_t valueSize;
+	size_t valueCapacity;
+	Value * variables;
+	size_t variableSize;
+	size_t variableCapacity;
+	Frame * frames;
+	unsigned int frameSize;
+	unsigned int frameCapacity;
+	ComputationResult result;
+} Interpreter;
+
+/* MODULE INTERNAL STATE */
+
+// The initial capacity of every stack of an execution.
+static const size_t _initialCapacity = 256;
+
+// The deepest chain of calls, so a runaway recursion stops the program
+// instead of exhausting the memory.
+static const unsigned int _maximumCallDepth = 1 << 20;
+
+static Logger * _logger = NULL;
+
+void initializeCalculatorModule() {
+	_logger = createLogger("Calculator");
+}
+
+void shutdownCalculatorModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+static void _applyArithmetic(Interpreter * interpreter, const ArithmeticExpression * arithmeticExpression);
+static boolean _compare(const int left, const int type, const int right);
+static void _evaluateArithmetic(Interpreter * interpreter, const ArithmeticExpression * arithmeticExpression);
+static void _evaluateBoolean(Interpreter * interpreter, const BooleanExpression * booleanExpression);
+static void _evaluateString(Interpreter * interpreter, const StringExpression * stringExpression);
+static void _execute(Interpreter * interpreter, const Instruction * instruction);
+static void _fail(Interpreter * interpreter, const char * error);
+static void _invoke(Interpreter * interpreter, const FunctionCall * functionCall);
+static Value _pop(Interpreter * interpreter);
+static void _popFrame(Interpreter * interpreter);
+static void _print(Interpreter * interpreter, const Value value, const int type);
+static void _push(Interpreter * interpreter, const Value value);
+static void _pushFrame(Interpreter * interpreter, const unsigned int frameSize, const unsigned int staticLink, const unsigned int level);
+static void _pushTask(Interpreter * interpreter, const TaskKind kind, const void * node);
+static void _return(Interpreter * interpreter);
+static void _run(Interpreter * interpreter);
+static Value * _variable(Interpreter * interpreter, const Slot slot);
+
+/**
+ * Applies an arithmetic operator to the two values on top of the stack. The
+ * exact result is computed with 64 bits, so an overflow is detected before
+ * it's truncated into an "int".
+ */
+static void _applyArithmetic(Interpreter * interpreter, const ArithmeticExpression * arithmeticExpression) {
+	const int64_t right = _pop(interpreter).integer;
+	const int64_t left = _pop(interpreter).integer;
+	int64_t result = 0;
+	switch (arithmeticExpression->type) {
+		case ADD_T:
+			result = left + right;
+			break;
+		case SUB_T:
+			result = left - right;
+			break;
+		case MUL_T:
+			result = left * right;
+			break;
+		case DIV_T:
+			if (right == 0) {
+				_fail(interpreter, "Division by zero");
+				return;
+			}
+			result = left / right;
+			break;
+		default:
+			break;
+	}
+	if (result < INT_MIN || INT_MAX < result) {
+		_fail(interpreter, "Integer overflow");
+		return;
+	}
+	_push(interpreter, (Value) {.integer = (int) result});
+}
+
+/**
+ * Compares two integers with the type of a compare operator.
+ */
+static boolean _compare(const int left, const int type, const int right) {
+	switch (type) {
+		case GREATER_THAN_T: return left > right;
+		case LESS_THAN_T: return left < right;
+		case EQUALS_EQUALS_T: return left == right;
+		case NOT_EQUALS_T: return left != right;
+		case GREATER_EQUALS_T: return left >= right;
+		case LESS_EQUALS_T: return left <= right;
+		default: return false;
+	}
+}
+
+/**
+ * Evaluates an arithmetic expression: a leaf is pushed right away, and an
+ * operator evaluates its left operand, then the right one, and then applies
+ * itself.
+ */
+static void _evaluateArithmetic(Interpreter * interpreter, const ArithmeticExpression * arithmeticExpression) {
+	switch (arithmeticExpression->type) {
+		case INT_LITERAL_T:
+			_push(interpreter, (Value) {.integer = arithmeticExpression->value});
+			break;
+		case VAR_ARITH_T:
+			_push(interpreter, *_variable(interpreter, arithmeticExpression->slot));
+			break;
+		case FUNC_CALL_ARITH_T:
+			_pushTask(interpreter, INVOKE, arithmeticExpression->functionCall);
+			_pushTask(interpreter, EVALUATE_ARGUMENTS, arithmeticExpression->functionCall->arguments);
+			break;
+		default:
+			_pushTask(interpreter, APPLY_ARITHMETIC, arithmeticExpression);
+			_pushTask(interpreter, EVALUATE_ARITHMETIC, arithmeticExpression->right);
+			_pushTask(interpreter, EVALUATE_ARITHMETIC, arithmeticExpression->left);
+			break;
+	}
+}
+
+/**
+ * Evaluates a boolean expression. "AND" and "OR" evaluate their right
+ * operand only if their left one doesn't decide the result.
+ */
+static void _evaluateBoolean(Interpreter * interpreter, const BooleanExpression * booleanExpression) {
+	switch (booleanExpression->type) {
+		case BOOL_LITERAL_T:
+			_push(interpreter, (Value) {.boolean = booleanExpression->value ? true : false});
+			break;
+		case VAR_BOOL_T:
+			_push(interpreter, *_variable(interpreter, booleanExpression->slot));
+			break;
+		case FUNC_CALL_BOOL_T:
+			_pushTask(interpreter, INVOKE, booleanExpression->functionCall);
+			_pushTask(interpreter, EVALUATE_ARGUMENTS, booleanExpression->functionCall->arguments);
+			break;
+		case AND_T:
+			_pushTask(interpreter, APPLY_AND, booleanExpression);
+			_pushTask(interpreter, EVALUATE_BOOLEAN, booleanExpression->left);
+			break;
+		case OR_T:
+			_pushTask(interpreter, APPLY_OR, booleanExpression);
+			_pushTask(interpreter, EVALUATE_BOOLEAN, booleanExpression->left);
+			break;
+		case NOT_T:
+			_pushTask(interpreter, APPLY_NOT, booleanExpression);
+			_pushTask(interpreter, EVALUATE_BOOLEAN, booleanExpression->notExpr);
+			break;
+		case COMPARISON_T:
+			_pushTask(interpreter, APPLY_COMPARISON, booleanExpression);
+			_pushTask(interpreter, EVALUATE_ARITHMETIC, booleanExpression->rightArith);
+			_pushTask(interpreter, EVALUATE_ARITHMETIC, booleanExpression->leftArith);
+			break;
+	}
+}
+
+/**
+ * Evaluates a string expression.
+ */
+static void _evaluateString(Interpreter * interpreter, const StringExpression * stringExpression) {
+	switch (stringExpression->type) {
+		case STRING_LITERAL_T:
+			_push(interpreter, (Value) {.string = stringExpression->value});
+			break;
+		case VAR_STRING_T:
+			_push(interpreter, *_variable(interpreter, stringExpression->slot));
+			break;
+		case FUNC_CALL_STRING_T:
+			_pushTask(interpreter, INVOKE, stringExpression->functionCall);
+			_pushTask(interpreter, EVALUATE_ARGUMENTS, stringExpression->functionCall->arguments);
+			break;
+	}
+}
+
+/**
+ * Executes an instruction: pushes what to do with the values of its
+ * expressions, and then their evaluations. A function declaration does
+ * nothing, because the calls are resolved by the call graph.
+ */
+static void _execute(Interpreter * interpreter, const Instruction * instruction) {
+	++interpreter->result.instructions;
+	interpreter->frames[interpreter->frameSize - 1].line = instruction->line;
+	switch (instruction->type) {
+		case DECLARATION_INSTRUCTION_T:
+			_pushTask(interpreter, STORE, instruction->declaration->assignation);
+			_pushTask(interpreter, EVALUATE_EXPRESSION, instruction->declaration->assignation->expression);
+			break;
+		case ASSIGNATION_INSTRUCTION_T:
+			_pushTask(interpreter, STORE, instruction->assignation);
+			_pushTask(interpreter, EVALUATE_EXPRESSION, instruction->assignation->expression);
+			break;
+		case EXPRESSION_INSTRUCTION_T:
+			_pushTask(interpreter, DISCARD, NULL);
+			_pushTask(interpreter, EVALUATE_EXPRESSION, instruction->expression);
+			break;
+		case PRINT_INSTRUCTION_T:
+			_pushTask(interpreter, PRINT_VALUE, NULL);
+			interpreter->tasks[interpreter->taskSize - 1].type = instruction->print->expression->type;
+			_pushTask(interpreter, EVALUATE_EXPRESSION, instruction->print->expression);
+			break;
+		case FUNCTION_CALL_INSTRUCTION_T:
+			_pushTask(interpreter, DISCARD, NULL);
+			_pushTask(interpreter, INVOKE, instruction->functionCall);
+			_pushTask(interpreter, EVALUATE_ARGUMENTS, instruction->functionCall->arguments);
+			break;
+		case RETURN_STATEMENT_INSTRUCTION_T:
+			_pushTask(interpreter, RETURN_VALUE, NULL);
+			_pushTask(interpreter, EVALUATE_EXPRESSION, instruction->returnStatement->expression);
+			break;
+		case CONDITIONAL_INSTRUCTION_T:
+			_pushTask(interpreter, BRANCH, instruction->conditional);
+			_pushTask(interpreter, EVALUATE_BOOLEAN, instruction->conditional->condition);
+			break;
+		case LOOP_INSTRUCTION_T:
+			_pushTask(interpreter, START_LOOP, instruction->loop);
+			_pushTask(interpreter, EVALUATE_ARITHMETIC, instruction->loop->end);
+			_pushTask(interpreter, EVALUATE_ARITHMETIC, instruction->loop->start);
+			break;
+		default:
+			break;
+	}
+}
+
+/**
+ * Stops the execution with an error, at the line of the current instruction.
+ * The output printed so far is flushed first, so it precedes the error.
+ */
+static void _fail(Interpreter * interpreter, const char * error) {
+	fflush(interpreter->output);
+	logError(_logger, "%s (on line %u).", error, interpreter->frames[interpreter->frameSize - 1].line);
+	interpreter->result.succeed = false;
+}
+
+/**
+ * Calls a function, whose arguments are on top of the stack of values: they
+ * are moved into the slots of its parameters, in a new frame linked to the
+ * frame of the enclosing function (i.e., the innermost frame of a lower
+ * level). The end of its block returns the default value. The parser rejects
+ * a call with the wrong amount of arguments, but a loaded AST could have one,
+ * so the arguments of the call itself are the ones on the stack.
+ */
+static void _invoke(Interpreter * interpreter, const FunctionCall * functionCall) {
+	unsigned int arguments = 0;
+	for (const Arguments * node = functionCall->arguments; node != NULL; node = node->next) {
+		++arguments;
+	}
+	const CallGraphNode * callee = calleeOf(interpreter->callGraph, functionCall);
+	if (callee == NULL) {
+		_fail(interpreter, "Unknown function");
+		return;
+	}
+	if (interpreter->frameSize == _maximumCallDepth) {
+		_fail(interpreter, "Too many nested calls");
+		return;
+	}
+	const Function * function = callee->function;
+	unsigned int staticLink = interpreter->frameSize - 1;
+	while (callee->level <= interpreter->frames[staticLink].level) {
+		staticLink = interpreter->frames[staticLink].staticLink;
+	}
+	unsigned int parameters = 0;
+	for (const Parameters * node = function->parameters; node != NULL; node = node->next) {
+		++parameters;
+	}
+	if (arguments != parameters) {
+		_fail(interpreter, "Wrong amount of arguments");
+		return;
+	}
+	const unsigned int line = interpreter->frames[interpreter->frameSize - 1].line;
+	_pushFrame(interpreter, function->frameSize, staticLink, callee->level);
+	interpreter->frames[interpreter->frameSize - 1].line = line;
+	Value * slots = &interpreter->variables[interpreter->frames[interpreter->frameSize - 1].base];
+	const Value * values = &interpreter->values[interpreter->valueSize - arguments];
+	for (const Parameters * parameters = function->parameters; parameters != NULL; parameters = parameters->next) {
+		slots[parameters->parameter->slot.index] = *values++;
+	}
+	interpreter->valueSize -= arguments;
+	_pushTask(interpreter, RETURN_DEFAULT, function);
+	_pushTask(interpreter, EXECUTE_INSTRUCTIONS, function->block->instructions);
+	++interpreter->result.calls;
+}
+
+/**
+ * Pops the value on top of the stack.
+ */
+static Value _pop(Interpreter * interpreter) {
+	return interpreter->values[--interpreter->valueSize];
+}
+
+/**
+ * Pops the frame of the current call, and its slots.
+ */
+static void _popFrame(Interpreter * interpreter) {
+	interpreter->variableSize = interpreter->frames[--interpreter->frameSize].base;
+}
+
+/**
+ * Prints a value of a type, in its own line. The booleans are printed as
+ * their literals.
+ */
+static void _print(Interpreter * interpreter, const Value value, const int type) {
+	switch (type) {
+		case ARITHMETIC_EXPR_T:
+			fprintf(interpreter->output, "%d\n", value.integer);
+			break;
+		case BOOLEAN_EXPR_T:
+			fputs(value.boolean ? "TRUE\n" : "FALSE\n", interpreter->output);
+			break;
+		case STRING_EXPR_T:
+			fputs(value.string == NULL ? "" : value.string, interpreter->output);
+			fputc('\n', interpreter->output);
+			break;
+	}
+}
+
+/**
+ * Pushes a value, doubling the capacity of the stack if it's full.
+ */
+static void _push(Interpreter * interpreter, const Value value) {
+	if (interpreter->valueSize == interpreter->valueCapacity) {
+		interpreter->valueCapacity *= 2;
+		interpreter->values = realloc(interpreter->values, interpreter->valueCapacity * sizeof(Value));
+	}
+	interpreter->values[interpreter->valueSize++] = value;
+}
+
+/**
+ * Pushes a frame, with its slots zeroed (i.e., zero, false, or NULL).
+ */
+static void _pushFrame(Interpreter * interpreter, const unsigned int frameSize, const unsigned int staticLink, const unsigned int level) {
+	if (interpreter->frameSize == interpreter->frameCapacity) {
+		interpreter->frameCapacity *= 2;
+		interpreter->frames = realloc(interpreter->frames, interpreter->frameCapacity * sizeof(Frame));
+	}
+	while (interpreter->variableCapacity < interpreter->variableSize + frameSize) {
+		interpreter->variableCapacity *= 2;
+		interpreter->variables = realloc(interpreter->variables, interpreter->variableCapacity * sizeof(Value));
+	}
+	interpreter->frames[interpreter->frameSize++] = (Frame) {
+		.base = interpreter->variableSize,
+		.staticLink = staticLink,
+		.level = level,
+		.line = 0
+	};
+	memset(&interpreter->variables[interpreter->variableSize], 0, frameSize * sizeof(Value));
+	interpreter->variableSize += frameSize;
+}
+
+/**
+ * Pushes a pending work, doubling the capacity of the stack if it's full.
+ */
+static void _pushTask(Interpreter * interpreter, const TaskKind kind, const void * node) {
+	if (interpreter->taskSize == interpreter->taskCapacity) {
+		interpreter->taskCapacity *= 2;
+		interpreter->tasks = realloc(interpreter->tasks, interpreter->taskCapacity * sizeof(Task));
+	}
+	interpreter->tasks[interpreter->taskSize++] = (Task) {
+		.node = node,
+		.current = 0,
+		.end = 0,
+		.kind = kind,
+		.type = 0
+	};
+}
+
+/**
+ * Returns the value on top of the stack from the current call: drops the
+ * pending work of the call (up to the end of its block) and its frame. A
+ * return outside of any function ends the program.
+ */
+static void _return(Interpreter * interpreter) {
+	const Value value = _pop(interpreter);
+	while (0 < interpreter->taskSize) {
+		if (interpreter->tasks[--interpreter->taskSize].kind == RETURN_DEFAULT) {
+			_popFrame(interpreter);
+			_push(interpreter, value);
+			return;
+		}
+	}
+}
+
+/**
+ * Runs the pending work until there's nothing left, or until an error.
+ */
+static void _run(Interpreter * interpreter) {
+	while (0 < interpreter->taskSize && interpreter->result.succeed) {
+		const Task task = interpreter->tasks[--interpreter->taskSize];
+		switch (task.kind) {
+			case APPLY_AND:
+				if (_pop(interpreter).boolean) {
+					_pushTask(interpreter, EVALUATE_BOOLEAN, ((const BooleanExpression *) task.node)->right);
+				}
+				else {
+					_push(interpreter, (Value) {.boolean = false});
+				}
+				break;
+			case APPLY_ARITHMETIC:
+				_applyArithmetic(interpreter, task.node);
+				break;
+			case APPLY_COMPARISON: {
+				const BooleanExpression * comparison = task.node;
+				const int right = _pop(interpreter).integer;
+				const int left = _pop(interpreter).integer;
+				_push(interpreter, (Value) {.boolean = _compare(left, comparison->op->type, right)});
+				break;
+			}
+			case APPLY_NOT:
+				_push(interpreter, (Value) {.boolean = !_pop(interpreter).boolean});
+				break;
+			case APPLY_OR:
+				if (_pop(interpreter).boolean) {
+					_push(interpreter, (Value) {.boolean = true});
+				}
+				else {
+					_pushTask(interpreter, EVALUATE_BOOLEAN, ((const BooleanExpression *) task.node)->right);
+				}
+				break;
+			case BRANCH: {
+				const Conditional * conditional = task.node;
+				const Block * block = _pop(interpreter).boolean ? conditional->ifBlock : conditional->elseBlock;
+				_pushTask(interpreter, EXECUTE_INSTRUCTIONS, block->instructions);
+				break;
+			}
+			case DISCARD:
+				--interpreter->valueSize;
+				break;
+			case EVALUATE_ARGUMENTS: {
+				const Arguments * arguments = task.node;
+				if (arguments != NULL) {
+					_pushTask(interpreter, EVALUATE_ARGUMENTS, arguments->next);
+					_pushTask(interpreter, EVALUATE_EXPRESSION, arguments->argument->expression);
+				}
+				break;
+			}
+			case EVALUATE_ARITHMETIC:
+				_evaluateArithmetic(interpreter, task.node);
+				break;
+			case EVALUATE_BOOLEAN:
+				_evaluateBoolean(interpreter, task.node);
+				break;
+			case EVALUATE_EXPRESSION: {
+				const Expression * expression = task.node;
+				switch (expression->type) {
+					case ARITHMETIC_EXPR_T:
+						_evaluateArithmetic(interpreter, expression->arithmeticExpression);
+						break;
+					case BOOLEAN_EXPR_T:
+						_evaluateBoolean(interpreter, expression->booleanExpression);
+						break;
+					case STRING_EXPR_T:
+						_evaluateString(interpreter, expression->stringExpression);
+						break;
+				}
+				break;
+			}
+			case EVALUATE_STRING:
+				_evaluateString(interpreter, task.node);
+				break;
+			case EXECUTE_INSTRUCTIONS: {
+				const Instruction * instruction = task.node;
+				if (instruction->next != NULL) {
+					_pushTask(interpreter, EXECUTE_INSTRUCTIONS, instruction->next);
+				}
+				_execute(interpreter, instruction);
+				break;
+			}
+			case INVOKE:
+				_invoke(interpreter, task.node);
+				break;
+			case ITERATE: {
+				const Loop * loop = task.node;
+				if (task.current < task.end) {
+					_pushTask(interpreter, ITERATE, loop);
+					interpreter->tasks[interpreter->taskSize - 1].current = task.current + 1;
+					interpreter->tasks[interpreter->taskSize - 1].end = task.end;
+				}
+				_variable(interpreter, loop->slot)->integer = (int) task.current;
+				_pushTask(interpreter, EXECUTE_INSTRUCTIONS, loop->block->instructions);
+				break;
+			}
+			case PRINT_VALUE:
+				_print(interpreter, _pop(interpreter), task.type);
+				break;
+			case RETURN_DEFAULT: {
+				const Function * function = task.node;
+				_popFrame(interpreter);
+				_push(interpreter, function->returnType->type == STRING_T ? (Value) {.string = ""} : (Value) {.integer = 0});
+				break;
+			}
+			case RETURN_VALUE:
+				_return(interpreter);
+				break;
+			case START_LOOP: {
+				const int end = _pop(interpreter).integer;
+				const int start = _pop(interpreter).integer;
+				if (start <= end) {
+					_pushTask(interpreter, ITERATE, task.node);
+					interpreter->tasks[interpreter->taskSize - 1].current = start;
+					interpreter->tasks[interpreter->taskSize - 1].end = end;
+				}
+				break;
+			}
+			case STORE:
+				*_variable(interpreter, ((const Assignation *) task.node)->slot) = _pop(interpreter);
+				break;
+		}
+	}
+}
+
+/**
+ * The slot of a variable, in the frame "depth" static links above the
+ * current one.
+ */
+static Value * _variable(Interpreter * interpreter, const Slot slot) {
+	unsigned int frame = interpreter->frameSize - 1;
+	for (unsigned int depth = slot.depth; 0 < depth; --depth) {
+		frame = interpreter->frames[frame].staticLink;
+	}
+	return &interpreter->variables[interpreter->frames[frame].base + slot.index];
+}
+
+/* PUBLIC FUNCTIONS */
+
+ComputationResult computeProgram(const Program * program, const CallGraph * callGraph, FILE * output) {
+	Interpreter interpreter = {
+		.callGraph = callGraph,
+		.output = output,
+		.tasks = malloc(_initialCapacity * sizeof(Task)),
+		.taskSize = 0,
+		.taskCapacity = _initialCapacity,
+		.values = malloc(_initialCapacity * sizeof(Value)),
+		.valueSize = 0,
+		.valueCapacity = _initialCapacity,
+		.variables = malloc(_initialCapacity * sizeof(Value)),
+		.variableSize = 0,
+		.variableCapacity = _initialCapacity,
+		.frames = malloc(_initialCapacity * sizeof(Frame)),
+		.frameSize = 0,
+		.frameCapacity = _initialCapacity,
+		.result = {
+			.succeed = true,
+			.instructions = 0,
+			.calls = 0
+		}
+	};
+	_pushFrame(&interpreter, program->frameSize, 0, 0);
+	_pushTask(&interpreter, EXECUTE_INSTRUCTIONS, program->block->instructions);
+	_run(&interpreter);
+	fflush(output);
+	free(interpreter.frames);
+	free(interpreter.variables);
+	free(interpreter.values);
+	free(interpreter.tasks);
+	return interpreter.result;
+}
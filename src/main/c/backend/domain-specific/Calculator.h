@@ -1,53 +1,69 @@
-// #ifndef CALCULATOR_HEADER
-// #define CALCULATOR_HEADER
-
-// /**
-//  * We reuse the types from the AST for convenience, but you should separate
-//  * the layers of the backend and frontend using another group of
-//  * domain-specific models or DTOs (Data Transfer Objects).
-//  */
-// #include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
-// #include "../../shared/Logger.h"
-// #include "../../shared/Type.h"
-// #include <limits.h>
-
-// /** Initialize module's internal state. */
-// void initializeCalculatorModule();
-
-// /** Shutdown module's internal state. */
-// void shutdownCalculatorModule();
-
-// /**
-//  * The result of a computation. It's considered valid only if "succeed" is
-//  * true.
-//  */
-// typedef struct {
-// 	boolean succeed;
-// 	int value;
-// } ComputationResult;
-
-// typedef ComputationResult (*BinaryOperator)(const int, const int);
-
-// /** Arithmetic operations. */
-
-// ComputationResult add(const int leftAddend, const int rightAddend);
-// ComputationResult divide(const int dividend, const int divisor);
-// ComputationResult multiply(const int multiplicand, const int multiplier);
-// ComputationResult subtract(const int minuend, const int subtract);
-
-// /**
-//  * Computes the final value of a mathematical constant.
-//  */
-// ComputationResult computeConstant(Constant * constant);
-
-// /**
-//  * Computes the final value of a mathematical expression.
-//  */
-// ComputationResult computeExpression(Expression * expression);
-
-// /**
-//  * Computes the final value of a mathematical factor.
-//  */
-// ComputationResult computeFactor(Factor * factor);
-
-// #endif
+#ifndef CALCULATOR_HEADER
+#define CALCULATOR_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "../semantic-analysis/CallGraph.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializeCalculatorModule();
+
+/** Shutdown module's internal state. */
+void shutdownCalculatorModule();
+
+/**
+ * An execution engine that runs a program directly over its AST.
+ *
+ * The language is statically typed, so a value doesn't carry its type: the
+ * AST knows it. A string is an immutable C-string interned by the frontend
+ * (the language can't build new ones), so values are copied freely.
+ *
+ * Every call has its own frame, sized by the function, whose slots are the
+ * parameters and the variables of the function. A frame links to the frame
+ * of the enclosing function (i.e., its static link), so the slot of a
+ * variable (see "AbstractSyntaxTree.h") is found by going up "depth" links.
+ * The functions are resolved through the call graph (see "CallGraph.h").
+ *
+ * Neither deep expressions nor deep recursion can overflow the C stack: the
+ * pending work (i.e., the continuations) and the values being computed live
+ * in stacks in heap-memory, and nothing is recursive.
+ *
+ * The semantics are the ones assumed by the analyses (see "RangeAnalysis.h"):
+ * the arithmetic is checked (an overflow or a division by zero stops the
+ * program), "FOR x IN (a, b)" evaluates its bounds once and runs its block
+ * for every "x" from "a" to "b" (both included), and "AND" and "OR" are
+ * evaluated from left to right, short-circuiting. A function that ends
+ * without "RETURN" returns zero, false, or an empty string.
+ */
+
+/**
+ * A value of any type of the language.
+ */
+typedef union {
+	int integer;
+	boolean boolean;
+	const char * string;
+} Value;
+
+/**
+ * The outcome of an execution. It's considered valid only if "succeed" is
+ * true. Otherwise, the execution stopped at an error (already logged).
+ */
+typedef struct {
+	boolean succeed;
+	unsigned long long instructions;
+	unsigned long long calls;
+} ComputationResult;
+
+/**
+ * Runs a program, given its call graph, and prints its output in a stream.
+ */
+ComputationResult computeProgram(const Program * program, const CallGraph * callGraph, FILE * output);
+
+#endif
@@ -0,0 +1,595 @@
+#include "JustInTimeCompiler.h"
+
+/**
+ * Platform dependent native code support: x86-64 machine code, in memory
+ * mapped as executable.
+ *
+ * @see https://man7.org/linux/man-pages/man2/mmap.2.html
+ * @see https://man7.org/linux/man-pages/man2/mprotect.2.html
+ */
+#if defined (__x86_64__) && defined (__linux__)
+#define NATIVE_CODE_IS_SUPPORTED 1
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#else
+#define NATIVE_CODE_IS_SUPPORTED 0
+#endif
+
+/**
+ * The errors that stop native code.
+ */
+typedef enum {
+	OVERFLOW_FAILURE,
+	DIVISION_BY_ZERO_FAILURE,
+	STACK_FAILURE
+} NativeFailure;
+
+/**
+ * A 32-bit displacement of the machine code, to patch once its target is
+ * known: an instruction of the bytecode (for a jump), a function (for a
+ * call), or a failure at a line (for a check).
+ */
+typedef struct {
+	size_t position;
+	unsigned int target;
+	unsigned int line;
+} Patch;
+
+/**
+ * A growable array of patches.
+ */
+typedef struct {
+	Patch * patches;
+	unsigned int size;
+	unsigned int capacity;
+} Patches;
+
+/**
+ * The state of the translation: the machine code emitted so far, where each
+ * function (and each instruction of the current one) begins, and the
+ * patches. The registers of the current frame live below its frame pointer.
+ */
+typedef struct {
+	NativeCode * nativeCode;
+	uint8_t * code;
+	size_t size;
+	size_t capacity;
+	size_t * functions;
+	size_t * instructions;
+	Patches jumps;
+	Patches calls;
+	Patches failures;
+	int32_t frameBytes;
+} NativeCompiler;
+
+/* MODULE INTERNAL STATE */
+
+// The initial capacity of the machine code, and of every array of patches.
+static const unsigned int _initialCapacity = 4096;
+
+// The machine stack assumed when its limit is unknown, and the most that
+// native code may use.
+static const size_t _defaultStack = 8 * 1024 * 1024;
+static const size_t _maximumStack = 64 * 1024 * 1024;
+
+// The machine stack kept free below the limit of native code, for the
+// runtime functions it calls, and for the frames above the virtual machine.
+static const size_t _stackMargin = 256 * 1024;
+
+// The condition codes of x86-64, in the order of the comparisons of the
+// bytecode (i.e., less, less or equal, greater, greater or equal, equal, and
+// not equal).
+static const uint8_t _conditions[] = {0x0C, 0x0E, 0x0F, 0x0D, 0x04, 0x05};
+
+// The errors of each failure, as the virtual machine reports them.
+static const char * const _failures[] = {
+	[OVERFLOW_FAILURE] = "Integer overflow",
+	[DIVISION_BY_ZERO_FAILURE] = "Division by zero",
+	[STACK_FAILURE] = "Too many nested calls"
+};
+
+static Logger * _logger = NULL;
+
+void initializeJustInTimeCompilerModule() {
+	_logger = createLogger("JustInTimeCompiler");
+}
+
+void shutdownJustInTimeCompilerModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+static void _addPatch(Patches * patches, const size_t position, const unsigned int target, const unsigned int line);
+static int _callBytecode(const unsigned int function, const Value * arguments, NativeCode * nativeCode);
+static void _check(NativeCompiler * compiler, const uint8_t condition, const NativeFailure failure, const unsigned int line);
+static void _compileFunction(NativeCompiler * compiler, const unsigned int index);
+static void _compileInstruction(NativeCompiler * compiler, const BytecodeFunction * function, const unsigned int pc);
+static void _emit(NativeCompiler * compiler, const char * bytes, const size_t size);
+static void _emit32(NativeCompiler * compiler, const int32_t value);
+static void _emit64(NativeCompiler * compiler, const uint64_t value);
+static void _failNative(const unsigned int failure, const unsigned int line, NativeCode * nativeCode);
+static boolean _isTranslatable(const BytecodeFunction * function, const CallGraphNode * node);
+static void _jump(NativeCompiler * compiler, const uint8_t condition, const unsigned int target);
+static void _patch(NativeCompiler * compiler, const size_t position, const size_t target);
+static void _slot(NativeCompiler * compiler, const char * opcode, const size_t size, const int32_t reg);
+
+/**
+ * Appends a patch, doubling the capacity of the array if it's full.
+ */
+static void _addPatch(Patches * patches, const size_t position, const unsigned int target, const unsigned int line) {
+	if (patches->size == patches->capacity) {
+		patches->capacity = patches->capacity == 0 ? _initialCapacity : 2 * patches->capacity;
+		patches->patches = realloc(patches->patches, patches->capacity * sizeof(Patch));
+	}
+	patches->patches[patches->size++] = (Patch) {
+		.position = position,
+		.target = target,
+		.line = line
+	};
+}
+
+/**
+ * The trampoline from native code to the virtual machine.
+ */
+static int _callBytecode(const unsigned int function, const Value * arguments, NativeCode * nativeCode) {
+	return nativeCode->callback(nativeCode->context, function, arguments);
+}
+
+/**
+ * Emits a conditional jump to a failure, at a line (see "_jump").
+ */
+static void _check(NativeCompiler * compiler, const uint8_t condition, const NativeFailure failure, const unsigned int line) {
+	const char jump[] = {0x0F, 0x80 | condition};
+	_emit(compiler, jump, 2);
+	_addPatch(&compiler->failures, compiler->size, failure, line);
+	_emit32(compiler, 0);
+}
+
+/**
+ * Translates a function. Its frame holds every register of the function
+ * (8 bytes each, as in the virtual machine), with the non-parameters zeroed,
+ * and the parameters copied from the arguments of the caller (whose address
+ * is in "rdi"). The failures of its checks are stubs after its code, that
+ * call the runtime with the line of the failing instruction.
+ */
+static void _compileFunction(NativeCompiler * compiler, const unsigned int index) {
+	const BytecodeFunction * function = &compiler->nativeCode->bytecode->functions[index];
+	compiler->functions[index] = compiler->size;
+	compiler->frameBytes = (int32_t) ((function->registers * 8 + 15) & ~15u);
+	compiler->jumps.size = 0;
+	compiler->failures.size = 0;
+	// push rbp; mov rbp, rsp; sub rsp, frameBytes
+	_emit(compiler, "\x55\x48\x89\xE5\x48\x81\xEC", 7);
+	_emit32(compiler, compiler->frameBytes);
+	for (unsigned int reg = 0; reg < function->registers; ++reg) {
+		boolean parameter = false;
+		for (unsigned int k = 0; k < function->parameterCount; ++k) {
+			parameter |= function->parameters[k] == reg;
+		}
+		if (!parameter) {
+			// mov qword [rbp + reg], 0
+			_slot(compiler, "\x48\xC7\x85", 3, reg);
+			_emit32(compiler, 0);
+		}
+	}
+	for (unsigned int k = 0; k < function->parameterCount; ++k) {
+		// mov eax, [rdi + 8k]; mov [rbp + parameter], eax
+		_emit(compiler, "\x8B\x87", 2);
+		_emit32(compiler, 8 * k);
+		_slot(compiler, "\x89\x85", 2, function->parameters[k]);
+	}
+	for (unsigned int pc = 0; pc < function->size; ++pc) {
+		compiler->instructions[pc] = compiler->size;
+		_compileInstruction(compiler, function, pc);
+	}
+	for (unsigned int k = 0; k < compiler->jumps.size; ++k) {
+		const Patch * jump = &compiler->jumps.patches[k];
+		_patch(compiler, jump->position, compiler->instructions[jump->target]);
+	}
+	for (unsigned int k = 0; k < compiler->failures.size; ++k) {
+		const Patch * failure = &compiler->failures.patches[k];
+		_patch(compiler, failure->position, compiler->size);
+		// mov edi, failure; mov esi, line; mov rdx, nativeCode; mov rax, _failNative; call rax
+		_emit(compiler, "\xBF", 1);
+		_emit32(compiler, failure->target);
+		_emit(compiler, "\xBE", 1);
+		_emit32(compiler, failure->line);
+		_emit(compiler, "\x48\xBA", 2);
+		_emit64(compiler, (uint64_t) (uintptr_t) compiler->nativeCode);
+		_emit(compiler, "\x48\xB8", 2);
+		_emit64(compiler, (uint64_t) (uintptr_t) _failNative);
+		_emit(compiler, "\xFF\xD0", 2);
+	}
+}
+
+/**
+ * Translates an instruction of the bytecode into its template, that works
+ * on "eax" and "ecx". A call checks the machine stack first.
+ */
+static void _compileInstruction(NativeCompiler * compiler, const BytecodeFunction * function, const unsigned int pc) {
+	const BytecodeInstruction * instruction = &function->code[pc];
+	const unsigned int line = function->lines[pc];
+	const int32_t a = instruction->a;
+	const int32_t b = instruction->b;
+	const int32_t c = instruction->c;
+	switch (instruction->operation) {
+		case MOVE_OP:
+			_slot(compiler, "\x8B\x85", 2, b);
+			_slot(compiler, "\x89\x85", 2, a);
+			break;
+		case LOAD_INT_OP:
+			// mov dword [rbp + a], b
+			_slot(compiler, "\xC7\x85", 2, a);
+			_emit32(compiler, b);
+			break;
+		case ADD_OP:
+		case SUB_OP:
+		case MUL_OP:
+		case UNCHECKED_ADD_OP:
+		case UNCHECKED_SUB_OP:
+		case UNCHECKED_MUL_OP: {
+			const BytecodeOperation operation = instruction->operation;
+			_slot(compiler, "\x8B\x85", 2, b);
+			if (operation == ADD_OP || operation == UNCHECKED_ADD_OP) {
+				_slot(compiler, "\x03\x85", 2, c);
+			}
+			else if (operation == SUB_OP || operation == UNCHECKED_SUB_OP) {
+				_slot(compiler, "\x2B\x85", 2, c);
+			}
+			else {
+				_slot(compiler, "\x0F\xAF\x85", 3, c);
+			}
+			if (operation == ADD_OP || operation == SUB_OP || operation == MUL_OP) {
+				_check(compiler, 0x00, OVERFLOW_FAILURE, line);
+			}
+			_slot(compiler, "\x89\x85", 2, a);
+			break;
+		}
+		case ADD_IMMEDIATE_OP:
+		case UNCHECKED_ADD_IMMEDIATE_OP:
+			// mov eax, [rbp + b]; add eax, c
+			_slot(compiler, "\x8B\x85", 2, b);
+			_emit(compiler, "\x05", 1);
+			_emit32(compiler, c);
+			if (instruction->operation == ADD_IMMEDIATE_OP) {
+				_check(compiler, 0x00, OVERFLOW_FAILURE, line);
+			}
+			_slot(compiler, "\x89\x85", 2, a);
+			break;
+		case DIV_OP:
+			// mov ecx, [rbp + c]; test ecx, ecx; je division-by-zero
+			_slot(compiler, "\x8B\x8D", 2, c);
+			_emit(compiler, "\x85\xC9", 2);
+			_check(compiler, 0x04, DIVISION_BY_ZERO_FAILURE, line);
+			// mov eax, [rbp + b]; cmp ecx, -1; jne +11; cmp eax, INT_MIN; je overflow
+			_slot(compiler, "\x8B\x85", 2, b);
+			_emit(compiler, "\x83\xF9\xFF\x75\x0B\x3D\x00\x00\x00\x80", 10);
+			_check(compiler, 0x04, OVERFLOW_FAILURE, line);
+			// cdq; idiv ecx
+			_emit(compiler, "\x99\xF7\xF9", 3);
+			_slot(compiler, "\x89\x85", 2, a);
+			break;
+		case UNCHECKED_DIV_OP:
+			_slot(compiler, "\x8B\x8D", 2, c);
+			_slot(compiler, "\x8B\x85", 2, b);
+			_emit(compiler, "\x99\xF7\xF9", 3);
+			_slot(compiler, "\x89\x85", 2, a);
+			break;
+		case LESS_THAN_OP:
+		case LESS_EQUALS_OP:
+		case GREATER_THAN_OP:
+		case GREATER_EQUALS_OP:
+		case EQUALS_OP:
+		case NOT_EQUALS_OP: {
+			// mov eax, [rbp + b]; cmp eax, [rbp + c]; setcc al; movzx eax, al
+			const char set[] = {0x0F, 0x90 | _conditions[instruction->operation - LESS_THAN_OP], 0xC0, 0x0F, 0xB6, 0xC0};
+			_slot(compiler, "\x8B\x85", 2, b);
+			_slot(compiler, "\x3B\x85", 2, c);
+			_emit(compiler, set, 6);
+			_slot(compiler, "\x89\x85", 2, a);
+			break;
+		}
+		case NOT_OP:
+			// mov eax, [rbp + b]; test eax, eax; sete al; movzx eax, al
+			_slot(compiler, "\x8B\x85", 2, b);
+			_emit(compiler, "\x85\xC0\x0F\x94\xC0\x0F\xB6\xC0", 8);
+			_slot(compiler, "\x89\x85", 2, a);
+			break;
+		case JUMP_OP:
+			_emit(compiler, "\xE9", 1);
+			_addPatch(&compiler->jumps, compiler->size, a, line);
+			_emit32(compiler, 0);
+			break;
+		case JUMP_IF_TRUE_OP:
+		case JUMP_IF_FALSE_OP:
+			// cmp dword [rbp + b], 0
+			_slot(compiler, "\x83\xBD", 2, b);
+			_emit(compiler, "\x00", 1);
+			_jump(compiler, instruction->operation == JUMP_IF_TRUE_OP ? 0x05 : 0x04, a);
+			break;
+		case JUMP_IF_LESS_THAN_OP:
+		case JUMP_IF_LESS_EQUALS_OP:
+		case JUMP_IF_GREATER_THAN_OP:
+		case JUMP_IF_GREATER_EQUALS_OP:
+		case JUMP_IF_EQUALS_OP:
+		case JUMP_IF_NOT_EQUALS_OP:
+			_slot(compiler, "\x8B\x85", 2, b);
+			_slot(compiler, "\x3B\x85", 2, c);
+			_jump(compiler, _conditions[instruction->operation - JUMP_IF_LESS_THAN_OP], a);
+			break;
+		case LOOP_OP:
+			// mov eax, [rbp + a]; cmp eax, [rbp + b]; jge +14; add eax, 1; mov [rbp + a], eax; jmp c
+			_slot(compiler, "\x8B\x85", 2, a);
+			_slot(compiler, "\x3B\x85", 2, b);
+			_emit(compiler, "\x7D\x0E\x83\xC0\x01", 5);
+			_slot(compiler, "\x89\x85", 2, a);
+			_emit(compiler, "\xE9", 1);
+			_addPatch(&compiler->jumps, compiler->size, c, line);
+			_emit32(compiler, 0);
+			break;
+		case CALL_OP:
+			// cmp rsp, r15; jb too-many-nested-calls
+			_emit(compiler, "\x4C\x39\xFC", 3);
+			_check(compiler, 0x02, STACK_FAILURE, line);
+			if (compiler->nativeCode->functions[b] != NULL) {
+				// lea rdi, [rbp + c]; call function
+				_slot(compiler, "\x48\x8D\xBD", 3, c);
+				_emit(compiler, "\xE8", 1);
+				_addPatch(&compiler->calls, compiler->size, b, line);
+				_emit32(compiler, 0);
+			}
+			else {
+				// mov edi, b; lea rsi, [rbp + c]; mov rdx, nativeCode; mov rax, _callBytecode; call rax
+				_emit(compiler, "\xBF", 1);
+				_emit32(compiler, b);
+				_slot(compiler, "\x48\x8D\xB5", 3, c);
+				_emit(compiler, "\x48\xBA", 2);
+				_emit64(compiler, (uint64_t) (uintptr_t) compiler->nativeCode);
+				_emit(compiler, "\x48\xB8", 2);
+				_emit64(compiler, (uint64_t) (uintptr_t) _callBytecode);
+				_emit(compiler, "\xFF\xD0", 2);
+			}
+			_slot(compiler, "\x89\x85", 2, a);
+			break;
+		case RETURN_OP:
+			// mov eax, [rbp + a]; mov rsp, rbp; pop rbp; ret
+			_slot(compiler, "\x8B\x85", 2, a);
+			_emit(compiler, "\x48\x89\xEC\x5D\xC3", 5);
+			break;
+		default:
+			break;
+	}
+}
+
+/**
+ * Appends bytes to the machine code, doubling its capacity if it's full.
+ */
+static void _emit(NativeCompiler * compiler, const char * bytes, const size_t size) {
+	while (compiler->capacity < compiler->size + size) {
+		compiler->capacity *= 2;
+		compiler->code = realloc(compiler->code, compiler->capacity);
+	}
+	memcpy(&compiler->code[compiler->size], bytes, size);
+	compiler->size += size;
+}
+
+/**
+ * Appends a little-endian 32-bit value to the machine code.
+ */
+static void _emit32(NativeCompiler * compiler, const int32_t value) {
+	const uint32_t bits = (uint32_t) value;
+	const char bytes[] = {bits, bits >> 8, bits >> 16, bits >> 24};
+	_emit(compiler, bytes, 4);
+}
+
+/**
+ * Appends a little-endian 64-bit value to the machine code.
+ */
+static void _emit64(NativeCompiler * compiler, const uint64_t value) {
+	_emit32(compiler, (int32_t) (uint32_t) value);
+	_emit32(compiler, (int32_t) (uint32_t) (value >> 32));
+}
+
+/**
+ * The runtime function called by native code when a check fails. It never
+ * returns: it jumps to the failure of the execution.
+ */
+static void _failNative(const unsigned int failure, const unsigned int line, NativeCode * nativeCode) {
+	fflush(nativeCode->output);
+	logError(_logger, "%s (on line %u).", _failures[failure], line);
+	longjmp(nativeCode->failure, 1);
+}
+
+/**
+ * Whether a function can be translated by itself (regardless of the
+ * functions it calls): its parameters and its result are integers, and its
+ * bytecode doesn't print, use strings, or reach outer frames.
+ */
+static boolean _isTranslatable(const BytecodeFunction * function, const CallGraphNode * node) {
+	if (node->function->returnType->type != INT_T) {
+		return false;
+	}
+	for (const Parameters * parameters = node->function->parameters; parameters != NULL; parameters = parameters->next) {
+		if (parameters->parameter->type->type != INT_T) {
+			return false;
+		}
+	}
+	for (unsigned int pc = 0; pc < function->size; ++pc) {
+		switch (function->code[pc].operation) {
+			case LOAD_STRING_OP:
+			case LOAD_OUTER_OP:
+			case STORE_OUTER_OP:
+			case PRINT_INT_OP:
+			case PRINT_BOOL_OP:
+			case PRINT_STRING_OP:
+			case HALT_OP:
+				return false;
+			default:
+				break;
+		}
+	}
+	return true;
+}
+
+/**
+ * Emits a conditional jump to an instruction of the bytecode of the current
+ * function.
+ */
+static void _jump(NativeCompiler * compiler, const uint8_t condition, const unsigned int target) {
+	const char jump[] = {0x0F, 0x80 | condition};
+	_emit(compiler, jump, 2);
+	_addPatch(&compiler->jumps, compiler->size, target, 0);
+	_emit32(compiler, 0);
+}
+
+/**
+ * Sets a 32-bit displacement of the machine code, relative to its end.
+ */
+static void _patch(NativeCompiler * compiler, const size_t position, const size_t target) {
+	const int32_t displacement = (int32_t) (target - (position + 4));
+	const uint32_t bits = (uint32_t) displacement;
+	compiler->code[position] = bits;
+	compiler->code[position + 1] = bits >> 8;
+	compiler->code[position + 2] = bits >> 16;
+	compiler->code[position + 3] = bits >> 24;
+}
+
+/**
+ * Emits an opcode whose memory operand is a register of the frame (i.e.,
+ * "[rbp + displacement]").
+ */
+static void _slot(NativeCompiler * compiler, const char * opcode, const size_t size, const int32_t reg) {
+	_emit(compiler, opcode, size);
+	_emit32(compiler, 8 * reg - compiler->frameBytes);
+}
+
+/* PUBLIC FUNCTIONS */
+
+NativeCode * createNativeCode(const Bytecode * bytecode, const CallGraph * callGraph) {
+	NativeCode * nativeCode = calloc(1, sizeof(NativeCode));
+	nativeCode->bytecode = bytecode;
+	nativeCode->functions = calloc(bytecode->size, sizeof(const void *));
+#if NATIVE_CODE_IS_SUPPORTED
+	// The translatable functions are marked (with a non-NULL entry), and then
+	// unmarked while any of them calls an unmarked function that needs the
+	// frame of an enclosing function (or that returns a string, which doesn't
+	// fit in "eax"), until nothing changes.
+	static const char marked = 0;
+	for (unsigned int k = 0; k < callGraph->size; ++k) {
+		if (_isTranslatable(&bytecode->functions[k], &callGraph->nodes[k])) {
+			nativeCode->functions[k] = &marked;
+		}
+	}
+	boolean changed = true;
+	while (changed) {
+		changed = false;
+		for (unsigned int k = 0; k < callGraph->size; ++k) {
+			const BytecodeFunction * function = &bytecode->functions[k];
+			for (unsigned int pc = 0; nativeCode->functions[k] != NULL && pc < function->size; ++pc) {
+				const BytecodeInstruction * instruction = &function->code[pc];
+				if (instruction->operation == CALL_OP && nativeCode->functions[instruction->b] == NULL
+						&& (bytecode->functions[instruction->b].level != 1
+							|| callGraph->nodes[instruction->b].function->returnType->type == STRING_T)) {
+					nativeCode->functions[k] = NULL;
+					changed = true;
+				}
+			}
+		}
+	}
+	unsigned int longestFunction = 0;
+	for (unsigned int k = 0; k < callGraph->size; ++k) {
+		if (longestFunction < bytecode->functions[k].size) {
+			longestFunction = bytecode->functions[k].size;
+		}
+	}
+	NativeCompiler compiler = {
+		.nativeCode = nativeCode,
+		.code = malloc(_initialCapacity),
+		.size = 0,
+		.capacity = _initialCapacity,
+		.functions = calloc(bytecode->size, sizeof(size_t)),
+		.instructions = calloc(longestFunction + 1, sizeof(size_t)),
+		.jumps = {NULL, 0, 0},
+		.calls = {NULL, 0, 0},
+		.failures = {NULL, 0, 0},
+		.frameBytes = 0
+	};
+	// The entry from C: saves "r15", sets it to the limit of the stack, and
+	// calls the function with the arguments (i.e., entry(arguments, function,
+	// limit)).
+	//     push rbp; mov rbp, rsp; push r15; sub rsp, 8; mov r15, rdx; call rsi
+	//     add rsp, 8; pop r15; pop rbp; ret
+	_emit(&compiler, "\x55\x48\x89\xE5\x41\x57\x48\x83\xEC\x08\x49\x89\xD7\xFF\xD6\x48\x83\xC4\x08\x41\x5F\x5D\xC3", 23);
+	for (unsigned int k = 0; k < callGraph->size; ++k) {
+		if (nativeCode->functions[k] != NULL) {
+			_compileFunction(&compiler, k);
+			++nativeCode->compiledFunctions;
+		}
+	}
+	for (unsigned int k = 0; k < compiler.calls.size; ++k) {
+		const Patch * call = &compiler.calls.patches[k];
+		_patch(&compiler, call->position, compiler.functions[call->target]);
+	}
+	const size_t page = (size_t) sysconf(_SC_PAGESIZE);
+	nativeCode->size = (compiler.size + page - 1) / page * page;
+	nativeCode->memory = mmap(NULL, nativeCode->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (nativeCode->memory == MAP_FAILED || (memcpy(nativeCode->memory, compiler.code, compiler.size),
+			mprotect(nativeCode->memory, nativeCode->size, PROT_READ | PROT_EXEC) != 0)) {
+		logWarning(_logger, "Cannot map executable memory, so no function is compiled.");
+		if (nativeCode->memory != MAP_FAILED) {
+			munmap(nativeCode->memory, nativeCode->size);
+		}
+		nativeCode->memory = NULL;
+		nativeCode->compiledFunctions = 0;
+	}
+	for (unsigned int k = 0; k < callGraph->size; ++k) {
+		nativeCode->functions[k] = nativeCode->memory != NULL && nativeCode->functions[k] != NULL
+			? (const uint8_t *) nativeCode->memory + compiler.functions[k]
+			: NULL;
+	}
+	nativeCode->entry = nativeCode->memory;
+	free(compiler.failures.patches);
+	free(compiler.calls.patches);
+	free(compiler.jumps.patches);
+	free(compiler.instructions);
+	free(compiler.functions);
+	free(compiler.code);
+#endif
+	return nativeCode;
+}
+
+void destroyNativeCode(NativeCode * nativeCode) {
+	if (nativeCode != NULL) {
+#if NATIVE_CODE_IS_SUPPORTED
+		if (nativeCode->memory != NULL) {
+			munmap(nativeCode->memory, nativeCode->size);
+		}
+#endif
+		free(nativeCode->functions);
+		free(nativeCode);
+	}
+}
+
+void enterNativeCode(NativeCode * nativeCode, BytecodeCallback callback, void * context, FILE * output) {
+	nativeCode->callback = callback;
+	nativeCode->context = context;
+	nativeCode->output = output;
+#if NATIVE_CODE_IS_SUPPORTED
+	size_t stack = _defaultStack;
+	struct rlimit limit;
+	if (getrlimit(RLIMIT_STACK, &limit) == 0) {
+		stack = limit.rlim_cur == RLIM_INFINITY || _maximumStack < limit.rlim_cur ? _maximumStack : limit.rlim_cur;
+	}
+	const uintptr_t here = (uintptr_t) &limit;
+	nativeCode->stackLimit = stack <= 2 * _stackMargin ? here : here - (stack - 2 * _stackMargin);
+#endif
+}
+
+int callNativeCode(const NativeCode * nativeCode, const unsigned int function, const Value * arguments) {
+	int (*entry)(const Value *, const void *, uintptr_t) = (int (*)(const Value *, const void *, uintptr_t)) nativeCode->entry;
+	return entry(arguments, nativeCode->functions[function], nativeCode->stackLimit);
+}
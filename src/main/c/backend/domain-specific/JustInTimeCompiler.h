@@ -0,0 +1,97 @@
+#ifndef JUST_IN_TIME_COMPILER_HEADER
+#define JUST_IN_TIME_COMPILER_HEADER
+
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "../semantic-analysis/CallGraph.h"
+#include "Bytecode.h"
+#include "Calculator.h"
+#include <limits.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializeJustInTimeCompilerModule();
+
+/** Shutdown module's internal state. */
+void shutdownJustInTimeCompilerModule();
+
+/**
+ * A template JIT, that translates the bytecode of the integer functions of
+ * a program (see "Bytecode.h") into native x86-64 code, when the program is
+ * loaded. Every other function keeps running on the virtual machine (see
+ * "VirtualMachine.h"), and both kinds of code call each other through
+ * trampolines.
+ *
+ * A function is compiled if its parameters and its result are "INT", and its
+ * bytecode only computes integers and booleans (i.e., it neither prints,
+ * nor uses strings, nor the variables of the enclosing functions). It may
+ * call compiled functions, and the functions of the program that aren't
+ * nested in another one and don't return strings (because they don't need
+ * any frame of the virtual machine, other than the one of the program).
+ *
+ * Each bytecode instruction becomes a fixed template of machine code over
+ * the registers of the frame, which live in the machine stack. The semantics
+ * are the ones of the virtual machine: a failed check (or a recursion that
+ * exhausts the machine stack) logs its error with the line of the failing
+ * instruction, and stops the whole execution by jumping to "failure".
+ *
+ * The native code is only supported on x86-64 systems with "mmap" (e.g.,
+ * Linux). Elsewhere, no function is compiled.
+ */
+
+/**
+ * Runs a function of the bytecode (indexed as in "Bytecode.h") on the
+ * virtual machine, on behalf of native code, and returns its result.
+ */
+typedef int (*BytecodeCallback)(void * context, const unsigned int function, const Value * arguments);
+
+/**
+ * The native code of a program: the entry of every compiled function (or
+ * NULL, if it isn't compiled), indexed as the functions of the bytecode.
+ * While native code runs, it calls the other functions through a callback,
+ * it bounds its recursion by a limit of the machine stack, and it reports its
+ * errors by jumping to "failure".
+ */
+typedef struct {
+	const Bytecode * bytecode;
+	void * memory;
+	size_t size;
+	const void * entry;
+	const void ** functions;
+	unsigned int compiledFunctions;
+	BytecodeCallback callback;
+	void * context;
+	FILE * output;
+	uintptr_t stackLimit;
+	jmp_buf failure;
+} NativeCode;
+
+/**
+ * Compiles the eligible functions of the bytecode of a program into native
+ * code, given its call graph.
+ */
+NativeCode * createNativeCode(const Bytecode * bytecode, const CallGraph * callGraph);
+
+/**
+ * Destroy a native code.
+ */
+void destroyNativeCode(NativeCode * nativeCode);
+
+/**
+ * Prepares the native code to run on behalf of an execution of the virtual
+ * machine, from the current machine stack: the other functions will be run
+ * by a callback, and the output will be flushed before reporting any error.
+ * The caller must set "failure" (with "setjmp") before calling native code.
+ */
+void enterNativeCode(NativeCode * nativeCode, BytecodeCallback callback, void * context, FILE * output);
+
+/**
+ * Calls a compiled function with its arguments, and returns its result.
+ */
+int callNativeCode(const NativeCode * nativeCode, const unsigned int function, const Value * arguments);
+
+#endif
@@ -0,0 +1,442 @@
+#include "VirtualMachine.h"
+
+#if defined(__GNUC__) && !defined(BYTECODE_SWITCH_DISPATCH)
+	#define COMPUTED_GOTO_DISPATCH
+#endif
+
+/**
+ * The frame of a call (or of the program): where its registers begin in the
+ * stack of registers, the frame of the enclosing function, the level of the
+ * function (see "CallGraph.h"), and where the result of the call goes.
+ */
+typedef struct {
+	size_t base;
+	unsigned int staticLink;
+	unsigned int level;
+	const BytecodeFunction * function;
+	const BytecodeInstruction * returnAddress;
+	int32_t returnRegister;
+} Frame;
+
+/**
+ * The state of an execution: the stack of the registers of every frame, the
+ * stack of frames, the native code of the compiled functions (if any), and
+ * the result so far.
+ */
+typedef struct {
+	const Bytecode * bytecode;
+	NativeCode * nativeCode;
+	FILE * output;
+	Value * registers;
+	size_t registerCapacity;
+	Frame * frames;
+	unsigned int frameSize;
+	unsigned int frameCapacity;
+	ComputationResult result;
+} VirtualMachine;
+
+/* MODULE INTERNAL STATE */
+
+// The initial capacity of the stacks of registers and of frames.
+static const unsigned int _initialCapacity = 256;
+
+// The deepest chain of calls, as in the interpreter (see "Calculator.c").
+static const unsigned int _maximumCallDepth = 1 << 20;
+
+static Logger * _logger = NULL;
+
+void initializeVirtualMachineModule() {
+	_logger = createLogger("VirtualMachine");
+}
+
+void shutdownVirtualMachineModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+static int _callFromNative(void * context, const unsigned int function, const Value * arguments);
+static Value * _enter(VirtualMachine * virtualMachine, const BytecodeFunction * callee, const Value * arguments, const BytecodeInstruction * returnAddress, const int32_t returnRegister);
+static Value _execute(VirtualMachine * virtualMachine);
+static void _fail(VirtualMachine * virtualMachine, const BytecodeFunction * function, const BytecodeInstruction * instruction, const char * error);
+static Value * _outer(VirtualMachine * virtualMachine, const int32_t depth, const int32_t index);
+static Value * _reserve(VirtualMachine * virtualMachine, const BytecodeFunction * callee);
+
+/**
+ * Runs a function on behalf of native code (see "JustInTimeCompiler.h"), in
+ * a frame above the current one, and returns its result. If the function
+ * fails, the whole execution stops by jumping to the failure of the native
+ * code.
+ */
+static int _callFromNative(void * context, const unsigned int function, const Value * arguments) {
+	VirtualMachine * virtualMachine = context;
+	const BytecodeFunction * callee = &virtualMachine->bytecode->functions[function];
+	if (virtualMachine->frameSize == _maximumCallDepth) {
+		fflush(virtualMachine->output);
+		logError(_logger, "Too many nested calls (on line %u).", callee->line);
+		longjmp(virtualMachine->nativeCode->failure, 1);
+	}
+	_reserve(virtualMachine, callee);
+	_enter(virtualMachine, callee, arguments, NULL, 0);
+	++virtualMachine->result.calls;
+	const Value returned = _execute(virtualMachine);
+	if (!virtualMachine->result.succeed) {
+		longjmp(virtualMachine->nativeCode->failure, 1);
+	}
+	return returned.integer;
+}
+
+/**
+ * Enters a function, called from the current frame: pushes its frame (linked
+ * to the frame of its enclosing function), with its registers zeroed, and
+ * copies the arguments into its parameters. Returns the registers of the new
+ * frame. The stacks must have room for it (see "_reserve").
+ */
+static Value * _enter(VirtualMachine * virtualMachine, const BytecodeFunction * callee, const Value * arguments, const BytecodeInstruction * returnAddress, const int32_t returnRegister) {
+	const Frame * caller = &virtualMachine->frames[virtualMachine->frameSize - 1];
+	const size_t base = caller->base + caller->function->registers;
+	unsigned int staticLink = virtualMachine->frameSize - 1;
+	while (callee->level <= virtualMachine->frames[staticLink].level) {
+		staticLink = virtualMachine->frames[staticLink].staticLink;
+	}
+	Value * registers = &virtualMachine->registers[base];
+	memset(registers, 0, callee->registers * sizeof(Value));
+	for (unsigned int k = 0; k < callee->parameterCount; ++k) {
+		registers[callee->parameters[k]] = arguments[k];
+	}
+	virtualMachine->frames[virtualMachine->frameSize++] = (Frame) {
+		.base = base,
+		.staticLink = staticLink,
+		.level = callee->level,
+		.function = callee,
+		.returnAddress = returnAddress,
+		.returnRegister = returnRegister
+	};
+	return registers;
+}
+
+/**
+ * Runs the bytecode from the beginning of the current frame until it halts,
+ * until it returns to native code (with the returned value), or until an
+ * error. The instruction pointer, the registers of the current frame and the
+ * counters live in local variables, so the compiler can keep them in machine
+ * registers. A call to a compiled function runs its native code instead.
+ */
+static Value _execute(VirtualMachine * virtualMachine) {
+#ifdef COMPUTED_GOTO_DISPATCH
+	#define LABEL(operation) [operation] = &&operation##_LABEL
+	static const void * const labels[BYTECODE_OPERATIONS] = {
+		LABEL(MOVE_OP), LABEL(LOAD_INT_OP), LABEL(LOAD_STRING_OP), LABEL(LOAD_OUTER_OP), LABEL(STORE_OUTER_OP),
+		LABEL(ADD_OP), LABEL(SUB_OP), LABEL(MUL_OP), LABEL(DIV_OP), LABEL(ADD_IMMEDIATE_OP),
+		LABEL(UNCHECKED_ADD_OP), LABEL(UNCHECKED_SUB_OP), LABEL(UNCHECKED_MUL_OP), LABEL(UNCHECKED_DIV_OP),
+		LABEL(UNCHECKED_ADD_IMMEDIATE_OP), LABEL(LESS_THAN_OP), LABEL(LESS_EQUALS_OP), LABEL(GREATER_THAN_OP),
+		LABEL(GREATER_EQUALS_OP), LABEL(EQUALS_OP), LABEL(NOT_EQUALS_OP), LABEL(NOT_OP), LABEL(JUMP_OP),
+		LABEL(JUMP_IF_TRUE_OP), LABEL(JUMP_IF_FALSE_OP), LABEL(JUMP_IF_LESS_THAN_OP), LABEL(JUMP_IF_LESS_EQUALS_OP),
+		LABEL(JUMP_IF_GREATER_THAN_OP), LABEL(JUMP_IF_GREATER_EQUALS_OP), LABEL(JUMP_IF_EQUALS_OP),
+		LABEL(JUMP_IF_NOT_EQUALS_OP), LABEL(LOOP_OP), LABEL(CALL_OP), LABEL(RETURN_OP), LABEL(PRINT_INT_OP),
+		LABEL(PRINT_BOOL_OP), LABEL(PRINT_STRING_OP), LABEL(HALT_OP)
+	};
+	#undef LABEL
+	#define BEGIN_DISPATCH() DISPATCH();
+	#define END_DISPATCH()
+	#define OPERATION(operation) operation##_LABEL
+	#define DISPATCH() goto *labels[ip->operation]
+#else
+	#define BEGIN_DISPATCH() for (;;) { switch (ip->operation) {
+	#define END_DISPATCH() default: goto halt; } }
+	#define OPERATION(operation) case operation
+	#define DISPATCH() continue
+#endif
+	#define NEXT() ++executed; ++ip; DISPATCH()
+	#define JUMP(target) ++executed; ip = function->code + (target); DISPATCH()
+	#define FAIL(error) _fail(virtualMachine, function, ip, error); virtualMachine->result.succeed = false; goto halt
+	#define CHECKED(expression) \
+		value = (expression); \
+		if (value < INT_MIN || INT_MAX < value) { \
+			FAIL("Integer overflow"); \
+		} \
+		r[ip->a].integer = (int) value; \
+		NEXT()
+
+	const Bytecode * bytecode = virtualMachine->bytecode;
+	const void * const * natives = virtualMachine->nativeCode == NULL ? NULL : virtualMachine->nativeCode->functions;
+	FILE * output = virtualMachine->output;
+	const Frame * top = &virtualMachine->frames[virtualMachine->frameSize - 1];
+	const BytecodeFunction * function = top->function;
+	const BytecodeInstruction * ip = function->code;
+	Value * r = &virtualMachine->registers[top->base];
+	Value returned = {.integer = 0};
+	unsigned long long executed = 0;
+	unsigned long long calls = 0;
+	int64_t value;
+
+	BEGIN_DISPATCH()
+		OPERATION(MOVE_OP):
+			r[ip->a] = r[ip->b];
+			NEXT();
+		OPERATION(LOAD_INT_OP):
+			r[ip->a].integer = ip->b;
+			NEXT();
+		OPERATION(LOAD_STRING_OP):
+			r[ip->a].string = bytecode->strings[ip->b];
+			NEXT();
+		OPERATION(LOAD_OUTER_OP):
+			r[ip->a] = *_outer(virtualMachine, ip->b, ip->c);
+			NEXT();
+		OPERATION(STORE_OUTER_OP):
+			*_outer(virtualMachine, ip->b, ip->c) = r[ip->a];
+			NEXT();
+		OPERATION(ADD_OP):
+			CHECKED((int64_t) r[ip->b].integer + r[ip->c].integer);
+		OPERATION(SUB_OP):
+			CHECKED((int64_t) r[ip->b].integer - r[ip->c].integer);
+		OPERATION(MUL_OP):
+			CHECKED((int64_t) r[ip->b].integer * r[ip->c].integer);
+		OPERATION(DIV_OP):
+			if (r[ip->c].integer == 0) {
+				FAIL("Division by zero");
+			}
+			CHECKED((int64_t) r[ip->b].integer / r[ip->c].integer);
+		OPERATION(ADD_IMMEDIATE_OP):
+			CHECKED((int64_t) r[ip->b].integer + ip->c);
+		OPERATION(UNCHECKED_ADD_OP):
+			r[ip->a].integer = r[ip->b].integer + r[ip->c].integer;
+			NEXT();
+		OPERATION(UNCHECKED_SUB_OP):
+			r[ip->a].integer = r[ip->b].integer - r[ip->c].integer;
+			NEXT();
+		OPERATION(UNCHECKED_MUL_OP):
+			r[ip->a].integer = r[ip->b].integer * r[ip->c].integer;
+			NEXT();
+		OPERATION(UNCHECKED_DIV_OP):
+			r[ip->a].integer = r[ip->b].integer / r[ip->c].integer;
+			NEXT();
+		OPERATION(UNCHECKED_ADD_IMMEDIATE_OP):
+			r[ip->a].integer = r[ip->b].integer + ip->c;
+			NEXT();
+		OPERATION(LESS_THAN_OP):
+			r[ip->a].boolean = r[ip->b].integer < r[ip->c].integer;
+			NEXT();
+		OPERATION(LESS_EQUALS_OP):
+			r[ip->a].boolean = r[ip->b].integer <= r[ip->c].integer;
+			NEXT();
+		OPERATION(GREATER_THAN_OP):
+			r[ip->a].boolean = r[ip->b].integer > r[ip->c].integer;
+			NEXT();
+		OPERATION(GREATER_EQUALS_OP):
+			r[ip->a].boolean = r[ip->b].integer >= r[ip->c].integer;
+			NEXT();
+		OPERATION(EQUALS_OP):
+			r[ip->a].boolean = r[ip->b].integer == r[ip->c].integer;
+			NEXT();
+		OPERATION(NOT_EQUALS_OP):
+			r[ip->a].boolean = r[ip->b].integer != r[ip->c].integer;
+			NEXT();
+		OPERATION(NOT_OP):
+			r[ip->a].boolean = !r[ip->b].boolean;
+			NEXT();
+		OPERATION(JUMP_OP):
+			JUMP(ip->a);
+		OPERATION(JUMP_IF_TRUE_OP):
+			if (r[ip->b].boolean) {
+				JUMP(ip->a);
+			}
+			NEXT();
+		OPERATION(JUMP_IF_FALSE_OP):
+			if (!r[ip->b].boolean) {
+				JUMP(ip->a);
+			}
+			NEXT();
+		OPERATION(JUMP_IF_LESS_THAN_OP):
+			if (r[ip->b].integer < r[ip->c].integer) {
+				JUMP(ip->a);
+			}
+			NEXT();
+		OPERATION(JUMP_IF_LESS_EQUALS_OP):
+			if (r[ip->b].integer <= r[ip->c].integer) {
+				JUMP(ip->a);
+			}
+			NEXT();
+		OPERATION(JUMP_IF_GREATER_THAN_OP):
+			if (r[ip->b].integer > r[ip->c].integer) {
+				JUMP(ip->a);
+			}
+			NEXT();
+		OPERATION(JUMP_IF_GREATER_EQUALS_OP):
+			if (r[ip->b].integer >= r[ip->c].integer) {
+				JUMP(ip->a);
+			}
+			NEXT();
+		OPERATION(JUMP_IF_EQUALS_OP):
+			if (r[ip->b].integer == r[ip->c].integer) {
+				JUMP(ip->a);
+			}
+			NEXT();
+		OPERATION(JUMP_IF_NOT_EQUALS_OP):
+			if (r[ip->b].integer != r[ip->c].integer) {
+				JUMP(ip->a);
+			}
+			NEXT();
+		OPERATION(LOOP_OP):
+			if (r[ip->a].integer < r[ip->b].integer) {
+				++r[ip->a].integer;
+				JUMP(ip->c);
+			}
+			NEXT();
+		OPERATION(CALL_OP): {
+			const BytecodeFunction * callee = &bytecode->functions[ip->b];
+			if (virtualMachine->frameSize == _maximumCallDepth) {
+				FAIL("Too many nested calls");
+			}
+			++calls;
+			if (natives != NULL && natives[ip->b] != NULL) {
+				const int integer = callNativeCode(virtualMachine->nativeCode, ip->b, &r[ip->c]);
+				r = &virtualMachine->registers[virtualMachine->frames[virtualMachine->frameSize - 1].base];
+				r[ip->a].integer = integer;
+				NEXT();
+			}
+			r = _reserve(virtualMachine, callee);
+			r = _enter(virtualMachine, callee, &r[ip->c], ip + 1, ip->a);
+			++executed;
+			function = callee;
+			ip = callee->code;
+			DISPATCH();
+		}
+		OPERATION(RETURN_OP): {
+			returned = r[ip->a];
+			const Frame * frame = &virtualMachine->frames[--virtualMachine->frameSize];
+			const Frame * caller = frame - 1;
+			if (frame->returnAddress == NULL) {
+				++executed;
+				goto halt;
+			}
+			function = caller->function;
+			r = &virtualMachine->registers[caller->base];
+			ip = frame->returnAddress;
+			r[frame->returnRegister] = returned;
+			++executed;
+			DISPATCH();
+		}
+		OPERATION(PRINT_INT_OP):
+			fprintf(output, "%d\n", r[ip->a].integer);
+			NEXT();
+		OPERATION(PRINT_BOOL_OP):
+			fputs(r[ip->a].boolean ? "TRUE\n" : "FALSE\n", output);
+			NEXT();
+		OPERATION(PRINT_STRING_OP):
+			fputs(r[ip->a].string == NULL ? "" : r[ip->a].string, output);
+			fputc('\n', output);
+			NEXT();
+		OPERATION(HALT_OP):
+			++executed;
+			goto halt;
+	END_DISPATCH()
+
+halt:
+	virtualMachine->result.instructions += executed;
+	virtualMachine->result.calls += calls;
+
+	#undef BEGIN_DISPATCH
+	#undef END_DISPATCH
+	#undef OPERATION
+	#undef DISPATCH
+	#undef NEXT
+	#undef JUMP
+	#undef FAIL
+	#undef CHECKED
+	return returned;
+}
+
+/**
+ * Stops the execution with an error, at the line of the failing instruction.
+ * The output printed so far is flushed first, so it precedes the error.
+ */
+static void _fail(VirtualMachine * virtualMachine, const BytecodeFunction * function, const BytecodeInstruction * instruction, const char * error) {
+	fflush(virtualMachine->output);
+	logError(_logger, "%s (on line %u).", error, function->lines[instruction - function->code]);
+}
+
+/**
+ * The register of a variable, in the frame "depth" static links above the
+ * current one.
+ */
+static Value * _outer(VirtualMachine * virtualMachine, const int32_t depth, const int32_t index) {
+	unsigned int frame = virtualMachine->frameSize - 1;
+	for (int32_t k = 0; k < depth; ++k) {
+		frame = virtualMachine->frames[frame].staticLink;
+	}
+	return &virtualMachine->registers[virtualMachine->frames[frame].base + index];
+}
+
+/**
+ * Grows the stacks, if a call to a function from the current frame doesn't
+ * fit in them. Returns the registers of the current frame (which may move).
+ */
+static Value * _reserve(VirtualMachine * virtualMachine, const BytecodeFunction * callee) {
+	const Frame * caller = &virtualMachine->frames[virtualMachine->frameSize - 1];
+	const size_t base = caller->base + caller->function->registers;
+	if (virtualMachine->frameSize == virtualMachine->frameCapacity) {
+		virtualMachine->frameCapacity *= 2;
+		virtualMachine->frames = realloc(virtualMachine->frames, virtualMachine->frameCapacity * sizeof(Frame));
+	}
+	while (virtualMachine->registerCapacity < base + callee->registers) {
+		virtualMachine->registerCapacity *= 2;
+		virtualMachine->registers = realloc(virtualMachine->registers, virtualMachine->registerCapacity * sizeof(Value));
+	}
+	return &virtualMachine->registers[virtualMachine->frames[virtualMachine->frameSize - 1].base];
+}
+
+/* PUBLIC FUNCTIONS */
+
+ComputationResult runBytecode(const Bytecode * bytecode, NativeCode * nativeCode, FILE * output) {
+	const BytecodeFunction * program = bytecodeProgramOf(bytecode);
+	// On the heap, since native code may jump back to this function.
+	VirtualMachine * virtualMachine = calloc(1, sizeof(VirtualMachine));
+	*virtualMachine = (VirtualMachine) {
+		.bytecode = bytecode,
+		.nativeCode = nativeCode,
+		.output = output,
+		.registers = NULL,
+		.registerCapacity = _initialCapacity,
+		.frames = malloc(_initialCapacity * sizeof(Frame)),
+		.frameSize = 1,
+		.frameCapacity = _initialCapacity,
+		.result = {
+			.succeed = true,
+			.instructions = 0,
+			.calls = 0
+		}
+	};
+	while (virtualMachine->registerCapacity < program->registers) {
+		virtualMachine->registerCapacity *= 2;
+	}
+	virtualMachine->registers = calloc(virtualMachine->registerCapacity, sizeof(Value));
+	virtualMachine->frames[0] = (Frame) {
+		.base = 0,
+		.staticLink = 0,
+		.level = 0,
+		.function = program,
+		.returnAddress = NULL,
+		.returnRegister = 0
+	};
+	if (nativeCode != NULL) {
+		enterNativeCode(nativeCode, _callFromNative, virtualMachine, output);
+		if (setjmp(nativeCode->failure) != 0) {
+			virtualMachine->result.succeed = false;
+		}
+		else {
+			_execute(virtualMachine);
+		}
+	}
+	else {
+		_execute(virtualMachine);
+	}
+	fflush(output);
+	const ComputationResult result = virtualMachine->result;
+	free(virtualMachine->frames);
+	free(virtualMachine->registers);
+	free(virtualMachine);
+	return result;
+}
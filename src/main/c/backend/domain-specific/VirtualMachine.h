@@ -0,0 +1,45 @@
+#ifndef VIRTUAL_MACHINE_HEADER
+#define VIRTUAL_MACHINE_HEADER
+
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "Bytecode.h"
+#include "Calculator.h"
+#include "JustInTimeCompiler.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializeVirtualMachineModule();
+
+/** Shutdown module's internal state. */
+void shutdownVirtualMachineModule();
+
+/**
+ * An execution engine that runs the bytecode of a program (see
+ * "Bytecode.h"), with the same semantics and output of the interpreter (see
+ * "Calculator.h").
+ *
+ * The registers of every frame live in a single stack, so a call only grows
+ * it by the registers of the called function. The dispatch jumps straight
+ * from an instruction to the next one through a table of labels (i.e., a
+ * computed "goto") if the C compiler supports it, or through a "switch"
+ * otherwise (or if "BYTECODE_SWITCH_DISPATCH" is defined).
+ *
+ * Given the native code of a program (see "JustInTimeCompiler.h"), a call to
+ * a compiled function runs natively, and native code calls back into the
+ * virtual machine to run the other functions.
+ */
+
+/**
+ * Runs the bytecode of a program, and prints its output in a stream. The
+ * native code is optional (i.e., NULL runs every function as bytecode). The
+ * instructions and calls of the result are the ones of the bytecode (so the
+ * ones inside native code aren't counted).
+ */
+ComputationResult runBytecode(const Bytecode * bytecode, NativeCode * nativeCode, FILE * output);
+
+#endif
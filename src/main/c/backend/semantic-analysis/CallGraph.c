@@ -0,0 +1,521 @@
+#include "CallGraph.h"
+
+/**
+ * A call site between two functions, as found while walking the AST.
+ */
+typedef struct {
+	unsigned int caller;
+	unsigned int callee;
+} CallGraphEdge;
+
+/**
+ * The effects of a function: the lowest level of the outer variables it
+ * reads and writes (or none), and whether it prints. First, only its own
+ * effects; once its component is found, also the ones of its callees.
+ */
+typedef struct {
+	unsigned int outerRead;
+	unsigned int outerWrite;
+	boolean prints;
+} CallGraphEffects;
+
+/**
+ * The state of the walk over the AST: a symbol table with the functions in
+ * scope (bound to their indexes), the stack of the enclosing functions, the
+ * edges and every call site, and the effects of every function.
+ */
+typedef struct {
+	CallGraph * callGraph;
+	unsigned int nodeCapacity;
+	CallGraphEffects * effects;
+	SymbolTable * symbolTable;
+	unsigned int * functions;
+	unsigned int depth;
+	unsigned int functionCapacity;
+	CallGraphEdge * edges;
+	unsigned int edgeCapacity;
+	CallSite * callSites;
+	unsigned int sites;
+	unsigned int siteCapacity;
+} CallGraphBuilder;
+
+/* MODULE INTERNAL STATE */
+
+// The initial capacity of the nodes, the enclosing functions and the call
+// sites of a call graph being built.
+static const unsigned int _initialCapacity = 64;
+
+// The marker of an absent level, index, component or slot.
+static const unsigned int _none = (unsigned int) -1;
+
+static Logger * _logger = NULL;
+
+void initializeCallGraphModule() {
+	_logger = createLogger("CallGraph");
+}
+
+void shutdownCallGraphModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+static boolean _arithmeticExpression(void * node, void * context);
+static boolean _assignation(void * node, void * context);
+static void _block(void * node, void * context);
+static boolean _booleanExpression(void * node, void * context);
+static void _buildCallees(CallGraph * callGraph, const CallGraphEdge * edges);
+static void _closeComponent(CallGraph * callGraph, CallGraphEffects * effects, const unsigned int * members, const unsigned int size);
+static void _findComponents(CallGraph * callGraph, CallGraphEffects * effects);
+static boolean _function(void * node, void * context);
+static boolean _functionCall(void * node, void * context);
+static void _functionEnd(void * node, void * context);
+static void _indexCallSites(CallGraph * callGraph, const CallSite * callSites, const unsigned int sites);
+static void _indexNodes(CallGraph * callGraph);
+static boolean _loop(void * node, void * context);
+static boolean _print(void * node, void * context);
+static boolean _scope(void * node, void * context);
+static boolean _stringExpression(void * node, void * context);
+static void _useVariable(CallGraphBuilder * builder, const Slot slot, const boolean isWrite);
+
+/**
+ * An arithmetic variable reads it.
+ */
+static boolean _arithmeticExpression(void * node, void * context) {
+	ArithmeticExpression * arithmeticExpression = node;
+	if (arithmeticExpression->type == VAR_ARITH_T) {
+		_useVariable(context, arithmeticExpression->slot, false);
+	}
+	return true;
+}
+
+/**
+ * An assignation (or the initialization of a declaration) writes its
+ * variable.
+ */
+static boolean _assignation(void * node, void * context) {
+	_useVariable(context, ((Assignation *) node)->slot, true);
+	return true;
+}
+
+/**
+ * The end of a block closes its scope, so the functions declared in it are
+ * not visible anymore.
+ */
+static void _block(void * node, void * context) {
+	popScope(((CallGraphBuilder *) context)->symbolTable);
+}
+
+/**
+ * A boolean variable reads it.
+ */
+static boolean _booleanExpression(void * node, void * context) {
+	BooleanExpression * booleanExpression = node;
+	if (booleanExpression->type == VAR_BOOL_T) {
+		_useVariable(context, booleanExpression->slot, false);
+	}
+	return true;
+}
+
+/**
+ * Groups the call sites by caller (with a counting sort, so the callees of
+ * every function keep the source order).
+ */
+static void _buildCallees(CallGraph * callGraph, const CallGraphEdge * edges) {
+	for (unsigned int k = 0; k < callGraph->calls; ++k) {
+		++callGraph->nodes[edges[k].caller].callees;
+	}
+	unsigned int offset = 0;
+	for (unsigned int k = 0; k < callGraph->size; ++k) {
+		callGraph->nodes[k].firstCallee = offset;
+		offset += callGraph->nodes[k].callees;
+		callGraph->nodes[k].callees = 0;
+	}
+	callGraph->callees = malloc((callGraph->calls == 0 ? 1 : callGraph->calls) * sizeof(unsigned int));
+	for (unsigned int k = 0; k < callGraph->calls; ++k) {
+		CallGraphNode * caller = &callGraph->nodes[edges[k].caller];
+		callGraph->callees[caller->firstCallee + caller->callees++] = edges[k].callee;
+	}
+}
+
+/**
+ * Numbers a new strongly connected component, and summarizes its functions.
+ * Every function of a component may call the others, so all of them share
+ * the effects of the component, and the ones of the components it calls
+ * (which are already summarized, because they're found first). An effect
+ * over a variable is outer only to the functions of a higher level than the
+ * one of the variable.
+ */
+static void _closeComponent(CallGraph * callGraph, CallGraphEffects * effects, const unsigned int * members, const unsigned int size) {
+	const unsigned int component = callGraph->components++;
+	for (unsigned int k = 0; k < size; ++k) {
+		callGraph->nodes[members[k]].component = component;
+	}
+	CallGraphEffects summary = {_none, _none, false};
+	boolean recursive = 1 < size;
+	for (unsigned int k = 0; k < size; ++k) {
+		const CallGraphNode * node = &callGraph->nodes[members[k]];
+		const CallGraphEffects * own = &effects[members[k]];
+		summary.outerRead = own->outerRead < summary.outerRead ? own->outerRead : summary.outerRead;
+		summary.outerWrite = own->outerWrite < summary.outerWrite ? own->outerWrite : summary.outerWrite;
+		summary.prints |= own->prints;
+		for (unsigned int c = node->firstCallee; c < node->firstCallee + node->callees; ++c) {
+			const unsigned int callee = callGraph->callees[c];
+			if (callGraph->nodes[callee].component == component) {
+				recursive = true;
+				continue;
+			}
+			const CallGraphEffects * called = &effects[callee];
+			summary.outerRead = called->outerRead < summary.outerRead ? called->outerRead : summary.outerRead;
+			summary.outerWrite = called->outerWrite < summary.outerWrite ? called->outerWrite : summary.outerWrite;
+			summary.prints |= called->prints;
+		}
+	}
+	for (unsigned int k = 0; k < size; ++k) {
+		CallGraphNode * node = &callGraph->nodes[members[k]];
+		CallGraphEffects * exported = &effects[members[k]];
+		exported->outerRead = summary.outerRead < node->level ? summary.outerRead : _none;
+		exported->outerWrite = summary.outerWrite < node->level ? summary.outerWrite : _none;
+		exported->prints = summary.prints;
+		node->recursive = recursive;
+		node->prints = summary.prints;
+		node->writesOuterVariables = exported->outerWrite != _none;
+		node->dependsOnlyOnParameters = exported->outerRead == _none;
+		if (recursive) {
+			++callGraph->recursiveFunctions;
+		}
+	}
+}
+
+/**
+ * Finds the strongly connected components with the algorithm of Tarjan, but
+ * the depth-first search keeps its path in heap-memory (and the next callee
+ * to explore of every function in it), instead of recursing. A function
+ * explored but without a component is still in the stack of the algorithm.
+ * The components are found in reverse topological order (i.e., callees
+ * first), so they're summarized as soon as they're found.
+ *
+ * @see https://doi.org/10.1137/0201010
+ */
+static void _findComponents(CallGraph * callGraph, CallGraphEffects * effects) {
+	const unsigned int size = callGraph->size;
+	unsigned int * order = malloc(size * sizeof(unsigned int));
+	unsigned int * lowest = malloc(size * sizeof(unsigned int));
+	unsigned int * cursor = malloc(size * sizeof(unsigned int));
+	unsigned int * stack = malloc(size * sizeof(unsigned int));
+	unsigned int * path = malloc(size * sizeof(unsigned int));
+	unsigned int explored = 0;
+	unsigned int stackSize = 0;
+	unsigned int pathSize = 0;
+	for (unsigned int k = 0; k < size; ++k) {
+		order[k] = _none;
+		callGraph->nodes[k].component = _none;
+	}
+	for (unsigned int root = 0; root < size; ++root) {
+		if (order[root] != _none) {
+			continue;
+		}
+		order[root] = lowest[root] = explored++;
+		cursor[root] = callGraph->nodes[root].firstCallee;
+		stack[stackSize++] = path[pathSize++] = root;
+		while (0 < pathSize) {
+			const unsigned int current = path[pathSize - 1];
+			const CallGraphNode * node = &callGraph->nodes[current];
+			if (cursor[current] < node->firstCallee + node->callees) {
+				const unsigned int callee = callGraph->callees[cursor[current]++];
+				if (order[callee] == _none) {
+					order[callee] = lowest[callee] = explored++;
+					cursor[callee] = callGraph->nodes[callee].firstCallee;
+					stack[stackSize++] = path[pathSize++] = callee;
+				}
+				else if (callGraph->nodes[callee].component == _none && order[callee] < lowest[current]) {
+					lowest[current] = order[callee];
+				}
+				continue;
+			}
+			--pathSize;
+			if (lowest[current] == order[current]) {
+				unsigned int first = stackSize;
+				while (stack[--first] != current);
+				_closeComponent(callGraph, effects, stack + first, stackSize - first);
+				stackSize = first;
+			}
+			if (0 < pathSize) {
+				const unsigned int caller = path[pathSize - 1];
+				if (lowest[current] < lowest[caller]) {
+					lowest[caller] = lowest[current];
+				}
+			}
+		}
+	}
+	free(path);
+	free(stack);
+	free(cursor);
+	free(lowest);
+	free(order);
+}
+
+/**
+ * A function gets the next index, and is bound to it in the enclosing scope
+ * (before its body, so it can call itself). Then, it encloses its body.
+ */
+static boolean _function(void * node, void * context) {
+	CallGraphBuilder * builder = context;
+	CallGraph * callGraph = builder->callGraph;
+	const Function * function = node;
+	if (callGraph->size == builder->nodeCapacity) {
+		builder->nodeCapacity = 2 * builder->nodeCapacity;
+		callGraph->nodes = realloc(callGraph->nodes, builder->nodeCapacity * sizeof(CallGraphNode));
+		builder->effects = realloc(builder->effects, builder->nodeCapacity * sizeof(CallGraphEffects));
+	}
+	const unsigned int index = callGraph->size++;
+	callGraph->nodes[index] = (CallGraphNode) {
+		.function = function,
+		.level = builder->depth + 1,
+		.component = _none,
+		.firstCallee = 0,
+		.callees = 0,
+		.recursive = false,
+		.prints = false,
+		.writesOuterVariables = false,
+		.dependsOnlyOnParameters = true
+	};
+	builder->effects[index] = (CallGraphEffects) {_none, _none, false};
+	bindSymbol(builder->symbolTable, function->functionName, FUNCTION_SYMBOL, (int) index);
+	if (builder->depth == builder->functionCapacity) {
+		builder->functionCapacity = 2 * builder->functionCapacity;
+		builder->functions = realloc(builder->functions, builder->functionCapacity * sizeof(unsigned int));
+	}
+	builder->functions[builder->depth++] = index;
+	return true;
+}
+
+/**
+ * A call is a call site of the innermost function bound to that name and, if
+ * it's inside a function, an edge from it. The calls of the program itself
+ * (outside any function) are not part of the graph.
+ */
+static boolean _functionCall(void * node, void * context) {
+	CallGraphBuilder * builder = context;
+	const FunctionCall * functionCall = node;
+	const Symbol * symbol = lookupSymbol(builder->symbolTable, functionCall->functionName);
+	if (symbol == NULL || symbol->kind != FUNCTION_SYMBOL) {
+		logError(_logger, "The called function \"%s\" is not in scope.", functionCall->functionName);
+		return true;
+	}
+	if (builder->sites == builder->siteCapacity) {
+		builder->siteCapacity = 2 * builder->siteCapacity;
+		builder->callSites = realloc(builder->callSites, builder->siteCapacity * sizeof(CallSite));
+	}
+	builder->callSites[builder->sites++] = (CallSite) {
+		.functionCall = functionCall,
+		.callee = (unsigned int) symbol->type
+	};
+	if (builder->depth == 0) {
+		return true;
+	}
+	if (builder->callGraph->calls == builder->edgeCapacity) {
+		builder->edgeCapacity = 2 * builder->edgeCapacity;
+		builder->edges = realloc(builder->edges, builder->edgeCapacity * sizeof(CallGraphEdge));
+	}
+	builder->edges[builder->callGraph->calls++] = (CallGraphEdge) {
+		.caller = builder->functions[builder->depth - 1],
+		.callee = (unsigned int) symbol->type
+	};
+	return true;
+}
+
+/**
+ * The end of a function stops enclosing the rest of the program.
+ */
+static void _functionEnd(void * node, void * context) {
+	--((CallGraphBuilder *) context)->depth;
+}
+
+/**
+ * Indexes the call sites by call, in an open-addressing hash table (with
+ * linear probing) at most half full. The calls are never hash-consed, so
+ * every call site has its own.
+ */
+static void _indexCallSites(CallGraph * callGraph, const CallSite * callSites, const unsigned int sites) {
+	callGraph->callSiteCapacity = _initialCapacity;
+	while (callGraph->callSiteCapacity < 2 * sites) {
+		callGraph->callSiteCapacity *= 2;
+	}
+	callGraph->callSites = calloc(callGraph->callSiteCapacity, sizeof(CallSite));
+	const unsigned int mask = callGraph->callSiteCapacity - 1;
+	for (unsigned int index = 0; index < sites; ++index) {
+		unsigned int k = hashAddress(callSites[index].functionCall) & mask;
+		while (callGraph->callSites[k].functionCall != NULL) {
+			k = (k + 1) & mask;
+		}
+		callGraph->callSites[k] = callSites[index];
+	}
+}
+
+/**
+ * Indexes the nodes by function, in an open-addressing hash table (with
+ * linear probing) at most half full.
+ */
+static void _indexNodes(CallGraph * callGraph) {
+	callGraph->slotCapacity = _initialCapacity;
+	while (callGraph->slotCapacity < 2 * callGraph->size) {
+		callGraph->slotCapacity *= 2;
+	}
+	callGraph->slots = malloc(callGraph->slotCapacity * sizeof(unsigned int));
+	for (unsigned int k = 0; k < callGraph->slotCapacity; ++k) {
+		callGraph->slots[k] = _none;
+	}
+	const unsigned int mask = callGraph->slotCapacity - 1;
+	for (unsigned int index = 0; index < callGraph->size; ++index) {
+		unsigned int k = hashAddress(callGraph->nodes[index].function) & mask;
+		while (callGraph->slots[k] != _none) {
+			k = (k + 1) & mask;
+		}
+		callGraph->slots[k] = index;
+	}
+}
+
+/**
+ * A loop writes its variable.
+ */
+static boolean _loop(void * node, void * context) {
+	_useVariable(context, ((Loop *) node)->slot, true);
+	return true;
+}
+
+/**
+ * A print inside a function is an effect of it.
+ */
+static boolean _print(void * node, void * context) {
+	CallGraphBuilder * builder = context;
+	if (0 < builder->depth) {
+		builder->effects[builder->functions[builder->depth - 1]].prints = true;
+	}
+	return true;
+}
+
+/**
+ * A block opens a scope for the functions declared in it.
+ */
+static boolean _scope(void * node, void * context) {
+	pushScope(((CallGraphBuilder *) context)->symbolTable);
+	return true;
+}
+
+/**
+ * A string variable reads it.
+ */
+static boolean _stringExpression(void * node, void * context) {
+	StringExpression * stringExpression = node;
+	if (stringExpression->type == VAR_STRING_T) {
+		_useVariable(context, stringExpression->slot, false);
+	}
+	return true;
+}
+
+/**
+ * Records a read or a write of a variable in the innermost function, if the
+ * variable is outer to it (i.e., it's in the frame of an enclosing function,
+ * or of the program). The level of the variable is the level of the
+ * function minus the frames to go up.
+ */
+static void _useVariable(CallGraphBuilder * builder, const Slot slot, const boolean isWrite) {
+	if (builder->depth == 0 || slot.depth == 0) {
+		return;
+	}
+	const unsigned int level = slot.depth <= builder->depth ? builder->depth - slot.depth : 0;
+	CallGraphEffects * effects = &builder->effects[builder->functions[builder->depth - 1]];
+	unsigned int * outer = isWrite ? &effects->outerWrite : &effects->outerRead;
+	if (level < *outer) {
+		*outer = level;
+	}
+}
+
+/* PUBLIC FUNCTIONS */
+
+CallGraph * createCallGraph(const Program * program) {
+	static const AbstractSyntaxTreeVisitor walker = {
+		.preOrder = {
+			[ARITHMETIC_EXPRESSION_NODE] = _arithmeticExpression,
+			[ASSIGNATION_NODE] = _assignation,
+			[BLOCK_NODE] = _scope,
+			[BOOLEAN_EXPRESSION_NODE] = _booleanExpression,
+			[FUNCTION_CALL_NODE] = _functionCall,
+			[FUNCTION_NODE] = _function,
+			[LOOP_NODE] = _loop,
+			[PRINT_NODE] = _print,
+			[STRING_EXPRESSION_NODE] = _stringExpression
+		},
+		.postOrder = {
+			[BLOCK_NODE] = _block,
+			[FUNCTION_NODE] = _functionEnd
+		}
+	};
+	CallGraph * callGraph = calloc(1, sizeof(CallGraph));
+	CallGraphBuilder builder = {
+		.callGraph = callGraph,
+		.nodeCapacity = _initialCapacity,
+		.effects = malloc(_initialCapacity * sizeof(CallGraphEffects)),
+		.symbolTable = createSymbolTable(),
+		.functions = malloc(_initialCapacity * sizeof(unsigned int)),
+		.depth = 0,
+		.functionCapacity = _initialCapacity,
+		.edges = malloc(_initialCapacity * sizeof(CallGraphEdge)),
+		.edgeCapacity = _initialCapacity,
+		.callSites = malloc(_initialCapacity * sizeof(CallSite)),
+		.sites = 0,
+		.siteCapacity = _initialCapacity
+	};
+	callGraph->nodes = malloc(_initialCapacity * sizeof(CallGraphNode));
+	visitAbstractSyntaxTree(&walker, PROGRAM_NODE, (void *) program, &builder);
+	_buildCallees(callGraph, builder.edges);
+	_findComponents(callGraph, builder.effects);
+	_indexNodes(callGraph);
+	_indexCallSites(callGraph, builder.callSites, builder.sites);
+	destroySymbolTable(builder.symbolTable);
+	free(builder.callSites);
+	free(builder.edges);
+	free(builder.functions);
+	free(builder.effects);
+	logDebugging(_logger, "The call graph has %u functions, %u calls, and %u components (%u recursive functions).",
+		callGraph->size, callGraph->calls, callGraph->components, callGraph->recursiveFunctions);
+	return callGraph;
+}
+
+void destroyCallGraph(CallGraph * callGraph) {
+	if (callGraph != NULL) {
+		free(callGraph->callSites);
+		free(callGraph->slots);
+		free(callGraph->callees);
+		free(callGraph->nodes);
+		free(callGraph);
+	}
+}
+
+const CallGraphNode * callGraphNodeOf(const CallGraph * callGraph, const Function * function) {
+	const unsigned int mask = callGraph->slotCapacity - 1;
+	for (unsigned int k = hashAddress(function) & mask; callGraph->slots[k] != _none; k = (k + 1) & mask) {
+		const CallGraphNode * node = &callGraph->nodes[callGraph->slots[k]];
+		if (node->function == function) {
+			return node;
+		}
+	}
+	return NULL;
+}
+
+const CallGraphNode * calleeOf(const CallGraph * callGraph, const FunctionCall * functionCall) {
+	const unsigned int mask = callGraph->callSiteCapacity - 1;
+	for (unsigned int k = hashAddress(functionCall) & mask; callGraph->callSites[k].functionCall != NULL; k = (k + 1) & mask) {
+		if (callGraph->callSites[k].functionCall == functionCall) {
+			return &callGraph->nodes[callGraph->callSites[k].callee];
+		}
+	}
+	return NULL;
+}
+
+boolean isPureFunction(const CallGraphNode * node) {
+	return !node->prints && !node->writesOuterVariables && node->dependsOnlyOnParameters;
+}
@@ -0,0 +1,116 @@
+#ifndef CALL_GRAPH_HEADER
+#define CALL_GRAPH_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTreeVisitor.h"
+#include "../../shared/Hash.h"
+#include "../../shared/Logger.h"
+#include "../../shared/SymbolTable.h"
+#include "../../shared/Type.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+/** Initialize module's internal state. */
+void initializeCallGraphModule();
+
+/** Shutdown module's internal state. */
+void shutdownCallGraphModule();
+
+/**
+ * A whole-program analysis of the functions and their calls.
+ *
+ * The functions are numbered in source order (i.e., in pre-order, so an
+ * enclosing function precedes the ones nested in it), and each one knows its
+ * callees: an edge per call site, including the ones in nested functions
+ * (because a nested function may only run while its enclosing one does, its
+ * calls are its own, not of the enclosing function). The level of a function
+ * is the amount of functions that enclose it, plus one (the program is the
+ * level 0), so a variable is outer to a function if it lives in the frame of
+ * a lower level.
+ *
+ * The strongly connected components of the graph group the functions that
+ * may call each other (recursively). A function is recursive if its
+ * component has many functions, or if it calls itself.
+ *
+ * The summary of a function covers every function it may call, directly or
+ * not: whether it prints, whether it writes outer variables, and whether its
+ * result depends only on its parameters (i.e., it doesn't read outer
+ * variables). A pure function does none of them.
+ *
+ * Every call site (including the ones of the program itself) knows the
+ * function it calls, so later analyses don't need to resolve names again.
+ */
+
+/**
+ * A function of the call graph. Its callees are a range of the callees of the
+ * graph.
+ */
+typedef struct {
+	const Function * function;
+	unsigned int level;
+	unsigned int component;
+	unsigned int firstCallee;
+	unsigned int callees;
+	boolean recursive;
+	boolean prints;
+	boolean writesOuterVariables;
+	boolean dependsOnlyOnParameters;
+} CallGraphNode;
+
+/**
+ * A call site, and the index of the function it calls. An empty entry has a
+ * NULL call.
+ */
+typedef struct {
+	const FunctionCall * functionCall;
+	unsigned int callee;
+} CallSite;
+
+/**
+ * The call graph of a program. The callees of every function are stored
+ * contiguously (i.e., as compressed sparse rows), and hash tables index the
+ * nodes by function, and the call sites by call.
+ */
+typedef struct {
+	CallGraphNode * nodes;
+	unsigned int size;
+	unsigned int * callees;
+	unsigned int calls;
+	unsigned int components;
+	unsigned int recursiveFunctions;
+	unsigned int * slots;
+	unsigned int slotCapacity;
+	CallSite * callSites;
+	unsigned int callSiteCapacity;
+} CallGraph;
+
+/**
+ * Builds the call graph of a program, and the summary of every function.
+ * Neither the analysis nor its stacks are recursive, so the program can have
+ * any amount of functions, nested or recursive at any depth.
+ */
+CallGraph * createCallGraph(const Program * program);
+
+/**
+ * Destroy a call graph.
+ */
+void destroyCallGraph(CallGraph * callGraph);
+
+/**
+ * The node of a function of the analyzed program, or NULL if it's unknown.
+ */
+const CallGraphNode * callGraphNodeOf(const CallGraph * callGraph, const Function * function);
+
+/**
+ * The node of the function called by a call site of the analyzed program, or
+ * NULL if it's unknown.
+ */
+const CallGraphNode * calleeOf(const CallGraph * callGraph, const FunctionCall * functionCall);
+
+/**
+ * Whether a function neither prints, nor writes outer variables, and its
+ * result depends only on its parameters.
+ */
+boolean isPureFunction(const CallGraphNode * node);
+
+#endif
@@ -0,0 +1,486 @@
+#include "CostAnalysis.h"
+
+/**
+ * A call from the analyzed function (or the program) to a function of
+ * another component, and how many times it runs per call of the caller.
+ */
+typedef struct {
+	unsigned int callee;
+	Cost frequency;
+} CostCall;
+
+/**
+ * The state of the analysis of a function (or of the program): its component
+ * (or none), how many times the program calls it (only while ranking its
+ * statements), and the calls it makes to other components. While an
+ * expression is evaluated, its cost (with the called functions) and its own
+ * cost (without them) accumulate, at the frequency of its statement.
+ */
+typedef struct {
+	CostAnalysis * costAnalysis;
+	const CallGraph * callGraph;
+	const Function * function;
+	unsigned int component;
+	Cost invocations;
+	boolean ranking;
+	Cost frequency;
+	Cost cost;
+	Cost own;
+	CostCall * calls;
+	unsigned int size;
+	unsigned int capacity;
+} CostAnalyzer;
+
+/* MODULE INTERNAL STATE */
+
+// The initial capacity of the calls between components.
+static const unsigned int _initialCapacity = 64;
+
+// The marker of an absent component.
+static const unsigned int _none = (unsigned int) -1;
+
+// The costs of no operation, of a single one, and of "n" of them.
+static const Cost _zero = {{0}};
+static const Cost _one = {{1}};
+static const Cost _unknown = {{0, 1}};
+
+// The trip count of the loops whose bounds are unknown.
+static double _tripCount = 100;
+
+static Logger * _logger = NULL;
+
+void initializeCostAnalysisModule() {
+	_logger = createLogger("CostAnalysis");
+	_tripCount = strtod(getStringOrDefault("COST_TRIP_COUNT", "100"), NULL);
+}
+
+void shutdownCostAnalysisModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+static void _add(Cost * cost, const Cost * other);
+static Cost _analyzeBlock(CostAnalyzer * analyzer, const Block * block, const Cost * frequency);
+static Cost _analyzeExpression(CostAnalyzer * analyzer, const NodeKind kind, const void * node, const Cost * frequency, Cost * own);
+static Cost _analyzeInstruction(CostAnalyzer * analyzer, const Instruction * instruction, const Cost * frequency);
+static void _countInvocations(CostAnalysis * costAnalysis, const unsigned int * order, const CostAnalyzer * analyzer, const unsigned int * firstCalls);
+static void _estimateCosts(CostAnalysis * costAnalysis, const Program * program, const unsigned int * order, CostAnalyzer * analyzer, unsigned int * firstCalls);
+static boolean _functionCall(void * node, void * context);
+static Cost _maximum(const Cost * cost, const Cost * other);
+static Cost _multiply(const Cost * cost, const Cost * other);
+static boolean _operation(void * node, void * context);
+static void _rank(CostAnalyzer * analyzer, const Instruction * instruction, const Cost * own, const Cost * frequency);
+static void _rankStatements(CostAnalysis * costAnalysis, const Program * program, CostAnalyzer * analyzer);
+static Cost _tripCountOf(const Loop * loop);
+
+/**
+ * Adds a cost to another, in place.
+ */
+static void _add(Cost * cost, const Cost * other) {
+	for (unsigned int k = 0; k <= MAXIMUM_COST_DEGREE; ++k) {
+		cost->terms[k] += other->terms[k];
+	}
+}
+
+/**
+ * The cost of the instructions of a block, in order.
+ */
+static Cost _analyzeBlock(CostAnalyzer * analyzer, const Block * block, const Cost * frequency) {
+	Cost cost = _zero;
+	for (const Instruction * instruction = block->instructions; instruction != NULL; instruction = instruction->next) {
+		const Cost instructionCost = _analyzeInstruction(analyzer, instruction, frequency);
+		_add(&cost, &instructionCost);
+	}
+	return cost;
+}
+
+/**
+ * The cost of an expression (with the called functions), that also adds its
+ * own cost (without them).
+ */
+static Cost _analyzeExpression(CostAnalyzer * analyzer, const NodeKind kind, const void * node, const Cost * frequency, Cost * own) {
+	static const AbstractSyntaxTreeVisitor evaluator = {
+		.preOrder = {
+			[ARITHMETIC_EXPRESSION_NODE] = _operation,
+			[BOOLEAN_EXPRESSION_NODE] = _operation,
+			[FUNCTION_CALL_NODE] = _functionCall,
+			[STRING_EXPRESSION_NODE] = _operation
+		}
+	};
+	analyzer->frequency = *frequency;
+	analyzer->cost = _zero;
+	analyzer->own = _zero;
+	if (node != NULL) {
+		visitAbstractSyntaxTree(&evaluator, kind, (void *) node, analyzer);
+	}
+	_add(own, &analyzer->own);
+	return analyzer->cost;
+}
+
+/**
+ * The cost of an instruction, that runs at a frequency (i.e., the product of
+ * the trip counts of the enclosing loops). Its own operations are a single
+ * one, plus its expressions. A nested function costs nothing until called,
+ * but it's where its line is known.
+ */
+static Cost _analyzeInstruction(CostAnalyzer * analyzer, const Instruction * instruction, const Cost * frequency) {
+	Cost own = _one;
+	Cost cost = _one;
+	Cost expressionCost;
+	switch (instruction->type) {
+		case DECLARATION_INSTRUCTION_T:
+			expressionCost = _analyzeExpression(analyzer, EXPRESSION_NODE, instruction->declaration->assignation->expression, frequency, &own);
+			break;
+		case ASSIGNATION_INSTRUCTION_T:
+			expressionCost = _analyzeExpression(analyzer, EXPRESSION_NODE, instruction->assignation->expression, frequency, &own);
+			break;
+		case EXPRESSION_INSTRUCTION_T:
+			expressionCost = _analyzeExpression(analyzer, EXPRESSION_NODE, instruction->expression, frequency, &own);
+			break;
+		case PRINT_INSTRUCTION_T:
+			expressionCost = _analyzeExpression(analyzer, EXPRESSION_NODE, instruction->print->expression, frequency, &own);
+			break;
+		case FUNCTION_CALL_INSTRUCTION_T:
+			expressionCost = _analyzeExpression(analyzer, FUNCTION_CALL_NODE, instruction->functionCall, frequency, &own);
+			break;
+		case RETURN_STATEMENT_INSTRUCTION_T:
+			expressionCost = _analyzeExpression(analyzer, EXPRESSION_NODE, instruction->returnStatement->expression, frequency, &own);
+			break;
+		case FUNCTION_INSTRUCTION_T: {
+			const CallGraphNode * node = callGraphNodeOf(analyzer->callGraph, instruction->function);
+			if (node != NULL) {
+				analyzer->costAnalysis->functions[node - analyzer->callGraph->nodes].line = instruction->line;
+			}
+			return _zero;
+		}
+		case CONDITIONAL_INSTRUCTION_T: {
+			const Conditional * conditional = instruction->conditional;
+			expressionCost = _analyzeExpression(analyzer, BOOLEAN_EXPRESSION_NODE, conditional->condition, frequency, &own);
+			const Cost ifCost = _analyzeBlock(analyzer, conditional->ifBlock, frequency);
+			const Cost elseCost = _analyzeBlock(analyzer, conditional->elseBlock, frequency);
+			const Cost branchCost = _maximum(&ifCost, &elseCost);
+			_add(&cost, &branchCost);
+			break;
+		}
+		case LOOP_INSTRUCTION_T: {
+			const Loop * loop = instruction->loop;
+			expressionCost = _analyzeExpression(analyzer, ARITHMETIC_EXPRESSION_NODE, loop->start, frequency, &own);
+			_add(&cost, &expressionCost);
+			expressionCost = _analyzeExpression(analyzer, ARITHMETIC_EXPRESSION_NODE, loop->end, frequency, &own);
+			const Cost tripCount = _tripCountOf(loop);
+			const Cost blockFrequency = _multiply(frequency, &tripCount);
+			const Cost blockCost = _analyzeBlock(analyzer, loop->block, &blockFrequency);
+			const Cost loopCost = _multiply(&tripCount, &blockCost);
+			_add(&cost, &loopCost);
+			break;
+		}
+		default:
+			return _zero;
+	}
+	_add(&cost, &expressionCost);
+	_rank(analyzer, instruction, &own, frequency);
+	return cost;
+}
+
+/**
+ * Counts how many times the program calls each function: once the program
+ * itself, and every function as many times as its callers call it. The
+ * components are walked from the last one (i.e., callers first), so every
+ * caller is complete before its callees. A recursive component runs "n"
+ * times per call from outside of it, any of its functions.
+ */
+static void _countInvocations(CostAnalysis * costAnalysis, const unsigned int * order, const CostAnalyzer * analyzer, const unsigned int * firstCalls) {
+	const CallGraph * callGraph = costAnalysis->callGraph;
+	costAnalysis->program.invocations = _one;
+	for (unsigned int k = firstCalls[costAnalysis->size]; k < analyzer->size; ++k) {
+		_add(&costAnalysis->functions[analyzer->calls[k].callee].invocations, &analyzer->calls[k].frequency);
+	}
+	unsigned int last = costAnalysis->size;
+	while (0 < last) {
+		const unsigned int component = callGraph->nodes[order[last - 1]].component;
+		unsigned int first = last;
+		Cost invocations = _zero;
+		while (0 < first && callGraph->nodes[order[first - 1]].component == component) {
+			_add(&invocations, &costAnalysis->functions[order[--first]].invocations);
+		}
+		if (callGraph->nodes[order[first]].recursive) {
+			invocations = _multiply(&invocations, &_unknown);
+			for (unsigned int k = first; k < last; ++k) {
+				costAnalysis->functions[order[k]].invocations = invocations;
+			}
+		}
+		for (unsigned int k = first; k < last; ++k) {
+			const unsigned int caller = order[k];
+			const unsigned int end = k + 1 < costAnalysis->size ? firstCalls[order[k + 1]] : firstCalls[costAnalysis->size];
+			for (unsigned int c = firstCalls[caller]; c < end; ++c) {
+				const Cost calls = _multiply(&costAnalysis->functions[caller].invocations, &analyzer->calls[c].frequency);
+				_add(&costAnalysis->functions[analyzer->calls[c].callee].invocations, &calls);
+			}
+		}
+		last = first;
+	}
+}
+
+/**
+ * Estimates the cost of a call of every function, in the order of their
+ * components (i.e., callees first), so the cost of a called function of
+ * another component is always known. Then, the cost of the program. The
+ * calls of each function are recorded contiguously, in the same order.
+ */
+static void _estimateCosts(CostAnalysis * costAnalysis, const Program * program, const unsigned int * order, CostAnalyzer * analyzer, unsigned int * firstCalls) {
+	const CallGraph * callGraph = costAnalysis->callGraph;
+	for (unsigned int k = 0; k < costAnalysis->size; ++k) {
+		const CallGraphNode * node = &callGraph->nodes[order[k]];
+		FunctionCost * functionCost = &costAnalysis->functions[order[k]];
+		analyzer->function = node->function;
+		analyzer->component = node->component;
+		firstCalls[order[k]] = analyzer->size;
+		functionCost->cost = _analyzeBlock(analyzer, node->function->block, &_one);
+		if (node->recursive) {
+			functionCost->cost = _multiply(&functionCost->cost, &_unknown);
+		}
+	}
+	analyzer->function = NULL;
+	analyzer->component = _none;
+	firstCalls[costAnalysis->size] = analyzer->size;
+	costAnalysis->program.cost = _analyzeBlock(analyzer, program->block, &_one);
+}
+
+/**
+ * A call to a function of another component runs its operations (and
+ * records the call, unless the statements are being ranked). The call itself
+ * is an operation of its expression, or of its instruction.
+ */
+static boolean _functionCall(void * node, void * context) {
+	CostAnalyzer * analyzer = context;
+	const CallGraphNode * callee = calleeOf(analyzer->callGraph, node);
+	if (callee == NULL || callee->component == analyzer->component) {
+		return true;
+	}
+	const unsigned int index = (unsigned int) (callee - analyzer->callGraph->nodes);
+	_add(&analyzer->cost, &analyzer->costAnalysis->functions[index].cost);
+	if (!analyzer->ranking) {
+		if (analyzer->size == analyzer->capacity) {
+			analyzer->capacity = 2 * analyzer->capacity;
+			analyzer->calls = realloc(analyzer->calls, analyzer->capacity * sizeof(CostCall));
+		}
+		analyzer->calls[analyzer->size++] = (CostCall) {
+			.callee = index,
+			.frequency = analyzer->frequency
+		};
+	}
+	return true;
+}
+
+/**
+ * The highest coefficient of each power of two costs (i.e., a bound of
+ * both).
+ */
+static Cost _maximum(const Cost * cost, const Cost * other) {
+	Cost maximum;
+	for (unsigned int k = 0; k <= MAXIMUM_COST_DEGREE; ++k) {
+		maximum.terms[k] = cost->terms[k] < other->terms[k] ? other->terms[k] : cost->terms[k];
+	}
+	return maximum;
+}
+
+/**
+ * The product of two costs. The terms of a degree higher than the maximum
+ * saturate into the highest one.
+ */
+static Cost _multiply(const Cost * cost, const Cost * other) {
+	Cost product = _zero;
+	for (unsigned int i = 0; i <= MAXIMUM_COST_DEGREE; ++i) {
+		if (cost->terms[i] == 0) {
+			continue;
+		}
+		for (unsigned int j = 0; j <= MAXIMUM_COST_DEGREE; ++j) {
+			const unsigned int k = i + j < MAXIMUM_COST_DEGREE ? i + j : MAXIMUM_COST_DEGREE;
+			product.terms[k] += cost->terms[i] * other->terms[j];
+		}
+	}
+	return product;
+}
+
+/**
+ * Every node of an expression is an operation.
+ */
+static boolean _operation(void * node, void * context) {
+	CostAnalyzer * analyzer = context;
+	++analyzer->cost.terms[0];
+	++analyzer->own.terms[0];
+	return true;
+}
+
+/**
+ * Ranks a statement among the hottest ones, by the amount of its own
+ * operations that the program runs (i.e., per run of the statement, times
+ * its frequency, times the calls of its function). The hottest statements
+ * are sorted from the hottest one, and a tie keeps the first one found.
+ */
+static void _rank(CostAnalyzer * analyzer, const Instruction * instruction, const Cost * own, const Cost * frequency) {
+	if (!analyzer->ranking) {
+		return;
+	}
+	CostAnalysis * costAnalysis = analyzer->costAnalysis;
+	const Cost runs = _multiply(&analyzer->invocations, frequency);
+	const Cost total = _multiply(&runs, own);
+	const double operations = costAt(&total, costAnalysis->tripCount);
+	if (operations <= 0) {
+		return;
+	}
+	unsigned int k = costAnalysis->hottestSize;
+	if (k == HOTTEST_STATEMENTS) {
+		if (operations <= costAnalysis->hottest[k - 1].operations) {
+			return;
+		}
+		--k;
+	}
+	else {
+		++costAnalysis->hottestSize;
+	}
+	while (0 < k && costAnalysis->hottest[k - 1].operations < operations) {
+		costAnalysis->hottest[k] = costAnalysis->hottest[k - 1];
+		--k;
+	}
+	costAnalysis->hottest[k] = (HotStatement) {
+		.instruction = instruction,
+		.function = analyzer->function,
+		.operations = operations,
+		.degree = costDegree(&total)
+	};
+}
+
+/**
+ * Walks every function (and the program) again, once the calls of each one
+ * are known, to rank their statements.
+ */
+static void _rankStatements(CostAnalysis * costAnalysis, const Program * program, CostAnalyzer * analyzer) {
+	const CallGraph * callGraph = costAnalysis->callGraph;
+	analyzer->ranking = true;
+	for (unsigned int k = 0; k < costAnalysis->size; ++k) {
+		analyzer->function = callGraph->nodes[k].function;
+		analyzer->component = callGraph->nodes[k].component;
+		analyzer->invocations = costAnalysis->functions[k].invocations;
+		_analyzeBlock(analyzer, analyzer->function->block, &_one);
+	}
+	analyzer->function = NULL;
+	analyzer->component = _none;
+	analyzer->invocations = _one;
+	_analyzeBlock(analyzer, program->block, &_one);
+}
+
+/**
+ * The trip count of a loop, which runs from its start to its end, both
+ * included. It's exact if both bounds are literals, or if the end is the
+ * start plus or minus a literal (the expressions are hash-consed, so equal
+ * bounds are the same node). Otherwise, it's unknown.
+ */
+static Cost _tripCountOf(const Loop * loop) {
+	const ArithmeticExpression * start = loop->start;
+	const ArithmeticExpression * end = loop->end;
+	long long difference;
+	if (start->type == INT_LITERAL_T && end->type == INT_LITERAL_T) {
+		difference = (long long) end->value - start->value;
+	}
+	else if (start == end) {
+		difference = 0;
+	}
+	else if (end->type == ADD_T && end->left == start && end->right->type == INT_LITERAL_T) {
+		difference = end->right->value;
+	}
+	else if (end->type == ADD_T && end->right == start && end->left->type == INT_LITERAL_T) {
+		difference = end->left->value;
+	}
+	else if (end->type == SUB_T && end->left == start && end->right->type == INT_LITERAL_T) {
+		difference = -(long long) end->right->value;
+	}
+	else {
+		return _unknown;
+	}
+	Cost tripCount = _zero;
+	tripCount.terms[0] = difference < 0 ? 0 : (double) (difference + 1);
+	return tripCount;
+}
+
+/* PUBLIC FUNCTIONS */
+
+CostAnalysis * createCostAnalysis(const Program * program, const CallGraph * callGraph) {
+	CostAnalysis * costAnalysis = calloc(1, sizeof(CostAnalysis));
+	costAnalysis->callGraph = callGraph;
+	costAnalysis->size = callGraph->size;
+	costAnalysis->functions = calloc(callGraph->size == 0 ? 1 : callGraph->size, sizeof(FunctionCost));
+	costAnalysis->tripCount = _tripCount;
+	unsigned int * order = malloc((callGraph->size == 0 ? 1 : callGraph->size) * sizeof(unsigned int));
+	unsigned int * firstCalls = calloc(callGraph->components + 1, sizeof(unsigned int));
+	for (unsigned int k = 0; k < callGraph->size; ++k) {
+		costAnalysis->functions[k].function = callGraph->nodes[k].function;
+		++firstCalls[callGraph->nodes[k].component + 1];
+	}
+	for (unsigned int k = 0; k < callGraph->components; ++k) {
+		firstCalls[k + 1] += firstCalls[k];
+	}
+	for (unsigned int k = 0; k < callGraph->size; ++k) {
+		order[firstCalls[callGraph->nodes[k].component]++] = k;
+	}
+	free(firstCalls);
+	firstCalls = malloc((callGraph->size + 1) * sizeof(unsigned int));
+	CostAnalyzer analyzer = {
+		.costAnalysis = costAnalysis,
+		.callGraph = callGraph,
+		.function = NULL,
+		.component = _none,
+		.invocations = _zero,
+		.ranking = false,
+		.calls = malloc(_initialCapacity * sizeof(CostCall)),
+		.size = 0,
+		.capacity = _initialCapacity
+	};
+	_estimateCosts(costAnalysis, program, order, &analyzer, firstCalls);
+	_countInvocations(costAnalysis, order, &analyzer, firstCalls);
+	_rankStatements(costAnalysis, program, &analyzer);
+	for (unsigned int k = 0; k < costAnalysis->size; ++k) {
+		FunctionCost * functionCost = &costAnalysis->functions[k];
+		functionCost->operations = costAt(&functionCost->cost, costAnalysis->tripCount);
+		functionCost->degree = costDegree(&functionCost->cost);
+	}
+	costAnalysis->program.operations = costAt(&costAnalysis->program.cost, costAnalysis->tripCount);
+	costAnalysis->program.degree = costDegree(&costAnalysis->program.cost);
+	free(analyzer.calls);
+	free(firstCalls);
+	free(order);
+	logDebugging(_logger, "The program runs about %g operations (a degree of %u), assuming %g iterations per unknown loop.",
+		costAnalysis->program.operations, costAnalysis->program.degree, costAnalysis->tripCount);
+	return costAnalysis;
+}
+
+void destroyCostAnalysis(CostAnalysis * costAnalysis) {
+	if (costAnalysis != NULL) {
+		free(costAnalysis->functions);
+		free(costAnalysis);
+	}
+}
+
+double costAt(const Cost * cost, const double tripCount) {
+	double value = 0;
+	for (unsigned int k = MAXIMUM_COST_DEGREE + 1; 0 < k; --k) {
+		value = value * tripCount + cost->terms[k - 1];
+	}
+	return value;
+}
+
+unsigned int costDegree(const Cost * cost) {
+	unsigned int degree = MAXIMUM_COST_DEGREE;
+	while (0 < degree && cost->terms[degree] == 0) {
+		--degree;
+	}
+	return degree;
+}
+
+const FunctionCost * functionCostOf(const CostAnalysis * costAnalysis, const Function * function) {
+	const CallGraphNode * node = callGraphNodeOf(costAnalysis->callGraph, function);
+	return node == NULL ? NULL : &costAnalysis->functions[node - costAnalysis->callGraph->nodes];
+}
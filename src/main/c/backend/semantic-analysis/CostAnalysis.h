@@ -0,0 +1,115 @@
+#ifndef COST_ANALYSIS_HEADER
+#define COST_ANALYSIS_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTreeVisitor.h"
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "CallGraph.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializeCostAnalysisModule();
+
+/** Shutdown module's internal state. */
+void shutdownCostAnalysisModule();
+
+/**
+ * A static estimation of how many operations a program runs, without running
+ * it. Every instruction and every node of its expressions is an operation,
+ * and a call also runs the operations of the called function.
+ *
+ * The trip count of a loop is exact if its bounds are literals, or if they
+ * differ in a literal (e.g., "FOR k IN (i, i + 3)" runs 4 times). Otherwise,
+ * it's the unknown "n", so a cost is a polynomial in "n": a loop multiplies
+ * the cost of its block by its trip count, a conditional costs as much as
+ * its most expensive branch, and a recursive function runs its block "n"
+ * times per call (the calls between the functions of its strongly connected
+ * component cost a single operation). The polynomials are evaluated with the
+ * trip count assumed by the analysis (see "COST_TRIP_COUNT").
+ *
+ * Each function is also weighted by how many times the whole program calls
+ * it, so the hottest statements are the ones whose own operations (i.e.,
+ * without the ones of the functions they call) run the most.
+ */
+
+/** The highest degree of a cost. Higher terms saturate into this one. */
+#define MAXIMUM_COST_DEGREE 8
+
+/** The amount of hottest statements kept by the analysis. */
+#define HOTTEST_STATEMENTS 10
+
+/**
+ * A polynomial in the unknown trip count "n", by coefficient of each power.
+ */
+typedef struct {
+	double terms[MAXIMUM_COST_DEGREE + 1];
+} Cost;
+
+/**
+ * The cost of a function (or of the program, whose function is NULL): the
+ * operations of a single call, and how many times it's called. Its operations
+ * are the cost evaluated with the assumed trip count.
+ */
+typedef struct {
+	const Function * function;
+	unsigned int line;
+	Cost cost;
+	Cost invocations;
+	double operations;
+	unsigned int degree;
+} FunctionCost;
+
+/**
+ * A statement of a function (or of the program, if the function is NULL),
+ * with the amount of its own operations run by the whole program.
+ */
+typedef struct {
+	const Instruction * instruction;
+	const Function * function;
+	double operations;
+	unsigned int degree;
+} HotStatement;
+
+/**
+ * The costs of every function (indexed as the nodes of the call graph) and
+ * of the program, and the hottest statements, from the hottest one.
+ */
+typedef struct {
+	const CallGraph * callGraph;
+	FunctionCost * functions;
+	unsigned int size;
+	FunctionCost program;
+	HotStatement hottest[HOTTEST_STATEMENTS];
+	unsigned int hottestSize;
+	double tripCount;
+} CostAnalysis;
+
+/**
+ * Estimates the costs of a program, given its call graph.
+ */
+CostAnalysis * createCostAnalysis(const Program * program, const CallGraph * callGraph);
+
+/**
+ * Destroy a cost analysis.
+ */
+void destroyCostAnalysis(CostAnalysis * costAnalysis);
+
+/**
+ * The value of a cost, for a trip count.
+ */
+double costAt(const Cost * cost, const double tripCount);
+
+/**
+ * The degree of a cost (i.e., its complexity is O(n^degree)).
+ */
+unsigned int costDegree(const Cost * cost);
+
+/**
+ * The cost of a function of the analyzed program, or NULL if it's unknown.
+ */
+const FunctionCost * functionCostOf(const CostAnalysis * costAnalysis, const Function * function);
+
+#endif
@@ -0,0 +1,771 @@
+#include "RangeAnalysis.h"
+
+/**
+ * The values an integer can take, both bounds included. The bounds are wider
+ * than an "int", so the exact result of any operation between two "int"
+ * intervals can be computed before checking whether it fits.
+ */
+typedef struct {
+	int64_t lower;
+	int64_t upper;
+} Interval;
+
+/**
+ * The intervals of the variables of the current frame (by slot), whether
+ * that point of the program is reachable, and whether a call can write the
+ * variables of the frame.
+ */
+typedef struct {
+	Interval * intervals;
+	unsigned int size;
+	boolean reachable;
+	boolean writableByCalls;
+} RangeEnvironment;
+
+/**
+ * The state of the analysis: the environment of the current point of the
+ * program, the stack of the intervals of the expression being evaluated (and
+ * the last value of a whole expression), the amount of calls evaluated so
+ * far, and the depth of the loops being analyzed. While refining a condition
+ * its expressions are evaluated again, but they don't annotate nor forget
+ * anything.
+ */
+typedef struct {
+	RangeAnalysis * rangeAnalysis;
+	const CallGraph * callGraph;
+	RangeEnvironment * environment;
+	Interval * values;
+	unsigned int size;
+	unsigned int capacity;
+	Interval last;
+	unsigned int calls;
+	unsigned int loopDepth;
+	boolean refining;
+} RangeAnalyzer;
+
+/* MODULE INTERNAL STATE */
+
+// The initial capacity of the annotations (must be a power of 2) and of the
+// stack of intervals.
+static const unsigned int _initialCapacity = 64;
+
+// Marks an annotated operation, whose checks are known.
+static const unsigned int _analyzed = 4;
+
+// The deepest loop whose fixed point is computed. Each nested level may
+// analyze its block a few times per iteration of the enclosing loop, so
+// deeper loops assume that every variable of the frame is unknown, and are
+// analyzed once.
+static const unsigned int _maximumLoopDepth = 6;
+
+// How deep a condition is refined (i.e., through how many AND, OR, and NOT).
+static const unsigned int _maximumRefinementDepth = 32;
+
+// Any value of an "int".
+static const Interval _unknown = {INT_MIN, INT_MAX};
+
+static Logger * _logger = NULL;
+
+void initializeRangeAnalysisModule() {
+	_logger = createLogger("RangeAnalysis");
+}
+
+void shutdownRangeAnalysisModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+static void _analyzeBlock(RangeAnalyzer * analyzer, const Block * block);
+static void _analyzeConditional(RangeAnalyzer * analyzer, const Conditional * conditional);
+static void _analyzeFunction(RangeAnalyzer * analyzer, const Function * function);
+static void _analyzeInstruction(RangeAnalyzer * analyzer, const Instruction * instruction);
+static void _analyzeLoop(RangeAnalyzer * analyzer, const Loop * loop);
+static void _annotate(RangeAnalysis * rangeAnalysis, const ArithmeticExpression * arithmeticExpression, const RangeCheck checks);
+static void _arithmeticExpression(void * node, void * context);
+static void _booleanExpression(void * node, void * context);
+static Interval _combine(const ArithmeticExpression * arithmeticExpression, const Interval left, const Interval right, RangeCheck * checks);
+static Interval _compare(const Interval interval, const int type, const Interval other);
+static RangeEnvironment * _copyEnvironment(const RangeEnvironment * environment);
+static RangeEnvironment * _createEnvironment(const unsigned int size);
+static void _destroyEnvironment(RangeEnvironment * environment);
+static Interval _divide(const Interval dividend, const Interval divisor);
+static boolean _equalEnvironments(const RangeEnvironment * environment, const RangeEnvironment * other);
+static Interval _evaluateArithmeticExpression(RangeAnalyzer * analyzer, const ArithmeticExpression * arithmeticExpression);
+static void _evaluateExpression(RangeAnalyzer * analyzer, const NodeKind kind, const void * node);
+static void _expression(void * node, void * context);
+static void _forget(RangeEnvironment * environment);
+static void _functionCall(void * node, void * context);
+static boolean _isEmpty(const Interval interval);
+static void _joinEnvironment(RangeEnvironment * environment, const RangeEnvironment * other);
+static int _negate(const int type);
+static Interval _pop(RangeAnalyzer * analyzer);
+static void _push(RangeAnalyzer * analyzer, const Interval interval);
+static void _refine(RangeAnalyzer * analyzer, RangeEnvironment * environment, const BooleanExpression * condition, const boolean truth, const unsigned int depth);
+static void _refineVariable(RangeAnalyzer * analyzer, RangeEnvironment * environment, const ArithmeticExpression * variable, const int type, const ArithmeticExpression * other);
+static int _reverse(const int type);
+static void _set(RangeEnvironment * environment, const Slot slot, const Interval interval);
+static void _widenEnvironment(RangeEnvironment * environment, const RangeEnvironment * other);
+
+/**
+ * Analyzes the instructions of a block, in order.
+ */
+static void _analyzeBlock(RangeAnalyzer * analyzer, const Block * block) {
+	for (const Instruction * instruction = block->instructions; instruction != NULL; instruction = instruction->next) {
+		_analyzeInstruction(analyzer, instruction);
+	}
+}
+
+/**
+ * Analyzes each branch of a conditional in an environment refined by its
+ * condition (unless the condition calls a function, that could change the
+ * compared variables), and joins both branches.
+ */
+static void _analyzeConditional(RangeAnalyzer * analyzer, const Conditional * conditional) {
+	const unsigned int calls = analyzer->calls;
+	_evaluateExpression(analyzer, BOOLEAN_EXPRESSION_NODE, conditional->condition);
+	RangeEnvironment * environment = analyzer->environment;
+	RangeEnvironment * branches[] = {_copyEnvironment(environment), _copyEnvironment(environment)};
+	const Block * blocks[] = {conditional->ifBlock, conditional->elseBlock};
+	environment->reachable = false;
+	for (unsigned int k = 0; k < 2; ++k) {
+		if (calls == analyzer->calls) {
+			_refine(analyzer, branches[k], conditional->condition, k == 0, 0);
+		}
+	}
+	for (unsigned int k = 0; k < 2; ++k) {
+		analyzer->environment = branches[k];
+		if (branches[k]->reachable) {
+			_analyzeBlock(analyzer, blocks[k]);
+		}
+		_joinEnvironment(environment, branches[k]);
+		_destroyEnvironment(branches[k]);
+	}
+	analyzer->environment = environment;
+}
+
+/**
+ * Analyzes the body of a function in its own frame, where every variable is
+ * unknown until assigned (i.e., the parameters). Afterwards, a call in the
+ * enclosing frame can reach the function, so it can write the variables of
+ * that frame if the function writes outer variables.
+ */
+static void _analyzeFunction(RangeAnalyzer * analyzer, const Function * function) {
+	RangeEnvironment * environment = analyzer->environment;
+	const unsigned int loopDepth = analyzer->loopDepth;
+	analyzer->environment = _createEnvironment(function->frameSize);
+	analyzer->loopDepth = 0;
+	_analyzeBlock(analyzer, function->block);
+	_destroyEnvironment(analyzer->environment);
+	analyzer->environment = environment;
+	analyzer->loopDepth = loopDepth;
+	const CallGraphNode * node = analyzer->callGraph == NULL ? NULL : callGraphNodeOf(analyzer->callGraph, function);
+	if (node == NULL || node->writesOuterVariables) {
+		environment->writableByCalls = true;
+	}
+}
+
+/**
+ * Analyzes an instruction, if it's reachable. A return makes the rest of
+ * the block unreachable.
+ */
+static void _analyzeInstruction(RangeAnalyzer * analyzer, const Instruction * instruction) {
+	if (!analyzer->environment->reachable) {
+		return;
+	}
+	switch (instruction->type) {
+		case DECLARATION_INSTRUCTION_T:
+		case ASSIGNATION_INSTRUCTION_T: {
+			const Assignation * assignation = instruction->type == DECLARATION_INSTRUCTION_T
+				? instruction->declaration->assignation
+				: instruction->assignation;
+			_evaluateExpression(analyzer, EXPRESSION_NODE, assignation->expression);
+			_set(analyzer->environment, assignation->slot,
+				assignation->expression->type == ARITHMETIC_EXPR_T ? analyzer->last : _unknown);
+			break;
+		}
+		case EXPRESSION_INSTRUCTION_T:
+			_evaluateExpression(analyzer, EXPRESSION_NODE, instruction->expression);
+			break;
+		case PRINT_INSTRUCTION_T:
+			_evaluateExpression(analyzer, EXPRESSION_NODE, instruction->print->expression);
+			break;
+		case FUNCTION_CALL_INSTRUCTION_T:
+			_evaluateExpression(analyzer, FUNCTION_CALL_NODE, instruction->functionCall);
+			break;
+		case RETURN_STATEMENT_INSTRUCTION_T:
+			_evaluateExpression(analyzer, EXPRESSION_NODE, instruction->returnStatement->expression);
+			analyzer->environment->reachable = false;
+			break;
+		case FUNCTION_INSTRUCTION_T:
+			_analyzeFunction(analyzer, instruction->function);
+			break;
+		case CONDITIONAL_INSTRUCTION_T:
+			_analyzeConditional(analyzer, instruction->conditional);
+			break;
+		case LOOP_INSTRUCTION_T:
+			_analyzeLoop(analyzer, instruction->loop);
+			break;
+	}
+}
+
+/**
+ * Analyzes a loop until the environment at the beginning of its block
+ * reaches a fixed point: the join of the environment before the loop and
+ * after every iteration, where the loop variable is between the bounds. The
+ * intervals that keep growing are widened to every "int", so it takes a few
+ * iterations. The block is never analyzed if the loop can't run.
+ */
+static void _analyzeLoop(RangeAnalyzer * analyzer, const Loop * loop) {
+	const Interval start = _evaluateArithmeticExpression(analyzer, loop->start);
+	const Interval end = _evaluateArithmeticExpression(analyzer, loop->end);
+	const Interval counter = {start.lower, end.upper};
+	if (_isEmpty(counter)) {
+		return;
+	}
+	RangeEnvironment * environment = analyzer->environment;
+	RangeEnvironment * head = _copyEnvironment(environment);
+	++analyzer->loopDepth;
+	if (_maximumLoopDepth < analyzer->loopDepth) {
+		_forget(head);
+		head->writableByCalls = true;
+	}
+	while (true) {
+		RangeEnvironment * body = _copyEnvironment(head);
+		_set(body, loop->slot, counter);
+		analyzer->environment = body;
+		_analyzeBlock(analyzer, loop->block);
+		RangeEnvironment * next = _copyEnvironment(head);
+		_joinEnvironment(next, body);
+		_destroyEnvironment(body);
+		const boolean stable = _equalEnvironments(next, head);
+		_widenEnvironment(head, next);
+		_destroyEnvironment(next);
+		if (stable) {
+			break;
+		}
+	}
+	--analyzer->loopDepth;
+	analyzer->environment = environment;
+	memcpy(environment->intervals, head->intervals, environment->size * sizeof(Interval));
+	environment->writableByCalls = head->writableByCalls;
+	_destroyEnvironment(head);
+}
+
+/**
+ * Merges the checks that an occurrence of an operation needs with the ones
+ * of its other occurrences.
+ */
+static void _annotate(RangeAnalysis * rangeAnalysis, const ArithmeticExpression * arithmeticExpression, const RangeCheck checks) {
+	if (rangeAnalysis->capacity <= 2 * (rangeAnalysis->size + 1)) {
+		RangeAnnotation * annotations = rangeAnalysis->annotations;
+		const unsigned int capacity = rangeAnalysis->capacity;
+		rangeAnalysis->capacity = capacity == 0 ? _initialCapacity : 2 * capacity;
+		rangeAnalysis->annotations = calloc(rangeAnalysis->capacity, sizeof(RangeAnnotation));
+		rangeAnalysis->size = 0;
+		for (unsigned int k = 0; k < capacity; ++k) {
+			if (annotations[k].expression != NULL) {
+				_annotate(rangeAnalysis, annotations[k].expression, annotations[k].checks);
+			}
+		}
+		free(annotations);
+	}
+	const unsigned int mask = rangeAnalysis->capacity - 1;
+	unsigned int k = hashAddress(arithmeticExpression) & mask;
+	while (rangeAnalysis->annotations[k].expression != NULL && rangeAnalysis->annotations[k].expression != arithmeticExpression) {
+		k = (k + 1) & mask;
+	}
+	RangeAnnotation * annotation = &rangeAnalysis->annotations[k];
+	if (annotation->expression == NULL) {
+		annotation->expression = arithmeticExpression;
+		++rangeAnalysis->size;
+	}
+	annotation->checks |= checks | _analyzed;
+}
+
+/**
+ * Evaluates an arithmetic expression, once its operands are in the stack,
+ * and annotates its checks (if it's an operation).
+ */
+static void _arithmeticExpression(void * node, void * context) {
+	RangeAnalyzer * analyzer = context;
+	const ArithmeticExpression * arithmeticExpression = node;
+	switch (arithmeticExpression->type) {
+		case ADD_T:
+		case SUB_T:
+		case MUL_T:
+		case DIV_T: {
+			const Interval right = _pop(analyzer);
+			const Interval left = _pop(analyzer);
+			RangeCheck checks = NO_CHECK;
+			_push(analyzer, _combine(arithmeticExpression, left, right, &checks));
+			if (!analyzer->refining) {
+				_annotate(analyzer->rangeAnalysis, arithmeticExpression, checks);
+			}
+			break;
+		}
+		case VAR_ARITH_T: {
+			const Slot slot = arithmeticExpression->slot;
+			_push(analyzer, slot.depth == 0 && slot.index < analyzer->environment->size
+				? analyzer->environment->intervals[slot.index]
+				: _unknown);
+			break;
+		}
+		case INT_LITERAL_T:
+			_push(analyzer, (Interval) {arithmeticExpression->value, arithmeticExpression->value});
+			break;
+		case FUNC_CALL_ARITH_T:
+			_push(analyzer, _unknown);
+			break;
+	}
+}
+
+/**
+ * A comparison discards the intervals of its operands.
+ */
+static void _booleanExpression(void * node, void * context) {
+	if (((BooleanExpression *) node)->type == COMPARISON_T) {
+		_pop(context);
+		_pop(context);
+	}
+}
+
+/**
+ * The exact interval of an operation, and the checks it needs: a division
+ * needs a check if its divisor can be zero, and any operation needs a check
+ * if its exact result might not fit in an "int". Because a failed check
+ * stops the program, the result always fits.
+ */
+static Interval _combine(const ArithmeticExpression * arithmeticExpression, const Interval left, const Interval right, RangeCheck * checks) {
+	Interval result = _unknown;
+	switch (arithmeticExpression->type) {
+		case ADD_T:
+			result = (Interval) {left.lower + right.lower, left.upper + right.upper};
+			break;
+		case SUB_T:
+			result = (Interval) {left.lower - right.upper, left.upper - right.lower};
+			break;
+		case MUL_T: {
+			const int64_t products[] = {
+				left.lower * right.lower,
+				left.lower * right.upper,
+				left.upper * right.lower,
+				left.upper * right.upper
+			};
+			result = (Interval) {products[0], products[0]};
+			for (unsigned int k = 1; k < 4; ++k) {
+				result.lower = products[k] < result.lower ? products[k] : result.lower;
+				result.upper = result.upper < products[k] ? products[k] : result.upper;
+			}
+			break;
+		}
+		case DIV_T:
+			if (right.lower <= 0 && 0 <= right.upper) {
+				*checks |= DIVISION_BY_ZERO_CHECK;
+			}
+			result = _divide(left, right);
+			break;
+		default:
+			break;
+	}
+	if (result.lower < INT_MIN || INT_MAX < result.upper) {
+		*checks |= OVERFLOW_CHECK;
+		result.lower = result.lower < INT_MIN ? INT_MIN : result.lower;
+		result.upper = INT_MAX < result.upper ? INT_MAX : result.upper;
+	}
+	return result;
+}
+
+/**
+ * Narrows the interval of a value, knowing that it's related to another one
+ * by a comparison (i.e., "value <type> other" holds). The result is empty
+ * if the comparison can't hold.
+ */
+static Interval _compare(const Interval interval, const int type, const Interval other) {
+	Interval result = interval;
+	switch (type) {
+		case GREATER_THAN_T:
+			result.lower = interval.lower < other.lower + 1 ? other.lower + 1 : interval.lower;
+			break;
+		case GREATER_EQUALS_T:
+			result.lower = interval.lower < other.lower ? other.lower : interval.lower;
+			break;
+		case LESS_THAN_T:
+			result.upper = other.upper - 1 < interval.upper ? other.upper - 1 : interval.upper;
+			break;
+		case LESS_EQUALS_T:
+			result.upper = other.upper < interval.upper ? other.upper : interval.upper;
+			break;
+		case EQUALS_EQUALS_T:
+			result.lower = interval.lower < other.lower ? other.lower : interval.lower;
+			result.upper = other.upper < interval.upper ? other.upper : interval.upper;
+			break;
+		case NOT_EQUALS_T:
+			if (other.lower == other.upper) {
+				result.lower += interval.lower == other.lower;
+				result.upper -= interval.upper == other.upper;
+			}
+			break;
+	}
+	return result;
+}
+
+/**
+ * A copy of an environment.
+ */
+static RangeEnvironment * _copyEnvironment(const RangeEnvironment * environment) {
+	RangeEnvironment * copy = _createEnvironment(environment->size);
+	memcpy(copy->intervals, environment->intervals, environment->size * sizeof(Interval));
+	copy->reachable = environment->reachable;
+	copy->writableByCalls = environment->writableByCalls;
+	return copy;
+}
+
+/**
+ * A reachable environment of the specified amount of slots, where every
+ * variable is unknown.
+ */
+static RangeEnvironment * _createEnvironment(const unsigned int size) {
+	RangeEnvironment * environment = calloc(1, sizeof(RangeEnvironment));
+	environment->intervals = malloc((size == 0 ? 1 : size) * sizeof(Interval));
+	environment->size = size;
+	environment->reachable = true;
+	environment->writableByCalls = false;
+	_forget(environment);
+	return environment;
+}
+
+/**
+ * Destroy an environment.
+ */
+static void _destroyEnvironment(RangeEnvironment * environment) {
+	free(environment->intervals);
+	free(environment);
+}
+
+/**
+ * The interval of a truncated division, whose divisor is not zero (if it
+ * can only be zero, the division always fails, so its result is unknown).
+ * For a divisor of constant sign, the quotient is monotone in both operands,
+ * so its bounds are quotients of the bounds. The only quotient that doesn't
+ * fit in an "int" is the one of INT_MIN by -1.
+ */
+static Interval _divide(const Interval dividend, const Interval divisor) {
+	const Interval negative = {divisor.lower, divisor.upper < -1 ? divisor.upper : -1};
+	const Interval positive = {1 < divisor.lower ? divisor.lower : 1, divisor.upper};
+	boolean empty = true;
+	Interval result = _unknown;
+	for (unsigned int s = 0; s < 2; ++s) {
+		const Interval part = s == 0 ? negative : positive;
+		if (_isEmpty(part)) {
+			continue;
+		}
+		const int64_t quotients[] = {
+			dividend.lower / part.lower,
+			dividend.lower / part.upper,
+			dividend.upper / part.lower,
+			dividend.upper / part.upper
+		};
+		for (unsigned int k = 0; k < 4; ++k) {
+			if (empty) {
+				result = (Interval) {quotients[k], quotients[k]};
+				empty = false;
+			}
+			result.lower = quotients[k] < result.lower ? quotients[k] : result.lower;
+			result.upper = result.upper < quotients[k] ? quotients[k] : result.upper;
+		}
+	}
+	return empty ? _unknown : result;
+}
+
+/**
+ * Whether two environments are the same.
+ */
+static boolean _equalEnvironments(const RangeEnvironment * environment, const RangeEnvironment * other) {
+	return environment->reachable == other->reachable
+		&& environment->writableByCalls == other->writableByCalls
+		&& memcmp(environment->intervals, other->intervals, environment->size * sizeof(Interval)) == 0;
+}
+
+/**
+ * The interval of an arithmetic expression.
+ */
+static Interval _evaluateArithmeticExpression(RangeAnalyzer * analyzer, const ArithmeticExpression * arithmeticExpression) {
+	_evaluateExpression(analyzer, ARITHMETIC_EXPRESSION_NODE, arithmeticExpression);
+	return _pop(analyzer);
+}
+
+/**
+ * Evaluates an expression (or any subtree that contains expressions), with
+ * the iterative traversal of the AST, so deep expressions can't overflow the
+ * C stack. The intervals of the arithmetic operands are kept in a stack.
+ */
+static void _evaluateExpression(RangeAnalyzer * analyzer, const NodeKind kind, const void * node) {
+	static const AbstractSyntaxTreeVisitor evaluator = {
+		.postOrder = {
+			[ARITHMETIC_EXPRESSION_NODE] = _arithmeticExpression,
+			[BOOLEAN_EXPRESSION_NODE] = _booleanExpression,
+			[EXPRESSION_NODE] = _expression,
+			[FUNCTION_CALL_NODE] = _functionCall
+		}
+	};
+	visitAbstractSyntaxTree(&evaluator, kind, (void *) node, analyzer);
+}
+
+/**
+ * A whole arithmetic expression leaves its interval as the last value.
+ */
+static void _expression(void * node, void * context) {
+	RangeAnalyzer * analyzer = context;
+	if (((Expression *) node)->type == ARITHMETIC_EXPR_T) {
+		analyzer->last = _pop(analyzer);
+	}
+}
+
+/**
+ * Every variable of an environment becomes unknown.
+ */
+static void _forget(RangeEnvironment * environment) {
+	for (unsigned int k = 0; k < environment->size; ++k) {
+		environment->intervals[k] = _unknown;
+	}
+}
+
+/**
+ * After a call (and its arguments), the variables of the frame are unknown
+ * if the call can write them.
+ */
+static void _functionCall(void * node, void * context) {
+	RangeAnalyzer * analyzer = context;
+	if (analyzer->refining) {
+		return;
+	}
+	++analyzer->calls;
+	if (analyzer->environment->writableByCalls) {
+		_forget(analyzer->environment);
+	}
+}
+
+/**
+ * Whether an interval has no values.
+ */
+static boolean _isEmpty(const Interval interval) {
+	return interval.upper < interval.lower;
+}
+
+/**
+ * Joins an environment with another one: a variable can take the values of
+ * both of them (but an unreachable environment has no values).
+ */
+static void _joinEnvironment(RangeEnvironment * environment, const RangeEnvironment * other) {
+	environment->writableByCalls |= other->writableByCalls;
+	if (!other->reachable) {
+		return;
+	}
+	if (!environment->reachable) {
+		memcpy(environment->intervals, other->intervals, environment->size * sizeof(Interval));
+		environment->reachable = true;
+		return;
+	}
+	for (unsigned int k = 0; k < environment->size; ++k) {
+		Interval * interval = &environment->intervals[k];
+		const Interval * otherInterval = &other->intervals[k];
+		interval->lower = otherInterval->lower < interval->lower ? otherInterval->lower : interval->lower;
+		interval->upper = interval->upper < otherInterval->upper ? otherInterval->upper : interval->upper;
+	}
+}
+
+/**
+ * The comparison that holds when another one doesn't.
+ */
+static int _negate(const int type) {
+	switch (type) {
+		case GREATER_THAN_T: return LESS_EQUALS_T;
+		case GREATER_EQUALS_T: return LESS_THAN_T;
+		case LESS_THAN_T: return GREATER_EQUALS_T;
+		case LESS_EQUALS_T: return GREATER_THAN_T;
+		case EQUALS_EQUALS_T: return NOT_EQUALS_T;
+		default: return EQUALS_EQUALS_T;
+	}
+}
+
+/**
+ * Pops the interval of the last evaluated operand.
+ */
+static Interval _pop(RangeAnalyzer * analyzer) {
+	return analyzer->values[--analyzer->size];
+}
+
+/**
+ * Pushes the interval of an operand, doubling the capacity of the stack if
+ * it's full.
+ */
+static void _push(RangeAnalyzer * analyzer, const Interval interval) {
+	if (analyzer->size == analyzer->capacity) {
+		analyzer->capacity = analyzer->capacity == 0 ? _initialCapacity : 2 * analyzer->capacity;
+		analyzer->values = realloc(analyzer->values, analyzer->capacity * sizeof(Interval));
+	}
+	analyzer->values[analyzer->size++] = interval;
+}
+
+/**
+ * Narrows an environment, knowing the truth of a condition. Comparisons
+ * narrow their variables (of the current frame), and a conjunction that
+ * holds (or a disjunction that doesn't) narrows with both sides. If a
+ * variable can't take any value, the environment is unreachable.
+ */
+static void _refine(RangeAnalyzer * analyzer, RangeEnvironment * environment, const BooleanExpression * condition, const boolean truth, const unsigned int depth) {
+	if (_maximumRefinementDepth < depth || !environment->reachable) {
+		return;
+	}
+	switch (condition->type) {
+		case AND_T:
+		case OR_T:
+			if ((condition->type == AND_T) == truth) {
+				_refine(analyzer, environment, condition->left, truth, depth + 1);
+				_refine(analyzer, environment, condition->right, truth, depth + 1);
+			}
+			break;
+		case NOT_T:
+			_refine(analyzer, environment, condition->notExpr, !truth, depth + 1);
+			break;
+		case COMPARISON_T: {
+			const int type = truth ? (int) condition->op->type : _negate(condition->op->type);
+			_refineVariable(analyzer, environment, condition->leftArith, type, condition->rightArith);
+			_refineVariable(analyzer, environment, condition->rightArith, _reverse(type), condition->leftArith);
+			break;
+		}
+		case BOOL_LITERAL_T:
+			if (condition->value != truth) {
+				environment->reachable = false;
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+/**
+ * Narrows a compared variable of the current frame (if it's a variable),
+ * knowing that "variable <type> other" holds. The other side is evaluated
+ * in the environment of the analyzer (i.e., before the condition refines
+ * anything), which contains the refined one.
+ */
+static void _refineVariable(RangeAnalyzer * analyzer, RangeEnvironment * environment, const ArithmeticExpression * variable, const int type, const ArithmeticExpression * other) {
+	if (variable->type != VAR_ARITH_T || variable->slot.depth != 0 || environment->size <= variable->slot.index) {
+		return;
+	}
+	analyzer->refining = true;
+	const Interval otherInterval = _evaluateArithmeticExpression(analyzer, other);
+	analyzer->refining = false;
+	Interval * interval = &environment->intervals[variable->slot.index];
+	*interval = _compare(*interval, type, otherInterval);
+	if (_isEmpty(*interval)) {
+		environment->reachable = false;
+	}
+}
+
+/**
+ * The comparison that holds with its operands swapped.
+ */
+static int _reverse(const int type) {
+	switch (type) {
+		case GREATER_THAN_T: return LESS_THAN_T;
+		case GREATER_EQUALS_T: return LESS_EQUALS_T;
+		case LESS_THAN_T: return GREATER_THAN_T;
+		case LESS_EQUALS_T: return GREATER_EQUALS_T;
+		default: return type;
+	}
+}
+
+/**
+ * Assigns an interval to a variable, if it's in the current frame.
+ */
+static void _set(RangeEnvironment * environment, const Slot slot, const Interval interval) {
+	if (slot.depth == 0 && slot.index < environment->size) {
+		environment->intervals[slot.index] = interval;
+	}
+}
+
+/**
+ * Widens an environment with a bigger one: each bound that grows jumps to
+ * the limit of an "int", so a loop reaches its fixed point quickly.
+ */
+static void _widenEnvironment(RangeEnvironment * environment, const RangeEnvironment * other) {
+	environment->writableByCalls |= other->writableByCalls;
+	if (!other->reachable) {
+		return;
+	}
+	if (!environment->reachable) {
+		memcpy(environment->intervals, other->intervals, environment->size * sizeof(Interval));
+		environment->reachable = true;
+		return;
+	}
+	for (unsigned int k = 0; k < environment->size; ++k) {
+		Interval * interval = &environment->intervals[k];
+		if (other->intervals[k].lower < interval->lower) {
+			interval->lower = INT_MIN;
+		}
+		if (interval->upper < other->intervals[k].upper) {
+			interval->upper = INT_MAX;
+		}
+	}
+}
+
+/* PUBLIC FUNCTIONS */
+
+RangeAnalysis * createRangeAnalysis(const Program * program, const CallGraph * callGraph) {
+	RangeAnalysis * rangeAnalysis = calloc(1, sizeof(RangeAnalysis));
+	RangeAnalyzer analyzer = {
+		.rangeAnalysis = rangeAnalysis,
+		.callGraph = callGraph,
+		.environment = _createEnvironment(program->frameSize),
+		.values = NULL,
+		.size = 0,
+		.capacity = 0,
+		.last = _unknown,
+		.calls = 0,
+		.loopDepth = 0,
+		.refining = false
+	};
+	_analyzeBlock(&analyzer, program->block);
+	_destroyEnvironment(analyzer.environment);
+	free(analyzer.values);
+	for (unsigned int k = 0; k < rangeAnalysis->capacity; ++k) {
+		const RangeAnnotation * annotation = &rangeAnalysis->annotations[k];
+		if (annotation->expression == NULL) {
+			continue;
+		}
+		++rangeAnalysis->operations;
+		rangeAnalysis->removedOverflowChecks += (annotation->checks & OVERFLOW_CHECK) == 0;
+		if (annotation->expression->type == DIV_T) {
+			++rangeAnalysis->divisions;
+			rangeAnalysis->removedDivisionChecks += (annotation->checks & DIVISION_BY_ZERO_CHECK) == 0;
+		}
+	}
+	logDebugging(_logger, "Removed %u of %u division-by-zero checks, and %u of %u overflow checks.",
+		rangeAnalysis->removedDivisionChecks, rangeAnalysis->divisions, rangeAnalysis->removedOverflowChecks, rangeAnalysis->operations);
+	return rangeAnalysis;
+}
+
+void destroyRangeAnalysis(RangeAnalysis * rangeAnalysis) {
+	if (rangeAnalysis != NULL) {
+		free(rangeAnalysis->annotations);
+		free(rangeAnalysis);
+	}
+}
+
+RangeCheck rangeChecksOf(const RangeAnalysis * rangeAnalysis, const ArithmeticExpression * arithmeticExpression) {
+	if (rangeAnalysis->capacity != 0) {
+		const unsigned int mask = rangeAnalysis->capacity - 1;
+		unsigned int k = hashAddress(arithmeticExpression) & mask;
+		for (; rangeAnalysis->annotations[k].expression != NULL; k = (k + 1) & mask) {
+			if (rangeAnalysis->annotations[k].expression == arithmeticExpression) {
+				return rangeAnalysis->annotations[k].checks & (DIVISION_BY_ZERO_CHECK | OVERFLOW_CHECK);
+			}
+		}
+	}
+	return DIVISION_BY_ZERO_CHECK | OVERFLOW_CHECK;
+}
@@ -0,0 +1,95 @@
+#ifndef RANGE_ANALYSIS_HEADER
+#define RANGE_ANALYSIS_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTreeVisitor.h"
+#include "../../shared/Hash.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "CallGraph.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializeRangeAnalysisModule();
+
+/** Shutdown module's internal state. */
+void shutdownRangeAnalysisModule();
+
+/**
+ * An abstract interpretation of the program over integer intervals, that
+ * finds the arithmetic operations that never need a runtime check: the
+ * divisions whose divisor can't be zero, and the operations whose result
+ * always fits in an "int".
+ *
+ * The intervals of the variables of the current frame are tracked through
+ * declarations, assignations, the bounds of the loops, and the comparisons
+ * of the conditions (e.g., "n" is positive inside "IF (n > 0)"). Every other
+ * value is unknown: the parameters, the results of the calls, and the
+ * variables of the enclosing frames (because any call could write them). A
+ * call only forgets the variables of the current frame if a function that
+ * writes outer variables was declared in it (see "CallGraph.h"), because no
+ * other function can reach them.
+ *
+ * The execution engines must honor the semantics assumed by the analysis:
+ * the arithmetic is checked (i.e., an overflow or a division by zero stops
+ * the program), and "FOR x IN (a, b)" evaluates its bounds once, and runs
+ * its block for every "x" from "a" to "b", both included (or never, if "a"
+ * is greater than "b"), regardless of the assignations to "x".
+ *
+ * The expressions are hash-consed, so an operation can appear many times
+ * (e.g., in different functions); a check is removed only if it's not needed
+ * in any of them. Operations in unreachable code keep their checks.
+ */
+
+/**
+ * The checks that an arithmetic operation needs (a bitmask).
+ */
+typedef enum {
+	NO_CHECK = 0,
+	DIVISION_BY_ZERO_CHECK = 1,
+	OVERFLOW_CHECK = 2
+} RangeCheck;
+
+/**
+ * The checks of an analyzed operation. An empty entry has a NULL expression.
+ */
+typedef struct {
+	const ArithmeticExpression * expression;
+	RangeCheck checks;
+} RangeAnnotation;
+
+/**
+ * The annotations of every analyzed operation, in an open-addressing hash
+ * table indexed by address, and how many checks were removed.
+ */
+typedef struct {
+	RangeAnnotation * annotations;
+	unsigned int capacity;
+	unsigned int size;
+	unsigned int divisions;
+	unsigned int removedDivisionChecks;
+	unsigned int operations;
+	unsigned int removedOverflowChecks;
+} RangeAnalysis;
+
+/**
+ * Analyzes the value ranges of a program, given its call graph.
+ */
+RangeAnalysis * createRangeAnalysis(const Program * program, const CallGraph * callGraph);
+
+/**
+ * Destroy a range analysis.
+ */
+void destroyRangeAnalysis(RangeAnalysis * rangeAnalysis);
+
+/**
+ * The checks needed by an arithmetic operation (i.e., an addition,
+ * subtraction, multiplication or division). Every check is needed if the
+ * operation wasn't analyzed.
+ */
+RangeCheck rangeChecksOf(const RangeAnalysis * rangeAnalysis, const ArithmeticExpression * arithmeticExpression);
+
+#endif
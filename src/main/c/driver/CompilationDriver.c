@@ -0,0 +1,621 @@
+#include "CompilationDriver.h"
+
+/**
+ * Platform dependent pipes, to feed the compilers of the system.
+ */
+#if defined (_WIN32)
+	#define popen _popen
+	#define pclose _pclose
+#endif
+
+/**
+ * The reports of the analyses of a compilation (a bitmask).
+ */
+typedef enum {
+	NO_REPORT = 0,
+	CALL_GRAPH_REPORT = 1,
+	RANGE_REPORT = 2,
+	COST_REPORT = 4,
+	BYTECODE_REPORT = 8,
+	C_SOURCE_REPORT = 16,
+	ASSEMBLY_REPORT = 32
+} CompilationReport;
+
+/**
+ * The analyses of a compilation (a bitmask), which only run when a report,
+ * an engine or a toolchain needs them.
+ */
+typedef enum {
+	NO_ANALYSIS = 0,
+	CALL_GRAPH_ANALYSIS = 1,
+	RANGE_ANALYSIS = 2,
+	COST_ANALYSIS = 4
+} CompilationAnalysis;
+
+/**
+ * The engine that runs a program after its compilation, if any.
+ */
+typedef enum {
+	NO_ENGINE = 0,
+	INTERPRETER_ENGINE,
+	BYTECODE_ENGINE,
+	NATIVE_ENGINE
+} ExecutionEngine;
+
+/**
+ * The toolchain that builds a program into an executable.
+ */
+typedef enum {
+	C_TOOLCHAIN = 0,
+	ASSEMBLER_TOOLCHAIN
+} Toolchain;
+
+/**
+ * A backend that generates the source of a program for a toolchain.
+ */
+typedef boolean (*SourceGenerator)(const CompilerState * compilerState, FILE * output);
+
+/* MODULE INTERNAL STATE */
+
+// The size of every chunk of the arena of a compilation.
+static const size_t _arenaChunkSize = 256 * 1024;
+
+// The highest degree of the complexity of a function accepted by the report
+// of the costs.
+static unsigned int _maximumCostDegree = 2;
+
+static Logger * _logger = NULL;
+
+void initializeCompilationDriverModule() {
+	_logger = createLogger("CompilationDriver");
+	_maximumCostDegree = strtoul(getStringOrDefault("COST_MAXIMUM_DEGREE", "2"), NULL, 10);
+}
+
+void shutdownCompilationDriverModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+static CompilationAnalysis _analysesOf(const CompilationReport reports, const ExecutionEngine engine, const char * executablePath);
+static CompilationStatus _assemble(const CompilerState * compilerState, const char * executablePath);
+static CompilationStatus _compile(const char * sourcePath, const char * astPath, StreamingState * streamingState, const CompilationReport reports, const ExecutionEngine engine, const char * executablePath, const Toolchain toolchain);
+static NativeCode * _compileNative(const CompilerState * compilerState, const Bytecode * bytecode);
+static void _compileTask(void * argument);
+static void _consumeInstruction(void * instruction, void * context);
+static boolean _countNode(void * node, void * context);
+static CompilationStatus _generate(const CompilerState * compilerState, const char * executablePath);
+static Bytecode * _lower(const CompilerState * compilerState);
+static double _now(void);
+static boolean _pipe(const CompilerState * compilerState, const SourceGenerator sourceGenerator, const char * command);
+static char * _quote(const char * argument);
+static CompilationStatus _reportBytecode(const CompilerState * compilerState);
+static void _reportCallGraph(const CallGraph * callGraph, const double seconds);
+static CompilationStatus _reportCosts(const CostAnalysis * costAnalysis, const double seconds);
+static void _reportRanges(const RangeAnalysis * rangeAnalysis, const double seconds);
+static CompilationStatus _run(const CompilerState * compilerState, const ExecutionEngine engine);
+
+/**
+ * The analyses needed by the reports, the engine and the toolchain of a
+ * compilation. The range analysis is read by every backend but the
+ * interpreter, the cost analysis only by its report, and both are built on
+ * the call graph.
+ */
+static CompilationAnalysis _analysesOf(const CompilationReport reports, const ExecutionEngine engine, const char * executablePath) {
+	CompilationAnalysis analyses = NO_ANALYSIS;
+	if ((reports & (RANGE_REPORT | BYTECODE_REPORT | C_SOURCE_REPORT | ASSEMBLY_REPORT))
+		|| (engine != NO_ENGINE && engine != INTERPRETER_ENGINE) || executablePath != NULL) {
+		analyses |= RANGE_ANALYSIS;
+	}
+	if (reports & COST_REPORT) {
+		analyses |= COST_ANALYSIS;
+	}
+	if (analyses != NO_ANALYSIS || (reports & CALL_GRAPH_REPORT) || engine != NO_ENGINE) {
+		analyses |= CALL_GRAPH_ANALYSIS;
+	}
+	return analyses;
+}
+
+/**
+ * Generates the assembly of a compiled program, and prints it or (if the path
+ * of an executable is provided) builds it with the GNU assembler (see "AS"),
+ * which reads the assembly from a pipe, and the linker (see "LD"). The object
+ * file is written next to the executable, and removed afterwards.
+ */
+static CompilationStatus _assemble(const CompilerState * compilerState, const char * executablePath) {
+	if (executablePath == NULL) {
+		return generateAssembly(compilerState, stdout) ? SUCCEED : FAILED;
+	}
+	const double start = _now();
+	const char * assembler = getStringOrDefault("AS", "as");
+	const char * linker = getStringOrDefault("LD", "ld");
+	char * objectPath = concatenate(2, executablePath, ".o");
+	char * quotedPath = _quote(executablePath);
+	char * quotedObjectPath = _quote(objectPath);
+	char * command = concatenate(9, assembler, " -o ", quotedObjectPath, " - && ", linker, " -o ", quotedPath, " ", quotedObjectPath);
+	const boolean built = _pipe(compilerState, generateAssembly, command);
+	remove(objectPath);
+	free(command);
+	free(quotedObjectPath);
+	free(quotedPath);
+	free(objectPath);
+	if (!built) {
+		logError(_logger, "Cannot build the executable \"%s\" with the assembler \"%s\" and the linker \"%s\".", executablePath, assembler, linker);
+		return FAILED;
+	}
+	logDebugging(_logger, "Assembled the executable \"%s\" in %.3f s.", executablePath, _now() - start);
+	return SUCCEED;
+}
+
+/**
+ * Compiles a single source file and, if the path of an AST file is
+ * provided, stores the flat representation of its AST in it. If a streaming
+ * state is provided, the top-level instructions are streamed instead (and
+ * the program is not analyzed as a whole, because its AST is never complete).
+ * The analyses run only if a report, the engine or the toolchain needs them
+ * (see "_analysesOf"), and their results can be reported, with their times,
+ * the program can be run by an engine, and (if the path of an executable is
+ * provided) it can be built into an executable by a toolchain.
+ */
+static CompilationStatus _compile(const char * sourcePath, const char * astPath, StreamingState * streamingState, const CompilationReport reports, const ExecutionEngine engine, const char * executablePath, const Toolchain toolchain) {
+	Arena * arena = createArena(_arenaChunkSize);
+	CompilerState compilerState = {
+		.abstractSyntaxtTree = NULL,
+		.arena = arena,
+		.callGraph = NULL,
+		.costAnalysis = NULL,
+		.nodeTable = createNodeTable(arena),
+		.rangeAnalysis = NULL,
+		.sourcePath = sourcePath,
+		.stringTable = createStringTable(arena),
+		.streamingState = streamingState,
+		.succeed = false,
+		.symbolTable = createSymbolTable(),
+		.value = 0
+	};
+	const SyntacticAnalysisStatus syntacticAnalysisStatus = parse(&compilerState);
+	logDebugging(_logger, "Hash-consing built %u of %u immutable nodes.",
+		compilerState.nodeTable->size, compilerState.nodeTable->requests);
+	CompilationStatus compilationStatus = SUCCEED;
+	if (syntacticAnalysisStatus == ACCEPT) {
+		if (astPath != NULL) {
+			FlatProgram * flatProgram = flattenProgram(compilerState.abstractSyntaxtTree);
+			const FlatProgramFileStatus status = storeFlatProgram(flatProgram, astPath);
+			if (status != FLAT_PROGRAM_FILE_OK) {
+				logError(_logger, "Cannot store the AST in \"%s\": %s.", astPath, flatProgramFileStatusToString(status));
+				compilationStatus = FAILED;
+			}
+			destroyFlatProgram(flatProgram);
+		}
+		if (streamingState == NULL) {
+			const CompilationAnalysis analyses = _analysesOf(reports, engine, executablePath);
+			if (analyses & CALL_GRAPH_ANALYSIS) {
+				const double start = _now();
+				compilerState.callGraph = createCallGraph(compilerState.abstractSyntaxtTree);
+				if (reports & CALL_GRAPH_REPORT) {
+					_reportCallGraph(compilerState.callGraph, _now() - start);
+				}
+			}
+			if (analyses & RANGE_ANALYSIS) {
+				const double start = _now();
+				compilerState.rangeAnalysis = createRangeAnalysis(compilerState.abstractSyntaxtTree, compilerState.callGraph);
+				if (reports & RANGE_REPORT) {
+					_reportRanges(compilerState.rangeAnalysis, _now() - start);
+				}
+			}
+			if (analyses & COST_ANALYSIS) {
+				const double start = _now();
+				compilerState.costAnalysis = createCostAnalysis(compilerState.abstractSyntaxtTree, compilerState.callGraph);
+				if ((reports & COST_REPORT) && _reportCosts(compilerState.costAnalysis, _now() - start) == FAILED) {
+					compilationStatus = FAILED;
+				}
+			}
+		}
+		// ----------------------------------------------------------------------------------------
+		// Beginning of the Backend... ------------------------------------------------------------
+		if (streamingState == NULL && (reports & BYTECODE_REPORT) && _reportBytecode(&compilerState) == FAILED) {
+			compilationStatus = FAILED;
+		}
+		if (streamingState == NULL && (reports & C_SOURCE_REPORT) && _generate(&compilerState, NULL) == FAILED) {
+			compilationStatus = FAILED;
+		}
+		if (streamingState == NULL && (reports & ASSEMBLY_REPORT) && _assemble(&compilerState, NULL) == FAILED) {
+			compilationStatus = FAILED;
+		}
+		if (streamingState == NULL && executablePath != NULL
+			&& (toolchain == C_TOOLCHAIN ? _generate : _assemble)(&compilerState, executablePath) == FAILED) {
+			compilationStatus = FAILED;
+		}
+		if (streamingState == NULL && engine != NO_ENGINE && _run(&compilerState, engine) == FAILED) {
+			compilationStatus = FAILED;
+		}
+		// ...end of the Backend. -----------------------------------------------------------------
+		// ----------------------------------------------------------------------------------------
+		// logDebugging(_logger, "Releasing AST resources...");
+		// releaseProgram(&compilerState);
+	}
+	else {
+		logError(_logger, "The syntactic-analysis phase rejects the input program.");
+		compilationStatus = FAILED;
+	}
+	destroyCostAnalysis(compilerState.costAnalysis);
+	destroyRangeAnalysis(compilerState.rangeAnalysis);
+	destroyCallGraph(compilerState.callGraph);
+	destroyNodeTable(compilerState.nodeTable);
+	destroyStringTable(compilerState.stringTable);
+	destroySymbolTable(compilerState.symbolTable);
+	destroyArena(arena);
+	return compilationStatus;
+}
+
+/**
+ * Compiles the bytecode of a program into native code, and reports how many
+ * functions were compiled, the size of the code, and the time of the
+ * compilation.
+ */
+static NativeCode * _compileNative(const CompilerState * compilerState, const Bytecode * bytecode) {
+	const double start = _now();
+	NativeCode * nativeCode = createNativeCode(bytecode, compilerState->callGraph);
+	logDebugging(_logger, "Compiled %u of %u functions into %zu bytes of native code in %.3f s.",
+		nativeCode->compiledFunctions, bytecode->size - 1, nativeCode->size, _now() - start);
+	return nativeCode;
+}
+
+/**
+ * A thread pool task, that compiles a single source file of a batch, and
+ * stores its outcome.
+ */
+static void _compileTask(void * argument) {
+	CompilationResult * compilationResult = argument;
+	const double start = _now();
+	compilationResult->compilationStatus = compile(compilationResult->sourcePath);
+	compilationResult->seconds = _now() - start;
+}
+
+/**
+ * The consumer of a streaming compilation, which receives each top-level
+ * instruction once it's parsed and checked, and counts its nodes for the
+ * report of the compilation. No analysis or backend can follow it, since the
+ * bodies of the functions are released with their instructions.
+ */
+static void _consumeInstruction(void * instruction, void * context) {
+	static const AbstractSyntaxTreeVisitor nodeCounter = {
+		.preOrder = {[0 ... NODE_KINDS - 1] = _countNode}
+	};
+	visitAbstractSyntaxTree(&nodeCounter, INSTRUCTION_NODE, instruction, context);
+}
+
+/**
+ * A visitor that counts the nodes of an AST.
+ */
+static boolean _countNode(void * node, void * context) {
+	++*(unsigned long long *) context;
+	return true;
+}
+
+/**
+ * Generates the C source of a compiled program, and prints it or (if the path
+ * of an executable is provided) builds it with the C compiler of the system
+ * (see "CC"), which reads the source from a pipe.
+ */
+static CompilationStatus _generate(const CompilerState * compilerState, const char * executablePath) {
+	if (executablePath == NULL) {
+		return generate(compilerState, stdout) ? SUCCEED : FAILED;
+	}
+	const double start = _now();
+	const char * compiler = getStringOrDefault("CC", "cc");
+	char * quotedPath = _quote(executablePath);
+	char * command = concatenate(4, compiler, " -O2 -x c -o ", quotedPath, " -");
+	const boolean built = _pipe(compilerState, generate, command);
+	free(command);
+	free(quotedPath);
+	if (!built) {
+		logError(_logger, "Cannot build the executable \"%s\" with the C compiler \"%s\".", executablePath, compiler);
+		return FAILED;
+	}
+	logDebugging(_logger, "Built the executable \"%s\" in %.3f s.", executablePath, _now() - start);
+	return SUCCEED;
+}
+
+/**
+ * Lowers a compiled program into bytecode, and reports its size and the time
+ * of the lowering.
+ */
+static Bytecode * _lower(const CompilerState * compilerState) {
+	const double start = _now();
+	Bytecode * bytecode = createBytecode(compilerState->abstractSyntaxtTree, compilerState->callGraph, compilerState->rangeAnalysis);
+	if (bytecode == NULL) {
+		logError(_logger, "The program cannot be lowered into bytecode.");
+		return NULL;
+	}
+	logDebugging(_logger, "Lowered %u functions into %u bytecode instructions in %.3f s.",
+		bytecode->size - 1, bytecode->instructions, _now() - start);
+	return bytecode;
+}
+
+/**
+ * The value of a monotonic clock, in seconds.
+ *
+ * @see https://man7.org/linux/man-pages/man3/clock_gettime.3.html
+ */
+static double _now(void) {
+#if defined (CLOCK_MONOTONIC)
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+#else
+	return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * Generates the source of a compiled program into the standard input of a
+ * shell command (e.g., a compiler), and returns whether both succeed.
+ */
+static boolean _pipe(const CompilerState * compilerState, const SourceGenerator sourceGenerator, const char * command) {
+	FILE * pipe = popen(command, "w");
+	if (pipe == NULL) {
+		return false;
+	}
+#if defined (SIGPIPE)
+	// If the command exits early, the writes to the pipe fail instead.
+	void (*handler)(int) = signal(SIGPIPE, SIG_IGN);
+#endif
+	const boolean generated = sourceGenerator(compilerState, pipe);
+	const int status = pclose(pipe);
+#if defined (SIGPIPE)
+	signal(SIGPIPE, handler);
+#endif
+	return generated && status == 0;
+}
+
+/**
+ * Quotes an argument of a shell command (i.e., between single quotes, where
+ * every single quote is closed, escaped, and reopened). The returned string
+ * must be freed.
+ */
+static char * _quote(const char * argument) {
+	char * quoted = malloc(4 * strlen(argument) + 3);
+	char * end = quoted;
+	*end++ = '\'';
+	for (const char * character = argument; *character != '\0'; ++character) {
+		if (*character == '\'') {
+			memcpy(end, "'\\''", 4);
+			end += 4;
+		}
+		else {
+			*end++ = *character;
+		}
+	}
+	*end++ = '\'';
+	*end = '\0';
+	return quoted;
+}
+
+/**
+ * Prints the listing of the bytecode of a program.
+ */
+static CompilationStatus _reportBytecode(const CompilerState * compilerState) {
+	Bytecode * bytecode = _lower(compilerState);
+	if (bytecode == NULL) {
+		return FAILED;
+	}
+	disassembleBytecode(bytecode, stdout);
+	destroyBytecode(bytecode);
+	return SUCCEED;
+}
+
+/**
+ * Reports the size of the call graph of a program, how many of its functions
+ * are recursive, and how many have each kind of effect.
+ */
+static void _reportCallGraph(const CallGraph * callGraph, const double seconds) {
+	unsigned int printing = 0;
+	unsigned int writing = 0;
+	unsigned int parametric = 0;
+	unsigned int pure = 0;
+	for (unsigned int k = 0; k < callGraph->size; ++k) {
+		const CallGraphNode * node = &callGraph->nodes[k];
+		printing += node->prints;
+		writing += node->writesOuterVariables;
+		parametric += node->dependsOnlyOnParameters;
+		pure += isPureFunction(node);
+	}
+	logInformation(_logger, "Analyzed %u functions and %u calls in %.3f s: %u strongly connected components, %u recursive functions.",
+		callGraph->size, callGraph->calls, seconds, callGraph->components, callGraph->recursiveFunctions);
+	logInformation(_logger, "%u functions print, %u write outer variables, %u depend only on their parameters, and %u are pure.",
+		printing, writing, parametric, pure);
+}
+
+/**
+ * Reports the estimated cost of every function (in source order), the
+ * hottest statements, and the cost of the program. Fails if the complexity
+ * of any function (or of the program) exceeds the maximum degree.
+ */
+static CompilationStatus _reportCosts(const CostAnalysis * costAnalysis, const double seconds) {
+	logInformation(_logger, "Estimated the costs of %u functions in %.3f s, assuming %g iterations for every loop of unknown bounds.",
+		costAnalysis->size, seconds, costAnalysis->tripCount);
+	unsigned int degree = costAnalysis->program.degree;
+	for (unsigned int k = 0; k < costAnalysis->size; ++k) {
+		const FunctionCost * functionCost = &costAnalysis->functions[k];
+		logInformation(_logger, "Line %u: \"%s\" runs %.4g operations per call, in O(n^%u), and is called %.4g times.",
+			functionCost->line, functionCost->function->functionName, functionCost->operations, functionCost->degree,
+			costAt(&functionCost->invocations, costAnalysis->tripCount));
+		degree = degree < functionCost->degree ? functionCost->degree : degree;
+	}
+	for (unsigned int k = 0; k < costAnalysis->hottestSize; ++k) {
+		const HotStatement * hotStatement = &costAnalysis->hottest[k];
+		logInformation(_logger, "Hot statement #%u on line %u (in \"%s\"): %.4g operations, in O(n^%u).",
+			k + 1, hotStatement->instruction->line, hotStatement->function == NULL ? "PROGRAM" : hotStatement->function->functionName,
+			hotStatement->operations, hotStatement->degree);
+	}
+	logInformation(_logger, "The program runs %.4g operations, in O(n^%u).", costAnalysis->program.operations, costAnalysis->program.degree);
+	if (_maximumCostDegree < degree) {
+		logError(_logger, "The estimated complexity O(n^%u) exceeds the maximum of O(n^%u) (see \"COST_MAXIMUM_DEGREE\").",
+			degree, _maximumCostDegree);
+		return FAILED;
+	}
+	return SUCCEED;
+}
+
+/**
+ * Reports how many runtime checks of the arithmetic operations are removed
+ * by the analysis of their value ranges.
+ */
+static void _reportRanges(const RangeAnalysis * rangeAnalysis, const double seconds) {
+	logInformation(_logger, "Analyzed the ranges of %u operations in %.3f s: removed %u of %u division-by-zero checks, and %u of %u overflow checks.",
+		rangeAnalysis->operations, seconds, rangeAnalysis->removedDivisionChecks, rangeAnalysis->divisions,
+		rangeAnalysis->removedOverflowChecks, rangeAnalysis->operations);
+}
+
+/**
+ * Runs a compiled program with an engine, and reports how many instructions
+ * and calls it ran, and its time.
+ */
+static CompilationStatus _run(const CompilerState * compilerState, const ExecutionEngine engine) {
+	Bytecode * bytecode = NULL;
+	if (engine != INTERPRETER_ENGINE && (bytecode = _lower(compilerState)) == NULL) {
+		return FAILED;
+	}
+	NativeCode * nativeCode = engine == NATIVE_ENGINE ? _compileNative(compilerState, bytecode) : NULL;
+	const double start = _now();
+	const ComputationResult computationResult = engine == INTERPRETER_ENGINE
+		? computeProgram(compilerState->abstractSyntaxtTree, compilerState->callGraph, stdout)
+		: runBytecode(bytecode, nativeCode, stdout);
+	logDebugging(_logger, "Ran %llu instructions and %llu calls in %.3f s.",
+		computationResult.instructions, computationResult.calls, _now() - start);
+	destroyNativeCode(nativeCode);
+	destroyBytecode(bytecode);
+	if (!computationResult.succeed) {
+		logError(_logger, "The execution of the program failed.");
+		return FAILED;
+	}
+	return SUCCEED;
+}
+
+/* PUBLIC FUNCTIONS */
+
+CompilationStatus compile(const char * sourcePath) {
+	return _compile(sourcePath, NULL, NULL, NO_REPORT, NO_ENGINE, NULL, C_TOOLCHAIN);
+}
+
+CompilationStatus compileWithCallGraphReport(const char * sourcePath) {
+	return _compile(sourcePath, NULL, NULL, CALL_GRAPH_REPORT, NO_ENGINE, NULL, C_TOOLCHAIN);
+}
+
+CompilationStatus compileWithRangeReport(const char * sourcePath) {
+	return _compile(sourcePath, NULL, NULL, RANGE_REPORT, NO_ENGINE, NULL, C_TOOLCHAIN);
+}
+
+CompilationStatus compileWithCostReport(const char * sourcePath) {
+	return _compile(sourcePath, NULL, NULL, COST_REPORT, NO_ENGINE, NULL, C_TOOLCHAIN);
+}
+
+CompilationStatus compileAndRun(const char * sourcePath) {
+	return _compile(sourcePath, NULL, NULL, NO_REPORT, INTERPRETER_ENGINE, NULL, C_TOOLCHAIN);
+}
+
+CompilationStatus compileAndRunBytecode(const char * sourcePath) {
+	return _compile(sourcePath, NULL, NULL, NO_REPORT, BYTECODE_ENGINE, NULL, C_TOOLCHAIN);
+}
+
+CompilationStatus compileAndRunNative(const char * sourcePath) {
+	return _compile(sourcePath, NULL, NULL, NO_REPORT, NATIVE_ENGINE, NULL, C_TOOLCHAIN);
+}
+
+CompilationStatus compileToC(const char * sourcePath) {
+	return _compile(sourcePath, NULL, NULL, C_SOURCE_REPORT, NO_ENGINE, NULL, C_TOOLCHAIN);
+}
+
+CompilationStatus compileToExecutable(const char * sourcePath, const char * executablePath) {
+	return _compile(sourcePath, NULL, NULL, NO_REPORT, NO_ENGINE, executablePath, C_TOOLCHAIN);
+}
+
+CompilationStatus compileToAssembly(const char * sourcePath) {
+	return _compile(sourcePath, NULL, NULL, ASSEMBLY_REPORT, NO_ENGINE, NULL, C_TOOLCHAIN);
+}
+
+CompilationStatus compileToAssembledExecutable(const char * sourcePath, const char * executablePath) {
+	return _compile(sourcePath, NULL, NULL, NO_REPORT, NO_ENGINE, executablePath, ASSEMBLER_TOOLCHAIN);
+}
+
+CompilationStatus compileWithBytecodeListing(const char * sourcePath) {
+	return _compile(sourcePath, NULL, NULL, BYTECODE_REPORT, NO_ENGINE, NULL, C_TOOLCHAIN);
+}
+
+CompilationStatus compileStreaming(const char * sourcePath) {
+	unsigned long long nodes = 0;
+	Arena * arena = createArena(_arenaChunkSize);
+	StreamingState streamingState = {
+		.consume = _consumeInstruction,
+		.context = &nodes,
+		.arena = arena,
+		.nodeTable = createNodeTable(arena),
+		.stringTable = createStringTable(arena),
+		.skeleton = NULL,
+		.instructions = 0,
+		.keptInstructions = 0,
+		.releases = 0
+	};
+	const CompilationStatus compilationStatus = _compile(sourcePath, NULL, &streamingState, NO_REPORT, NO_ENGINE, NULL, C_TOOLCHAIN);
+	logDebugging(_logger, "Streamed %llu top-level instructions (%llu nodes), and released the AST %u times. The skeleton kept %u instructions.",
+		streamingState.instructions, nodes, streamingState.releases, streamingState.keptInstructions);
+	destroyNodeTable(streamingState.nodeTable);
+	destroyStringTable(streamingState.stringTable);
+	destroyArena(arena);
+	return compilationStatus;
+}
+
+CompilationStatus compileToAbstractSyntaxTreeFile(const char * sourcePath, const char * astPath) {
+	return _compile(sourcePath, astPath, NULL, NO_REPORT, NO_ENGINE, NULL, C_TOOLCHAIN);
+}
+
+CompilationStatus compileFromAbstractSyntaxTreeFile(const char * astPath) {
+	SourceFile * sourceFile = openSourceFile(astPath);
+	if (sourceFile == NULL) {
+		logError(_logger, "Cannot load the AST from \"%s\": %s.", astPath, strerror(errno));
+		return FAILED;
+	}
+	const boolean isAbstractSyntaxTreeFile = isMappedSourceFile(sourceFile) && isFlatProgramContent(sourceFile->content, sourceFile->size);
+	closeSourceFile(sourceFile);
+	if (!isAbstractSyntaxTreeFile) {
+		logError(_logger, "Cannot load the AST from \"%s\": %s.", astPath, flatProgramFileStatusToString(FLAT_PROGRAM_FILE_INVALID_FORMAT));
+		return FAILED;
+	}
+	return compile(astPath);
+}
+
+CompilationStatus compileAll(const unsigned int count, const char ** sourcePaths) {
+	const unsigned int processors = availableProcessors();
+	const unsigned int threads = count < processors ? count : processors;
+	logDebugging(_logger, "Compiling %u source files on %u threads...", count, threads);
+	CompilationResult * compilationResults = calloc(count, sizeof(CompilationResult));
+	const double start = _now();
+	ThreadPool * threadPool = createThreadPool(threads);
+	for (unsigned int k = 0; k < count; ++k) {
+		compilationResults[k].sourcePath = sourcePaths[k];
+		submitToThreadPool(threadPool, _compileTask, &compilationResults[k]);
+	}
+	waitForThreadPool(threadPool);
+	destroyThreadPool(threadPool);
+	const double seconds = _now() - start;
+	unsigned int failures = 0;
+	double sequentialSeconds = 0;
+	for (unsigned int k = 0; k < count; ++k) {
+		const CompilationResult * compilationResult = &compilationResults[k];
+		if (compilationResult->compilationStatus == SUCCEED) {
+			logInformation(_logger, "%s: succeed (%.3f s).", compilationResult->sourcePath, compilationResult->seconds);
+		}
+		else {
+			logError(_logger, "%s: failed (%.3f s).", compilationResult->sourcePath, compilationResult->seconds);
+			++failures;
+		}
+		sequentialSeconds += compilationResult->seconds;
+	}
+	logInformation(_logger, "Compiled %u source files in %.3f s on %u threads (%u succeed, %u failed, %.3f s of total work).",
+		count, seconds, threads, count - failures, failures, sequentialSeconds);
+	free(compilationResults);
+	return failures == 0 ? SUCCEED : FAILED;
+}
@@ -0,0 +1,164 @@
+#ifndef COMPILATION_DRIVER_HEADER
+#define COMPILATION_DRIVER_HEADER
+
+#include "../backend/code-generation/AssemblyGenerator.h"
+#include "../backend/code-generation/Generator.h"
+#include "../backend/domain-specific/Bytecode.h"
+#include "../backend/domain-specific/Calculator.h"
+#include "../backend/domain-specific/JustInTimeCompiler.h"
+#include "../backend/domain-specific/VirtualMachine.h"
+#include "../backend/semantic-analysis/CallGraph.h"
+#include "../backend/semantic-analysis/CostAnalysis.h"
+#include "../backend/semantic-analysis/RangeAnalysis.h"
+#include "../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../frontend/syntactic-analysis/AbstractSyntaxTreeVisitor.h"
+#include "../frontend/syntactic-analysis/FlatAbstractSyntaxTree.h"
+#include "../frontend/syntactic-analysis/FlatAbstractSyntaxTreeFile.h"
+#include "../frontend/syntactic-analysis/SyntacticAnalyzer.h"
+#include "../shared/CompilerState.h"
+#include "../shared/Environment.h"
+#include "../shared/Logger.h"
+#include "../shared/NodeTable.h"
+#include "../shared/SourceFile.h"
+#include "../shared/StringTable.h"
+#include "../shared/ThreadPool.h"
+#include <signal.h>
+#include <stdlib.h>
+#include <time.h>
+
+/** Initialize module's internal state. */
+void initializeCompilationDriverModule();
+
+/** Shutdown module's internal state. */
+void shutdownCompilationDriverModule();
+
+/**
+ * The outcome of the compilation of a single source file.
+ */
+typedef struct {
+	const char * sourcePath;
+	CompilationStatus compilationStatus;
+	double seconds;
+} CompilationResult;
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL), with its own compiler state.
+ */
+CompilationStatus compile(const char * sourcePath);
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL), and reports its call graph: the amount of functions, calls and
+ * recursive functions, the effects of the functions, and the time of the
+ * analysis.
+ */
+CompilationStatus compileWithCallGraphReport(const char * sourcePath);
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL), and reports how many runtime checks of its arithmetic operations
+ * (i.e., of division by zero and of overflow) the analysis of their value
+ * ranges removes, and the time of the analysis.
+ */
+CompilationStatus compileWithRangeReport(const char * sourcePath);
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL), and reports the estimated cost of every function, its hottest
+ * statements, the cost of the whole program, and the time of the analysis.
+ * Fails if the complexity of any function exceeds the maximum degree.
+ */
+CompilationStatus compileWithCostReport(const char * sourcePath);
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL), and runs it with the interpreter, printing its output. Fails if
+ * the program stops at a runtime error (e.g., a division by zero).
+ */
+CompilationStatus compileAndRun(const char * sourcePath);
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL), lowers it into bytecode, and runs it with the virtual machine,
+ * printing its output (as "compileAndRun" does).
+ */
+CompilationStatus compileAndRunBytecode(const char * sourcePath);
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL), lowers it into bytecode, compiles its integer functions into native
+ * code, and runs it with the virtual machine (as "compileAndRunBytecode"
+ * does), calling the native code of those functions.
+ */
+CompilationStatus compileAndRunNative(const char * sourcePath);
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL), and prints its translation into C (see "Generator.h").
+ */
+CompilationStatus compileToC(const char * sourcePath);
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL), translates it into C, and builds an executable with the C compiler
+ * of the system (i.e., "cc", or the one of the "CC" environment variable),
+ * with optimizations.
+ */
+CompilationStatus compileToExecutable(const char * sourcePath, const char * executablePath);
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL), and prints its translation into x86-64 assembly (see
+ * "AssemblyGenerator.h").
+ */
+CompilationStatus compileToAssembly(const char * sourcePath);
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL), translates it into x86-64 assembly, and builds a static executable
+ * with the GNU assembler and linker (i.e., "as" and "ld", or the ones of the
+ * "AS" and "LD" environment variables), without a C compiler.
+ */
+CompilationStatus compileToAssembledExecutable(const char * sourcePath, const char * executablePath);
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL), lowers it into bytecode, and prints its listing.
+ */
+CompilationStatus compileWithBytecodeListing(const char * sourcePath);
+
+/**
+ * Compiles a single source file (or the standard input, if the path is
+ * NULL) in streaming mode: each top-level instruction is checked as soon as
+ * it's parsed, and released afterwards, so the memory of the compilation
+ * doesn't grow with the size of the program (only with its function
+ * signatures and global variables). It only parses and checks the program:
+ * since the bodies of the functions are released, it can neither be
+ * analyzed, nor run, nor built.
+ */
+CompilationStatus compileStreaming(const char * sourcePath);
+
+/**
+ * Compiles a single source file, and stores its AST in a binary file, so it
+ * can be loaded later without lexing or parsing the source again.
+ */
+CompilationStatus compileToAbstractSyntaxTreeFile(const char * sourcePath, const char * astPath);
+
+/**
+ * Compiles a program from the AST stored in a binary file, which is mapped,
+ * checked and rebuilt without lexing or parsing its source, and then goes
+ * through the same phases. Fails if the file is not an AST file. Any other
+ * compilation also accepts an AST file in place of a source file (e.g., to
+ * run it, or to build it into an executable).
+ */
+CompilationStatus compileFromAbstractSyntaxTreeFile(const char * astPath);
+
+/**
+ * Compiles many source files concurrently, on a thread pool sized to the
+ * amount of processors. Reports the status and time of every file, and the
+ * aggregate timing of the batch. Fails if any file fails.
+ */
+CompilationStatus compileAll(const unsigned int count, const char ** sourcePaths);
+
+#endif
@@ -18,12 +18,53 @@ void shutdownFlexActionsModule() {
 
 /* PRIVATE FUNCTIONS */
 
+static void _appendToStringLiteral(StringLiteralBuffer * stringLiteral, const char * characters, const unsigned int length);
+static const char * _identifier(LexicalAnalyzerContext * lexicalAnalyzerContext);
 static void _logLexicalAnalyzerContext(const char * functionName, LexicalAnalyzerContext * lexicalAnalyzerContext);
+static void _openScope(LexicalAnalyzerContext * lexicalAnalyzerContext, const Symbol * function);
+static Token _redeclaration(LexicalAnalyzerContext * lexicalAnalyzerContext);
+static Token _typedToken(const Symbol * symbol);
+static void _variable(LexicalAnalyzerContext * lexicalAnalyzerContext, const char * name, const Symbol * symbol);
 
 /**
- * Logs a lexical-analyzer context in DEBUGGING level.
+ * Appends characters to the string literal being scanned, doubling the
+ * capacity of the buffer when it's exhausted.
+ */
+static void _appendToStringLiteral(StringLiteralBuffer * stringLiteral, const char * characters, const unsigned int length) {
+	if (stringLiteral->capacity < stringLiteral->length + length) {
+		unsigned int capacity = stringLiteral->capacity == 0 ? 64 : stringLiteral->capacity;
+		while (capacity < stringLiteral->length + length) {
+			capacity *= 2;
+		}
+		stringLiteral->characters = realloc(stringLiteral->characters, capacity);
+		stringLiteral->capacity = capacity;
+	}
+	memcpy(stringLiteral->characters + stringLiteral->length, characters, length);
+	stringLiteral->length += length;
+}
+
+/**
+ * Interns the lexeme of an identifier, so it's hashed only once: its handle
+ * is both its name in the AST and its key in the symbol table. In a streaming
+ * compilation, the identifiers are interned in the memory of the skeleton,
+ * because the symbol table outlives every released instruction.
+ */
+static const char * _identifier(LexicalAnalyzerContext * lexicalAnalyzerContext) {
+	const CompilerState * compilerState = lexicalAnalyzerContext->compilerState;
+	StringTable * stringTable = compilerState->streamingState == NULL
+		? compilerState->stringTable
+		: compilerState->streamingState->stringTable;
+	return intern(stringTable, lexicalAnalyzerContext->lexeme, lexicalAnalyzerContext->length);
+}
+
+/**
+ * Logs a lexical-analyzer context in DEBUGGING level. The lexeme is escaped
+ * only if the message will be visible.
  */
 static void _logLexicalAnalyzerContext(const char * functionName, LexicalAnalyzerContext * lexicalAnalyzerContext) {
+	if (!isLoggingEnabled(_logger, DEBUGGING)) {
+		return;
+	}
 	char * escapedLexeme = escape(lexicalAnalyzerContext->lexeme);
 	logDebugging(_logger, "%s: %s (context = %d, length = %d, line = %d)",
 		functionName,
@@ -34,6 +75,54 @@ static void _logLexicalAnalyzerContext(const char * functionName, LexicalAnalyze
 	free(escapedLexeme);
 }
 
+/**
+ * Opens the scope of the program or a function (for its parameters), that
+ * its block will reuse. Both also open a frame (the function is NULL for the
+ * program).
+ */
+static void _openScope(LexicalAnalyzerContext * lexicalAnalyzerContext, const Symbol * function) {
+	pushFrame(lexicalAnalyzerContext->compilerState->symbolTable, function);
+	lexicalAnalyzerContext->isScopeOpen = true;
+}
+
+/**
+ * Rejects the redeclaration of an identifier in the same scope (i.e., a
+ * variable, a parameter or a function), since its binding would change the
+ * type of a slot already in use. The parser fails on the unknown token.
+ */
+static Token _redeclaration(LexicalAnalyzerContext * lexicalAnalyzerContext) {
+	logError(_logger, "The identifier \"%.*s\" is already declared in this scope (on line %d).",
+		lexicalAnalyzerContext->length, lexicalAnalyzerContext->lexeme, lexicalAnalyzerContext->line);
+	return YYUNDEF;
+}
+
+/**
+ * The token of a bound identifier, according to its kind and type.
+ */
+static Token _typedToken(const Symbol * symbol) {
+	const boolean isFunction = symbol->kind == FUNCTION_SYMBOL;
+	switch (symbol->type) {
+		case INT_T:
+			return isFunction ? INT_FUNCTION_NAME : INT_VAR_NAME;
+		case BOOL_T:
+			return isFunction ? BOOL_FUNCTION_NAME : BOOL_VAR_NAME;
+		default:
+			return isFunction ? STRING_FUNCTION_NAME : STRING_VAR_NAME;
+	}
+}
+
+/**
+ * Sets the semantic value of a variable name: its interned name, and the
+ * location of its binding (if any), relative to the innermost frame.
+ */
+static void _variable(LexicalAnalyzerContext * lexicalAnalyzerContext, const char * name, const Symbol * symbol) {
+	const SymbolTable * symbolTable = lexicalAnalyzerContext->compilerState->symbolTable;
+	Variable * variable = &lexicalAnalyzerContext->semanticValue->variable;
+	variable->name = name;
+	variable->slot.depth = symbol == NULL ? 0 : symbolTable->frameDepth - 1 - symbol->frame;
+	variable->slot.index = symbol == NULL ? 0 : symbol->slot;
+}
+
 /* PUBLIC FUNCTIONS */
 
 void BeginMultilineCommentLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
@@ -95,6 +184,21 @@ Token ComparisonOperatorLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerCon
 
 Token BraceLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext, Token token) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
+    SymbolTable * symbolTable = lexicalAnalyzerContext->compilerState->symbolTable;
+    if (token == CLOSE_BRACE) {
+        lexicalAnalyzerContext->semanticValue->integer = popScope(symbolTable);
+    }
+    else if (lexicalAnalyzerContext->loopVariable != NULL) {
+        pushScope(symbolTable);
+        bindSymbol(symbolTable, lexicalAnalyzerContext->loopVariable, VARIABLE_SYMBOL, INT_T);
+        lexicalAnalyzerContext->loopVariable = NULL;
+    }
+    else if (lexicalAnalyzerContext->isScopeOpen) {
+        lexicalAnalyzerContext->isScopeOpen = false;
+    }
+    else {
+        pushScope(symbolTable);
+    }
     return token;
 }
 
@@ -110,24 +214,84 @@ Token AssignmentLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
 
 Token IdentifierLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
-    lexicalAnalyzerContext->semanticValue->string = strdup(lexicalAnalyzerContext->lexeme);
+    const char * name = _identifier(lexicalAnalyzerContext);
+    const Symbol * symbol = lookupSymbol(lexicalAnalyzerContext->compilerState->symbolTable, name);
+    if (symbol != NULL && symbol->kind == FUNCTION_SYMBOL) {
+        lexicalAnalyzerContext->semanticValue->string = name;
+    }
+    else {
+        _variable(lexicalAnalyzerContext, name, symbol);
+    }
+    return symbol == NULL ? VAR_NAME : _typedToken(symbol);
+}
+
+Token ProgramKeywordLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
+    _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
+    _openScope(lexicalAnalyzerContext, NULL);
+    return PROGRAM;
+}
+
+Token TypeKeywordLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext, Token token) {
+    _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
+    lexicalAnalyzerContext->declaredType = token == INT ? INT_T : token == BOOL ? BOOL_T : STRING_T;
+    return token;
+}
+
+Token LoopKeywordLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
+    _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
+    lexicalAnalyzerContext->declaredType = INT_T;
+    lexicalAnalyzerContext->isLoopHeader = true;
+    return FOR;
+}
+
+Token FunctionDeclarationLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
+    _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
+    const char * name = _identifier(lexicalAnalyzerContext);
+    lexicalAnalyzerContext->semanticValue->string = name;
+    const Symbol * function = bindSymbol(lexicalAnalyzerContext->compilerState->symbolTable, name, FUNCTION_SYMBOL, lexicalAnalyzerContext->declaredType);
+    if (function == NULL) {
+        return _redeclaration(lexicalAnalyzerContext);
+    }
+    _openScope(lexicalAnalyzerContext, function);
+    return FUNCTION_NAME;
+}
+
+Token VariableDeclarationLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
+    _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
+    const char * name = _identifier(lexicalAnalyzerContext);
+    if (lexicalAnalyzerContext->isLoopHeader) {
+        // The variable of a loop is bound when its block opens, in a new
+        // scope, so it takes the next slot of the frame.
+        const SymbolTable * symbolTable = lexicalAnalyzerContext->compilerState->symbolTable;
+        Variable * variable = &lexicalAnalyzerContext->semanticValue->variable;
+        variable->name = name;
+        variable->slot.depth = 0;
+        variable->slot.index = symbolTable->frames[symbolTable->frameDepth - 1].used;
+        lexicalAnalyzerContext->isLoopHeader = false;
+        lexicalAnalyzerContext->loopVariable = variable->name;
+        return VAR_NAME;
+    }
+    // The scope of a function is open since its name only while its
+    // parameters are declared.
+    SymbolTable * symbolTable = lexicalAnalyzerContext->compilerState->symbolTable;
+    const Symbol * symbol = lexicalAnalyzerContext->isScopeOpen
+        ? bindParameter(symbolTable, name, lexicalAnalyzerContext->declaredType)
+        : bindSymbol(symbolTable, name, VARIABLE_SYMBOL, lexicalAnalyzerContext->declaredType);
+    if (symbol == NULL) {
+        return _redeclaration(lexicalAnalyzerContext);
+    }
+    _variable(lexicalAnalyzerContext, name, symbol);
     return VAR_NAME;
 }
 
 void BeginStringLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
-    lexicalAnalyzerContext->semanticValue->string = strdup("");
+    lexicalAnalyzerContext->stringLiteral.length = 0;
 }
 
 void StringContentLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
-    char* newContent = realloc(lexicalAnalyzerContext->semanticValue->string, 
-                                strlen(lexicalAnalyzerContext->semanticValue->string) + 
-                                strlen(lexicalAnalyzerContext->lexeme) + 1);
-    if (newContent) {
-        lexicalAnalyzerContext->semanticValue->string = newContent;
-        strcat(lexicalAnalyzerContext->semanticValue->string, lexicalAnalyzerContext->lexeme);
-    }
+    _appendToStringLiteral(&lexicalAnalyzerContext->stringLiteral, lexicalAnalyzerContext->lexeme, lexicalAnalyzerContext->length);
 }
 
 void EscapedCharacterLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
@@ -139,16 +303,13 @@ void EscapedCharacterLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContex
         case 't': escapedChar = '\t'; break;
         default: escapedChar = lexicalAnalyzerContext->lexeme[1];
     }
-    char* newContent = realloc(lexicalAnalyzerContext->semanticValue->string, 
-                                strlen(lexicalAnalyzerContext->semanticValue->string) + 2);
-    if (newContent) {
-        lexicalAnalyzerContext->semanticValue->string = newContent;
-        strncat(lexicalAnalyzerContext->semanticValue->string, &escapedChar, 1);
-    }
+    _appendToStringLiteral(&lexicalAnalyzerContext->stringLiteral, &escapedChar, 1);
 }
 
 Token EndStringLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
+    lexicalAnalyzerContext->semanticValue->string = intern(lexicalAnalyzerContext->compilerState->stringTable,
+        lexicalAnalyzerContext->stringLiteral.characters, lexicalAnalyzerContext->stringLiteral.length);
     return STRING_LITERAL;
 }
 
@@ -19,6 +19,17 @@ void shutdownFlexActionsModule();
 
 /**
  * Flex lexeme processing actions.
+ *
+ * Identifiers are classified at scan time, with the symbol table of the
+ * compilation: a declared identifier (after a type keyword, or after "FOR")
+ * is bound in the innermost scope, and any other one is a typed variable or
+ * function name, according to its innermost binding (or a plain "VAR_NAME",
+ * if it's undeclared). Braces open and close the scopes.
+ *
+ * The program and each function also open a frame, so the semantic value of
+ * a variable name carries its slot (see "SymbolTable.h"), and the closing
+ * brace of a frame carries its size. The parameters of a function are
+ * recorded in its binding, so the parser can check its calls.
  */
 
 void BeginMultilineCommentLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
@@ -35,6 +46,11 @@ Token BraceLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext, Token t
 Token PunctuationLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext, Token token);
 Token AssignmentLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
 Token IdentifierLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
+Token ProgramKeywordLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
+Token TypeKeywordLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext, Token token);
+Token LoopKeywordLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
+Token FunctionDeclarationLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
+Token VariableDeclarationLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
 void BeginStringLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
 void StringContentLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
 void EscapedCharacterLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
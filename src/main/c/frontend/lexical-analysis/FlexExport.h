@@ -1,13 +1,37 @@
 #ifndef FLEX_EXPORT_HEADER
 #define FLEX_EXPORT_HEADER
 
+#include "../../shared/SourceFile.h"
+
+/**
+ * Hooks that allow to export static functions or variables from the inside
+ * of Flex infrastructure. This header must be included in the user-code
+ * section of the scanner (after the second "%%"), where the internal state of
+ * a scanner instance is fully defined.
+ */
+
 /**
- * Hook that allows to export a static function or variable from the inside of
- * Flex infrastructure, in this case, the current context (a.k.a. start
- * condition).
+ * The current context (a.k.a. start condition) of a scanner instance.
  */
-unsigned int flexCurrentContext(void) {
+unsigned int flexCurrentContext(yyscan_t yyscanner) {
+	struct yyguts_t * yyg = (struct yyguts_t *) yyscanner;
 	return YY_START;
 }
 
+/**
+ * Selects the input of a scanner instance. A mapped source file is scanned in
+ * place (its content already ends with the 2 NUL bytes required by Flex), and
+ * any other file is read incrementally from its stream.
+ *
+ * @see https://westes.github.io/flex/manual/Multiple-Input-Buffers.html
+ */
+void flexScanSourceFile(SourceFile * sourceFile, yyscan_t yyscanner) {
+	if (isMappedSourceFile(sourceFile)) {
+		yy_scan_buffer(sourceFile->content, sourceFile->size + 2, yyscanner);
+	}
+	else {
+		yyset_in(sourceFile->stream, yyscanner);
+	}
+}
+
 #endif
@@ -3,42 +3,53 @@
 /**
  * Flex exported variables and functions.
  *
- * @see https://westes.github.io/flex/manual/User-Values.html
+ * @see https://westes.github.io/flex/manual/Reentrant-Functions.html
  */
 
-// The wrapper of "yy_top_state" function (provided by Flex).
-extern unsigned int flexCurrentContext(void);
+// The wrapper of "YY_START" macro (provided by Flex).
+extern unsigned int flexCurrentContext(void * scanner);
+
+// The context of the scanner instance (provided by Flex).
+extern LexicalAnalyzerContext * yyget_extra(void * scanner);
 
 // The lexeme length in characters (provided by Flex).
-extern int yyleng;
+extern int yyget_leng(void * scanner);
 
 // The line number (provided by Flex).
-extern int yylineno;
+extern int yyget_lineno(void * scanner);
+
+// The location of the lookahead symbol (provided by Bison, through Flex).
+extern YYLTYPE * yyget_lloc(void * scanner);
 
-// The semantic value of the lookahead symbol (provided by Bison).
-extern union SemanticValue yylval;
+// The semantic value of the lookahead symbol (provided by Bison, through Flex).
+extern union SemanticValue * yyget_lval(void * scanner);
 
 // The current lexeme (provided by Flex).
-extern char * yytext;
+extern char * yyget_text(void * scanner);
 
 /* PUBLIC FUNCTIONS */
 
-LexicalAnalyzerContext * createLexicalAnalyzerContext() {
+LexicalAnalyzerContext * createLexicalAnalyzerContext(CompilerState * compilerState) {
 	LexicalAnalyzerContext * lexicalAnalyzerContext = calloc(1, sizeof(LexicalAnalyzerContext));
-	lexicalAnalyzerContext->length = yyleng;
-	lexicalAnalyzerContext->lexeme = calloc(1 + yyleng, sizeof(char));
-	lexicalAnalyzerContext->line = yylineno;
-	lexicalAnalyzerContext->semanticValue = &yylval;
-	lexicalAnalyzerContext->currentContext = flexCurrentContext();
-	strncpy(lexicalAnalyzerContext->lexeme, yytext, yyleng);
+	lexicalAnalyzerContext->compilerState = compilerState;
 	return lexicalAnalyzerContext;
 }
 
 void destroyLexicalAnalyzerContext(LexicalAnalyzerContext * lexicalAnalyzerContext) {
 	if (lexicalAnalyzerContext != NULL) {
-		if (lexicalAnalyzerContext->lexeme != NULL) {
-			free(lexicalAnalyzerContext->lexeme);
-		}
+		free(lexicalAnalyzerContext->stringLiteral.characters);
 		free(lexicalAnalyzerContext);
 	}
 }
+
+LexicalAnalyzerContext * currentLexicalAnalyzerContext(void * scanner) {
+	LexicalAnalyzerContext * lexicalAnalyzerContext = yyget_extra(scanner);
+	lexicalAnalyzerContext->length = yyget_leng(scanner);
+	lexicalAnalyzerContext->lexeme = yyget_text(scanner);
+	lexicalAnalyzerContext->line = yyget_lineno(scanner);
+	YYLTYPE * location = yyget_lloc(scanner);
+	location->first_line = location->last_line = lexicalAnalyzerContext->line;
+	lexicalAnalyzerContext->semanticValue = yyget_lval(scanner);
+	lexicalAnalyzerContext->currentContext = flexCurrentContext(scanner);
+	return lexicalAnalyzerContext;
+}
@@ -1,30 +1,71 @@
 #ifndef LEXICAL_ANALYZER_CONTEXT_HEADER
 #define LEXICAL_ANALYZER_CONTEXT_HEADER
 
+#include "../../shared/CompilerState.h"
+#include "../syntactic-analysis/AbstractSyntaxTree.h"
+#include "../syntactic-analysis/BisonParser.h"
 #include <stdlib.h>
 #include <string.h>
 
 /**
- * The state of a lexical-analyzer context.
+ * A growable buffer with the decoded content of the string literal being
+ * scanned (inside the STRING_CONTENT context). It tracks its length and
+ * capacity, so appending a fragment is amortized constant time, and it's
+ * reused across literals.
  */
 typedef struct {
+	char * characters;
+	unsigned int length;
+	unsigned int capacity;
+} StringLiteralBuffer;
+
+/**
+ * The state of a lexical-analyzer context. The lexeme is a borrowed view over
+ * the Flex buffer (not a copy), so it's only valid during the execution of
+ * the Flex action that requested the context. Flex NUL-terminates the lexeme
+ * while the action runs, so it can be used as a regular C-string.
+ *
+ * Every scanner instance owns its context (as the Flex "extra" data), so
+ * many programs can be scanned concurrently.
+ *
+ * The declared type is the type of the last type keyword (the type of the
+ * identifier being declared, as in the AST), and the scope of the program or a function is
+ * open since its header, so its block must not open another one. The variable
+ * of a loop is only bound when the block of the loop opens its scope (so the
+ * bounds are resolved in the enclosing one): it's the interned name of the
+ * variable, while it's pending.
+ */
+typedef struct {
+	CompilerState * compilerState;
 	unsigned int currentContext;
+	enum DataType declaredType;
+	boolean isLoopHeader;
+	boolean isScopeOpen;
 	unsigned int length;
-	char * lexeme;
+	const char * lexeme;
 	unsigned int line;
+	const char * loopVariable;
 	union SemanticValue * semanticValue;
+	StringLiteralBuffer stringLiteral;
 } LexicalAnalyzerContext;
 
 /**
- * Creates a new context with the current state of the lexical-analyzer over
- * the lexeme just consumed. The lexeme is a deep-copy of the original,
- * allocated in heap-memory.
+ * Creates the context of a new scanner instance, that will scan the program
+ * of the specified compilation.
  */
-LexicalAnalyzerContext * createLexicalAnalyzerContext();
+LexicalAnalyzerContext * createLexicalAnalyzerContext(CompilerState * compilerState);
 
 /**
- * Destroy a lexical-analyzer context and its resources.
+ * Destroy the context of a scanner instance.
  */
 void destroyLexicalAnalyzerContext(LexicalAnalyzerContext * lexicalAnalyzerContext);
 
+/**
+ * Refreshes the context of a scanner instance with the current state of Flex
+ * over the lexeme just consumed, and returns it. The same instance is reused
+ * on every call, hence no heap-memory is involved. It also sets the location
+ * of the lexeme (i.e., its line), for the parser.
+ */
+LexicalAnalyzerContext * currentLexicalAnalyzerContext(void * scanner);
+
 #endif
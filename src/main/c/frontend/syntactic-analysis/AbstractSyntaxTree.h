@@ -1,6 +1,7 @@
 #ifndef ABSTRACT_SYNTAX_TREE_HEADER
 #define ABSTRACT_SYNTAX_TREE_HEADER
 
+#include "../../shared/CompilerState.h"
 #include "../../shared/Logger.h"
 #include "../../shared/Type.h"
 #include <stdlib.h>
@@ -37,11 +38,44 @@ typedef struct Arguments Arguments;
 typedef struct Argument Argument;
 typedef struct ReturnStatement ReturnStatement;
 typedef struct Type Type;
+typedef struct Slot Slot;
+typedef struct Variable Variable;
 
 /**
  * Node types for the Abstract Syntax Tree (AST).
+ *
+ * The expressions (except function calls), types and compare operators are
+ * hash-consed: structurally identical nodes are built once and shared, so
+ * they're immutable, and two of them are equal if and only if their pointers
+ * are equal.
+ *
+ * Every variable is resolved while parsing (see "SymbolTable.h"): its slot
+ * locates it in the frames of the functions, so it can be read from a flat
+ * array, without looking up its name. The functions and the program know the
+ * size of their frames.
+ *
+ * Every instruction knows the line of the source file where it begins.
  */
 
+/**
+ * The location of a variable: the amount of frames to go up from the frame
+ * of the current function (0 for its own variables, or the program's ones
+ * outside any function), and the index of the variable in that frame.
+ */
+struct Slot {
+    unsigned int depth;
+    unsigned int index;
+};
+
+/**
+ * A variable, with its resolved location (the semantic value of a variable
+ * name).
+ */
+struct Variable {
+    const char * name;
+    Slot slot;
+};
+
 enum InstructionType_T {
     DECLARATION_INSTRUCTION_T,
     ASSIGNATION_INSTRUCTION_T,
@@ -56,6 +90,7 @@ enum InstructionType_T {
 
 struct Program {
     Block * block;
+    unsigned int frameSize;
 };
 
 struct Block {
@@ -75,17 +110,19 @@ struct Instruction {
         Loop * loop;
     };
     enum InstructionType_T type;
+    unsigned int line;
     Instruction * next;
 };
 
 struct Declaration {
     Type * type;
-    char * varName;
+    const char * varName;
     Assignation * assignation;
 };
 
 struct Assignation {
-    char * varName;
+    const char * varName;
+    Slot slot;
     Expression * expression;
 };
 
@@ -103,16 +140,17 @@ struct Print {
 };
 
 struct FunctionCall {
-    char * functionName;
+    const char * functionName;
     Arguments * arguments;
     Type * returnType;
 };
 
 struct Function {
     Type * returnType;
-    char * functionName;
+    const char * functionName;
     Parameters * parameters;
     Block * block;
+    unsigned int frameSize;
 };
 
 struct Conditional {
@@ -122,7 +160,8 @@ struct Conditional {
 };
 
 struct Loop {
-    char * varName;
+    const char * varName;
+    Slot slot;
     ArithmeticExpression * start;
     ArithmeticExpression * end;
     Block * block;
@@ -134,7 +173,10 @@ struct ArithmeticExpression {
             ArithmeticExpression * left;
             ArithmeticExpression * right;
         };
-        char * varName;
+        struct {
+            const char * varName;
+            Slot slot;
+        };
         int value;
         FunctionCall * functionCall;
     };
@@ -153,7 +195,10 @@ struct BooleanExpression {
             ArithmeticExpression * rightArith;
         };
         BooleanExpression * notExpr;
-        char * varName;
+        struct {
+            const char * varName;
+            Slot slot;
+        };
         bool value;
         FunctionCall * functionCall;
     };
@@ -162,8 +207,11 @@ struct BooleanExpression {
 
 struct StringExpression {
     union {
-        char * value;
-        char * varName;
+        const char * value;
+        struct {
+            const char * varName;
+            Slot slot;
+        };
         FunctionCall * functionCall;
     };
     enum StringExpressionType { STRING_LITERAL_T, VAR_STRING_T, FUNC_CALL_STRING_T } type;
@@ -180,7 +228,8 @@ struct Parameters {
 
 struct Parameter {
     Type * type;
-    char * varName;
+    const char * varName;
+    Slot slot;
 };
 
 struct Arguments {
@@ -201,27 +250,10 @@ struct Type {
 };
 
 /**
- * Node recursive destructors.
+ * Releases the entire AST at once, with a single reset of the arena of the
+ * compilation. Every other allocation of the arena (e.g., the interned
+ * strings) is released too, so the string and node tables are cleared.
  */
-void releaseProgram(Program * program);
-void releaseBlock(Block * block);
-void releaseInstruction(Instruction * instruction);
-void releaseDeclaration(Declaration * declaration);
-void releaseAssignation(Assignation * assignation);
-void releaseExpression(Expression * expression);
-void releasePrint(Print * print);
-void releaseFunctionCall(FunctionCall * functionCall);
-void releaseFunction(Function * function);
-void releaseConditional(Conditional * conditional);
-void releaseLoop(Loop * loop);
-void releaseArithmeticExpression(ArithmeticExpression * arithmeticExpression);
-void releaseBooleanExpression(BooleanExpression * booleanExpression);
-void releaseStringExpression(StringExpression * stringExpression);
-void releaseCompareOperator(CompareOperator * compareOperator);
-void releaseParameters(Parameters * parameters);
-void releaseParameter(Parameter * parameter);
-void releaseArguments(Arguments * arguments);
-void releaseArgument(Argument * argument);
-void releaseReturnStatement(ReturnStatement * returnStatement);
+void releaseProgram(CompilerState * compilerState);
 
 #endif
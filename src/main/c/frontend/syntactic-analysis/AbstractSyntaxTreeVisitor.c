@@ -0,0 +1,249 @@
+#include "AbstractSyntaxTreeVisitor.h"
+
+/**
+ * A node waiting in the stack of a traversal. Once expanded, its children
+ * were pushed above it, and it waits for its post-order callback.
+ */
+typedef struct {
+	void * node;
+	uint8_t kind;
+	boolean expanded;
+} VisitorFrame;
+
+typedef struct {
+	VisitorFrame * frames;
+	size_t size;
+	size_t capacity;
+} VisitorStack;
+
+/* MODULE INTERNAL STATE */
+
+// The initial capacity of the stack of a traversal.
+static const size_t _initialCapacity = 64;
+
+/* PRIVATE FUNCTIONS */
+
+static void _push(VisitorStack * stack, const NodeKind kind, void * node);
+static void _pushChildren(VisitorStack * stack, const NodeKind kind, void * node);
+static void _pushNext(VisitorStack * stack, const NodeKind kind, void * node);
+
+/**
+ * Pushes a node, doubling the capacity of the stack if it's full. Absent
+ * nodes are ignored.
+ */
+static void _push(VisitorStack * stack, const NodeKind kind, void * node) {
+	if (node == NULL) {
+		return;
+	}
+	if (stack->size == stack->capacity) {
+		stack->capacity = stack->capacity == 0 ? _initialCapacity : 2 * stack->capacity;
+		stack->frames = realloc(stack->frames, stack->capacity * sizeof(VisitorFrame));
+	}
+	VisitorFrame * frame = &stack->frames[stack->size++];
+	frame->node = node;
+	frame->kind = kind;
+	frame->expanded = false;
+}
+
+/**
+ * Pushes the children of a node in reverse order, so the first one is the
+ * first to be popped. Only the first node of a list is pushed.
+ */
+static void _pushChildren(VisitorStack * stack, const NodeKind kind, void * node) {
+	switch (kind) {
+		case PROGRAM_NODE:
+			_push(stack, BLOCK_NODE, ((Program *) node)->block);
+			break;
+		case BLOCK_NODE:
+			_push(stack, INSTRUCTION_NODE, ((Block *) node)->instructions);
+			break;
+		case INSTRUCTION_NODE: {
+			Instruction * instruction = node;
+			switch (instruction->type) {
+				case DECLARATION_INSTRUCTION_T:
+					_push(stack, DECLARATION_NODE, instruction->declaration);
+					break;
+				case ASSIGNATION_INSTRUCTION_T:
+					_push(stack, ASSIGNATION_NODE, instruction->assignation);
+					break;
+				case EXPRESSION_INSTRUCTION_T:
+					_push(stack, EXPRESSION_NODE, instruction->expression);
+					break;
+				case PRINT_INSTRUCTION_T:
+					_push(stack, PRINT_NODE, instruction->print);
+					break;
+				case FUNCTION_CALL_INSTRUCTION_T:
+					_push(stack, FUNCTION_CALL_NODE, instruction->functionCall);
+					break;
+				case RETURN_STATEMENT_INSTRUCTION_T:
+					_push(stack, RETURN_STATEMENT_NODE, instruction->returnStatement);
+					break;
+				case FUNCTION_INSTRUCTION_T:
+					_push(stack, FUNCTION_NODE, instruction->function);
+					break;
+				case CONDITIONAL_INSTRUCTION_T:
+					_push(stack, CONDITIONAL_NODE, instruction->conditional);
+					break;
+				case LOOP_INSTRUCTION_T:
+					_push(stack, LOOP_NODE, instruction->loop);
+					break;
+			}
+			break;
+		}
+		case DECLARATION_NODE:
+			_push(stack, ASSIGNATION_NODE, ((Declaration *) node)->assignation);
+			_push(stack, TYPE_NODE, ((Declaration *) node)->type);
+			break;
+		case ASSIGNATION_NODE:
+			_push(stack, EXPRESSION_NODE, ((Assignation *) node)->expression);
+			break;
+		case EXPRESSION_NODE: {
+			Expression * expression = node;
+			switch (expression->type) {
+				case ARITHMETIC_EXPR_T:
+					_push(stack, ARITHMETIC_EXPRESSION_NODE, expression->arithmeticExpression);
+					break;
+				case BOOLEAN_EXPR_T:
+					_push(stack, BOOLEAN_EXPRESSION_NODE, expression->booleanExpression);
+					break;
+				case STRING_EXPR_T:
+					_push(stack, STRING_EXPRESSION_NODE, expression->stringExpression);
+					break;
+			}
+			break;
+		}
+		case PRINT_NODE:
+			_push(stack, EXPRESSION_NODE, ((Print *) node)->expression);
+			break;
+		case FUNCTION_CALL_NODE:
+			_push(stack, TYPE_NODE, ((FunctionCall *) node)->returnType);
+			_push(stack, ARGUMENTS_NODE, ((FunctionCall *) node)->arguments);
+			break;
+		case FUNCTION_NODE:
+			_push(stack, BLOCK_NODE, ((Function *) node)->block);
+			_push(stack, PARAMETERS_NODE, ((Function *) node)->parameters);
+			_push(stack, TYPE_NODE, ((Function *) node)->returnType);
+			break;
+		case CONDITIONAL_NODE:
+			_push(stack, BLOCK_NODE, ((Conditional *) node)->elseBlock);
+			_push(stack, BLOCK_NODE, ((Conditional *) node)->ifBlock);
+			_push(stack, BOOLEAN_EXPRESSION_NODE, ((Conditional *) node)->condition);
+			break;
+		case LOOP_NODE:
+			_push(stack, BLOCK_NODE, ((Loop *) node)->block);
+			_push(stack, ARITHMETIC_EXPRESSION_NODE, ((Loop *) node)->end);
+			_push(stack, ARITHMETIC_EXPRESSION_NODE, ((Loop *) node)->start);
+			break;
+		case ARITHMETIC_EXPRESSION_NODE: {
+			ArithmeticExpression * arithmeticExpression = node;
+			switch (arithmeticExpression->type) {
+				case ADD_T:
+				case SUB_T:
+				case MUL_T:
+				case DIV_T:
+					_push(stack, ARITHMETIC_EXPRESSION_NODE, arithmeticExpression->right);
+					_push(stack, ARITHMETIC_EXPRESSION_NODE, arithmeticExpression->left);
+					break;
+				case FUNC_CALL_ARITH_T:
+					_push(stack, FUNCTION_CALL_NODE, arithmeticExpression->functionCall);
+					break;
+				default:
+					break;
+			}
+			break;
+		}
+		case BOOLEAN_EXPRESSION_NODE: {
+			BooleanExpression * booleanExpression = node;
+			switch (booleanExpression->type) {
+				case AND_T:
+				case OR_T:
+					_push(stack, BOOLEAN_EXPRESSION_NODE, booleanExpression->right);
+					_push(stack, BOOLEAN_EXPRESSION_NODE, booleanExpression->left);
+					break;
+				case NOT_T:
+					_push(stack, BOOLEAN_EXPRESSION_NODE, booleanExpression->notExpr);
+					break;
+				case COMPARISON_T:
+					_push(stack, ARITHMETIC_EXPRESSION_NODE, booleanExpression->rightArith);
+					_push(stack, COMPARE_OPERATOR_NODE, booleanExpression->op);
+					_push(stack, ARITHMETIC_EXPRESSION_NODE, booleanExpression->leftArith);
+					break;
+				case FUNC_CALL_BOOL_T:
+					_push(stack, FUNCTION_CALL_NODE, booleanExpression->functionCall);
+					break;
+				default:
+					break;
+			}
+			break;
+		}
+		case STRING_EXPRESSION_NODE:
+			if (((StringExpression *) node)->type == FUNC_CALL_STRING_T) {
+				_push(stack, FUNCTION_CALL_NODE, ((StringExpression *) node)->functionCall);
+			}
+			break;
+		case PARAMETERS_NODE:
+			_push(stack, PARAMETER_NODE, ((Parameters *) node)->parameter);
+			break;
+		case PARAMETER_NODE:
+			_push(stack, TYPE_NODE, ((Parameter *) node)->type);
+			break;
+		case ARGUMENTS_NODE:
+			_push(stack, ARGUMENT_NODE, ((Arguments *) node)->argument);
+			break;
+		case ARGUMENT_NODE:
+			_push(stack, EXPRESSION_NODE, ((Argument *) node)->expression);
+			break;
+		case RETURN_STATEMENT_NODE:
+			_push(stack, EXPRESSION_NODE, ((ReturnStatement *) node)->expression);
+			break;
+		default:
+			break;
+	}
+}
+
+/**
+ * Pushes the next node of a list, once the previous one is done.
+ */
+static void _pushNext(VisitorStack * stack, const NodeKind kind, void * node) {
+	switch (kind) {
+		case INSTRUCTION_NODE:
+			_push(stack, INSTRUCTION_NODE, ((Instruction *) node)->next);
+			break;
+		case PARAMETERS_NODE:
+			_push(stack, PARAMETERS_NODE, ((Parameters *) node)->next);
+			break;
+		case ARGUMENTS_NODE:
+			_push(stack, ARGUMENTS_NODE, ((Arguments *) node)->next);
+			break;
+		default:
+			break;
+	}
+}
+
+/* PUBLIC FUNCTIONS */
+
+void visitAbstractSyntaxTree(const AbstractSyntaxTreeVisitor * visitor, const NodeKind kind, void * node, void * context) {
+	VisitorStack stack = {NULL, 0, 0};
+	_push(&stack, kind, node);
+	while (0 < stack.size) {
+		VisitorFrame * frame = &stack.frames[stack.size - 1];
+		void * current = frame->node;
+		const NodeKind currentKind = frame->kind;
+		if (frame->expanded) {
+			--stack.size;
+			if (visitor->postOrder[currentKind] != NULL) {
+				visitor->postOrder[currentKind](current, context);
+			}
+			_pushNext(&stack, currentKind, current);
+		}
+		else if (visitor->preOrder[currentKind] != NULL && !visitor->preOrder[currentKind](current, context)) {
+			--stack.size;
+			_pushNext(&stack, currentKind, current);
+		}
+		else {
+			frame->expanded = true;
+			_pushChildren(&stack, currentKind, current);
+		}
+	}
+	free(stack.frames);
+}
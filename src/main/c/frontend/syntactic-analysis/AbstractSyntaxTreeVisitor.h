@@ -0,0 +1,72 @@
+#ifndef ABSTRACT_SYNTAX_TREE_VISITOR_HEADER
+#define ABSTRACT_SYNTAX_TREE_VISITOR_HEADER
+
+#include "../../shared/Type.h"
+#include "AbstractSyntaxTree.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * A generic depth-first traversal of the AST, driven by an explicit stack in
+ * heap-memory (instead of the C stack), so neither long lists of
+ * instructions, parameters or arguments, nor deeply nested expressions can
+ * overflow it. Lists are walked as siblings: the next node of a list is
+ * pushed only after the previous one is done, so the stack grows with the
+ * depth of the tree, not with the length of its lists.
+ *
+ * The children of each node are visited in source order. Hash-consed nodes
+ * are visited once per occurrence, as if the AST were a tree.
+ */
+
+typedef enum {
+	PROGRAM_NODE,
+	BLOCK_NODE,
+	INSTRUCTION_NODE,
+	DECLARATION_NODE,
+	ASSIGNATION_NODE,
+	EXPRESSION_NODE,
+	PRINT_NODE,
+	FUNCTION_CALL_NODE,
+	FUNCTION_NODE,
+	CONDITIONAL_NODE,
+	LOOP_NODE,
+	ARITHMETIC_EXPRESSION_NODE,
+	BOOLEAN_EXPRESSION_NODE,
+	STRING_EXPRESSION_NODE,
+	COMPARE_OPERATOR_NODE,
+	PARAMETERS_NODE,
+	PARAMETER_NODE,
+	ARGUMENTS_NODE,
+	ARGUMENT_NODE,
+	RETURN_STATEMENT_NODE,
+	TYPE_NODE,
+	NODE_KINDS
+} NodeKind;
+
+/**
+ * Called before the children of a node. Returning false skips its children
+ * and its post-order callback.
+ */
+typedef boolean (*PreOrderCallback)(void * node, void * context);
+
+/**
+ * Called after the children of a node.
+ */
+typedef void (*PostOrderCallback)(void * node, void * context);
+
+/**
+ * The callbacks of a traversal, by kind of node. A NULL callback does
+ * nothing (and a NULL pre-order callback always visits the children).
+ */
+typedef struct {
+	PreOrderCallback preOrder[NODE_KINDS];
+	PostOrderCallback postOrder[NODE_KINDS];
+} AbstractSyntaxTreeVisitor;
+
+/**
+ * Traverses the subtree rooted at a node of the specified kind. Absent
+ * children (i.e., NULL pointers) are never visited.
+ */
+void visitAbstractSyntaxTree(const AbstractSyntaxTreeVisitor * visitor, const NodeKind kind, void * node, void * context);
+
+#endif
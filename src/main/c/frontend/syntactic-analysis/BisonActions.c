@@ -2,6 +2,41 @@
 
 /* MODULE INTERNAL STATE */
 
+/**
+ * The tags of the hash-consed nodes, that distinguish nodes of different
+ * types with the same bytes.
+ */
+typedef enum {
+	ARITHMETIC_EXPRESSION_NODE,
+	BOOLEAN_EXPRESSION_NODE,
+	EXPRESSION_NODE,
+	GLOBAL_DECLARATION_NODE,
+	STRING_EXPRESSION_NODE
+} NodeTag;
+
+// The only instance of each type and compare operator node. They never
+// change, so they are shared by every compilation.
+static Type _types[] = {
+	[INT_T] = {INT_T},
+	[BOOL_T] = {BOOL_T},
+	[STRING_T] = {STRING_T}
+};
+static CompareOperator _compareOperators[] = {
+	[GREATER_THAN_T] = {GREATER_THAN_T},
+	[LESS_THAN_T] = {LESS_THAN_T},
+	[EQUALS_EQUALS_T] = {EQUALS_EQUALS_T},
+	[NOT_EQUALS_T] = {NOT_EQUALS_T},
+	[GREATER_EQUALS_T] = {GREATER_EQUALS_T},
+	[LESS_EQUALS_T] = {LESS_EQUALS_T}
+};
+
+// The names of the types, for the errors.
+static const char * const _typeNames[] = {
+	[INT_T] = "INT",
+	[BOOL_T] = "BOOL",
+	[STRING_T] = "STRING"
+};
+
 static Logger * _logger = NULL;
 
 void initializeBisonActionsModule() {
@@ -14,13 +49,104 @@ void shutdownBisonActionsModule() {
 	}
 }
 
-/** IMPORTED FUNCTIONS */
-
-extern unsigned int flexCurrentContext(void);
-
 /* PRIVATE FUNCTIONS */
 
+static enum DataType _dataTypeOf(const Expression * expression);
+static void * _hashCons(CompilerState * compilerState, const NodeTag nodeTag, const void * node, const unsigned int size);
+static void _keep(StreamingState * streamingState, Instruction * instruction);
+static void _keepGlobal(StreamingState * streamingState, const Declaration * declaration, const unsigned int line);
+static void _keepSignature(StreamingState * streamingState, const Function * function, const unsigned int line);
 static void _logSyntacticAnalyzerAction(const char * functionName);
+static Instruction * _streamInstruction(CompilerState * compilerState, Instruction * instruction, const boolean isReleasable);
+
+/**
+ * The type of the value of an expression.
+ */
+static enum DataType _dataTypeOf(const Expression * expression) {
+	switch (expression->type) {
+		case ARITHMETIC_EXPR_T:
+			return INT_T;
+		case BOOLEAN_EXPR_T:
+			return BOOL_T;
+		default:
+			return STRING_T;
+	}
+}
+
+/**
+ * Returns the unique instance of an immutable node, so identical subtrees
+ * are built once and shared (they must never be modified afterwards). The
+ * constructors of the AST expect non-constant nodes, hence the cast.
+ */
+static void * _hashCons(CompilerState * compilerState, const NodeTag nodeTag, const void * node, const unsigned int size) {
+	return (void *) internNode(compilerState->nodeTable, nodeTag, node, size);
+}
+
+/**
+ * Appends an instruction (allocated in the memory of the skeleton) to the
+ * skeleton of a streaming compilation.
+ */
+static void _keep(StreamingState * streamingState, Instruction * instruction) {
+	Instruction * last = streamingState->skeleton;
+	if (last == NULL) {
+		instruction->next = instruction;
+	}
+	else {
+		instruction->next = last->next;
+		last->next = instruction;
+	}
+	streamingState->skeleton = instruction;
+	++streamingState->keptInstructions;
+}
+
+/**
+ * Keeps a global variable in the skeleton, without its initial value. The
+ * globals are hash-consed, so each one is kept only once. As every identifier
+ * of a streaming compilation, its name already lives in the memory of the
+ * skeleton.
+ */
+static void _keepGlobal(StreamingState * streamingState, const Declaration * declaration, const unsigned int line) {
+	Declaration candidate;
+	memset(&candidate, 0, sizeof(Declaration));
+	candidate.type = declaration->type;
+	candidate.varName = declaration->assignation->varName;
+	const unsigned int globals = streamingState->nodeTable->size;
+	Declaration * global = (Declaration *) internNode(streamingState->nodeTable, GLOBAL_DECLARATION_NODE, &candidate, sizeof(Declaration));
+	if (globals < streamingState->nodeTable->size) {
+		Instruction * instruction = allocateInArena(streamingState->arena, sizeof(Instruction));
+		instruction->type = DECLARATION_INSTRUCTION_T;
+		instruction->declaration = global;
+		instruction->line = line;
+		_keep(streamingState, instruction);
+	}
+}
+
+/**
+ * Keeps the signature of a function in the skeleton (i.e., the function
+ * without its block). Its names already live in the memory of the skeleton.
+ */
+static void _keepSignature(StreamingState * streamingState, const Function * function, const unsigned int line) {
+	Arena * arena = streamingState->arena;
+	Function * signature = allocateInArena(arena, sizeof(Function));
+	signature->returnType = function->returnType;
+	signature->functionName = function->functionName;
+	signature->frameSize = function->frameSize;
+	Parameters ** next = &signature->parameters;
+	for (const Parameters * parameters = function->parameters; parameters != NULL; parameters = parameters->next) {
+		Parameters * copy = allocateInArena(arena, sizeof(Parameters));
+		copy->parameter = allocateInArena(arena, sizeof(Parameter));
+		copy->parameter->type = parameters->parameter->type;
+		copy->parameter->varName = parameters->parameter->varName;
+		copy->parameter->slot = parameters->parameter->slot;
+		*next = copy;
+		next = &copy->next;
+	}
+	Instruction * instruction = allocateInArena(arena, sizeof(Instruction));
+	instruction->type = FUNCTION_INSTRUCTION_T;
+	instruction->function = signature;
+	instruction->line = line;
+	_keep(streamingState, instruction);
+}
 
 /**
  * Logs a syntactic-analyzer action in DEBUGGING level.
@@ -29,454 +155,550 @@ static void _logSyntacticAnalyzerAction(const char * functionName) {
 	logDebugging(_logger, "%s", functionName);
 }
 
+/**
+ * Hands a top-level instruction to the consumer of a streaming compilation,
+ * after keeping its part of the skeleton. Once the AST outgrows the first
+ * chunk of its arena, it's released (so the tables are cleared once per
+ * chunk, not once per instruction). Nothing is linked, hence the NULL list.
+ */
+static Instruction * _streamInstruction(CompilerState * compilerState, Instruction * instruction, const boolean isReleasable) {
+	StreamingState * streamingState = compilerState->streamingState;
+	instruction->next = NULL;
+	if (instruction->type == DECLARATION_INSTRUCTION_T) {
+		_keepGlobal(streamingState, instruction->declaration, instruction->line);
+	}
+	else if (instruction->type == FUNCTION_INSTRUCTION_T) {
+		_keepSignature(streamingState, instruction->function, instruction->line);
+	}
+	streamingState->consume(instruction, streamingState->context);
+	++streamingState->instructions;
+	if (isReleasable && compilerState->arena->chunkSize < allocatedInArena(compilerState->arena)) {
+		releaseProgram(compilerState);
+		++streamingState->releases;
+	}
+	return NULL;
+}
+
 /* PUBLIC FUNCTIONS */
 
-Program * ProgramSemanticAction(CompilerState * compilerState, Block * block) {
+Program * ProgramSemanticAction(CompilerState * compilerState, Block * block, const unsigned int frameSize) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Program * program = calloc(1, sizeof(Program));
+    Program * program = allocateInArena(compilerState->arena, sizeof(Program));
     program->block = block;
-    compilerState->abstractSyntaxtTree = program;
-    if (0 < flexCurrentContext()) {
-        logError(_logger, "The final context is not the default (0): %d", flexCurrentContext());
-        compilerState->succeed = false;
-    } else {
-        compilerState->succeed = true;
+    program->frameSize = frameSize;
+    if (compilerState->streamingState != NULL) {
+        Instruction * skeleton = compilerState->streamingState->skeleton;
+        if (skeleton != NULL) {
+            block->instructions = skeleton->next;
+            skeleton->next = NULL;
+        }
     }
+    compilerState->abstractSyntaxtTree = program;
+    compilerState->succeed = true;
     return program;
 }
 
-Block * BlockSemanticAction(Instruction * instructions) {
+Block * BlockSemanticAction(CompilerState * compilerState, Instruction * instructions) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Block * block = calloc(1, sizeof(Block));
-    block->instructions = instructions;
+    Block * block = allocateInArena(compilerState->arena, sizeof(Block));
+    if (instructions != NULL) {
+        block->instructions = instructions->next;
+        instructions->next = NULL;
+    }
     return block;
 }
 
-Instruction * SingleInstructionSemanticAction(Instruction * instruction) {
+Instruction * SingleProgramInstructionSemanticAction(CompilerState * compilerState, Instruction * instruction, const boolean isReleasable) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
+    if (compilerState->streamingState != NULL) {
+        return _streamInstruction(compilerState, instruction, isReleasable);
+    }
+    return SingleInstructionSemanticAction(compilerState, instruction);
+}
+
+Instruction * MultipleProgramInstructionsSemanticAction(CompilerState * compilerState, Instruction * instructions, Instruction * instruction, const boolean isReleasable) {
+    _logSyntacticAnalyzerAction(__FUNCTION__);
+    if (compilerState->streamingState != NULL) {
+        return _streamInstruction(compilerState, instruction, isReleasable);
+    }
+    return MultipleInstructionsSemanticAction(compilerState, instructions, instruction);
+}
+
+Instruction * SingleInstructionSemanticAction(CompilerState * compilerState, Instruction * instruction) {
+    _logSyntacticAnalyzerAction(__FUNCTION__);
+    instruction->next = instruction;
     return instruction;
 }
 
-Instruction * MultipleInstructionsSemanticAction(Instruction * instruction, Instruction * instructions) {
+Instruction * MultipleInstructionsSemanticAction(CompilerState * compilerState, Instruction * instructions, Instruction * instruction) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    instruction->next = instructions;
+    instruction->next = instructions->next;
+    instructions->next = instruction;
     return instruction;
 }
 
-Instruction * DeclarationInstructionSemanticAction(Declaration * declaration) {
+Instruction * DeclarationInstructionSemanticAction(CompilerState * compilerState, Declaration * declaration, const unsigned int line) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Instruction * instruction = calloc(1, sizeof(Instruction));
+    Instruction * instruction = allocateInArena(compilerState->arena, sizeof(Instruction));
     instruction->type = DECLARATION_INSTRUCTION_T;
     instruction->declaration = declaration;
+    instruction->line = line;
     return instruction;
 }
 
-Instruction * AssignationInstructionSemanticAction(Assignation * assignation) {
+Instruction * AssignationInstructionSemanticAction(CompilerState * compilerState, Assignation * assignation, const unsigned int line) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Instruction * instruction = calloc(1, sizeof(Instruction));
+    Instruction * instruction = allocateInArena(compilerState->arena, sizeof(Instruction));
     instruction->type = ASSIGNATION_INSTRUCTION_T;
     instruction->assignation = assignation;
+    instruction->line = line;
     return instruction;
 }
 
-Instruction * ExpressionInstructionSemanticAction(Expression * expression) {
+Instruction * ExpressionInstructionSemanticAction(CompilerState * compilerState, Expression * expression, const unsigned int line) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Instruction * instruction = calloc(1, sizeof(Instruction));
+    Instruction * instruction = allocateInArena(compilerState->arena, sizeof(Instruction));
     instruction->type = EXPRESSION_INSTRUCTION_T;
     instruction->expression = expression;
+    instruction->line = line;
     return instruction;
 }
 
-Instruction * PrintInstructionSemanticAction(Print * print) {
+Instruction * PrintInstructionSemanticAction(CompilerState * compilerState, Print * print, const unsigned int line) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Instruction * instruction = calloc(1, sizeof(Instruction));
+    Instruction * instruction = allocateInArena(compilerState->arena, sizeof(Instruction));
     instruction->type = PRINT_INSTRUCTION_T;
     instruction->print = print;
+    instruction->line = line;
     return instruction;
 }
 
-Instruction * FunctionCallInstructionSemanticAction(FunctionCall * functionCall) {
+Instruction * FunctionCallInstructionSemanticAction(CompilerState * compilerState, FunctionCall * functionCall, const unsigned int line) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Instruction * instruction = calloc(1, sizeof(Instruction));
+    Instruction * instruction = allocateInArena(compilerState->arena, sizeof(Instruction));
     instruction->type = FUNCTION_CALL_INSTRUCTION_T;
     instruction->functionCall = functionCall;
+    instruction->line = line;
     return instruction;
 }
 
-Instruction * ReturnStatementInstructionSemanticAction(ReturnStatement * returnStatement) {
+Instruction * ReturnStatementInstructionSemanticAction(CompilerState * compilerState, ReturnStatement * returnStatement, const unsigned int line) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Instruction * instruction = calloc(1, sizeof(Instruction));
+    Instruction * instruction = allocateInArena(compilerState->arena, sizeof(Instruction));
     instruction->type = RETURN_STATEMENT_INSTRUCTION_T;
     instruction->returnStatement = returnStatement;
+    instruction->line = line;
     return instruction;
 }
 
-Instruction * FunctionInstructionSemanticAction(Function * function) {
+Instruction * FunctionInstructionSemanticAction(CompilerState * compilerState, Function * function, const unsigned int line) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Instruction * instruction = calloc(1, sizeof(Instruction));
+    Instruction * instruction = allocateInArena(compilerState->arena, sizeof(Instruction));
     instruction->type = FUNCTION_INSTRUCTION_T;
     instruction->function = function;
+    instruction->line = line;
     return instruction;
 }
 
-Instruction * ConditionalInstructionSemanticAction(Conditional * conditional) {
+Instruction * ConditionalInstructionSemanticAction(CompilerState * compilerState, Conditional * conditional, const unsigned int line) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Instruction * instruction = calloc(1, sizeof(Instruction));
+    Instruction * instruction = allocateInArena(compilerState->arena, sizeof(Instruction));
     instruction->type = CONDITIONAL_INSTRUCTION_T;
     instruction->conditional = conditional;
+    instruction->line = line;
     return instruction;
 }
 
-Instruction * LoopInstructionSemanticAction(Loop * loop) {
+Instruction * LoopInstructionSemanticAction(CompilerState * compilerState, Loop * loop, const unsigned int line) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Instruction * instruction = calloc(1, sizeof(Instruction));
+    Instruction * instruction = allocateInArena(compilerState->arena, sizeof(Instruction));
     instruction->type = LOOP_INSTRUCTION_T;
     instruction->loop = loop;
+    instruction->line = line;
     return instruction;
 }
 
-Declaration * DeclarationSemanticAction(Type * type, Assignation * assignation) {
+Declaration * DeclarationSemanticAction(CompilerState * compilerState, Type * type, Assignation * assignation) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Declaration * declaration = calloc(1, sizeof(Declaration));
+    Declaration * declaration = allocateInArena(compilerState->arena, sizeof(Declaration));
     declaration->type = type;
     declaration->assignation = assignation;
     return declaration;
 }
 
-Type * IntTypeSemanticAction() {
+Type * IntTypeSemanticAction(CompilerState * compilerState) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Type * type = calloc(1, sizeof(Type));
-    type->type = INT_T;
-    return type;
+    return &_types[INT_T];
 }
 
-Type * BoolTypeSemanticAction() {
+Type * BoolTypeSemanticAction(CompilerState * compilerState) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Type * type = calloc(1, sizeof(Type));
-    type->type = BOOL_T;
-    return type;
+    return &_types[BOOL_T];
 }
 
-Type * StringTypeSemanticAction() {
+Type * StringTypeSemanticAction(CompilerState * compilerState) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Type * type = calloc(1, sizeof(Type));
-    type->type = STRING_T;
-    return type;
+    return &_types[STRING_T];
 }
 
-Assignation * AssignationSemanticAction(char * varName, Expression * expression) {
+Assignation * AssignationSemanticAction(CompilerState * compilerState, Variable variable, Expression * expression) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Assignation * assignation = calloc(1, sizeof(Assignation));
-    assignation->varName = varName;
+    Assignation * assignation = allocateInArena(compilerState->arena, sizeof(Assignation));
+    assignation->varName = variable.name;
+    assignation->slot = variable.slot;
     assignation->expression = expression;
     return assignation;
 }
 
-Expression * ArithmeticExpressionSemanticAction(ArithmeticExpression * arithmeticExpression) {
+Expression * ArithmeticExpressionSemanticAction(CompilerState * compilerState, ArithmeticExpression * arithmeticExpression) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Expression * expression = calloc(1, sizeof(Expression));
-    expression->type = ARITHMETIC_EXPR_T;
-    expression->arithmeticExpression = arithmeticExpression;
-    return expression;
+    Expression expression;
+    memset(&expression, 0, sizeof(Expression));
+    expression.type = ARITHMETIC_EXPR_T;
+    expression.arithmeticExpression = arithmeticExpression;
+    return _hashCons(compilerState, EXPRESSION_NODE, &expression, sizeof(Expression));
 }
 
-Expression * BooleanExpressionSemanticAction(BooleanExpression * booleanExpression) {
+Expression * BooleanExpressionSemanticAction(CompilerState * compilerState, BooleanExpression * booleanExpression) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Expression * expression = calloc(1, sizeof(Expression));
-    expression->type = BOOLEAN_EXPR_T;
-    expression->booleanExpression = booleanExpression;
-    return expression;
+    Expression expression;
+    memset(&expression, 0, sizeof(Expression));
+    expression.type = BOOLEAN_EXPR_T;
+    expression.booleanExpression = booleanExpression;
+    return _hashCons(compilerState, EXPRESSION_NODE, &expression, sizeof(Expression));
 }
 
-Expression * StringExpressionSemanticAction(StringExpression * stringExpression) {
+Expression * StringExpressionSemanticAction(CompilerState * compilerState, StringExpression * stringExpression) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Expression * expression = calloc(1, sizeof(Expression));
-    expression->type = STRING_EXPR_T;
-    expression->stringExpression = stringExpression;
-    return expression;
+    Expression expression;
+    memset(&expression, 0, sizeof(Expression));
+    expression.type = STRING_EXPR_T;
+    expression.stringExpression = stringExpression;
+    return _hashCons(compilerState, EXPRESSION_NODE, &expression, sizeof(Expression));
 }
 
-ArithmeticExpression * AdditionExpressionSemanticAction(ArithmeticExpression * left, ArithmeticExpression * right) {
+ArithmeticExpression * AdditionExpressionSemanticAction(CompilerState * compilerState, ArithmeticExpression * left, ArithmeticExpression * right) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    ArithmeticExpression * arithmeticExpression = calloc(1, sizeof(ArithmeticExpression));
-    arithmeticExpression->type = ADD_T;
-    arithmeticExpression->left = left;
-    arithmeticExpression->right = right;
-    return arithmeticExpression;
+    ArithmeticExpression arithmeticExpression;
+    memset(&arithmeticExpression, 0, sizeof(ArithmeticExpression));
+    arithmeticExpression.type = ADD_T;
+    arithmeticExpression.left = left;
+    arithmeticExpression.right = right;
+    return _hashCons(compilerState, ARITHMETIC_EXPRESSION_NODE, &arithmeticExpression, sizeof(ArithmeticExpression));
 }
 
-ArithmeticExpression * FunctionCallArithmeticExpressionSemanticAction(FunctionCall * functionCall) {
+ArithmeticExpression * FunctionCallArithmeticExpressionSemanticAction(CompilerState * compilerState, FunctionCall * functionCall) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    ArithmeticExpression * arithmeticExpression = calloc(1, sizeof(ArithmeticExpression));
+    ArithmeticExpression * arithmeticExpression = allocateInArena(compilerState->arena, sizeof(ArithmeticExpression));
     arithmeticExpression->type = FUNC_CALL_ARITH_T;
     arithmeticExpression->functionCall = functionCall;
     return arithmeticExpression;
 }
 
-ArithmeticExpression * SubtractionExpressionSemanticAction(ArithmeticExpression * left, ArithmeticExpression * right) {
+ArithmeticExpression * SubtractionExpressionSemanticAction(CompilerState * compilerState, ArithmeticExpression * left, ArithmeticExpression * right) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    ArithmeticExpression * arithmeticExpression = calloc(1, sizeof(ArithmeticExpression));
-    arithmeticExpression->type = SUB_T;
-    arithmeticExpression->left = left;
-    arithmeticExpression->right = right;
-    return arithmeticExpression;
+    ArithmeticExpression arithmeticExpression;
+    memset(&arithmeticExpression, 0, sizeof(ArithmeticExpression));
+    arithmeticExpression.type = SUB_T;
+    arithmeticExpression.left = left;
+    arithmeticExpression.right = right;
+    return _hashCons(compilerState, ARITHMETIC_EXPRESSION_NODE, &arithmeticExpression, sizeof(ArithmeticExpression));
 }
 
-ArithmeticExpression * MultiplicationExpressionSemanticAction(ArithmeticExpression * left, ArithmeticExpression * right) {
+ArithmeticExpression * MultiplicationExpressionSemanticAction(CompilerState * compilerState, ArithmeticExpression * left, ArithmeticExpression * right) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    ArithmeticExpression * arithmeticExpression = calloc(1, sizeof(ArithmeticExpression));
-    arithmeticExpression->type = MUL_T;
-    arithmeticExpression->left = left;
-    arithmeticExpression->right = right;
-    return arithmeticExpression;
+    ArithmeticExpression arithmeticExpression;
+    memset(&arithmeticExpression, 0, sizeof(ArithmeticExpression));
+    arithmeticExpression.type = MUL_T;
+    arithmeticExpression.left = left;
+    arithmeticExpression.right = right;
+    return _hashCons(compilerState, ARITHMETIC_EXPRESSION_NODE, &arithmeticExpression, sizeof(ArithmeticExpression));
 }
 
-ArithmeticExpression * DivisionExpressionSemanticAction(ArithmeticExpression * left, ArithmeticExpression * right) {
+ArithmeticExpression * DivisionExpressionSemanticAction(CompilerState * compilerState, ArithmeticExpression * left, ArithmeticExpression * right) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    ArithmeticExpression * arithmeticExpression = calloc(1, sizeof(ArithmeticExpression));
-    arithmeticExpression->type = DIV_T;
-    arithmeticExpression->left = left;
-    arithmeticExpression->right = right;
-    return arithmeticExpression;
+    ArithmeticExpression arithmeticExpression;
+    memset(&arithmeticExpression, 0, sizeof(ArithmeticExpression));
+    arithmeticExpression.type = DIV_T;
+    arithmeticExpression.left = left;
+    arithmeticExpression.right = right;
+    return _hashCons(compilerState, ARITHMETIC_EXPRESSION_NODE, &arithmeticExpression, sizeof(ArithmeticExpression));
 }
 
-ArithmeticExpression * VarNameArithmeticExpressionSemanticAction(char * varName) {
+ArithmeticExpression * VarNameArithmeticExpressionSemanticAction(CompilerState * compilerState, Variable variable) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    ArithmeticExpression * arithmeticExpression = calloc(1, sizeof(ArithmeticExpression));
-    arithmeticExpression->type = VAR_ARITH_T;
-    arithmeticExpression->varName = varName;
-    return arithmeticExpression;
+    ArithmeticExpression arithmeticExpression;
+    memset(&arithmeticExpression, 0, sizeof(ArithmeticExpression));
+    arithmeticExpression.type = VAR_ARITH_T;
+    arithmeticExpression.varName = variable.name;
+    arithmeticExpression.slot = variable.slot;
+    return _hashCons(compilerState, ARITHMETIC_EXPRESSION_NODE, &arithmeticExpression, sizeof(ArithmeticExpression));
 }
  
-ArithmeticExpression * IntegerArithmeticExpressionSemanticAction(int value) {
+ArithmeticExpression * IntegerArithmeticExpressionSemanticAction(CompilerState * compilerState, int value) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    ArithmeticExpression * arithmeticExpression = calloc(1, sizeof(ArithmeticExpression));
-    arithmeticExpression->type = INT_LITERAL_T;
-    arithmeticExpression->value = value;
-    return arithmeticExpression;
+    ArithmeticExpression arithmeticExpression;
+    memset(&arithmeticExpression, 0, sizeof(ArithmeticExpression));
+    arithmeticExpression.type = INT_LITERAL_T;
+    arithmeticExpression.value = value;
+    return _hashCons(compilerState, ARITHMETIC_EXPRESSION_NODE, &arithmeticExpression, sizeof(ArithmeticExpression));
 }
 
-BooleanExpression * VarNameBooleanExpressionSemanticAction(char * varName) {
+BooleanExpression * VarNameBooleanExpressionSemanticAction(CompilerState * compilerState, Variable variable) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    BooleanExpression * booleanExpression = calloc(1, sizeof(BooleanExpression));
-    booleanExpression->type = VAR_BOOL_T;
-    booleanExpression->varName = varName;
-    return booleanExpression;
+    BooleanExpression booleanExpression;
+    memset(&booleanExpression, 0, sizeof(BooleanExpression));
+    booleanExpression.type = VAR_BOOL_T;
+    booleanExpression.varName = variable.name;
+    booleanExpression.slot = variable.slot;
+    return _hashCons(compilerState, BOOLEAN_EXPRESSION_NODE, &booleanExpression, sizeof(BooleanExpression));
 }
 
-BooleanExpression * FunctionCallBooleanExpressionSemanticAction(FunctionCall * functionCall) {
+BooleanExpression * FunctionCallBooleanExpressionSemanticAction(CompilerState * compilerState, FunctionCall * functionCall) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    BooleanExpression * booleanExpression = calloc(1, sizeof(BooleanExpression));
+    BooleanExpression * booleanExpression = allocateInArena(compilerState->arena, sizeof(BooleanExpression));
     booleanExpression->type = FUNC_CALL_BOOL_T;
     booleanExpression->functionCall = functionCall;
     return booleanExpression;
 }
 
-BooleanExpression * AndExpressionSemanticAction(BooleanExpression * left, BooleanExpression * right) {
+BooleanExpression * AndExpressionSemanticAction(CompilerState * compilerState, BooleanExpression * left, BooleanExpression * right) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    BooleanExpression * booleanExpression = calloc(1, sizeof(BooleanExpression));
-    booleanExpression->type = AND_T;
-    booleanExpression->left = left;
-    booleanExpression->right = right;
-    return booleanExpression;
+    BooleanExpression booleanExpression;
+    memset(&booleanExpression, 0, sizeof(BooleanExpression));
+    booleanExpression.type = AND_T;
+    booleanExpression.left = left;
+    booleanExpression.right = right;
+    return _hashCons(compilerState, BOOLEAN_EXPRESSION_NODE, &booleanExpression, sizeof(BooleanExpression));
 }
 
-BooleanExpression * OrExpressionSemanticAction(BooleanExpression * left, BooleanExpression * right) {
+BooleanExpression * OrExpressionSemanticAction(CompilerState * compilerState, BooleanExpression * left, BooleanExpression * right) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    BooleanExpression * booleanExpression = calloc(1, sizeof(BooleanExpression));
-    booleanExpression->type = OR_T;
-    booleanExpression->left = left;
-    booleanExpression->right = right;
-    return booleanExpression;
+    BooleanExpression booleanExpression;
+    memset(&booleanExpression, 0, sizeof(BooleanExpression));
+    booleanExpression.type = OR_T;
+    booleanExpression.left = left;
+    booleanExpression.right = right;
+    return _hashCons(compilerState, BOOLEAN_EXPRESSION_NODE, &booleanExpression, sizeof(BooleanExpression));
 }
 
-BooleanExpression * NotExpressionSemanticAction(BooleanExpression * expression) {
+BooleanExpression * NotExpressionSemanticAction(CompilerState * compilerState, BooleanExpression * expression) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    BooleanExpression * booleanExpression = calloc(1, sizeof(BooleanExpression));
-    booleanExpression->type = NOT_T;
-    booleanExpression->notExpr = expression;
-    return booleanExpression;
+    BooleanExpression booleanExpression;
+    memset(&booleanExpression, 0, sizeof(BooleanExpression));
+    booleanExpression.type = NOT_T;
+    booleanExpression.notExpr = expression;
+    return _hashCons(compilerState, BOOLEAN_EXPRESSION_NODE, &booleanExpression, sizeof(BooleanExpression));
 }
 
-BooleanExpression * ComparisonExpressionSemanticAction(ArithmeticExpression * left, CompareOperator * op, ArithmeticExpression * right) {
+BooleanExpression * ComparisonExpressionSemanticAction(CompilerState * compilerState, ArithmeticExpression * left, CompareOperator * op, ArithmeticExpression * right) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    BooleanExpression * booleanExpression = calloc(1, sizeof(BooleanExpression));
-    booleanExpression->type = COMPARISON_T;
-    booleanExpression->leftArith = left;
-    booleanExpression->op = op;
-    booleanExpression->rightArith = right;
-    return booleanExpression;
+    BooleanExpression booleanExpression;
+    memset(&booleanExpression, 0, sizeof(BooleanExpression));
+    booleanExpression.type = COMPARISON_T;
+    booleanExpression.leftArith = left;
+    booleanExpression.op = op;
+    booleanExpression.rightArith = right;
+    return _hashCons(compilerState, BOOLEAN_EXPRESSION_NODE, &booleanExpression, sizeof(BooleanExpression));
 }
 
-BooleanExpression * BoolLiteralExpressionSemanticAction(bool value) {
+BooleanExpression * BoolLiteralExpressionSemanticAction(CompilerState * compilerState, bool value) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    BooleanExpression * booleanExpression = calloc(1, sizeof(BooleanExpression));
-    booleanExpression->type = BOOL_LITERAL_T;
-    booleanExpression->value = value;
-    return booleanExpression;
+    BooleanExpression booleanExpression;
+    memset(&booleanExpression, 0, sizeof(BooleanExpression));
+    booleanExpression.type = BOOL_LITERAL_T;
+    booleanExpression.value = value;
+    return _hashCons(compilerState, BOOLEAN_EXPRESSION_NODE, &booleanExpression, sizeof(BooleanExpression));
 }
 
-StringExpression * VarNameStringExpressionSemanticAction(char * varName) {
+StringExpression * VarNameStringExpressionSemanticAction(CompilerState * compilerState, Variable variable) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    StringExpression * stringExpression = calloc(1, sizeof(StringExpression));
-    stringExpression->type = VAR_STRING_T;
-    stringExpression->varName = varName;
-    return stringExpression;
+    StringExpression stringExpression;
+    memset(&stringExpression, 0, sizeof(StringExpression));
+    stringExpression.type = VAR_STRING_T;
+    stringExpression.varName = variable.name;
+    stringExpression.slot = variable.slot;
+    return _hashCons(compilerState, STRING_EXPRESSION_NODE, &stringExpression, sizeof(StringExpression));
 }
 
-StringExpression * FunctionCallStringExpressionSemanticAction(FunctionCall * functionCall) {
+StringExpression * FunctionCallStringExpressionSemanticAction(CompilerState * compilerState, FunctionCall * functionCall) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    StringExpression * stringExpression = calloc(1, sizeof(StringExpression));
+    StringExpression * stringExpression = allocateInArena(compilerState->arena, sizeof(StringExpression));
     stringExpression->type = FUNC_CALL_STRING_T;
     stringExpression->functionCall = functionCall;
     return stringExpression;
 }
 
-StringExpression * StringLiteralExpressionSemanticAction(char * value) {
+StringExpression * StringLiteralExpressionSemanticAction(CompilerState * compilerState, const char * value) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    StringExpression * stringExpression = calloc(1, sizeof(StringExpression));
-    stringExpression->type = STRING_LITERAL_T;
-    stringExpression->value = value;
-    return stringExpression;
+    StringExpression stringExpression;
+    memset(&stringExpression, 0, sizeof(StringExpression));
+    stringExpression.type = STRING_LITERAL_T;
+    stringExpression.value = value;
+    return _hashCons(compilerState, STRING_EXPRESSION_NODE, &stringExpression, sizeof(StringExpression));
 }
 
-Print * PrintSemanticAction(Expression * expression) {
+Print * PrintSemanticAction(CompilerState * compilerState, Expression * expression) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Print * print = calloc(1, sizeof(Print));
+    Print * print = allocateInArena(compilerState->arena, sizeof(Print));
     print->expression = expression;
     return print;
 }
 
-Function * FunctionSemanticAction(Type * returnType, char * functionName, Parameters * parameters, Block * block) {
+Function * FunctionSemanticAction(CompilerState * compilerState, Type * returnType, const char * functionName, Parameters * parameters, Block * block, const unsigned int frameSize) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Function * function = calloc(1, sizeof(Function));
+    Function * function = allocateInArena(compilerState->arena, sizeof(Function));
     function->returnType = returnType;
     function->functionName = functionName;
-    function->parameters = parameters;
+    if (parameters != NULL) {
+        function->parameters = parameters->next;
+        parameters->next = NULL;
+    }
     function->block = block;
+    function->frameSize = frameSize;
     return function;
 }
 
-Parameters * SingleParameterSemanticAction(Parameter * parameter) {
+Parameters * SingleParameterSemanticAction(CompilerState * compilerState, Parameter * parameter) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Parameters * parameters = calloc(1, sizeof(Parameters));
+    Parameters * parameters = allocateInArena(compilerState->arena, sizeof(Parameters));
     parameters->parameter = parameter;
-    parameters->next = NULL;
+    parameters->next = parameters;
     return parameters;
 }
 
-Parameters * MultipleParametersSemanticAction(Parameter * parameter, Parameters * parameters) {
+Parameters * MultipleParametersSemanticAction(CompilerState * compilerState, Parameters * parameters, Parameter * parameter) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Parameters * newParameters = calloc(1, sizeof(Parameters));
+    Parameters * newParameters = allocateInArena(compilerState->arena, sizeof(Parameters));
     newParameters->parameter = parameter;
-    newParameters->next = parameters;
+    newParameters->next = parameters->next;
+    parameters->next = newParameters;
     return newParameters;
 }
 
-Parameter * ParameterSemanticAction(Type * type, char * varName) {
+Parameter * ParameterSemanticAction(CompilerState * compilerState, Type * type, Variable variable) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Parameter * parameter = calloc(1, sizeof(Parameter));
+    Parameter * parameter = allocateInArena(compilerState->arena, sizeof(Parameter));
     parameter->type = type;
-    parameter->varName = varName;
+    parameter->varName = variable.name;
+    parameter->slot = variable.slot;
     return parameter;
 }
 
-FunctionCall * FunctionCallSemanticAction(char * functionName, Arguments * arguments, Type * returnType) {
+FunctionCall * FunctionCallSemanticAction(CompilerState * compilerState, const char * functionName, Arguments * arguments, Type * returnType) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    FunctionCall * functionCall = calloc(1, sizeof(FunctionCall));
+    FunctionCall * functionCall = allocateInArena(compilerState->arena, sizeof(FunctionCall));
     functionCall->functionName = functionName;
-    functionCall->arguments = arguments;
+    if (arguments != NULL) {
+        functionCall->arguments = arguments->next;
+        arguments->next = NULL;
+    }
+    const Symbol * function = lookupSymbol(compilerState->symbolTable, functionName);
+    if (function != NULL && function->kind == FUNCTION_SYMBOL) {
+        const int * types = parameterTypes(compilerState->symbolTable, function);
+        unsigned int count = 0;
+        for (const Arguments * node = functionCall->arguments; node != NULL; node = node->next) {
+            const enum DataType type = _dataTypeOf(node->argument->expression);
+            if (count < function->parameters && (int) type != types[count]) {
+                logError(_logger, "The argument %u of the function \"%s\" must be %s, not %s.",
+                    1 + count, functionName, _typeNames[types[count]], _typeNames[type]);
+                return NULL;
+            }
+            ++count;
+        }
+        if (count != function->parameters) {
+            logError(_logger, "The function \"%s\" takes %u argument(s), but it's called with %u.",
+                functionName, function->parameters, count);
+            return NULL;
+        }
+    }
     functionCall->returnType = returnType;
     return functionCall;
 }
 
-Arguments * SingleArgumentSemanticAction(Argument * argument) {
+Arguments * SingleArgumentSemanticAction(CompilerState * compilerState, Argument * argument) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Arguments * arguments = calloc(1, sizeof(Arguments));
+    Arguments * arguments = allocateInArena(compilerState->arena, sizeof(Arguments));
     arguments->argument = argument;
-    arguments->next = NULL;
+    arguments->next = arguments;
     return arguments;
 }
 
-Arguments * MultipleArgumentsSemanticAction(Argument * argument, Arguments * arguments) {
+Arguments * MultipleArgumentsSemanticAction(CompilerState * compilerState, Arguments * arguments, Argument * argument) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Arguments * newArguments = calloc(1, sizeof(Arguments));
+    Arguments * newArguments = allocateInArena(compilerState->arena, sizeof(Arguments));
     newArguments->argument = argument;
-    newArguments->next = arguments;
+    newArguments->next = arguments->next;
+    arguments->next = newArguments;
     return newArguments;
 }
 
-Argument * ArgumentSemanticAction(Expression * expression) {
+Argument * ArgumentSemanticAction(CompilerState * compilerState, Expression * expression) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Argument * argument = calloc(1, sizeof(Argument));
+    Argument * argument = allocateInArena(compilerState->arena, sizeof(Argument));
     argument->expression = expression;
     return argument;
 }
 
-Conditional * ConditionalSemanticAction(BooleanExpression * condition, Block * ifBlock, Block * elseBlock) {
+Conditional * ConditionalSemanticAction(CompilerState * compilerState, BooleanExpression * condition, Block * ifBlock, Block * elseBlock) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Conditional * conditional = calloc(1, sizeof(Conditional));
+    Conditional * conditional = allocateInArena(compilerState->arena, sizeof(Conditional));
     conditional->condition = condition;
     conditional->ifBlock = ifBlock;
     conditional->elseBlock = elseBlock;
     return conditional;
 }
 
-Loop * LoopSemanticAction(char * varName, ArithmeticExpression * start, ArithmeticExpression * end, Block * block) {
+Loop * LoopSemanticAction(CompilerState * compilerState, Variable variable, ArithmeticExpression * start, ArithmeticExpression * end, Block * block) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    Loop * loop = calloc(1, sizeof(Loop));
-    loop->varName = varName;
+    Loop * loop = allocateInArena(compilerState->arena, sizeof(Loop));
+    loop->varName = variable.name;
+    loop->slot = variable.slot;
     loop->start = start;
     loop->end = end;
     loop->block = block;
     return loop;
 }
 
-CompareOperator * GreaterThanSemanticAction() {
+CompareOperator * GreaterThanSemanticAction(CompilerState * compilerState) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    CompareOperator * op = calloc(1, sizeof(CompareOperator));
-    op->type = GREATER_THAN_T;
-    return op;
+    return &_compareOperators[GREATER_THAN_T];
 }
 
-CompareOperator * LessThanSemanticAction() {
+CompareOperator * LessThanSemanticAction(CompilerState * compilerState) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    CompareOperator * op = calloc(1, sizeof(CompareOperator));
-    op->type = LESS_THAN_T;
-    return op;
+    return &_compareOperators[LESS_THAN_T];
 }
 
-CompareOperator * EqualsEqualsSemanticAction() {
+CompareOperator * EqualsEqualsSemanticAction(CompilerState * compilerState) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    CompareOperator * op = calloc(1, sizeof(CompareOperator));
-    op->type = EQUALS_EQUALS_T;
-    return op;
+    return &_compareOperators[EQUALS_EQUALS_T];
 }
 
-CompareOperator * NotEqualsSemanticAction() {
+CompareOperator * NotEqualsSemanticAction(CompilerState * compilerState) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    CompareOperator * op = calloc(1, sizeof(CompareOperator));
-    op->type = NOT_EQUALS_T;
-    return op;
+    return &_compareOperators[NOT_EQUALS_T];
 }
 
-CompareOperator * GreaterEqualsSemanticAction() {
+CompareOperator * GreaterEqualsSemanticAction(CompilerState * compilerState) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    CompareOperator * op = calloc(1, sizeof(CompareOperator));
-    op->type = GREATER_EQUALS_T;
-    return op;
+    return &_compareOperators[GREATER_EQUALS_T];
 }
 
-CompareOperator * LessEqualsSemanticAction() {
+CompareOperator * LessEqualsSemanticAction(CompilerState * compilerState) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    CompareOperator * op = calloc(1, sizeof(CompareOperator));
-    op->type = LESS_EQUALS_T;
-    return op;
+    return &_compareOperators[LESS_EQUALS_T];
 }
 
-ReturnStatement * ReturnStatementSemanticAction(Expression * expression) {
+ReturnStatement * ReturnStatementSemanticAction(CompilerState * compilerState, Expression * expression) {
     _logSyntacticAnalyzerAction(__FUNCTION__);
-    ReturnStatement * returnStatement = calloc(1, sizeof(ReturnStatement));
+    const Symbol * function = enclosingFunction(compilerState->symbolTable);
+    if (function != NULL && function->type != (int) _dataTypeOf(expression)) {
+        logError(_logger, "The function \"%s\" must return %s, not %s.",
+            function->name, _typeNames[function->type], _typeNames[_dataTypeOf(expression)]);
+        return NULL;
+    }
+    ReturnStatement * returnStatement = allocateInArena(compilerState->arena, sizeof(ReturnStatement));
     returnStatement->expression = expression;
     return returnStatement;
 }
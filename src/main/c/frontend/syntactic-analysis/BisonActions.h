@@ -8,6 +8,7 @@
 #include "SyntacticAnalyzer.h"
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 
 /** Initialize module's internal state. */
 void initializeBisonActionsModule();
@@ -17,62 +18,83 @@ void shutdownBisonActionsModule();
 
 /**
  * Bison semantic actions.
+ *
+ * The lists (instructions, parameters and arguments) are reduced with
+ * left-recursive rules, so the parser stack doesn't grow with their length.
+ * While a list is being built, its semantic value is its last node, which
+ * points back to the first one (i.e., the list is circular), so each append
+ * takes constant time. The action that consumes the complete list (block,
+ * function or function call) breaks the cycle, and stores its first node.
+ *
+ * In a streaming compilation (see "StreamingState"), the top-level
+ * instructions are not linked: each one is handed to the consumer when it's
+ * reduced, and the whole AST is released every time it outgrows a chunk of
+ * its arena. The program ends up with the skeleton as its only instructions.
+ *
+ * While a program is scanned, its calls and RETURN statements are checked
+ * against the binding of their function (see "SymbolTable.h"): a call must
+ * match the types of its parameters, and a RETURN the type of the function
+ * it belongs to. On a mismatch, the action logs it and returns NULL, and the
+ * parser aborts. A rebuilt AST (see "FlatAbstractSyntaxTree.h") has no
+ * bindings, so it's never checked again.
  */
 
-Program * ProgramSemanticAction(CompilerState * compilerState, Block * block);
-Block * BlockSemanticAction(Instruction * instructions);
-Instruction * SingleInstructionSemanticAction(Instruction * instruction);
-Instruction * MultipleInstructionsSemanticAction(Instruction * instruction, Instruction * instructions);
-Instruction * DeclarationInstructionSemanticAction(Declaration * declaration);
-Instruction * AssignationInstructionSemanticAction(Assignation * assignation);
-Instruction * PrintInstructionSemanticAction(Print * print);
-Instruction * FunctionCallInstructionSemanticAction(FunctionCall * functionCall);
-Instruction * ReturnStatementInstructionSemanticAction(ReturnStatement * returnStatement);
-Instruction * FunctionInstructionSemanticAction(Function * function);
-Instruction * ConditionalInstructionSemanticAction(Conditional * conditional);
-Instruction * LoopInstructionSemanticAction(Loop * loop);
-Declaration * DeclarationSemanticAction(Type * type, Assignation * assignation);
-Type * IntTypeSemanticAction();
-Type * BoolTypeSemanticAction();
-Type * StringTypeSemanticAction();
-Assignation * AssignationSemanticAction(char * varName, Expression * expression);
-Expression * ArithmeticExpressionSemanticAction(ArithmeticExpression * arithmeticExpression);
-Expression * BooleanExpressionSemanticAction(BooleanExpression * booleanExpression);
-Expression * StringExpressionSemanticAction(StringExpression * stringExpression);
-ArithmeticExpression * AdditionExpressionSemanticAction(ArithmeticExpression * left, ArithmeticExpression * right);
-ArithmeticExpression * SubtractionExpressionSemanticAction(ArithmeticExpression * left, ArithmeticExpression * right);
-ArithmeticExpression * MultiplicationExpressionSemanticAction(ArithmeticExpression * left, ArithmeticExpression * right);
-ArithmeticExpression * DivisionExpressionSemanticAction(ArithmeticExpression * left, ArithmeticExpression * right);
-ArithmeticExpression * VarNameArithmeticExpressionSemanticAction(char * varName);
-ArithmeticExpression * IntegerArithmeticExpressionSemanticAction(int value);
-ArithmeticExpression * FunctionCallArithmeticExpressionSemanticAction(FunctionCall * functionCall);
-BooleanExpression * AndExpressionSemanticAction(BooleanExpression * left, BooleanExpression * right);
-BooleanExpression * OrExpressionSemanticAction(BooleanExpression * left, BooleanExpression * right);
-BooleanExpression * NotExpressionSemanticAction(BooleanExpression * expression);
-BooleanExpression * ComparisonExpressionSemanticAction(ArithmeticExpression * left, CompareOperator * op, ArithmeticExpression * right);
-BooleanExpression * VarNameBooleanExpressionSemanticAction(char * varName);
-BooleanExpression * BoolLiteralExpressionSemanticAction(bool value);
-BooleanExpression * FunctionCallBooleanExpressionSemanticAction(FunctionCall * functionCall);
-StringExpression * StringLiteralExpressionSemanticAction(char * value);
-StringExpression * VarNameStringExpressionSemanticAction(char * varName);
-StringExpression * FunctionCallStringExpressionSemanticAction(FunctionCall * functionCall);
-Print * PrintSemanticAction(Expression * expression);
-Function * FunctionSemanticAction(Type * returnType, char * functionName, Parameters * parameters, Block * block);
-Parameters * SingleParameterSemanticAction(Parameter * parameter);
-Parameters * MultipleParametersSemanticAction(Parameter * parameter, Parameters * parameters);
-Parameter * ParameterSemanticAction(Type * type, char * varName);
-FunctionCall * FunctionCallSemanticAction(char * functionName, Arguments * arguments, Type * returnType);
-Arguments * SingleArgumentSemanticAction(Argument * argument);
-Arguments * MultipleArgumentsSemanticAction(Argument * argument, Arguments * arguments);
-Argument * ArgumentSemanticAction(Expression * expression);
-Conditional * ConditionalSemanticAction(BooleanExpression * condition, Block * ifBlock, Block * elseBlock);
-Loop * LoopSemanticAction(char * varName, ArithmeticExpression * start, ArithmeticExpression * end, Block * block);
-CompareOperator * GreaterThanSemanticAction();
-CompareOperator * LessThanSemanticAction();
-CompareOperator * EqualsEqualsSemanticAction();
-CompareOperator * NotEqualsSemanticAction();
-CompareOperator * GreaterEqualsSemanticAction();
-CompareOperator * LessEqualsSemanticAction();
-ReturnStatement * ReturnStatementSemanticAction(Expression * expression);
+Program * ProgramSemanticAction(CompilerState * compilerState, Block * block, const unsigned int frameSize);
+Block * BlockSemanticAction(CompilerState * compilerState, Instruction * instructions);
+Instruction * SingleProgramInstructionSemanticAction(CompilerState * compilerState, Instruction * instruction, const boolean isReleasable);
+Instruction * MultipleProgramInstructionsSemanticAction(CompilerState * compilerState, Instruction * instructions, Instruction * instruction, const boolean isReleasable);
+Instruction * SingleInstructionSemanticAction(CompilerState * compilerState, Instruction * instruction);
+Instruction * MultipleInstructionsSemanticAction(CompilerState * compilerState, Instruction * instructions, Instruction * instruction);
+Instruction * DeclarationInstructionSemanticAction(CompilerState * compilerState, Declaration * declaration, const unsigned int line);
+Instruction * AssignationInstructionSemanticAction(CompilerState * compilerState, Assignation * assignation, const unsigned int line);
+Instruction * PrintInstructionSemanticAction(CompilerState * compilerState, Print * print, const unsigned int line);
+Instruction * FunctionCallInstructionSemanticAction(CompilerState * compilerState, FunctionCall * functionCall, const unsigned int line);
+Instruction * ReturnStatementInstructionSemanticAction(CompilerState * compilerState, ReturnStatement * returnStatement, const unsigned int line);
+Instruction * FunctionInstructionSemanticAction(CompilerState * compilerState, Function * function, const unsigned int line);
+Instruction * ConditionalInstructionSemanticAction(CompilerState * compilerState, Conditional * conditional, const unsigned int line);
+Instruction * LoopInstructionSemanticAction(CompilerState * compilerState, Loop * loop, const unsigned int line);
+Declaration * DeclarationSemanticAction(CompilerState * compilerState, Type * type, Assignation * assignation);
+Type * IntTypeSemanticAction(CompilerState * compilerState);
+Type * BoolTypeSemanticAction(CompilerState * compilerState);
+Type * StringTypeSemanticAction(CompilerState * compilerState);
+Assignation * AssignationSemanticAction(CompilerState * compilerState, Variable variable, Expression * expression);
+Expression * ArithmeticExpressionSemanticAction(CompilerState * compilerState, ArithmeticExpression * arithmeticExpression);
+Expression * BooleanExpressionSemanticAction(CompilerState * compilerState, BooleanExpression * booleanExpression);
+Expression * StringExpressionSemanticAction(CompilerState * compilerState, StringExpression * stringExpression);
+ArithmeticExpression * AdditionExpressionSemanticAction(CompilerState * compilerState, ArithmeticExpression * left, ArithmeticExpression * right);
+ArithmeticExpression * SubtractionExpressionSemanticAction(CompilerState * compilerState, ArithmeticExpression * left, ArithmeticExpression * right);
+ArithmeticExpression * MultiplicationExpressionSemanticAction(CompilerState * compilerState, ArithmeticExpression * left, ArithmeticExpression * right);
+ArithmeticExpression * DivisionExpressionSemanticAction(CompilerState * compilerState, ArithmeticExpression * left, ArithmeticExpression * right);
+ArithmeticExpression * VarNameArithmeticExpressionSemanticAction(CompilerState * compilerState, Variable variable);
+ArithmeticExpression * IntegerArithmeticExpressionSemanticAction(CompilerState * compilerState, int value);
+ArithmeticExpression * FunctionCallArithmeticExpressionSemanticAction(CompilerState * compilerState, FunctionCall * functionCall);
+BooleanExpression * AndExpressionSemanticAction(CompilerState * compilerState, BooleanExpression * left, BooleanExpression * right);
+BooleanExpression * OrExpressionSemanticAction(CompilerState * compilerState, BooleanExpression * left, BooleanExpression * right);
+BooleanExpression * NotExpressionSemanticAction(CompilerState * compilerState, BooleanExpression * expression);
+BooleanExpression * ComparisonExpressionSemanticAction(CompilerState * compilerState, ArithmeticExpression * left, CompareOperator * op, ArithmeticExpression * right);
+BooleanExpression * VarNameBooleanExpressionSemanticAction(CompilerState * compilerState, Variable variable);
+BooleanExpression * BoolLiteralExpressionSemanticAction(CompilerState * compilerState, bool value);
+BooleanExpression * FunctionCallBooleanExpressionSemanticAction(CompilerState * compilerState, FunctionCall * functionCall);
+StringExpression * StringLiteralExpressionSemanticAction(CompilerState * compilerState, const char * value);
+StringExpression * VarNameStringExpressionSemanticAction(CompilerState * compilerState, Variable variable);
+StringExpression * FunctionCallStringExpressionSemanticAction(CompilerState * compilerState, FunctionCall * functionCall);
+Print * PrintSemanticAction(CompilerState * compilerState, Expression * expression);
+Function * FunctionSemanticAction(CompilerState * compilerState, Type * returnType, const char * functionName, Parameters * parameters, Block * block, const unsigned int frameSize);
+Parameters * SingleParameterSemanticAction(CompilerState * compilerState, Parameter * parameter);
+Parameters * MultipleParametersSemanticAction(CompilerState * compilerState, Parameters * parameters, Parameter * parameter);
+Parameter * ParameterSemanticAction(CompilerState * compilerState, Type * type, Variable variable);
+FunctionCall * FunctionCallSemanticAction(CompilerState * compilerState, const char * functionName, Arguments * arguments, Type * returnType);
+Arguments * SingleArgumentSemanticAction(CompilerState * compilerState, Argument * argument);
+Arguments * MultipleArgumentsSemanticAction(CompilerState * compilerState, Arguments * arguments, Argument * argument);
+Argument * ArgumentSemanticAction(CompilerState * compilerState, Expression * expression);
+Conditional * ConditionalSemanticAction(CompilerState * compilerState, BooleanExpression * condition, Block * ifBlock, Block * elseBlock);
+Loop * LoopSemanticAction(CompilerState * compilerState, Variable variable, ArithmeticExpression * start, ArithmeticExpression * end, Block * block);
+CompareOperator * GreaterThanSemanticAction(CompilerState * compilerState);
+CompareOperator * LessThanSemanticAction(CompilerState * compilerState);
+CompareOperator * EqualsEqualsSemanticAction(CompilerState * compilerState);
+CompareOperator * NotEqualsSemanticAction(CompilerState * compilerState);
+CompareOperator * GreaterEqualsSemanticAction(CompilerState * compilerState);
+CompareOperator * LessEqualsSemanticAction(CompilerState * compilerState);
+ReturnStatement * ReturnStatementSemanticAction(CompilerState * compilerState, Expression * expression);
 
 #endif
@@ -4,16 +4,33 @@
 
 %}
 
+// The state of the compilation is a parameter of the parser, so it's required
+// by the generated header (i.e., "BisonParser.h").
+%code requires {
+	#include "../../shared/CompilerState.h"
+}
+
 // You touch this, and you die.
 %define api.value.union.name SemanticValue
 
+// A pure (reentrant) parser, that receives its scanner instance and the state
+// of the compilation, instead of using global variables.
+%define api.pure full
+%lex-param {void * scanner}
+%parse-param {void * scanner} {CompilerState * compilerState}
+
+// The scanner tracks the lines of the tokens, so every instruction knows where
+// it begins in the source file.
+%locations
+
 %union {
 	/** Terminals. */
 
 	Token token;
 	int integer;
-	char* string;
+	const char * string;
 	bool boolean;
+	Variable variable;
 
 	/** Non-terminals. */
 
@@ -45,17 +62,18 @@
 %token <token> ADD SUB MUL DIV
 %token <token> AND OR NOT
 %token <token> PROGRAM INT BOOL STRING PRINT IF ELSE FOR IN RETURN
-%token <token> OPEN_PARENTHESIS CLOSE_PARENTHESIS SEMICOLON OPEN_BRACE CLOSE_BRACE COMMA EQUALS
+%token <token> OPEN_PARENTHESIS CLOSE_PARENTHESIS SEMICOLON OPEN_BRACE COMMA EQUALS
+%token <integer> CLOSE_BRACE
 %token <token> GREATER_THAN LESS_THAN EQUALS_EQUALS NOT_EQUALS GREATER_EQUALS LESS_EQUALS
-%token <string> VAR_NAME FUNCTION_NAME STRING_LITERAL
-%token <string> INT_VAR_NAME BOOL_VAR_NAME STRING_VAR_NAME
+%token <string> FUNCTION_NAME STRING_LITERAL
+%token <variable> VAR_NAME INT_VAR_NAME BOOL_VAR_NAME STRING_VAR_NAME
 %token <string> INT_FUNCTION_NAME BOOL_FUNCTION_NAME STRING_FUNCTION_NAME
 %token <boolean> BOOL_LITERAL
 
 /** Non-terminals. */
 %type <program> program
 %type <block> block
-%type <instruction> instructions instruction
+%type <instruction> program_instructions instructions instruction
 %type <declaration> declaration
 %type <assignation> assignation
 %type <expression> expression
@@ -88,119 +106,135 @@
 
 %%
 
-program: PROGRAM block                                              { $$ = ProgramSemanticAction(currentCompilerState(), $2); }
+// The closing brace of a function or of the program carries the size of the frame it closes (see "FlexActions.h").
+program: PROGRAM OPEN_BRACE program_instructions CLOSE_BRACE          { $$ = ProgramSemanticAction(compilerState, BlockSemanticAction(compilerState, $3), $4); }
+	;
+
+// The top-level instructions, that can be streamed one by one. The memory of
+// the AST can be released only if the parser holds no lookahead token (its
+// semantic value could live in that memory).
+program_instructions: instruction                                   { $$ = SingleProgramInstructionSemanticAction(compilerState, $1, yychar == YYEMPTY); }
+	| program_instructions instruction                              { $$ = MultipleProgramInstructionsSemanticAction(compilerState, $1, $2, yychar == YYEMPTY); }
 	;
 
-block: OPEN_BRACE instructions CLOSE_BRACE                          { $$ = BlockSemanticAction($2); }
+block: OPEN_BRACE instructions CLOSE_BRACE                          { $$ = BlockSemanticAction(compilerState, $2); }
 	;
 
-instructions: instruction                                           { $$ = SingleInstructionSemanticAction($1); }
-	| instruction instructions                                      { $$ = MultipleInstructionsSemanticAction($1, $2); }
+instructions: instruction                                           { $$ = SingleInstructionSemanticAction(compilerState, $1); }
+	| instructions instruction                                      { $$ = MultipleInstructionsSemanticAction(compilerState, $1, $2); }
 	;
 
-instruction: declaration SEMICOLON                                  { $$ = DeclarationInstructionSemanticAction($1); }
-	| assignation SEMICOLON                                         { $$ = AssignationInstructionSemanticAction($1); }
-	| print SEMICOLON                                               { $$ = PrintInstructionSemanticAction($1); }
-	| function_call SEMICOLON                                       { $$ = FunctionCallInstructionSemanticAction($1); }
-	| return_statement SEMICOLON                                    { $$ = ReturnStatementInstructionSemanticAction($1); }
-	| function                                                      { $$ = FunctionInstructionSemanticAction($1); }
-	| conditional                                                   { $$ = ConditionalInstructionSemanticAction($1); }
-	| loop                                                          { $$ = LoopInstructionSemanticAction($1); }
+instruction: declaration SEMICOLON                                  { $$ = DeclarationInstructionSemanticAction(compilerState, $1, @$.first_line); }
+	| assignation SEMICOLON                                         { $$ = AssignationInstructionSemanticAction(compilerState, $1, @$.first_line); }
+	| print SEMICOLON                                               { $$ = PrintInstructionSemanticAction(compilerState, $1, @$.first_line); }
+	| function_call SEMICOLON                                       { $$ = FunctionCallInstructionSemanticAction(compilerState, $1, @$.first_line); }
+	| return_statement SEMICOLON                                    { $$ = ReturnStatementInstructionSemanticAction(compilerState, $1, @$.first_line); }
+	| function                                                      { $$ = FunctionInstructionSemanticAction(compilerState, $1, @$.first_line); }
+	| conditional                                                   { $$ = ConditionalInstructionSemanticAction(compilerState, $1, @$.first_line); }
+	| loop                                                          { $$ = LoopInstructionSemanticAction(compilerState, $1, @$.first_line); }
 	;
 
-declaration: type assignation                             			{ $$ = DeclarationSemanticAction($1, $2); }
+// The scanner classifies every identifier with the symbol table (see "FlexActions.h"), so the declared
+// identifiers are always a "VAR_NAME", and the type of each expression is checked by the grammar.
+declaration: INT VAR_NAME EQUALS arit_exp                           { $$ = DeclarationSemanticAction(compilerState, IntTypeSemanticAction(compilerState), AssignationSemanticAction(compilerState, $2, ArithmeticExpressionSemanticAction(compilerState, $4))); }
+	| BOOL VAR_NAME EQUALS bool_exp                                 { $$ = DeclarationSemanticAction(compilerState, BoolTypeSemanticAction(compilerState), AssignationSemanticAction(compilerState, $2, BooleanExpressionSemanticAction(compilerState, $4))); }
+	| STRING VAR_NAME EQUALS string_exp                             { $$ = DeclarationSemanticAction(compilerState, StringTypeSemanticAction(compilerState), AssignationSemanticAction(compilerState, $2, StringExpressionSemanticAction(compilerState, $4))); }
 	;
 
-type: INT                                                           { $$ = IntTypeSemanticAction(); }
-	| BOOL                                                          { $$ = BoolTypeSemanticAction(); }
-	| STRING                                                        { $$ = StringTypeSemanticAction(); }
+type: INT                                                           { $$ = IntTypeSemanticAction(compilerState); }
+	| BOOL                                                          { $$ = BoolTypeSemanticAction(compilerState); }
+	| STRING                                                        { $$ = StringTypeSemanticAction(compilerState); }
 	;
 
-assignation: VAR_NAME EQUALS expression                             { $$ = AssignationSemanticAction($1, $3); }
+assignation: INT_VAR_NAME EQUALS arit_exp                          { $$ = AssignationSemanticAction(compilerState, $1, ArithmeticExpressionSemanticAction(compilerState, $3)); }
+	| BOOL_VAR_NAME EQUALS bool_exp                                 { $$ = AssignationSemanticAction(compilerState, $1, BooleanExpressionSemanticAction(compilerState, $3)); }
+	| STRING_VAR_NAME EQUALS string_exp                             { $$ = AssignationSemanticAction(compilerState, $1, StringExpressionSemanticAction(compilerState, $3)); }
 	;
 	
 
-expression: arit_exp                                                { $$ = ArithmeticExpressionSemanticAction($1); }
-	| bool_exp                                                      { $$ = BooleanExpressionSemanticAction($1); }
-	| string_exp                                                    { $$ = StringExpressionSemanticAction($1); }
+expression: arit_exp                                                { $$ = ArithmeticExpressionSemanticAction(compilerState, $1); }
+	| bool_exp                                                      { $$ = BooleanExpressionSemanticAction(compilerState, $1); }
+	| string_exp                                                    { $$ = StringExpressionSemanticAction(compilerState, $1); }
 	;
 
-arit_exp: INTEGER_LITERAL                                           { $$ = IntegerArithmeticExpressionSemanticAction($1); }
-	| INT_VAR_NAME                                                  { $$ = VarNameArithmeticExpressionSemanticAction($1); }
-	| int_function_call                                             { $$ = FunctionCallArithmeticExpressionSemanticAction($1); }
-	| arit_exp ADD arit_exp                                     	{ $$ = AdditionExpressionSemanticAction($1, $3); }
-	| arit_exp SUB arit_exp                                         { $$ = SubtractionExpressionSemanticAction($1, $3); }
-	| arit_exp MUL arit_exp                                         { $$ = MultiplicationExpressionSemanticAction($1, $3); }
-	| arit_exp DIV arit_exp                                         { $$ = DivisionExpressionSemanticAction($1, $3); }
+arit_exp: INTEGER_LITERAL                                           { $$ = IntegerArithmeticExpressionSemanticAction(compilerState, $1); }
+	| INT_VAR_NAME                                                  { $$ = VarNameArithmeticExpressionSemanticAction(compilerState, $1); }
+	| int_function_call                                             { $$ = FunctionCallArithmeticExpressionSemanticAction(compilerState, $1); }
+	| arit_exp ADD arit_exp                                     	{ $$ = AdditionExpressionSemanticAction(compilerState, $1, $3); }
+	| arit_exp SUB arit_exp                                         { $$ = SubtractionExpressionSemanticAction(compilerState, $1, $3); }
+	| arit_exp MUL arit_exp                                         { $$ = MultiplicationExpressionSemanticAction(compilerState, $1, $3); }
+	| arit_exp DIV arit_exp                                         { $$ = DivisionExpressionSemanticAction(compilerState, $1, $3); }
 	| OPEN_PARENTHESIS arit_exp CLOSE_PARENTHESIS                   { $$ = $2; }
 	;
 
-bool_exp: BOOL_LITERAL                                              { $$ = BoolLiteralExpressionSemanticAction($1); }
-	| BOOL_VAR_NAME                                                 { $$ = VarNameBooleanExpressionSemanticAction($1); }
-	| bool_function_call                                            { $$ = FunctionCallBooleanExpressionSemanticAction($1); }
-	| bool_exp AND bool_exp                                     	{ $$ = AndExpressionSemanticAction($1, $3); }
-	| bool_exp OR bool_exp                                          { $$ = OrExpressionSemanticAction($1, $3); }
-	| NOT bool_exp                                                  { $$ = NotExpressionSemanticAction($2); }
-	| arit_exp compare_op arit_exp                                  { $$ = ComparisonExpressionSemanticAction($1, $2, $3); }
+bool_exp: BOOL_LITERAL                                              { $$ = BoolLiteralExpressionSemanticAction(compilerState, $1); }
+	| BOOL_VAR_NAME                                                 { $$ = VarNameBooleanExpressionSemanticAction(compilerState, $1); }
+	| bool_function_call                                            { $$ = FunctionCallBooleanExpressionSemanticAction(compilerState, $1); }
+	| bool_exp AND bool_exp                                     	{ $$ = AndExpressionSemanticAction(compilerState, $1, $3); }
+	| bool_exp OR bool_exp                                          { $$ = OrExpressionSemanticAction(compilerState, $1, $3); }
+	| NOT bool_exp                                                  { $$ = NotExpressionSemanticAction(compilerState, $2); }
+	| arit_exp compare_op arit_exp                                  { $$ = ComparisonExpressionSemanticAction(compilerState, $1, $2, $3); }
 	| OPEN_PARENTHESIS bool_exp CLOSE_PARENTHESIS                   { $$ = $2; }
 	;
 
-string_exp: STRING_LITERAL                                          { $$ = StringLiteralExpressionSemanticAction($1); }
-	| STRING_VAR_NAME                                               { $$ = VarNameStringExpressionSemanticAction($1); }
-	| string_function_call                                          { $$ = FunctionCallStringExpressionSemanticAction($1); }
+string_exp: STRING_LITERAL                                          { $$ = StringLiteralExpressionSemanticAction(compilerState, $1); }
+	| STRING_VAR_NAME                                               { $$ = VarNameStringExpressionSemanticAction(compilerState, $1); }
+	| string_function_call                                          { $$ = FunctionCallStringExpressionSemanticAction(compilerState, $1); }
 	;
 
-print: PRINT OPEN_PARENTHESIS expression CLOSE_PARENTHESIS          { $$ = PrintSemanticAction($3); }
+print: PRINT OPEN_PARENTHESIS expression CLOSE_PARENTHESIS          { $$ = PrintSemanticAction(compilerState, $3); }
 	;
 
-function: type FUNCTION_NAME OPEN_PARENTHESIS parameters CLOSE_PARENTHESIS block { $$ = FunctionSemanticAction($1, $2, $4, $6); }
-	| type FUNCTION_NAME OPEN_PARENTHESIS CLOSE_PARENTHESIS block 	 			 { $$ = FunctionSemanticAction($1, $2, NULL, $5); }
+function: type FUNCTION_NAME OPEN_PARENTHESIS parameters CLOSE_PARENTHESIS OPEN_BRACE instructions CLOSE_BRACE { $$ = FunctionSemanticAction(compilerState, $1, $2, $4, BlockSemanticAction(compilerState, $7), $8); }
+	| type FUNCTION_NAME OPEN_PARENTHESIS CLOSE_PARENTHESIS OPEN_BRACE instructions CLOSE_BRACE 	 			{ $$ = FunctionSemanticAction(compilerState, $1, $2, NULL, BlockSemanticAction(compilerState, $6), $7); }
 	;
 
-parameters: parameter                                               { $$ = SingleParameterSemanticAction($1); }
-	| parameter COMMA parameters                                    { $$ = MultipleParametersSemanticAction($1, $3); }
+parameters: parameter                                               { $$ = SingleParameterSemanticAction(compilerState, $1); }
+	| parameters COMMA parameter                                    { $$ = MultipleParametersSemanticAction(compilerState, $1, $3); }
 	;
 
-parameter: type VAR_NAME                                            { $$ = ParameterSemanticAction($1, $2); }
+parameter: type VAR_NAME                                            { $$ = ParameterSemanticAction(compilerState, $1, $2); }
 	;
 
+// A call that doesn't match the parameters of its function, or a RETURN that doesn't match the type of its function,
+// aborts the parser (see "BisonActions.h").
 function_call: int_function_call | bool_function_call | string_function_call
 	;
 
-int_function_call: INT_FUNCTION_NAME OPEN_PARENTHESIS arguments CLOSE_PARENTHESIS { $$ = FunctionCallSemanticAction($1, $3, IntTypeSemanticAction()); }
-	| INT_FUNCTION_NAME OPEN_PARENTHESIS CLOSE_PARENTHESIS					    { $$ = FunctionCallSemanticAction($1, NULL, IntTypeSemanticAction()); }
+int_function_call: INT_FUNCTION_NAME OPEN_PARENTHESIS arguments CLOSE_PARENTHESIS { $$ = FunctionCallSemanticAction(compilerState, $1, $3, IntTypeSemanticAction(compilerState)); if ($$ == NULL) YYABORT; }
+	| INT_FUNCTION_NAME OPEN_PARENTHESIS CLOSE_PARENTHESIS					    { $$ = FunctionCallSemanticAction(compilerState, $1, NULL, IntTypeSemanticAction(compilerState)); if ($$ == NULL) YYABORT; }
 	;
 
-bool_function_call: BOOL_FUNCTION_NAME OPEN_PARENTHESIS arguments CLOSE_PARENTHESIS { $$ = FunctionCallSemanticAction($1, $3, BoolTypeSemanticAction()); }
-	| BOOL_FUNCTION_NAME OPEN_PARENTHESIS CLOSE_PARENTHESIS					      { $$ = FunctionCallSemanticAction($1, NULL, BoolTypeSemanticAction()); }
+bool_function_call: BOOL_FUNCTION_NAME OPEN_PARENTHESIS arguments CLOSE_PARENTHESIS { $$ = FunctionCallSemanticAction(compilerState, $1, $3, BoolTypeSemanticAction(compilerState)); if ($$ == NULL) YYABORT; }
+	| BOOL_FUNCTION_NAME OPEN_PARENTHESIS CLOSE_PARENTHESIS					      { $$ = FunctionCallSemanticAction(compilerState, $1, NULL, BoolTypeSemanticAction(compilerState)); if ($$ == NULL) YYABORT; }
 	;
 
-string_function_call: STRING_FUNCTION_NAME OPEN_PARENTHESIS arguments CLOSE_PARENTHESIS { $$ = FunctionCallSemanticAction($1, $3, StringTypeSemanticAction()); }
-	| STRING_FUNCTION_NAME OPEN_PARENTHESIS CLOSE_PARENTHESIS					        { $$ = FunctionCallSemanticAction($1, NULL, StringTypeSemanticAction()); }
+string_function_call: STRING_FUNCTION_NAME OPEN_PARENTHESIS arguments CLOSE_PARENTHESIS { $$ = FunctionCallSemanticAction(compilerState, $1, $3, StringTypeSemanticAction(compilerState)); if ($$ == NULL) YYABORT; }
+	| STRING_FUNCTION_NAME OPEN_PARENTHESIS CLOSE_PARENTHESIS					        { $$ = FunctionCallSemanticAction(compilerState, $1, NULL, StringTypeSemanticAction(compilerState)); if ($$ == NULL) YYABORT; }
 	;
 
-arguments: argument                                                 { $$ = SingleArgumentSemanticAction($1); }
-	| argument COMMA arguments                                      { $$ = MultipleArgumentsSemanticAction($1, $3); }
+arguments: argument                                                 { $$ = SingleArgumentSemanticAction(compilerState, $1); }
+	| arguments COMMA argument                                      { $$ = MultipleArgumentsSemanticAction(compilerState, $1, $3); }
 	;
 
-argument: expression                                                { $$ = ArgumentSemanticAction($1); }
+argument: expression                                                { $$ = ArgumentSemanticAction(compilerState, $1); }
 	;
 
-conditional: IF OPEN_PARENTHESIS bool_exp CLOSE_PARENTHESIS block ELSE block { $$ = ConditionalSemanticAction($3, $5, $7); }
+conditional: IF OPEN_PARENTHESIS bool_exp CLOSE_PARENTHESIS block ELSE block { $$ = ConditionalSemanticAction(compilerState, $3, $5, $7); }
 	;
 
-loop: FOR VAR_NAME IN OPEN_PARENTHESIS arit_exp COMMA arit_exp CLOSE_PARENTHESIS block { $$ = LoopSemanticAction($2, $5, $7, $9); }
+loop: FOR VAR_NAME IN OPEN_PARENTHESIS arit_exp COMMA arit_exp CLOSE_PARENTHESIS block { $$ = LoopSemanticAction(compilerState, $2, $5, $7, $9); }
 	;
 
-compare_op: GREATER_THAN                                            { $$ = GreaterThanSemanticAction(); }
-	| LESS_THAN                                                     { $$ = LessThanSemanticAction(); }
-	| EQUALS_EQUALS                                                 { $$ = EqualsEqualsSemanticAction(); }
-	| NOT_EQUALS                                                    { $$ = NotEqualsSemanticAction(); }
-	| GREATER_EQUALS                                                { $$ = GreaterEqualsSemanticAction(); }
-	| LESS_EQUALS                                                   { $$ = LessEqualsSemanticAction(); }
+compare_op: GREATER_THAN                                            { $$ = GreaterThanSemanticAction(compilerState); }
+	| LESS_THAN                                                     { $$ = LessThanSemanticAction(compilerState); }
+	| EQUALS_EQUALS                                                 { $$ = EqualsEqualsSemanticAction(compilerState); }
+	| NOT_EQUALS                                                    { $$ = NotEqualsSemanticAction(compilerState); }
+	| GREATER_EQUALS                                                { $$ = GreaterEqualsSemanticAction(compilerState); }
+	| LESS_EQUALS                                                   { $$ = LessEqualsSemanticAction(compilerState); }
 	;
 
-return_statement: RETURN expression                                 { $$ = ReturnStatementSemanticAction($2); }
+return_statement: RETURN expression                                 { $$ = ReturnStatementSemanticAction(compilerState, $2); if ($$ == NULL) YYABORT; }
 	;
 
 %%
@@ -0,0 +1,790 @@
+#include "FlatAbstractSyntaxTree.h"
+#include "AbstractSyntaxTreeVisitor.h"
+#include "BisonActions.h"
+
+/**
+ * The state of an expression being flattened: the indices of the flattened
+ * children, that wait for their parent (in post-order).
+ */
+typedef struct {
+	FlatProgram * flatProgram;
+	FlatArray(FlatIndex) indices;
+} ExpressionFlattening;
+
+/**
+ * The state of a program being unflattened: the nodes already rebuilt, with
+ * the same indices of the expressions and names of the flat program.
+ */
+typedef struct {
+	CompilerState * compilerState;
+	const FlatProgram * flatProgram;
+	void ** expressions;
+	const char ** names;
+} Unflattening;
+
+/* MODULE INTERNAL STATE */
+
+// The initial capacity of every array of nodes.
+static const FlatIndex _initialCapacity = 16;
+
+static Logger * _logger = NULL;
+
+void initializeFlatAbstractSyntaxTreeModule() {
+	_logger = createLogger("FlatAbstractSyntaxTree");
+}
+
+void shutdownFlatAbstractSyntaxTreeModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+/**
+ * Reserves consecutive nodes at the end of a flat array, and returns the
+ * index of the first one.
+ */
+#define _reserve(array, count) _reserveNodes((void **) &(array).nodes, &(array).size, &(array).capacity, sizeof(*(array).nodes), count)
+
+static boolean _enterExpression(void * node, void * context);
+static boolean _enterFunctionCall(void * node, void * context);
+static void _flattenArithmeticExpression(void * node, void * context);
+static FlatRange _flattenBlock(FlatProgram * flatProgram, const Block * block);
+static void _flattenBooleanExpression(void * node, void * context);
+static FlatIndex _flattenExpression(FlatProgram * flatProgram, const NodeKind kind, const void * expression);
+static FlatIndex _flattenFunction(FlatProgram * flatProgram, const Function * function);
+static FlatIndex _flattenFunctionCall(FlatProgram * flatProgram, const FunctionCall * functionCall);
+static void _flattenInstruction(FlatProgram * flatProgram, const FlatIndex index, const Instruction * instruction);
+static void _flattenStringExpression(void * node, void * context);
+static FlatIndex _lookupMemo(const FlatMemo * memo, const void * key);
+static FlatIndex _name(FlatProgram * flatProgram, const char * name);
+static FlatIndex _pop(ExpressionFlattening * expressionFlattening);
+static void _push(ExpressionFlattening * expressionFlattening, const FlatIndex index);
+static void _pushExpression(ExpressionFlattening * expressionFlattening, const void * node, const FlatExpression expression);
+static FlatIndex _reserveNodes(void ** nodes, FlatIndex * size, FlatIndex * capacity, const size_t nodeSize, const FlatIndex count);
+static void _storeInMemo(FlatMemo * memo, const void * key, const FlatIndex index);
+static Block * _unflattenBlock(Unflattening * unflattening, const FlatRange range);
+static CompareOperator * _unflattenCompareOperator(CompilerState * compilerState, const uint8_t comparison);
+static Expression * _unflattenExpression(Unflattening * unflattening, const FlatIndex index);
+static void _unflattenExpressions(Unflattening * unflattening);
+static FunctionCall * _unflattenFunctionCall(Unflattening * unflattening, const FlatIndex index);
+static Instruction * _unflattenInstruction(Unflattening * unflattening, const FlatInstruction * flatInstruction);
+static const char * _unflattenName(Unflattening * unflattening, const FlatIndex index);
+static Type * _unflattenType(CompilerState * compilerState, const uint8_t dataType);
+static Variable _unflattenVariable(Unflattening * unflattening, const FlatIndex name, const unsigned int depth, const FlatIndex index);
+
+/**
+ * Before an expression: if it was already flattened (i.e., it's shared), its
+ * index is reused, and its children are skipped.
+ */
+static boolean _enterExpression(void * node, void * context) {
+	ExpressionFlattening * expressionFlattening = context;
+	const FlatIndex index = _lookupMemo(&expressionFlattening->flatProgram->expressionMemo, node);
+	if (index == NO_FLAT_INDEX) {
+		return true;
+	}
+	_push(expressionFlattening, index);
+	return false;
+}
+
+/**
+ * Before a call inside an expression: it's flattened on its own (including
+ * its arguments), and its index is left for the expression.
+ */
+static boolean _enterFunctionCall(void * node, void * context) {
+	ExpressionFlattening * expressionFlattening = context;
+	_push(expressionFlattening, _flattenFunctionCall(expressionFlattening->flatProgram, node));
+	return false;
+}
+
+/**
+ * After the children of an arithmetic expression (so their indices are on
+ * the top of the stack, the right one first).
+ */
+static void _flattenArithmeticExpression(void * node, void * context) {
+	ExpressionFlattening * expressionFlattening = context;
+	const ArithmeticExpression * arithmeticExpression = node;
+	FlatExpression expression;
+	memset(&expression, 0, sizeof(FlatExpression));
+	switch (arithmeticExpression->type) {
+		case ADD_T:
+		case SUB_T:
+		case MUL_T:
+		case DIV_T:
+			expression.kind = FLAT_ADD + (arithmeticExpression->type - ADD_T);
+			expression.right = _pop(expressionFlattening);
+			expression.left = _pop(expressionFlattening);
+			break;
+		case VAR_ARITH_T:
+			expression.kind = FLAT_INT_VARIABLE;
+			expression.depth = arithmeticExpression->slot.depth;
+			expression.name = _name(expressionFlattening->flatProgram, arithmeticExpression->varName);
+			expression.slot = arithmeticExpression->slot.index;
+			break;
+		case INT_LITERAL_T:
+			expression.kind = FLAT_INT_LITERAL;
+			expression.value = arithmeticExpression->value;
+			break;
+		case FUNC_CALL_ARITH_T:
+			expression.kind = FLAT_INT_FUNCTION_CALL;
+			expression.call = _pop(expressionFlattening);
+			break;
+	}
+	_pushExpression(expressionFlattening, arithmeticExpression, expression);
+}
+
+/**
+ * Reserves the range of the block first, so its instructions are contiguous,
+ * and then flattens each one (nested blocks are stored after it).
+ */
+static FlatRange _flattenBlock(FlatProgram * flatProgram, const Block * block) {
+	FlatRange range = {0, 0};
+	for (const Instruction * instruction = block->instructions; instruction != NULL; instruction = instruction->next) {
+		++range.count;
+	}
+	range.offset = _reserve(flatProgram->instructions, range.count);
+	FlatIndex index = range.offset;
+	for (const Instruction * instruction = block->instructions; instruction != NULL; instruction = instruction->next) {
+		_flattenInstruction(flatProgram, index++, instruction);
+	}
+	return range;
+}
+
+static void _flattenBooleanExpression(void * node, void * context) {
+	ExpressionFlattening * expressionFlattening = context;
+	const BooleanExpression * booleanExpression = node;
+	FlatExpression expression;
+	memset(&expression, 0, sizeof(FlatExpression));
+	switch (booleanExpression->type) {
+		case AND_T:
+		case OR_T:
+			expression.kind = booleanExpression->type == AND_T ? FLAT_AND : FLAT_OR;
+			expression.right = _pop(expressionFlattening);
+			expression.left = _pop(expressionFlattening);
+			break;
+		case NOT_T:
+			expression.kind = FLAT_NOT;
+			expression.left = _pop(expressionFlattening);
+			expression.right = NO_FLAT_INDEX;
+			break;
+		case COMPARISON_T:
+			expression.kind = FLAT_COMPARISON;
+			expression.comparison = booleanExpression->op->type;
+			expression.right = _pop(expressionFlattening);
+			expression.left = _pop(expressionFlattening);
+			break;
+		case VAR_BOOL_T:
+			expression.kind = FLAT_BOOL_VARIABLE;
+			expression.depth = booleanExpression->slot.depth;
+			expression.name = _name(expressionFlattening->flatProgram, booleanExpression->varName);
+			expression.slot = booleanExpression->slot.index;
+			break;
+		case BOOL_LITERAL_T:
+			expression.kind = FLAT_BOOL_LITERAL;
+			expression.value = booleanExpression->value;
+			break;
+		case FUNC_CALL_BOOL_T:
+			expression.kind = FLAT_BOOL_FUNCTION_CALL;
+			expression.call = _pop(expressionFlattening);
+			break;
+	}
+	_pushExpression(expressionFlattening, booleanExpression, expression);
+}
+
+/**
+ * Flattens an expression of any kind (arithmetic, boolean, string, or their
+ * wrapper) with an iterative traversal, so deeply nested expressions don't
+ * overflow the C stack. Returns the index of its root.
+ */
+static FlatIndex _flattenExpression(FlatProgram * flatProgram, const NodeKind kind, const void * expression) {
+	static const AbstractSyntaxTreeVisitor expressionFlattener = {
+		.preOrder = {
+			[FUNCTION_CALL_NODE] = _enterFunctionCall,
+			[ARITHMETIC_EXPRESSION_NODE] = _enterExpression,
+			[BOOLEAN_EXPRESSION_NODE] = _enterExpression,
+			[STRING_EXPRESSION_NODE] = _enterExpression
+		},
+		.postOrder = {
+			[ARITHMETIC_EXPRESSION_NODE] = _flattenArithmeticExpression,
+			[BOOLEAN_EXPRESSION_NODE] = _flattenBooleanExpression,
+			[STRING_EXPRESSION_NODE] = _flattenStringExpression
+		}
+	};
+	ExpressionFlattening expressionFlattening;
+	memset(&expressionFlattening, 0, sizeof(ExpressionFlattening));
+	expressionFlattening.flatProgram = flatProgram;
+	visitAbstractSyntaxTree(&expressionFlattener, kind, (void *) expression, &expressionFlattening);
+	const FlatIndex index = _pop(&expressionFlattening);
+	free(expressionFlattening.indices.nodes);
+	return index;
+}
+
+static FlatIndex _flattenFunction(FlatProgram * flatProgram, const Function * function) {
+	FlatFunction flatFunction;
+	memset(&flatFunction, 0, sizeof(FlatFunction));
+	flatFunction.returnType = function->returnType->type;
+	flatFunction.name = _name(flatProgram, function->functionName);
+	for (const Parameters * parameters = function->parameters; parameters != NULL; parameters = parameters->next) {
+		++flatFunction.parameters.count;
+	}
+	flatFunction.parameters.offset = _reserve(flatProgram->parameters, flatFunction.parameters.count);
+	FlatIndex index = flatFunction.parameters.offset;
+	for (const Parameters * parameters = function->parameters; parameters != NULL; parameters = parameters->next) {
+		FlatParameter * flatParameter = &flatProgram->parameters.nodes[index++];
+		flatParameter->type = parameters->parameter->type->type;
+		flatParameter->name = _name(flatProgram, parameters->parameter->varName);
+		flatParameter->slot = parameters->parameter->slot.index;
+	}
+	flatFunction.block = _flattenBlock(flatProgram, function->block);
+	flatFunction.frameSize = function->frameSize;
+	const FlatIndex flatIndex = _reserve(flatProgram->functions, 1);
+	flatProgram->functions.nodes[flatIndex] = flatFunction;
+	return flatIndex;
+}
+
+static FlatIndex _flattenFunctionCall(FlatProgram * flatProgram, const FunctionCall * functionCall) {
+	FlatFunctionCall flatFunctionCall;
+	memset(&flatFunctionCall, 0, sizeof(FlatFunctionCall));
+	flatFunctionCall.returnType = functionCall->returnType->type;
+	flatFunctionCall.name = _name(flatProgram, functionCall->functionName);
+	for (const Arguments * arguments = functionCall->arguments; arguments != NULL; arguments = arguments->next) {
+		++flatFunctionCall.arguments.count;
+	}
+	flatFunctionCall.arguments.offset = _reserve(flatProgram->arguments, flatFunctionCall.arguments.count);
+	FlatIndex index = flatFunctionCall.arguments.offset;
+	for (const Arguments * arguments = functionCall->arguments; arguments != NULL; arguments = arguments->next) {
+		const FlatIndex expression = _flattenExpression(flatProgram, EXPRESSION_NODE, arguments->argument->expression);
+		flatProgram->arguments.nodes[index++] = expression;
+	}
+	const FlatIndex flatIndex = _reserve(flatProgram->functionCalls, 1);
+	flatProgram->functionCalls.nodes[flatIndex] = flatFunctionCall;
+	return flatIndex;
+}
+
+/**
+ * Flattens an instruction into its reserved slot. The slot is written at the
+ * end, because flattening its children may move the instructions array.
+ *
+ * Every node is zeroed before its fields are set (including its padding), so
+ * the same program is always flattened to the same bytes.
+ */
+static void _flattenInstruction(FlatProgram * flatProgram, const FlatIndex index, const Instruction * instruction) {
+	FlatInstruction flatInstruction;
+	memset(&flatInstruction, 0, sizeof(FlatInstruction));
+	flatInstruction.name = NO_FLAT_INDEX;
+	flatInstruction.operand = NO_FLAT_INDEX;
+	flatInstruction.line = instruction->line;
+	switch (instruction->type) {
+		case DECLARATION_INSTRUCTION_T:
+			flatInstruction.kind = FLAT_DECLARATION;
+			flatInstruction.dataType = instruction->declaration->type->type;
+			flatInstruction.depth = instruction->declaration->assignation->slot.depth;
+			flatInstruction.name = _name(flatProgram, instruction->declaration->assignation->varName);
+			flatInstruction.slot = instruction->declaration->assignation->slot.index;
+			flatInstruction.operand = _flattenExpression(flatProgram, EXPRESSION_NODE, instruction->declaration->assignation->expression);
+			break;
+		case ASSIGNATION_INSTRUCTION_T:
+			flatInstruction.kind = FLAT_ASSIGNATION;
+			flatInstruction.depth = instruction->assignation->slot.depth;
+			flatInstruction.name = _name(flatProgram, instruction->assignation->varName);
+			flatInstruction.slot = instruction->assignation->slot.index;
+			flatInstruction.operand = _flattenExpression(flatProgram, EXPRESSION_NODE, instruction->assignation->expression);
+			break;
+		case EXPRESSION_INSTRUCTION_T:
+			flatInstruction.kind = FLAT_EXPRESSION;
+			flatInstruction.operand = _flattenExpression(flatProgram, EXPRESSION_NODE, instruction->expression);
+			break;
+		case PRINT_INSTRUCTION_T:
+			flatInstruction.kind = FLAT_PRINT;
+			flatInstruction.operand = _flattenExpression(flatProgram, EXPRESSION_NODE, instruction->print->expression);
+			break;
+		case FUNCTION_CALL_INSTRUCTION_T:
+			flatInstruction.kind = FLAT_FUNCTION_CALL;
+			flatInstruction.operand = _flattenFunctionCall(flatProgram, instruction->functionCall);
+			break;
+		case RETURN_STATEMENT_INSTRUCTION_T:
+			flatInstruction.kind = FLAT_RETURN_STATEMENT;
+			flatInstruction.operand = _flattenExpression(flatProgram, EXPRESSION_NODE, instruction->returnStatement->expression);
+			break;
+		case FUNCTION_INSTRUCTION_T:
+			flatInstruction.kind = FLAT_FUNCTION;
+			flatInstruction.operand = _flattenFunction(flatProgram, instruction->function);
+			break;
+		case CONDITIONAL_INSTRUCTION_T: {
+			FlatConditional flatConditional = {
+				.condition = _flattenExpression(flatProgram, BOOLEAN_EXPRESSION_NODE, instruction->conditional->condition)
+			};
+			flatConditional.ifBlock = _flattenBlock(flatProgram, instruction->conditional->ifBlock);
+			flatConditional.elseBlock = _flattenBlock(flatProgram, instruction->conditional->elseBlock);
+			flatInstruction.kind = FLAT_CONDITIONAL;
+			flatInstruction.operand = _reserve(flatProgram->conditionals, 1);
+			flatProgram->conditionals.nodes[flatInstruction.operand] = flatConditional;
+			break;
+		}
+		case LOOP_INSTRUCTION_T: {
+			FlatLoop flatLoop = {
+				.name = _name(flatProgram, instruction->loop->varName),
+				.slot = instruction->loop->slot.index,
+				.start = _flattenExpression(flatProgram, ARITHMETIC_EXPRESSION_NODE, instruction->loop->start),
+				.end = _flattenExpression(flatProgram, ARITHMETIC_EXPRESSION_NODE, instruction->loop->end)
+			};
+			flatLoop.block = _flattenBlock(flatProgram, instruction->loop->block);
+			flatInstruction.kind = FLAT_LOOP;
+			flatInstruction.operand = _reserve(flatProgram->loops, 1);
+			flatProgram->loops.nodes[flatInstruction.operand] = flatLoop;
+			break;
+		}
+	}
+	flatProgram->instructions.nodes[index] = flatInstruction;
+}
+
+static void _flattenStringExpression(void * node, void * context) {
+	ExpressionFlattening * expressionFlattening = context;
+	const StringExpression * stringExpression = node;
+	FlatExpression expression;
+	memset(&expression, 0, sizeof(FlatExpression));
+	switch (stringExpression->type) {
+		case STRING_LITERAL_T:
+			expression.kind = FLAT_STRING_LITERAL;
+			expression.name = _name(expressionFlattening->flatProgram, stringExpression->value);
+			break;
+		case VAR_STRING_T:
+			expression.kind = FLAT_STRING_VARIABLE;
+			expression.depth = stringExpression->slot.depth;
+			expression.name = _name(expressionFlattening->flatProgram, stringExpression->varName);
+			expression.slot = stringExpression->slot.index;
+			break;
+		case FUNC_CALL_STRING_T:
+			expression.kind = FLAT_STRING_FUNCTION_CALL;
+			expression.call = _pop(expressionFlattening);
+			break;
+	}
+	_pushExpression(expressionFlattening, stringExpression, expression);
+}
+
+/**
+ * The index associated to a key, or NO_FLAT_INDEX if there's none.
+ */
+static FlatIndex _lookupMemo(const FlatMemo * memo, const void * key) {
+	if (memo->capacity == 0) {
+		return NO_FLAT_INDEX;
+	}
+	const FlatIndex mask = memo->capacity - 1;
+	for (FlatIndex k = hashAddress(key) & mask; memo->slots[k].key != NULL; k = (k + 1) & mask) {
+		if (memo->slots[k].key == key) {
+			return memo->slots[k].index;
+		}
+	}
+	return NO_FLAT_INDEX;
+}
+
+/**
+ * Returns the index of a name (an interned string), storing its characters
+ * the first time it's seen.
+ */
+static FlatIndex _name(FlatProgram * flatProgram, const char * name) {
+	FlatIndex index = _lookupMemo(&flatProgram->nameMemo, name);
+	if (index == NO_FLAT_INDEX) {
+		const size_t length = strlen(name);
+		const FlatIndex offset = _reserve(flatProgram->characters, length + 1);
+		memcpy(&flatProgram->characters.nodes[offset], name, length + 1);
+		index = _reserve(flatProgram->names, 1);
+		flatProgram->names.nodes[index] = offset;
+		_storeInMemo(&flatProgram->nameMemo, name, index);
+	}
+	return index;
+}
+
+static FlatIndex _pop(ExpressionFlattening * expressionFlattening) {
+	return expressionFlattening->indices.nodes[--expressionFlattening->indices.size];
+}
+
+static void _push(ExpressionFlattening * expressionFlattening, const FlatIndex index) {
+	const FlatIndex top = _reserve(expressionFlattening->indices, 1);
+	expressionFlattening->indices.nodes[top] = index;
+}
+
+/**
+ * Appends an expression, after all of its children, remembers the node it
+ * comes from, and leaves its index for its parent.
+ */
+static void _pushExpression(ExpressionFlattening * expressionFlattening, const void * node, const FlatExpression expression) {
+	FlatProgram * flatProgram = expressionFlattening->flatProgram;
+	const FlatIndex index = _reserve(flatProgram->expressions, 1);
+	flatProgram->expressions.nodes[index] = expression;
+	_storeInMemo(&flatProgram->expressionMemo, node, index);
+	_push(expressionFlattening, index);
+}
+
+/**
+ * Grows an array of nodes (doubling its capacity) until the requested nodes
+ * fit in it, and marks them as used (zeroed).
+ */
+static FlatIndex _reserveNodes(void ** nodes, FlatIndex * size, FlatIndex * capacity, const size_t nodeSize, const FlatIndex count) {
+	if (*capacity - *size < count) {
+		FlatIndex newCapacity = *capacity == 0 ? _initialCapacity : *capacity;
+		while (newCapacity - *size < count) {
+			newCapacity *= 2;
+		}
+		*nodes = realloc(*nodes, newCapacity * nodeSize);
+		*capacity = newCapacity;
+	}
+	const FlatIndex index = *size;
+	memset((char *) *nodes + (size_t) index * nodeSize, 0, (size_t) count * nodeSize);
+	*size += count;
+	return index;
+}
+
+/**
+ * Associates an index to a key, doubling the amount of slots (and
+ * re-inserting every key) when the memo is 3/4 full.
+ */
+static void _storeInMemo(FlatMemo * memo, const void * key, const FlatIndex index) {
+	if (4 * (memo->size + 1) > 3 * memo->capacity) {
+		const FlatIndex capacity = memo->capacity == 0 ? _initialCapacity : 2 * memo->capacity;
+		FlatMemoSlot * slots = calloc(capacity, sizeof(FlatMemoSlot));
+		for (FlatIndex slot = 0; slot < memo->capacity; ++slot) {
+			if (memo->slots[slot].key != NULL) {
+				FlatIndex k = hashAddress(memo->slots[slot].key) & (capacity - 1);
+				while (slots[k].key != NULL) {
+					k = (k + 1) & (capacity - 1);
+				}
+				slots[k] = memo->slots[slot];
+			}
+		}
+		free(memo->slots);
+		memo->slots = slots;
+		memo->capacity = capacity;
+	}
+	FlatIndex k = hashAddress(key) & (memo->capacity - 1);
+	while (memo->slots[k].key != NULL) {
+		k = (k + 1) & (memo->capacity - 1);
+	}
+	memo->slots[k].key = key;
+	memo->slots[k].index = index;
+	++memo->size;
+}
+
+/**
+ * Rebuilds a block with the same actions of the parser, so the instructions
+ * are appended to a circular list that the block breaks.
+ */
+static Block * _unflattenBlock(Unflattening * unflattening, const FlatRange range) {
+	CompilerState * compilerState = unflattening->compilerState;
+	Instruction * instructions = NULL;
+	for (FlatIndex index = range.offset; index < range.offset + range.count; ++index) {
+		Instruction * instruction = _unflattenInstruction(unflattening, &unflattening->flatProgram->instructions.nodes[index]);
+		if (instruction != NULL) {
+			instructions = instructions == NULL
+				? SingleInstructionSemanticAction(compilerState, instruction)
+				: MultipleInstructionsSemanticAction(compilerState, instructions, instruction);
+		}
+	}
+	return BlockSemanticAction(compilerState, instructions);
+}
+
+static CompareOperator * _unflattenCompareOperator(CompilerState * compilerState, const uint8_t comparison) {
+	switch (comparison) {
+		case GREATER_THAN_T:
+			return GreaterThanSemanticAction(compilerState);
+		case LESS_THAN_T:
+			return LessThanSemanticAction(compilerState);
+		case EQUALS_EQUALS_T:
+			return EqualsEqualsSemanticAction(compilerState);
+		case NOT_EQUALS_T:
+			return NotEqualsSemanticAction(compilerState);
+		case GREATER_EQUALS_T:
+			return GreaterEqualsSemanticAction(compilerState);
+		default:
+			return LessEqualsSemanticAction(compilerState);
+	}
+}
+
+/**
+ * Wraps an already rebuilt expression, according to the type of its kind.
+ */
+static Expression * _unflattenExpression(Unflattening * unflattening, const FlatIndex index) {
+	const uint8_t kind = unflattening->flatProgram->expressions.nodes[index].kind;
+	void * expression = unflattening->expressions[index];
+	if (kind <= FLAT_INT_FUNCTION_CALL) {
+		return ArithmeticExpressionSemanticAction(unflattening->compilerState, expression);
+	}
+	else if (kind <= FLAT_BOOL_FUNCTION_CALL) {
+		return BooleanExpressionSemanticAction(unflattening->compilerState, expression);
+	}
+	else {
+		return StringExpressionSemanticAction(unflattening->compilerState, expression);
+	}
+}
+
+/**
+ * Rebuilds every expression with a single linear scan, since the children of
+ * an expression (including the arguments of its call) are always stored
+ * before it. Shared subtrees are rebuilt only once.
+ */
+static void _unflattenExpressions(Unflattening * unflattening) {
+	CompilerState * compilerState = unflattening->compilerState;
+	void ** nodes = unflattening->expressions;
+	for (FlatIndex index = 0; index < unflattening->flatProgram->expressions.size; ++index) {
+		const FlatExpression * expression = &unflattening->flatProgram->expressions.nodes[index];
+		switch (expression->kind) {
+			case FLAT_ADD:
+				nodes[index] = AdditionExpressionSemanticAction(compilerState, nodes[expression->left], nodes[expression->right]);
+				break;
+			case FLAT_SUB:
+				nodes[index] = SubtractionExpressionSemanticAction(compilerState, nodes[expression->left], nodes[expression->right]);
+				break;
+			case FLAT_MUL:
+				nodes[index] = MultiplicationExpressionSemanticAction(compilerState, nodes[expression->left], nodes[expression->right]);
+				break;
+			case FLAT_DIV:
+				nodes[index] = DivisionExpressionSemanticAction(compilerState, nodes[expression->left], nodes[expression->right]);
+				break;
+			case FLAT_INT_VARIABLE:
+				nodes[index] = VarNameArithmeticExpressionSemanticAction(compilerState,
+					_unflattenVariable(unflattening, expression->name, expression->depth, expression->slot));
+				break;
+			case FLAT_INT_LITERAL:
+				nodes[index] = IntegerArithmeticExpressionSemanticAction(compilerState, expression->value);
+				break;
+			case FLAT_INT_FUNCTION_CALL:
+				nodes[index] = FunctionCallArithmeticExpressionSemanticAction(compilerState, _unflattenFunctionCall(unflattening, expression->call));
+				break;
+			case FLAT_AND:
+				nodes[index] = AndExpressionSemanticAction(compilerState, nodes[expression->left], nodes[expression->right]);
+				break;
+			case FLAT_OR:
+				nodes[index] = OrExpressionSemanticAction(compilerState, nodes[expression->left], nodes[expression->right]);
+				break;
+			case FLAT_NOT:
+				nodes[index] = NotExpressionSemanticAction(compilerState, nodes[expression->left]);
+				break;
+			case FLAT_COMPARISON:
+				nodes[index] = ComparisonExpressionSemanticAction(compilerState, nodes[expression->left],
+					_unflattenCompareOperator(compilerState, expression->comparison), nodes[expression->right]);
+				break;
+			case FLAT_BOOL_VARIABLE:
+				nodes[index] = VarNameBooleanExpressionSemanticAction(compilerState,
+					_unflattenVariable(unflattening, expression->name, expression->depth, expression->slot));
+				break;
+			case FLAT_BOOL_LITERAL:
+				nodes[index] = BoolLiteralExpressionSemanticAction(compilerState, expression->value);
+				break;
+			case FLAT_BOOL_FUNCTION_CALL:
+				nodes[index] = FunctionCallBooleanExpressionSemanticAction(compilerState, _unflattenFunctionCall(unflattening, expression->call));
+				break;
+			case FLAT_STRING_LITERAL:
+				nodes[index] = StringLiteralExpressionSemanticAction(compilerState, _unflattenName(unflattening, expression->name));
+				break;
+			case FLAT_STRING_VARIABLE:
+				nodes[index] = VarNameStringExpressionSemanticAction(compilerState,
+					_unflattenVariable(unflattening, expression->name, expression->depth, expression->slot));
+				break;
+			case FLAT_STRING_FUNCTION_CALL:
+				nodes[index] = FunctionCallStringExpressionSemanticAction(compilerState, _unflattenFunctionCall(unflattening, expression->call));
+				break;
+		}
+	}
+}
+
+static FunctionCall * _unflattenFunctionCall(Unflattening * unflattening, const FlatIndex index) {
+	CompilerState * compilerState = unflattening->compilerState;
+	const FlatFunctionCall * flatFunctionCall = &unflattening->flatProgram->functionCalls.nodes[index];
+	Arguments * arguments = NULL;
+	for (FlatIndex k = 0; k < flatFunctionCall->arguments.count; ++k) {
+		const FlatIndex expression = unflattening->flatProgram->arguments.nodes[flatFunctionCall->arguments.offset + k];
+		Argument * argument = ArgumentSemanticAction(compilerState, _unflattenExpression(unflattening, expression));
+		arguments = arguments == NULL
+			? SingleArgumentSemanticAction(compilerState, argument)
+			: MultipleArgumentsSemanticAction(compilerState, arguments, argument);
+	}
+	return FunctionCallSemanticAction(compilerState, _unflattenName(unflattening, flatFunctionCall->name), arguments,
+		_unflattenType(compilerState, flatFunctionCall->returnType));
+}
+
+/**
+ * Rebuilds an instruction (and its nested blocks). Expression instructions
+ * are never produced by the grammar, so they're not rebuilt.
+ */
+static Instruction * _unflattenInstruction(Unflattening * unflattening, const FlatInstruction * flatInstruction) {
+	CompilerState * compilerState = unflattening->compilerState;
+	const FlatProgram * flatProgram = unflattening->flatProgram;
+	const unsigned int line = flatInstruction->line;
+	switch (flatInstruction->kind) {
+		case FLAT_DECLARATION: {
+			Assignation * assignation = AssignationSemanticAction(compilerState,
+				_unflattenVariable(unflattening, flatInstruction->name, flatInstruction->depth, flatInstruction->slot),
+				_unflattenExpression(unflattening, flatInstruction->operand));
+			Type * type = _unflattenType(compilerState, flatInstruction->dataType);
+			return DeclarationInstructionSemanticAction(compilerState, DeclarationSemanticAction(compilerState, type, assignation), line);
+		}
+		case FLAT_ASSIGNATION:
+			return AssignationInstructionSemanticAction(compilerState, AssignationSemanticAction(compilerState,
+				_unflattenVariable(unflattening, flatInstruction->name, flatInstruction->depth, flatInstruction->slot),
+				_unflattenExpression(unflattening, flatInstruction->operand)), line);
+		case FLAT_PRINT:
+			return PrintInstructionSemanticAction(compilerState,
+				PrintSemanticAction(compilerState, _unflattenExpression(unflattening, flatInstruction->operand)), line);
+		case FLAT_FUNCTION_CALL:
+			return FunctionCallInstructionSemanticAction(compilerState, _unflattenFunctionCall(unflattening, flatInstruction->operand), line);
+		case FLAT_RETURN_STATEMENT:
+			return ReturnStatementInstructionSemanticAction(compilerState,
+				ReturnStatementSemanticAction(compilerState, _unflattenExpression(unflattening, flatInstruction->operand)), line);
+		case FLAT_FUNCTION: {
+			const FlatFunction * flatFunction = &flatProgram->functions.nodes[flatInstruction->operand];
+			Parameters * parameters = NULL;
+			for (FlatIndex k = flatFunction->parameters.offset; k < flatFunction->parameters.offset + flatFunction->parameters.count; ++k) {
+				const FlatParameter * flatParameter = &flatProgram->parameters.nodes[k];
+				Parameter * parameter = ParameterSemanticAction(compilerState,
+					_unflattenType(compilerState, flatParameter->type), _unflattenVariable(unflattening, flatParameter->name, 0, flatParameter->slot));
+				parameters = parameters == NULL
+					? SingleParameterSemanticAction(compilerState, parameter)
+					: MultipleParametersSemanticAction(compilerState, parameters, parameter);
+			}
+			Function * function = FunctionSemanticAction(compilerState, _unflattenType(compilerState, flatFunction->returnType),
+				_unflattenName(unflattening, flatFunction->name), parameters, _unflattenBlock(unflattening, flatFunction->block),
+				flatFunction->frameSize);
+			return FunctionInstructionSemanticAction(compilerState, function, line);
+		}
+		case FLAT_CONDITIONAL: {
+			const FlatConditional * flatConditional = &flatProgram->conditionals.nodes[flatInstruction->operand];
+			Conditional * conditional = ConditionalSemanticAction(compilerState, unflattening->expressions[flatConditional->condition],
+				_unflattenBlock(unflattening, flatConditional->ifBlock), _unflattenBlock(unflattening, flatConditional->elseBlock));
+			return ConditionalInstructionSemanticAction(compilerState, conditional, line);
+		}
+		case FLAT_LOOP: {
+			const FlatLoop * flatLoop = &flatProgram->loops.nodes[flatInstruction->operand];
+			Loop * loop = LoopSemanticAction(compilerState, _unflattenVariable(unflattening, flatLoop->name, 0, flatLoop->slot),
+				unflattening->expressions[flatLoop->start], unflattening->expressions[flatLoop->end],
+				_unflattenBlock(unflattening, flatLoop->block));
+			return LoopInstructionSemanticAction(compilerState, loop, line);
+		}
+		default:
+			return NULL;
+	}
+}
+
+/**
+ * Interns a name in the string table of the compilation, once.
+ */
+static const char * _unflattenName(Unflattening * unflattening, const FlatIndex index) {
+	if (unflattening->names[index] == NULL) {
+		const char * name = flatNameAt(unflattening->flatProgram, index);
+		unflattening->names[index] = intern(unflattening->compilerState->stringTable, name, strlen(name));
+	}
+	return unflattening->names[index];
+}
+
+static Type * _unflattenType(CompilerState * compilerState, const uint8_t dataType) {
+	switch (dataType) {
+		case INT_T:
+			return IntTypeSemanticAction(compilerState);
+		case BOOL_T:
+			return BoolTypeSemanticAction(compilerState);
+		default:
+			return StringTypeSemanticAction(compilerState);
+	}
+}
+
+static Variable _unflattenVariable(Unflattening * unflattening, const FlatIndex name, const unsigned int depth, const FlatIndex index) {
+	Variable variable = {
+		.name = _unflattenName(unflattening, name),
+		.slot = {depth, index}
+	};
+	return variable;
+}
+
+/* PUBLIC FUNCTIONS */
+
+FlatProgram * flattenProgram(const Program * program) {
+	FlatProgram * flatProgram = calloc(1, sizeof(FlatProgram));
+	flatProgram->block = _flattenBlock(flatProgram, program->block);
+	flatProgram->frameSize = program->frameSize;
+	free(flatProgram->nameMemo.slots);
+	free(flatProgram->expressionMemo.slots);
+	memset(&flatProgram->nameMemo, 0, sizeof(FlatMemo));
+	memset(&flatProgram->expressionMemo, 0, sizeof(FlatMemo));
+	logDebugging(_logger, "Flattened %u instructions and %u expressions (%zu bytes).",
+		flatProgram->instructions.size, flatProgram->expressions.size, flatProgramSize(flatProgram));
+	return flatProgram;
+}
+
+Program * unflattenProgram(CompilerState * compilerState, const FlatProgram * flatProgram) {
+	Unflattening unflattening = {
+		.compilerState = compilerState,
+		.flatProgram = flatProgram,
+		.expressions = calloc(flatProgram->expressions.size + 1, sizeof(void *)),
+		.names = calloc(flatProgram->names.size + 1, sizeof(const char *))
+	};
+	_unflattenExpressions(&unflattening);
+	Program * program = ProgramSemanticAction(compilerState, _unflattenBlock(&unflattening, flatProgram->block), flatProgram->frameSize);
+	free(unflattening.expressions);
+	free(unflattening.names);
+	logDebugging(_logger, "Unflattened %u instructions and %u expressions.",
+		flatProgram->instructions.size, flatProgram->expressions.size);
+	return program;
+}
+
+void destroyFlatProgram(FlatProgram * flatProgram) {
+	if (flatProgram != NULL) {
+		free(flatProgram->instructions.nodes);
+		free(flatProgram->expressions.nodes);
+		free(flatProgram->functionCalls.nodes);
+		free(flatProgram->functions.nodes);
+		free(flatProgram->parameters.nodes);
+		free(flatProgram->conditionals.nodes);
+		free(flatProgram->loops.nodes);
+		free(flatProgram->arguments.nodes);
+		free(flatProgram->names.nodes);
+		free(flatProgram->characters.nodes);
+		free(flatProgram->nameMemo.slots);
+		free(flatProgram->expressionMemo.slots);
+		free(flatProgram);
+	}
+}
+
+size_t flatProgramSize(const FlatProgram * flatProgram) {
+	return flatProgram->instructions.size * sizeof(FlatInstruction)
+		+ flatProgram->expressions.size * sizeof(FlatExpression)
+		+ flatProgram->functionCalls.size * sizeof(FlatFunctionCall)
+		+ flatProgram->functions.size * sizeof(FlatFunction)
+		+ flatProgram->parameters.size * sizeof(FlatParameter)
+		+ flatProgram->conditionals.size * sizeof(FlatConditional)
+		+ flatProgram->loops.size * sizeof(FlatLoop)
+		+ flatProgram->arguments.size * sizeof(FlatIndex)
+		+ flatProgram->names.size * sizeof(FlatIndex)
+		+ flatProgram->characters.size * sizeof(char);
+}
+
+void visitFlatBlock(const FlatProgram * flatProgram, const FlatRange block, FlatInstructionVisitor visitor, void * context) {
+	const FlatInstruction * instructions = flatProgram->instructions.nodes;
+	for (FlatIndex index = block.offset; index < block.offset + block.count; ++index) {
+		const FlatInstruction * instruction = &instructions[index];
+		visitor(flatProgram, instruction, context);
+		switch (instruction->kind) {
+			case FLAT_FUNCTION:
+				visitFlatBlock(flatProgram, flatProgram->functions.nodes[instruction->operand].block, visitor, context);
+				break;
+			case FLAT_CONDITIONAL:
+				visitFlatBlock(flatProgram, flatProgram->conditionals.nodes[instruction->operand].ifBlock, visitor, context);
+				visitFlatBlock(flatProgram, flatProgram->conditionals.nodes[instruction->operand].elseBlock, visitor, context);
+				break;
+			case FLAT_LOOP:
+				visitFlatBlock(flatProgram, flatProgram->loops.nodes[instruction->operand].block, visitor, context);
+				break;
+		}
+	}
+}
+
+const FlatInstruction * flatInstructionAt(const FlatProgram * flatProgram, const FlatIndex index) {
+	return &flatProgram->instructions.nodes[index];
+}
+
+const FlatExpression * flatExpressionAt(const FlatProgram * flatProgram, const FlatIndex index) {
+	return &flatProgram->expressions.nodes[index];
+}
+
+const char * flatNameAt(const FlatProgram * flatProgram, const FlatIndex index) {
+	return &flatProgram->characters.nodes[flatProgram->names.nodes[index]];
+}
@@ -0,0 +1,242 @@
+#ifndef FLAT_ABSTRACT_SYNTAX_TREE_HEADER
+#define FLAT_ABSTRACT_SYNTAX_TREE_HEADER
+
+#include "../../shared/Hash.h"
+#include "../../shared/Logger.h"
+#include "AbstractSyntaxTree.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializeFlatAbstractSyntaxTreeModule();
+
+/** Shutdown module's internal state. */
+void shutdownFlatAbstractSyntaxTreeModule();
+
+/**
+ * A compact representation of the AST. Every kind of node lives in its own
+ * contiguous array, and nodes refer to each other with 32-bit indices into
+ * those arrays (instead of pointers). The instructions of a block are stored
+ * next to each other, so a block is just a range of the instructions array.
+ * The children of an expression are always stored before it, so a linear
+ * scan of the expressions array visits them in post-order. A hash-consed
+ * expression is flattened only once, so shared subtrees remain shared. Since
+ * it doesn't contain any pointer, a flat AST can be stored and loaded as is
+ * (see "FlatAbstractSyntaxTreeFile.h").
+ */
+
+typedef uint32_t FlatIndex;
+
+/** The index of an absent node. */
+#define NO_FLAT_INDEX ((FlatIndex) UINT32_MAX)
+
+/**
+ * A contiguous range of nodes (e.g., the instructions of a block, or the
+ * arguments of a call).
+ */
+typedef struct {
+	FlatIndex offset;
+	FlatIndex count;
+} FlatRange;
+
+/**
+ * Node kinds (stored in a single byte).
+ */
+
+typedef enum {
+	FLAT_DECLARATION,
+	FLAT_ASSIGNATION,
+	FLAT_EXPRESSION,
+	FLAT_PRINT,
+	FLAT_FUNCTION_CALL,
+	FLAT_RETURN_STATEMENT,
+	FLAT_FUNCTION,
+	FLAT_CONDITIONAL,
+	FLAT_LOOP
+} FlatInstructionKind;
+
+typedef enum {
+	FLAT_ADD,
+	FLAT_SUB,
+	FLAT_MUL,
+	FLAT_DIV,
+	FLAT_INT_VARIABLE,
+	FLAT_INT_LITERAL,
+	FLAT_INT_FUNCTION_CALL,
+	FLAT_AND,
+	FLAT_OR,
+	FLAT_NOT,
+	FLAT_COMPARISON,
+	FLAT_BOOL_VARIABLE,
+	FLAT_BOOL_LITERAL,
+	FLAT_BOOL_FUNCTION_CALL,
+	FLAT_STRING_LITERAL,
+	FLAT_STRING_VARIABLE,
+	FLAT_STRING_FUNCTION_CALL
+} FlatExpressionKind;
+
+/**
+ * An instruction. The operand depends on the kind: an expression (for
+ * declarations, assignations, expressions, prints and returns), a call, a
+ * function, a conditional or a loop. The name and its slot (the depth and
+ * the index) are only used by declarations and assignations. The line is
+ * where the instruction begins in the source file.
+ */
+typedef struct {
+	uint8_t kind;
+	uint8_t dataType;
+	uint16_t depth;
+	FlatIndex name;
+	FlatIndex operand;
+	FlatIndex slot;
+	FlatIndex line;
+} FlatInstruction;
+
+/**
+ * An expression. Binary operators use both children, "not" uses only the
+ * left one, and leaves use either a literal value, a name or a call. The
+ * comparison operator is only used by comparisons, and the slot (the depth
+ * and the index) only by variables.
+ */
+typedef struct {
+	uint8_t kind;
+	uint8_t comparison;
+	uint16_t depth;
+	union {
+		struct {
+			FlatIndex left;
+			FlatIndex right;
+		};
+		int32_t value;
+		struct {
+			FlatIndex name;
+			FlatIndex slot;
+		};
+		FlatIndex call;
+	};
+} FlatExpression;
+
+typedef struct {
+	uint8_t returnType;
+	FlatIndex name;
+	FlatRange arguments;
+} FlatFunctionCall;
+
+typedef struct {
+	uint8_t type;
+	FlatIndex name;
+	FlatIndex slot;
+} FlatParameter;
+
+typedef struct {
+	uint8_t returnType;
+	FlatIndex name;
+	FlatRange parameters;
+	FlatRange block;
+	FlatIndex frameSize;
+} FlatFunction;
+
+typedef struct {
+	FlatIndex condition;
+	FlatRange ifBlock;
+	FlatRange elseBlock;
+} FlatConditional;
+
+typedef struct {
+	FlatIndex name;
+	FlatIndex slot;
+	FlatIndex start;
+	FlatIndex end;
+	FlatRange block;
+} FlatLoop;
+
+/**
+ * A growable array of nodes of the same type.
+ */
+#define FlatArray(T) struct { T * nodes; FlatIndex size; FlatIndex capacity; }
+
+/**
+ * A table that maps the address of an interned string (or a hash-consed
+ * node) to its index in a flat program, while the program is flattened. An
+ * empty slot has a NULL key.
+ */
+typedef struct {
+	const void * key;
+	FlatIndex index;
+} FlatMemoSlot;
+
+typedef struct {
+	FlatMemoSlot * slots;
+	FlatIndex capacity;
+	FlatIndex size;
+} FlatMemo;
+
+/**
+ * The whole flat AST of a program. The arguments are indices of expressions.
+ * The names are the distinct strings of the program (identifiers and string
+ * literals), each one stored as the offset of its first character in the
+ * characters array (and followed by a NUL character), so a name index is
+ * also a unique identifier of the string.
+ *
+ * The parameters and the variables of loops are always in the frame of their
+ * function, so their slots have no depth.
+ */
+typedef struct {
+	FlatRange block;
+	FlatIndex frameSize;
+	FlatArray(FlatInstruction) instructions;
+	FlatArray(FlatExpression) expressions;
+	FlatArray(FlatFunctionCall) functionCalls;
+	FlatArray(FlatFunction) functions;
+	FlatArray(FlatParameter) parameters;
+	FlatArray(FlatConditional) conditionals;
+	FlatArray(FlatLoop) loops;
+	FlatArray(FlatIndex) arguments;
+	FlatArray(FlatIndex) names;
+	FlatArray(char) characters;
+
+	// Only used while flattening.
+	FlatMemo nameMemo;
+	FlatMemo expressionMemo;
+} FlatProgram;
+
+/**
+ * Builds the flat representation of a program, from its AST.
+ */
+FlatProgram * flattenProgram(const Program * program);
+
+/**
+ * Rebuilds the AST of a flat program in the arena of a compilation, with the
+ * same semantic actions of the parser, so its strings are interned and its
+ * immutable nodes hash-consed as if the program were parsed.
+ */
+Program * unflattenProgram(CompilerState * compilerState, const FlatProgram * flatProgram);
+
+/**
+ * Destroy a flat program (the AST is not affected).
+ */
+void destroyFlatProgram(FlatProgram * flatProgram);
+
+/**
+ * The amount of bytes used by the nodes of a flat program.
+ */
+size_t flatProgramSize(const FlatProgram * flatProgram);
+
+/**
+ * Traversal API.
+ */
+
+typedef void (*FlatInstructionVisitor)(const FlatProgram * flatProgram, const FlatInstruction * instruction, void * context);
+
+/**
+ * Visits the instructions of a block in order, including those of nested
+ * blocks (which are visited right after the instruction that owns them).
+ */
+void visitFlatBlock(const FlatProgram * flatProgram, const FlatRange block, FlatInstructionVisitor visitor, void * context);
+
+const FlatInstruction * flatInstructionAt(const FlatProgram * flatProgram, const FlatIndex index);
+const FlatExpression * flatExpressionAt(const FlatProgram * flatProgram, const FlatIndex index);
+const char * flatNameAt(const FlatProgram * flatProgram, const FlatIndex index);
+
+#endif
@@ -0,0 +1,797 @@
+#include "FlatAbstractSyntaxTreeFile.h"
+
+/**
+ * Platform dependent memory-mapping support.
+ *
+ * @see https://man7.org/linux/man-pages/man2/mmap.2.html
+ */
+#if defined (__TOS_WIN__) \
+	|| defined (__WIN32__) \
+	|| defined (__WINDOWS__) \
+	|| defined (_WIN16) \
+	|| defined (_WIN32) \
+	|| defined (_WIN64)
+#define MAPPING_IS_SUPPORTED 0
+#else
+#define MAPPING_IS_SUPPORTED 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * A flat program loaded from a file, and the memory that holds its arrays.
+ * The program must be the first member, so both share the same address.
+ */
+typedef struct {
+	FlatProgram flatProgram;
+	void * content;
+	size_t size;
+} LoadedFlatProgram;
+
+/**
+ * The location of an array of a flat program, in memory.
+ */
+typedef struct {
+	void ** nodes;
+	FlatIndex * count;
+	uint32_t size;
+} FlatProgramArray;
+
+/**
+ * A block being checked: its next instruction, its end, its context (i.e.,
+ * the function whose frame it uses, or the program), and the amount of
+ * bindings before it.
+ */
+typedef struct {
+	FlatIndex next;
+	FlatIndex end;
+	FlatIndex context;
+	FlatIndex bindings;
+} ValidationScope;
+
+/**
+ * The state of the validation of a loaded flat program. The context of an
+ * instruction is the function whose frame it uses (or the program, with the
+ * index right after the last function), and the parent of a function is the
+ * context of its declaration. The slots of every frame start at its base,
+ * and each one has the type of the declaration, the parameter or the loop
+ * that binds it, while its scope is open. The mark of an expression is the
+ * generation in which its variables were last checked (a new one begins when
+ * a scope opens or closes). Every context, parent, type and mark is unset
+ * (i.e., all ones) until it's known.
+ */
+typedef struct {
+	const FlatProgram * flatProgram;
+	FlatIndex program;
+	FlatIndex * contexts;
+	FlatIndex * parents;
+	FlatIndex * bases;
+	uint8_t * types;
+	FlatIndex * marks;
+	FlatIndex generation;
+	FlatIndex * pending;
+	ValidationScope * scopes;
+	FlatIndex scopeCount;
+	FlatIndex * bindings;
+	FlatIndex bindingCount;
+} Validation;
+
+/* MODULE INTERNAL STATE */
+
+// The string "#TLAAST1", read in the byte order of the platform.
+static const uint64_t _magic = 0x31545341414C5423ull;
+
+static Logger * _logger = NULL;
+
+void initializeFlatAbstractSyntaxTreeFileModule() {
+	_logger = createLogger("FlatAbstractSyntaxTreeFile");
+}
+
+void shutdownFlatAbstractSyntaxTreeFileModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+static uint64_t _align(const uint64_t size);
+static void _arrays(FlatProgram * flatProgram, FlatProgramArray * arrays);
+static boolean _bind(Validation * validation, const FlatIndex context, const unsigned int depth, const FlatIndex index, const uint8_t type);
+static uint32_t _checksum(const void * content, const size_t size);
+static boolean _claim(Validation * validation, const FlatRange block, const FlatIndex context, const FlatIndex owner);
+static void _enter(Validation * validation, const FlatRange block, const FlatIndex context);
+static boolean _isConsistent(const FlatProgram * flatProgram);
+static boolean _isValidCall(const FlatProgram * flatProgram, const FlatIndex call, const FlatIndex before);
+static boolean _isValidExpression(const FlatProgram * flatProgram, const FlatIndex index);
+static boolean _isValidInstruction(Validation * validation, const FlatIndex index);
+static boolean _isValidRange(const FlatRange range, const FlatIndex size);
+static boolean _isValidVariables(Validation * validation, const FlatIndex expression, const FlatIndex context);
+static boolean _isWellTyped(Validation * validation);
+static boolean _isWellTypedInstruction(Validation * validation, const FlatInstruction * instruction, const FlatIndex context);
+static void _leave(Validation * validation);
+static void * _read(const char * path, size_t * size);
+static void _release(void * content, const size_t size);
+static FlatIndex _slotOf(const Validation * validation, const FlatIndex context, const unsigned int depth, const FlatIndex index);
+static uint8_t _typeOf(const FlatProgram * flatProgram, const FlatIndex expression);
+
+/**
+ * Rounds a size up to a multiple of 8 bytes, the alignment of every section.
+ */
+static uint64_t _align(const uint64_t size) {
+	return (size + 7) & ~((uint64_t) 7);
+}
+
+/**
+ * The arrays of a flat program, in the order of the sections of a file.
+ */
+static void _arrays(FlatProgram * flatProgram, FlatProgramArray * arrays) {
+	const FlatProgramArray layout[FLAT_PROGRAM_FILE_SECTIONS] = {
+		{(void **) &flatProgram->instructions.nodes, &flatProgram->instructions.size, sizeof(FlatInstruction)},
+		{(void **) &flatProgram->expressions.nodes, &flatProgram->expressions.size, sizeof(FlatExpression)},
+		{(void **) &flatProgram->functionCalls.nodes, &flatProgram->functionCalls.size, sizeof(FlatFunctionCall)},
+		{(void **) &flatProgram->functions.nodes, &flatProgram->functions.size, sizeof(FlatFunction)},
+		{(void **) &flatProgram->parameters.nodes, &flatProgram->parameters.size, sizeof(FlatParameter)},
+		{(void **) &flatProgram->conditionals.nodes, &flatProgram->conditionals.size, sizeof(FlatConditional)},
+		{(void **) &flatProgram->loops.nodes, &flatProgram->loops.size, sizeof(FlatLoop)},
+		{(void **) &flatProgram->arguments.nodes, &flatProgram->arguments.size, sizeof(FlatIndex)},
+		{(void **) &flatProgram->names.nodes, &flatProgram->names.size, sizeof(FlatIndex)},
+		{(void **) &flatProgram->characters.nodes, &flatProgram->characters.size, sizeof(char)}
+	};
+	memcpy(arrays, layout, sizeof(layout));
+}
+
+/**
+ * Binds a slot to a type, until the innermost scope closes. As in the parser,
+ * a slot can't be in use by any binding of an open scope (not even one of the
+ * same scope, since a redeclaration is rejected), so it's never retyped.
+ */
+static boolean _bind(Validation * validation, const FlatIndex context, const unsigned int depth, const FlatIndex index, const uint8_t type) {
+	const FlatIndex slot = _slotOf(validation, context, depth, index);
+	if (slot == NO_FLAT_INDEX || STRING_T < type || validation->types[slot] != UINT8_MAX) {
+		return false;
+	}
+	validation->bindings[validation->bindingCount++] = slot;
+	validation->types[slot] = type;
+	return true;
+}
+
+/**
+ * The 64-bit FNV-1a hash of a content (a multiple of 8 bytes), processed a
+ * word at a time, and folded to 32 bits.
+ *
+ * @see http://www.isthe.com/chongo/tech/comp/fnv/
+ */
+static uint32_t _checksum(const void * content, const size_t size) {
+	const uint64_t * words = content;
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t k = 0; k < size / sizeof(uint64_t); ++k) {
+		hash ^= words[k];
+		hash *= 1099511628211ull;
+	}
+	return (uint32_t) (hash ^ (hash >> 32));
+}
+
+/**
+ * Assigns a context to the instructions of a block. As in the grammar, a
+ * block can't be empty. A nested block must come after the instruction that
+ * owns it, and every instruction must belong to a single block, so the blocks
+ * form a tree that can be walked in a single pass.
+ */
+static boolean _claim(Validation * validation, const FlatRange block, const FlatIndex context, const FlatIndex owner) {
+	if (block.count == 0 || !_isValidRange(block, validation->flatProgram->instructions.size)
+			|| (owner != NO_FLAT_INDEX && block.offset <= owner)) {
+		return false;
+	}
+	for (FlatIndex index = block.offset; index < block.offset + block.count; ++index) {
+		if (validation->contexts[index] != NO_FLAT_INDEX) {
+			return false;
+		}
+		validation->contexts[index] = context;
+	}
+	return true;
+}
+
+/**
+ * Opens the scope of a block, whose instructions are checked next.
+ */
+static void _enter(Validation * validation, const FlatRange block, const FlatIndex context) {
+	validation->scopes[validation->scopeCount++] = (ValidationScope) {
+		.next = block.offset,
+		.end = block.offset + block.count,
+		.context = context,
+		.bindings = validation->bindingCount
+	};
+	++validation->generation;
+}
+
+/**
+ * Checks every index and offset of a loaded flat program, since a file can
+ * be crafted (the checksum only detects accidents): the names must be in the
+ * characters (which end with a NUL character), the children of an expression
+ * (and the arguments of its call) must be stored before it, and with the
+ * right types, the ranges must be inside their arrays, and the blocks must
+ * form a tree. Then, the slots are bound as the parser binds them, so every
+ * frame is smaller than the amount of declarations, parameters and loops, and
+ * every variable must be in a frame of its context, with the type of the
+ * binding in scope.
+ */
+static boolean _isConsistent(const FlatProgram * flatProgram) {
+	if (0 < flatProgram->characters.size && flatProgram->characters.nodes[flatProgram->characters.size - 1] != '\0') {
+		return false;
+	}
+	for (FlatIndex index = 0; index < flatProgram->names.size; ++index) {
+		if (flatProgram->characters.size <= flatProgram->names.nodes[index]) {
+			return false;
+		}
+	}
+	for (FlatIndex index = 0; index < flatProgram->expressions.size; ++index) {
+		if (!_isValidExpression(flatProgram, index)) {
+			return false;
+		}
+	}
+	for (FlatIndex index = 0; index < flatProgram->functionCalls.size; ++index) {
+		if (!_isValidCall(flatProgram, index, flatProgram->expressions.size)) {
+			return false;
+		}
+	}
+	uint64_t binders = flatProgram->parameters.size;
+	for (FlatIndex index = 0; index < flatProgram->instructions.size; ++index) {
+		const uint8_t kind = flatProgram->instructions.nodes[index].kind;
+		binders += kind == FLAT_DECLARATION || kind == FLAT_LOOP;
+	}
+	uint64_t slots = flatProgram->frameSize;
+	for (FlatIndex index = 0; index < flatProgram->functions.size; ++index) {
+		slots += flatProgram->functions.nodes[index].frameSize;
+	}
+	if (binders < slots || NO_FLAT_INDEX <= slots || flatProgram->functions.size == NO_FLAT_INDEX) {
+		return false;
+	}
+	Validation validation = {
+		.flatProgram = flatProgram,
+		.program = flatProgram->functions.size,
+		.contexts = malloc((flatProgram->instructions.size + 1) * sizeof(FlatIndex)),
+		.parents = malloc((flatProgram->functions.size + 1) * sizeof(FlatIndex)),
+		.bases = malloc((flatProgram->functions.size + 1) * sizeof(FlatIndex)),
+		.types = malloc(slots + 1),
+		.marks = malloc((flatProgram->expressions.size + 1) * sizeof(FlatIndex)),
+		.generation = 0,
+		.pending = malloc((flatProgram->expressions.size + 1) * sizeof(FlatIndex)),
+		.scopes = malloc((flatProgram->instructions.size + 1) * sizeof(ValidationScope)),
+		.scopeCount = 0,
+		.bindings = malloc((slots + 1) * sizeof(FlatIndex)),
+		.bindingCount = 0
+	};
+	memset(validation.contexts, 0xFF, flatProgram->instructions.size * sizeof(FlatIndex));
+	memset(validation.parents, 0xFF, flatProgram->functions.size * sizeof(FlatIndex));
+	memset(validation.types, 0xFF, slots);
+	memset(validation.marks, 0xFF, flatProgram->expressions.size * sizeof(FlatIndex));
+	FlatIndex base = flatProgram->frameSize;
+	for (FlatIndex index = 0; index < flatProgram->functions.size; ++index) {
+		validation.bases[index] = base;
+		base += flatProgram->functions.nodes[index].frameSize;
+	}
+	validation.bases[validation.program] = 0;
+	boolean consistent = _claim(&validation, flatProgram->block, validation.program, NO_FLAT_INDEX);
+	for (FlatIndex index = 0; consistent && index < flatProgram->instructions.size; ++index) {
+		consistent = validation.contexts[index] == NO_FLAT_INDEX || _isValidInstruction(&validation, index);
+	}
+	consistent = consistent && _isWellTyped(&validation);
+	free(validation.contexts);
+	free(validation.parents);
+	free(validation.bases);
+	free(validation.types);
+	free(validation.marks);
+	free(validation.pending);
+	free(validation.scopes);
+	free(validation.bindings);
+	return consistent;
+}
+
+/**
+ * Checks a call, whose arguments must be stored before an expression.
+ */
+static boolean _isValidCall(const FlatProgram * flatProgram, const FlatIndex call, const FlatIndex before) {
+	if (flatProgram->functionCalls.size <= call) {
+		return false;
+	}
+	const FlatFunctionCall * functionCall = &flatProgram->functionCalls.nodes[call];
+	if (flatProgram->names.size <= functionCall->name || !_isValidRange(functionCall->arguments, flatProgram->arguments.size)) {
+		return false;
+	}
+	for (FlatIndex k = 0; k < functionCall->arguments.count; ++k) {
+		if (before <= flatProgram->arguments.nodes[functionCall->arguments.offset + k]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Checks the references of an expression (but not its slot, that depends on
+ * the context where it's used).
+ */
+static boolean _isValidExpression(const FlatProgram * flatProgram, const FlatIndex index) {
+	const FlatExpression * expression = &flatProgram->expressions.nodes[index];
+	switch (expression->kind) {
+		case FLAT_ADD:
+		case FLAT_SUB:
+		case FLAT_MUL:
+		case FLAT_DIV:
+		case FLAT_COMPARISON:
+			return expression->left < index && expression->right < index
+				&& _typeOf(flatProgram, expression->left) == INT_T && _typeOf(flatProgram, expression->right) == INT_T;
+		case FLAT_AND:
+		case FLAT_OR:
+			return expression->left < index && expression->right < index
+				&& _typeOf(flatProgram, expression->left) == BOOL_T && _typeOf(flatProgram, expression->right) == BOOL_T;
+		case FLAT_NOT:
+			return expression->left < index && _typeOf(flatProgram, expression->left) == BOOL_T;
+		case FLAT_INT_VARIABLE:
+		case FLAT_BOOL_VARIABLE:
+		case FLAT_STRING_VARIABLE:
+		case FLAT_STRING_LITERAL:
+			return expression->name < flatProgram->names.size;
+		case FLAT_INT_LITERAL:
+		case FLAT_BOOL_LITERAL:
+			return true;
+		case FLAT_INT_FUNCTION_CALL:
+		case FLAT_BOOL_FUNCTION_CALL:
+		case FLAT_STRING_FUNCTION_CALL:
+			return _isValidCall(flatProgram, expression->call, index);
+		default:
+			return false;
+	}
+}
+
+/**
+ * Checks the references of an instruction, and assigns a context to its
+ * nested blocks (which come after it). Expression instructions are never
+ * produced by the grammar, so they're rejected.
+ */
+static boolean _isValidInstruction(Validation * validation, const FlatIndex index) {
+	const FlatProgram * flatProgram = validation->flatProgram;
+	const FlatInstruction * instruction = &flatProgram->instructions.nodes[index];
+	const FlatIndex context = validation->contexts[index];
+	switch (instruction->kind) {
+		case FLAT_DECLARATION:
+		case FLAT_ASSIGNATION:
+			return instruction->name < flatProgram->names.size
+				&& instruction->operand < flatProgram->expressions.size;
+		case FLAT_PRINT:
+		case FLAT_RETURN_STATEMENT:
+			return instruction->operand < flatProgram->expressions.size;
+		case FLAT_FUNCTION_CALL:
+			return _isValidCall(flatProgram, instruction->operand, flatProgram->expressions.size);
+		case FLAT_FUNCTION: {
+			const FlatIndex function = instruction->operand;
+			if (flatProgram->functions.size <= function || validation->parents[function] != NO_FLAT_INDEX) {
+				return false;
+			}
+			const FlatFunction * flatFunction = &flatProgram->functions.nodes[function];
+			validation->parents[function] = context;
+			if (flatProgram->names.size <= flatFunction->name || !_isValidRange(flatFunction->parameters, flatProgram->parameters.size)) {
+				return false;
+			}
+			for (FlatIndex k = flatFunction->parameters.offset; k < flatFunction->parameters.offset + flatFunction->parameters.count; ++k) {
+				if (flatProgram->names.size <= flatProgram->parameters.nodes[k].name) {
+					return false;
+				}
+			}
+			return _claim(validation, flatFunction->block, function, index);
+		}
+		case FLAT_CONDITIONAL: {
+			if (flatProgram->conditionals.size <= instruction->operand) {
+				return false;
+			}
+			const FlatConditional * conditional = &flatProgram->conditionals.nodes[instruction->operand];
+			return conditional->condition < flatProgram->expressions.size
+				&& _typeOf(flatProgram, conditional->condition) == BOOL_T
+				&& _claim(validation, conditional->ifBlock, context, index)
+				&& _claim(validation, conditional->elseBlock, context, index);
+		}
+		case FLAT_LOOP: {
+			if (flatProgram->loops.size <= instruction->operand) {
+				return false;
+			}
+			const FlatLoop * loop = &flatProgram->loops.nodes[instruction->operand];
+			return loop->name < flatProgram->names.size
+				&& loop->start < flatProgram->expressions.size && _typeOf(flatProgram, loop->start) == INT_T
+				&& loop->end < flatProgram->expressions.size && _typeOf(flatProgram, loop->end) == INT_T
+				&& _claim(validation, loop->block, context, index);
+		}
+		default:
+			return false;
+	}
+}
+
+static boolean _isValidRange(const FlatRange range, const FlatIndex size) {
+	return range.offset <= size && range.count <= size - range.offset;
+}
+
+/**
+ * Checks the slots of the variables of an expression (and of the arguments of
+ * its calls) in a context: each one must be bound, with the type of the
+ * variable. Since expressions are shared, each one is checked once per
+ * generation, on an explicit stack.
+ */
+static boolean _isValidVariables(Validation * validation, const FlatIndex expression, const FlatIndex context) {
+	const FlatProgram * flatProgram = validation->flatProgram;
+	const FlatIndex generation = validation->generation;
+	FlatIndex size = 0;
+	if (validation->marks[expression] != generation) {
+		validation->marks[expression] = generation;
+		validation->pending[size++] = expression;
+	}
+	while (0 < size) {
+		const FlatIndex index = validation->pending[--size];
+		const FlatExpression * node = &flatProgram->expressions.nodes[index];
+		FlatIndex children[2] = {NO_FLAT_INDEX, NO_FLAT_INDEX};
+		FlatRange arguments = {0, 0};
+		switch (node->kind) {
+			case FLAT_INT_VARIABLE:
+			case FLAT_BOOL_VARIABLE:
+			case FLAT_STRING_VARIABLE: {
+				const FlatIndex slot = _slotOf(validation, context, node->depth, node->slot);
+				if (slot == NO_FLAT_INDEX || validation->types[slot] != _typeOf(flatProgram, index)) {
+					return false;
+				}
+				break;
+			}
+			case FLAT_INT_FUNCTION_CALL:
+			case FLAT_BOOL_FUNCTION_CALL:
+			case FLAT_STRING_FUNCTION_CALL:
+				arguments = flatProgram->functionCalls.nodes[node->call].arguments;
+				break;
+			case FLAT_NOT:
+				children[0] = node->left;
+				break;
+			case FLAT_INT_LITERAL:
+			case FLAT_BOOL_LITERAL:
+			case FLAT_STRING_LITERAL:
+				break;
+			default:
+				children[0] = node->left;
+				children[1] = node->right;
+				break;
+		}
+		for (FlatIndex k = 0; k < 2 + arguments.count; ++k) {
+			const FlatIndex child = k < 2 ? children[k] : flatProgram->arguments.nodes[arguments.offset + k - 2];
+			if (child != NO_FLAT_INDEX && validation->marks[child] != generation) {
+				validation->marks[child] = generation;
+				validation->pending[size++] = child;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Walks the blocks in the order of the source, on an explicit stack, and
+ * checks the slots of every instruction while the bindings of its scope are
+ * open.
+ */
+static boolean _isWellTyped(Validation * validation) {
+	const FlatProgram * flatProgram = validation->flatProgram;
+	_enter(validation, flatProgram->block, validation->program);
+	while (0 < validation->scopeCount) {
+		ValidationScope * scope = &validation->scopes[validation->scopeCount - 1];
+		if (scope->next == scope->end) {
+			_leave(validation);
+		}
+		else if (!_isWellTypedInstruction(validation, &flatProgram->instructions.nodes[scope->next++], scope->context)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Checks the slots that an instruction uses, binds the ones it declares, and
+ * opens the scopes of its nested blocks. As in the parser, a declaration
+ * binds its slot before its expression, and a loop binds its variable after
+ * its bounds.
+ */
+static boolean _isWellTypedInstruction(Validation * validation, const FlatInstruction * instruction, const FlatIndex context) {
+	const FlatProgram * flatProgram = validation->flatProgram;
+	switch (instruction->kind) {
+		case FLAT_DECLARATION:
+			return _bind(validation, context, instruction->depth, instruction->slot, instruction->dataType)
+				&& _typeOf(flatProgram, instruction->operand) == instruction->dataType
+				&& _isValidVariables(validation, instruction->operand, context);
+		case FLAT_ASSIGNATION: {
+			const FlatIndex slot = _slotOf(validation, context, instruction->depth, instruction->slot);
+			return slot != NO_FLAT_INDEX && validation->types[slot] == _typeOf(flatProgram, instruction->operand)
+				&& _isValidVariables(validation, instruction->operand, context);
+		}
+		case FLAT_PRINT:
+			return _isValidVariables(validation, instruction->operand, context);
+		case FLAT_RETURN_STATEMENT:
+			// As in the parser, a RETURN of a function must have its type.
+			return (context == validation->program
+					|| _typeOf(flatProgram, instruction->operand) == flatProgram->functions.nodes[context].returnType)
+				&& _isValidVariables(validation, instruction->operand, context);
+		case FLAT_FUNCTION_CALL: {
+			const FlatFunctionCall * functionCall = &flatProgram->functionCalls.nodes[instruction->operand];
+			for (FlatIndex k = 0; k < functionCall->arguments.count; ++k) {
+				if (!_isValidVariables(validation, flatProgram->arguments.nodes[functionCall->arguments.offset + k], context)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case FLAT_FUNCTION: {
+			const FlatFunction * flatFunction = &flatProgram->functions.nodes[instruction->operand];
+			_enter(validation, flatFunction->block, instruction->operand);
+			for (FlatIndex k = flatFunction->parameters.offset; k < flatFunction->parameters.offset + flatFunction->parameters.count; ++k) {
+				const FlatParameter * parameter = &flatProgram->parameters.nodes[k];
+				if (!_bind(validation, instruction->operand, 0, parameter->slot, parameter->type)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case FLAT_CONDITIONAL: {
+			const FlatConditional * conditional = &flatProgram->conditionals.nodes[instruction->operand];
+			if (!_isValidVariables(validation, conditional->condition, context)) {
+				return false;
+			}
+			_enter(validation, conditional->elseBlock, context);
+			_enter(validation, conditional->ifBlock, context);
+			return true;
+		}
+		case FLAT_LOOP: {
+			const FlatLoop * loop = &flatProgram->loops.nodes[instruction->operand];
+			if (!_isValidVariables(validation, loop->start, context) || !_isValidVariables(validation, loop->end, context)) {
+				return false;
+			}
+			_enter(validation, loop->block, context);
+			return _bind(validation, context, 0, loop->slot, INT_T);
+		}
+		default:
+			return false;
+	}
+}
+
+/**
+ * Closes the innermost scope, and unbinds its slots.
+ */
+static void _leave(Validation * validation) {
+	const FlatIndex bindings = validation->scopes[--validation->scopeCount].bindings;
+	while (bindings < validation->bindingCount) {
+		validation->types[validation->bindings[--validation->bindingCount]] = UINT8_MAX;
+	}
+	++validation->generation;
+}
+
+/**
+ * Maps a whole file in memory (read-only), or reads it in heap-memory if
+ * mapping is not supported. Returns NULL on failure, with "errno" set.
+ */
+static void * _read(const char * path, size_t * size) {
+#if MAPPING_IS_SUPPORTED
+	const int descriptor = open(path, O_RDONLY);
+	if (descriptor < 0) {
+		return NULL;
+	}
+	struct stat status;
+	if (fstat(descriptor, &status) != 0) {
+		close(descriptor);
+		return NULL;
+	}
+	*size = (size_t) status.st_size;
+	void * content = *size == 0 ? NULL : mmap(NULL, *size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	close(descriptor);
+	if (content == MAP_FAILED || content == NULL) {
+		errno = content == NULL ? EINVAL : errno;
+		return NULL;
+	}
+	return content;
+#else
+	FILE * stream = fopen(path, "rb");
+	if (stream == NULL) {
+		return NULL;
+	}
+	fseek(stream, 0, SEEK_END);
+	*size = (size_t) ftell(stream);
+	fseek(stream, 0, SEEK_SET);
+	void * content = malloc(*size + 1);
+	if (fread(content, 1, *size, stream) != *size) {
+		free(content);
+		content = NULL;
+	}
+	fclose(stream);
+	return content;
+#endif
+}
+
+/**
+ * Releases the content of a file, read with "_read".
+ */
+static void _release(void * content, const size_t size) {
+#if MAPPING_IS_SUPPORTED
+	munmap(content, size);
+#else
+	free(content);
+#endif
+}
+
+/**
+ * The position (in the types of the validation) of a slot in the frame
+ * "depth" static links above the one of a context, or NO_FLAT_INDEX if it's
+ * not inside that frame.
+ */
+static FlatIndex _slotOf(const Validation * validation, const FlatIndex context, const unsigned int depth, const FlatIndex index) {
+	FlatIndex frame = context;
+	for (unsigned int k = 0; k < depth; ++k) {
+		if (frame == validation->program) {
+			return NO_FLAT_INDEX;
+		}
+		frame = validation->parents[frame];
+	}
+	const FlatIndex frameSize = frame == validation->program
+		? validation->flatProgram->frameSize
+		: validation->flatProgram->functions.nodes[frame].frameSize;
+	return index < frameSize ? validation->bases[frame] + index : NO_FLAT_INDEX;
+}
+
+/**
+ * The type of the value of an expression, or UINT8_MAX if its kind is not
+ * valid.
+ */
+static uint8_t _typeOf(const FlatProgram * flatProgram, const FlatIndex expression) {
+	const uint8_t kind = flatProgram->expressions.nodes[expression].kind;
+	if (kind <= FLAT_INT_FUNCTION_CALL) {
+		return INT_T;
+	}
+	else if (kind <= FLAT_BOOL_FUNCTION_CALL) {
+		return BOOL_T;
+	}
+	else if (kind <= FLAT_STRING_FUNCTION_CALL) {
+		return STRING_T;
+	}
+	return UINT8_MAX;
+}
+
+/* PUBLIC FUNCTIONS */
+
+FlatProgramFileStatus storeFlatProgram(const FlatProgram * flatProgram, const char * path) {
+	FlatProgramArray arrays[FLAT_PROGRAM_FILE_SECTIONS];
+	_arrays((FlatProgram *) flatProgram, arrays);
+	FlatProgramFileHeader header;
+	memset(&header, 0, sizeof(FlatProgramFileHeader));
+	header.magic = _magic;
+	header.version = FLAT_PROGRAM_FILE_VERSION;
+	header.block = flatProgram->block;
+	header.frameSize = flatProgram->frameSize;
+	uint64_t offset = _align(sizeof(FlatProgramFileHeader));
+	for (unsigned int k = 0; k < FLAT_PROGRAM_FILE_SECTIONS; ++k) {
+		header.sections[k].offset = offset;
+		header.sections[k].count = *arrays[k].count;
+		header.sections[k].size = arrays[k].size;
+		offset = _align(offset + (uint64_t) *arrays[k].count * arrays[k].size);
+	}
+	header.size = offset;
+	const uint64_t start = _align(sizeof(FlatProgramFileHeader));
+	char * payload = calloc(1, header.size - start);
+	for (unsigned int k = 0; k < FLAT_PROGRAM_FILE_SECTIONS; ++k) {
+		if (0 < header.sections[k].count) {
+			memcpy(payload + (header.sections[k].offset - start), *arrays[k].nodes, (size_t) header.sections[k].count * arrays[k].size);
+		}
+	}
+	header.checksum = _checksum(payload, header.size - start);
+	FlatProgramFileStatus status = FLAT_PROGRAM_FILE_OK;
+	FILE * stream = fopen(path, "wb");
+	if (stream == NULL) {
+		status = FLAT_PROGRAM_FILE_IO_ERROR;
+	}
+	else {
+		char padding[8] = {0};
+		if (fwrite(&header, sizeof(FlatProgramFileHeader), 1, stream) != 1
+				|| fwrite(padding, 1, start - sizeof(FlatProgramFileHeader), stream) != start - sizeof(FlatProgramFileHeader)
+				|| fwrite(payload, 1, header.size - start, stream) != header.size - start) {
+			status = FLAT_PROGRAM_FILE_IO_ERROR;
+		}
+		if (fclose(stream) != 0) {
+			status = FLAT_PROGRAM_FILE_IO_ERROR;
+		}
+	}
+	free(payload);
+	logDebugging(_logger, "Stored %llu bytes in \"%s\": %s.", (unsigned long long) header.size, path, flatProgramFileStatusToString(status));
+	return status;
+}
+
+FlatProgramFileStatus loadFlatProgram(const char * path, FlatProgram ** flatProgram) {
+	size_t size = 0;
+	void * content = _read(path, &size);
+	if (content == NULL) {
+		return FLAT_PROGRAM_FILE_IO_ERROR;
+	}
+	const FlatProgramFileHeader * header = content;
+	const uint64_t start = _align(sizeof(FlatProgramFileHeader));
+	if (size < start || header->magic != _magic) {
+		_release(content, size);
+		return FLAT_PROGRAM_FILE_INVALID_FORMAT;
+	}
+	if (header->version != FLAT_PROGRAM_FILE_VERSION) {
+		_release(content, size);
+		return FLAT_PROGRAM_FILE_UNSUPPORTED_VERSION;
+	}
+	if (header->size != size || _checksum((const char *) content + start, size - start) != header->checksum) {
+		_release(content, size);
+		return FLAT_PROGRAM_FILE_CORRUPTED;
+	}
+	LoadedFlatProgram * loadedFlatProgram = calloc(1, sizeof(LoadedFlatProgram));
+	loadedFlatProgram->content = content;
+	loadedFlatProgram->size = size;
+	loadedFlatProgram->flatProgram.block = header->block;
+	loadedFlatProgram->flatProgram.frameSize = header->frameSize;
+	FlatProgramArray arrays[FLAT_PROGRAM_FILE_SECTIONS];
+	_arrays(&loadedFlatProgram->flatProgram, arrays);
+	for (unsigned int k = 0; k < FLAT_PROGRAM_FILE_SECTIONS; ++k) {
+		const FlatProgramFileSection * section = &header->sections[k];
+		if (section->size != arrays[k].size || section->offset < start || size < section->offset
+				|| (size - section->offset) / section->size < section->count) {
+			unloadFlatProgram(&loadedFlatProgram->flatProgram);
+			return FLAT_PROGRAM_FILE_INVALID_FORMAT;
+		}
+		*arrays[k].nodes = (char *) content + section->offset;
+		*arrays[k].count = section->count;
+	}
+	FlatProgram * loaded = &loadedFlatProgram->flatProgram;
+	loaded->instructions.capacity = loaded->instructions.size;
+	loaded->expressions.capacity = loaded->expressions.size;
+	loaded->functionCalls.capacity = loaded->functionCalls.size;
+	loaded->functions.capacity = loaded->functions.size;
+	loaded->parameters.capacity = loaded->parameters.size;
+	loaded->conditionals.capacity = loaded->conditionals.size;
+	loaded->loops.capacity = loaded->loops.size;
+	loaded->arguments.capacity = loaded->arguments.size;
+	loaded->names.capacity = loaded->names.size;
+	loaded->characters.capacity = loaded->characters.size;
+	if (loaded->instructions.size < loaded->block.offset
+			|| loaded->instructions.size - loaded->block.offset < loaded->block.count) {
+		unloadFlatProgram(loaded);
+		return FLAT_PROGRAM_FILE_INVALID_FORMAT;
+	}
+	if (!_isConsistent(loaded)) {
+		unloadFlatProgram(loaded);
+		return FLAT_PROGRAM_FILE_INCONSISTENT;
+	}
+	logDebugging(_logger, "Loaded %zu bytes from \"%s\".", size, path);
+	*flatProgram = loaded;
+	return FLAT_PROGRAM_FILE_OK;
+}
+
+const boolean isFlatProgramContent(const char * content, const size_t size) {
+	return sizeof(uint64_t) <= size && memcmp(content, &_magic, sizeof(uint64_t)) == 0;
+}
+
+void unloadFlatProgram(FlatProgram * flatProgram) {
+	if (flatProgram != NULL) {
+		LoadedFlatProgram * loadedFlatProgram = (LoadedFlatProgram *) flatProgram;
+		_release(loadedFlatProgram->content, loadedFlatProgram->size);
+		free(loadedFlatProgram);
+	}
+}
+
+const char * flatProgramFileStatusToString(const FlatProgramFileStatus status) {
+	switch (status) {
+		case FLAT_PROGRAM_FILE_OK:
+			return "ok";
+		case FLAT_PROGRAM_FILE_IO_ERROR:
+			return strerror(errno);
+		case FLAT_PROGRAM_FILE_INVALID_FORMAT:
+			return "not a valid AST file";
+		case FLAT_PROGRAM_FILE_UNSUPPORTED_VERSION:
+			return "unsupported AST file version";
+		case FLAT_PROGRAM_FILE_CORRUPTED:
+			return "corrupted AST file (checksum mismatch)";
+		case FLAT_PROGRAM_FILE_INCONSISTENT:
+			return "inconsistent AST file (a node refers out of bounds)";
+		default:
+			return "unknown status";
+	}
+}
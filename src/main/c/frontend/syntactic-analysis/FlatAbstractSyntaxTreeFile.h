@@ -0,0 +1,95 @@
+#ifndef FLAT_ABSTRACT_SYNTAX_TREE_FILE_HEADER
+#define FLAT_ABSTRACT_SYNTAX_TREE_FILE_HEADER
+
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "FlatAbstractSyntaxTree.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializeFlatAbstractSyntaxTreeFileModule();
+
+/** Shutdown module's internal state. */
+void shutdownFlatAbstractSyntaxTreeFileModule();
+
+/**
+ * A binary file with a flat AST. It starts with a header, followed by the
+ * arrays of the flat program, byte by byte (each one aligned to 8 bytes).
+ * Since nodes refer to each other with indices, and names are offsets in the
+ * characters array, the file is position-independent: it can be mapped in
+ * memory and walked in place, without any deserialization.
+ *
+ * The checksum covers every byte after the header, but only detects
+ * accidents, so every index and offset is also checked when the file is
+ * loaded, in a single pass (see "loadFlatProgram"). The format uses the byte
+ * order and the structure layout of the platform that writes it, so a file
+ * produced in another platform is rejected (the magic number doesn't match).
+ */
+
+/** The version of the format, incremented on every incompatible change. */
+#define FLAT_PROGRAM_FILE_VERSION 3
+
+/** The amount of arrays stored in a file. */
+#define FLAT_PROGRAM_FILE_SECTIONS 10
+
+typedef struct {
+	uint64_t offset;
+	uint32_t count;
+	uint32_t size;
+} FlatProgramFileSection;
+
+typedef struct {
+	uint64_t magic;
+	uint32_t version;
+	uint32_t checksum;
+	uint64_t size;
+	FlatRange block;
+	FlatIndex frameSize;
+	FlatProgramFileSection sections[FLAT_PROGRAM_FILE_SECTIONS];
+} FlatProgramFileHeader;
+
+typedef enum {
+	FLAT_PROGRAM_FILE_OK,
+	FLAT_PROGRAM_FILE_IO_ERROR,
+	FLAT_PROGRAM_FILE_INVALID_FORMAT,
+	FLAT_PROGRAM_FILE_UNSUPPORTED_VERSION,
+	FLAT_PROGRAM_FILE_CORRUPTED,
+	FLAT_PROGRAM_FILE_INCONSISTENT
+} FlatProgramFileStatus;
+
+/**
+ * Stores a flat program in a file. On I/O errors, "errno" is set.
+ */
+FlatProgramFileStatus storeFlatProgram(const FlatProgram * flatProgram, const char * path);
+
+/**
+ * Loads a flat program from a file, mapping it in memory. The arrays of the
+ * program point inside the mapping (so they must not be modified), and it
+ * must be released with "unloadFlatProgram". On I/O errors, "errno" is set.
+ * A program that refers to a node, a name, or a slot out of bounds, or whose
+ * expressions aren't in post-order, or whose blocks don't form a tree, is
+ * rejected as inconsistent.
+ */
+FlatProgramFileStatus loadFlatProgram(const char * path, FlatProgram ** flatProgram);
+
+/**
+ * True if a content starts as a file of a flat program (i.e., with its magic
+ * number), even if the rest of it isn't valid.
+ */
+const boolean isFlatProgramContent(const char * content, const size_t size);
+
+/**
+ * Releases a flat program loaded from a file.
+ */
+void unloadFlatProgram(FlatProgram * flatProgram);
+
+/**
+ * A human-readable description of a status.
+ */
+const char * flatProgramFileStatusToString(const FlatProgramFileStatus status);
+
+#endif
@@ -0,0 +1,257 @@
+#include "ParseCache.h"
+
+/**
+ * Platform dependent file-system support.
+ *
+ * @see https://man7.org/linux/man-pages/man3/opendir.3.html
+ */
+#if defined (__TOS_WIN__) \
+	|| defined (__WIN32__) \
+	|| defined (__WINDOWS__) \
+	|| defined (_WIN16) \
+	|| defined (_WIN32) \
+	|| defined (_WIN64)
+#define CACHING_IS_SUPPORTED 0
+#else
+#define CACHING_IS_SUPPORTED 1
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+/**
+ * An entry of the cache directory, while evicting.
+ */
+typedef struct {
+	char * path;
+	uint64_t size;
+	time_t lastUse;
+} ParseCacheEntry;
+
+/* MODULE INTERNAL STATE */
+
+// The directory of the cache, or NULL if the cache is disabled.
+static const char * _directory = NULL;
+
+// The maximum size of the cache, in bytes.
+static uint64_t _maximumSize = 0;
+
+// The hash of the version of the compiler, that seeds every key.
+static uint64_t _seed = 0;
+
+// The amount of temporary files written so far (to give each one a name).
+static unsigned int _temporaryFiles = 0;
+
+// Whether an entry was stored, so the cache may have outgrown its size.
+static boolean _stored = false;
+
+static Logger * _logger = NULL;
+
+/* PRIVATE FUNCTIONS */
+
+static int _compareEntries(const void * left, const void * right);
+static char * _entryPath(const ParseCacheKey key);
+static void _evict(void);
+static char * _format(const char * format, ...);
+static uint64_t _hash(uint64_t hash, const void * content, const size_t size);
+
+/**
+ * Sorts the entries from the least to the most recently used.
+ */
+static int _compareEntries(const void * left, const void * right) {
+	const time_t leftLastUse = ((const ParseCacheEntry *) left)->lastUse;
+	const time_t rightLastUse = ((const ParseCacheEntry *) right)->lastUse;
+	return (leftLastUse > rightLastUse) - (leftLastUse < rightLastUse);
+}
+
+/**
+ * The path of the file of an entry (which must be freed).
+ */
+static char * _entryPath(const ParseCacheKey key) {
+	return _format("%s/%016llx-%llx.ast", _directory, (unsigned long long) key.hash, (unsigned long long) key.size);
+}
+
+/**
+ * Removes the least recently used entries, until the whole cache fits in its
+ * maximum size. Entries removed concurrently by another compiler are ignored.
+ */
+static void _evict(void) {
+#if CACHING_IS_SUPPORTED
+	DIR * directory = opendir(_directory);
+	if (directory == NULL) {
+		logWarning(_logger, "Cannot open the cache directory \"%s\": %s.", _directory, strerror(errno));
+		return;
+	}
+	ParseCacheEntry * entries = NULL;
+	unsigned int count = 0;
+	unsigned int capacity = 0;
+	uint64_t size = 0;
+	for (struct dirent * file = readdir(directory); file != NULL; file = readdir(directory)) {
+		const size_t length = strlen(file->d_name);
+		if (length < 4 || strcmp(file->d_name + length - 4, ".ast") != 0) {
+			continue;
+		}
+		char * path = _format("%s/%s", _directory, file->d_name);
+		struct stat status;
+		if (stat(path, &status) != 0) {
+			free(path);
+			continue;
+		}
+		if (count == capacity) {
+			capacity = capacity == 0 ? 64 : 2 * capacity;
+			entries = realloc(entries, capacity * sizeof(ParseCacheEntry));
+		}
+		entries[count].path = path;
+		entries[count].size = (uint64_t) status.st_size;
+		entries[count].lastUse = status.st_mtime;
+		size += entries[count++].size;
+	}
+	closedir(directory);
+	unsigned int evicted = 0;
+	if (_maximumSize < size) {
+		qsort(entries, count, sizeof(ParseCacheEntry), _compareEntries);
+		for (unsigned int k = 0; k < count && _maximumSize < size; ++k) {
+			remove(entries[k].path);
+			size -= entries[k].size;
+			++evicted;
+		}
+	}
+	for (unsigned int k = 0; k < count; ++k) {
+		free(entries[k].path);
+	}
+	free(entries);
+	logDebugging(_logger, "Evicted %u of %u entries (%llu bytes remain).", evicted, count, (unsigned long long) size);
+#endif
+}
+
+/**
+ * Formats a string in heap-memory (which must be freed).
+ */
+static char * _format(const char * format, ...) {
+	va_list arguments;
+	va_start(arguments, format);
+	const int length = vsnprintf(NULL, 0, format, arguments);
+	va_end(arguments);
+	char * string = calloc(length + 1, sizeof(char));
+	va_start(arguments, format);
+	vsnprintf(string, length + 1, format, arguments);
+	va_end(arguments);
+	return string;
+}
+
+/**
+ * A fast non-cryptographic hash, that processes a word at a time with a
+ * multiplication and a shift. The size is mixed in, so contents that only
+ * differ in trailing NUL bytes have different hashes.
+ */
+static uint64_t _hash(uint64_t hash, const void * content, const size_t size) {
+	const char * bytes = content;
+	size_t k = 0;
+	for (; k + sizeof(uint64_t) <= size; k += sizeof(uint64_t)) {
+		uint64_t word;
+		memcpy(&word, bytes + k, sizeof(uint64_t));
+		hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+		hash ^= hash >> 32;
+	}
+	uint64_t tail = 0;
+	memcpy(&tail, bytes + k, size - k);
+	hash = (hash ^ tail ^ (uint64_t) size) * 0x9E3779B97F4A7C15ull;
+	return hash ^ (hash >> 29);
+}
+
+/* PUBLIC FUNCTIONS */
+
+void initializeParseCacheModule() {
+	_logger = createLogger("ParseCache");
+	const char * directory = getStringOrDefault("PARSE_CACHE_DIRECTORY", "");
+	_maximumSize = strtoull(getStringOrDefault("PARSE_CACHE_SIZE", "256"), NULL, 10) * 1024 * 1024;
+	const uint32_t fileVersion = FLAT_PROGRAM_FILE_VERSION;
+	_seed = _hash(_hash(14695981039346656037ull, COMPILER_VERSION, strlen(COMPILER_VERSION)), &fileVersion, sizeof(uint32_t));
+#if CACHING_IS_SUPPORTED
+	if (directory[0] != '\0') {
+		if (mkdir(directory, 0755) == 0 || errno == EEXIST) {
+			_directory = directory;
+			logDebugging(_logger, "Caching in \"%s\" (up to %llu bytes).", _directory, (unsigned long long) _maximumSize);
+		}
+		else {
+			logWarning(_logger, "Cannot create the cache directory \"%s\" (caching is disabled): %s.", directory, strerror(errno));
+		}
+	}
+#endif
+}
+
+void shutdownParseCacheModule() {
+	if (_directory != NULL) {
+		if (_stored) {
+			_evict();
+		}
+		_directory = NULL;
+	}
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+const boolean isParseCacheEnabled(const SourceFile * sourceFile) {
+	return _directory != NULL && isMappedSourceFile(sourceFile);
+}
+
+ParseCacheKey parseCacheKey(const SourceFile * sourceFile) {
+	const ParseCacheKey key = {
+		.hash = _hash(_seed, sourceFile->content, sourceFile->size),
+		.size = sourceFile->size
+	};
+	return key;
+}
+
+const boolean loadFromParseCache(CompilerState * compilerState, const ParseCacheKey key) {
+	char * path = _entryPath(key);
+	FlatProgram * flatProgram = NULL;
+	const FlatProgramFileStatus status = loadFlatProgram(path, &flatProgram);
+	if (status == FLAT_PROGRAM_FILE_OK) {
+		unflattenProgram(compilerState, flatProgram);
+		unloadFlatProgram(flatProgram);
+#if CACHING_IS_SUPPORTED
+		// Marks the entry as the most recently used.
+		utime(path, NULL);
+#endif
+		logDebugging(_logger, "Hit: \"%s\".", path);
+	}
+	else if (status == FLAT_PROGRAM_FILE_IO_ERROR) {
+		logDebugging(_logger, "Miss: \"%s\".", path);
+	}
+	else {
+		logWarning(_logger, "Removing the invalid entry \"%s\": %s.", path, flatProgramFileStatusToString(status));
+		remove(path);
+	}
+	free(path);
+	return status == FLAT_PROGRAM_FILE_OK;
+}
+
+void storeInParseCache(const CompilerState * compilerState, const ParseCacheKey key) {
+	char * path = _entryPath(key);
+#if CACHING_IS_SUPPORTED
+	const long process = (long) getpid();
+#else
+	const long process = 0;
+#endif
+	char * temporaryPath = _format("%s.%ld-%u.tmp", path, process, __atomic_fetch_add(&_temporaryFiles, 1, __ATOMIC_RELAXED));
+	FlatProgram * flatProgram = flattenProgram(compilerState->abstractSyntaxtTree);
+	const FlatProgramFileStatus status = storeFlatProgram(flatProgram, temporaryPath);
+	destroyFlatProgram(flatProgram);
+	if (status != FLAT_PROGRAM_FILE_OK) {
+		logWarning(_logger, "Cannot store the entry \"%s\": %s.", path, flatProgramFileStatusToString(status));
+		remove(temporaryPath);
+	}
+	else if (rename(temporaryPath, path) != 0) {
+		logWarning(_logger, "Cannot store the entry \"%s\": %s.", path, strerror(errno));
+		remove(temporaryPath);
+	}
+	else {
+		__atomic_store_n(&_stored, true, __ATOMIC_RELAXED);
+		logDebugging(_logger, "Stored: \"%s\".", path);
+	}
+	free(temporaryPath);
+	free(path);
+}
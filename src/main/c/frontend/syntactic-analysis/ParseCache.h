@@ -0,0 +1,80 @@
+#ifndef PARSE_CACHE_HEADER
+#define PARSE_CACHE_HEADER
+
+#include "../../shared/CompilerState.h"
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/SourceFile.h"
+#include "../../shared/Type.h"
+#include "FlatAbstractSyntaxTree.h"
+#include "FlatAbstractSyntaxTreeFile.h"
+#include <errno.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * Identifies the front-end of this build (i.e., how sources are turned into
+ * ASTs), so the cache never reuses an AST built by another one. CMake defines
+ * it as a hash of the grammar, the patterns and the semantic actions; any
+ * other build uses its own date and time.
+ */
+#ifndef COMPILER_VERSION
+#define COMPILER_VERSION __DATE__ " " __TIME__
+#endif
+
+/** Initialize module's internal state. */
+void initializeParseCacheModule();
+
+/**
+ * Shutdown module's internal state. If the cache is enabled and an entry was
+ * stored, it evicts the least recently used entries until it fits in its
+ * maximum size (a run that only hits never scans the directory).
+ */
+void shutdownParseCacheModule();
+
+/**
+ * A content-addressed cache of ASTs, stored on disk. Each entry is the flat
+ * AST of an accepted program (see "FlatAbstractSyntaxTreeFile.h"), and its
+ * name is a hash of the bytes of the source file and of the version of the
+ * compiler, so an unchanged program is never lexed nor parsed again (even if
+ * it's moved or renamed). The modification time of an entry is its last use,
+ * and it's used to evict the least recently used ones.
+ *
+ * It's enabled by the "PARSE_CACHE_DIRECTORY" environment variable, and it's
+ * bounded by "PARSE_CACHE_SIZE" (in MiB). Only memory-mapped source files are
+ * cached (i.e., not the standard input), and only on POSIX platforms.
+ */
+
+typedef struct {
+	uint64_t hash;
+	uint64_t size;
+} ParseCacheKey;
+
+/**
+ * True if the cache can be used for the specified source file.
+ */
+const boolean isParseCacheEnabled(const SourceFile * sourceFile);
+
+/**
+ * The key of a source file in the cache, hashing its whole content.
+ */
+ParseCacheKey parseCacheKey(const SourceFile * sourceFile);
+
+/**
+ * Loads the AST of a cached source file in the compilation state, exactly as
+ * if it were parsed. Returns false on a miss.
+ */
+const boolean loadFromParseCache(CompilerState * compilerState, const ParseCacheKey key);
+
+/**
+ * Stores the AST of an accepted source file in the cache. Concurrent writers
+ * of the same entry are safe: each one writes a temporary file, and renames
+ * it atomically.
+ */
+void storeInParseCache(const CompilerState * compilerState, const ParseCacheKey key);
+
+#endif
@@ -1,9 +1,12 @@
 #include "SyntacticAnalyzer.h"
 #include "../lexical-analysis/LexicalAnalyzerContext.h"
+#include "../../shared/SourceFile.h"
+#include "FlatAbstractSyntaxTree.h"
+#include "FlatAbstractSyntaxTreeFile.h"
+#include "ParseCache.h"
 
 /* MODULE INTERNAL STATE */
 
-static CompilerState * _currentCompilerState = NULL;
 static Logger * _logger = NULL;
 
 void initializeSyntacticAnalyzerModule() {
@@ -18,7 +21,19 @@ void shutdownSyntacticAnalyzerModule() {
 
 /** IMPORTED FUNCTIONS */
 
-extern LexicalAnalyzerContext * createLexicalAnalyzerContext();
+// Selects the input of a scanner instance (provided by Flex exported functions).
+extern void flexScanSourceFile(SourceFile * sourceFile, void * scanner);
+
+// The wrapper of "YY_START" macro (provided by Flex exported functions).
+extern unsigned int flexCurrentContext(void * scanner);
+
+/**
+ * Flex reentrant API.
+ *
+ * @see https://westes.github.io/flex/manual/Init-and-Destroy-Functions.html
+ */
+extern int yylex_init_extra(LexicalAnalyzerContext * lexicalAnalyzerContext, void ** scanner);
+extern int yylex_destroy(void * scanner);
 
 /**
  * Bison exported functions.
@@ -31,30 +46,93 @@ extern LexicalAnalyzerContext * createLexicalAnalyzerContext();
  *
  * @see https://www.gnu.org/software/bison/manual/html_node/Parser-Function.html
  */
-extern int yyparse(void);
+extern int yyparse(void * scanner, CompilerState * compilerState);
 
-// Bison error-reporting function.
-void yyerror(const char * string) {
-	LexicalAnalyzerContext * lexicalAnalyzerContext = createLexicalAnalyzerContext();
-	logError(_logger, "Syntax error (on line %d).", lexicalAnalyzerContext->line);
+// Bison error-reporting function, at the location of the lookahead symbol.
+void yyerror(const YYLTYPE * location, void * scanner, CompilerState * compilerState, const char * string) {
+	logError(_logger, "Syntax error (on line %d).", location->first_line);
 }
 
-/* PUBLIC FUNCTIONS */
+/* PRIVATE FUNCTIONS */
+
+static SyntacticAnalysisStatus _load(CompilerState * compilerState);
 
-CompilerState * currentCompilerState() {
-	return _currentCompilerState;
+/**
+ * Loads the source file as the AST file of a previous compilation (see
+ * "FlatAbstractSyntaxTreeFile.h"), exactly as a hit of the parse cache. A
+ * streaming compilation rejects it, since the loaded AST is always complete.
+ */
+static SyntacticAnalysisStatus _load(CompilerState * compilerState) {
+	if (compilerState->streamingState != NULL) {
+		logError(_logger, "The AST file \"%s\" cannot be streamed.", compilerState->sourcePath);
+		compilerState->succeed = false;
+		return REJECT;
+	}
+	FlatProgram * flatProgram = NULL;
+	const FlatProgramFileStatus status = loadFlatProgram(compilerState->sourcePath, &flatProgram);
+	if (status != FLAT_PROGRAM_FILE_OK) {
+		logError(_logger, "Cannot load the AST from \"%s\": %s.", compilerState->sourcePath, flatProgramFileStatusToString(status));
+		compilerState->succeed = false;
+		return REJECT;
+	}
+	unflattenProgram(compilerState, flatProgram);
+	unloadFlatProgram(flatProgram);
+	logDebugging(_logger, "Parsing is skipped (the source is an AST file).");
+	return ACCEPT;
 }
 
+/* PUBLIC FUNCTIONS */
+
 SyntacticAnalysisStatus parse(CompilerState * compilerState) {
-	logDebugging(_logger, "Parsing...");
-	_currentCompilerState = compilerState;
-	const int code = yyparse();
-	_currentCompilerState = NULL;
+	SourceFile * sourceFile = openSourceFile(compilerState->sourcePath);
+	if (sourceFile == NULL) {
+		logError(_logger, "Cannot open the source file \"%s\": %s.", compilerState->sourcePath, strerror(errno));
+		compilerState->succeed = false;
+		return UNKNOWN_ERROR;
+	}
+	if (isMappedSourceFile(sourceFile) && isFlatProgramContent(sourceFile->content, sourceFile->size)) {
+		closeSourceFile(sourceFile);
+		return _load(compilerState);
+	}
+	// A streamed AST is never complete, so it cannot be cached.
+	const boolean isCacheable = compilerState->streamingState == NULL && isParseCacheEnabled(sourceFile);
+	ParseCacheKey key = {0, 0};
+	if (isCacheable) {
+		key = parseCacheKey(sourceFile);
+		if (loadFromParseCache(compilerState, key)) {
+			closeSourceFile(sourceFile);
+			logDebugging(_logger, "Parsing is skipped (the AST is cached).");
+			return ACCEPT;
+		}
+	}
+	LexicalAnalyzerContext * lexicalAnalyzerContext = createLexicalAnalyzerContext(compilerState);
+	void * scanner = NULL;
+	if (yylex_init_extra(lexicalAnalyzerContext, &scanner) != 0) {
+		logError(_logger, "Flex ran out of memory.");
+		destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
+		closeSourceFile(sourceFile);
+		compilerState->succeed = false;
+		return OUT_OF_MEMORY;
+	}
+	logDebugging(_logger, "Parsing (%s input)...", isMappedSourceFile(sourceFile) ? "memory-mapped" : "streamed");
+	flexScanSourceFile(sourceFile, scanner);
+	const int code = yyparse(scanner, compilerState);
+	const unsigned int finalContext = flexCurrentContext(scanner);
+	yylex_destroy(scanner);
+	destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
+	closeSourceFile(sourceFile);
 	SyntacticAnalysisStatus syntacticAnalysisStatus;
 	logDebugging(_logger, "Parsing is done.");
+	if (code == 0 && 0 < finalContext) {
+		logError(_logger, "The final context is not the default (0): %d", finalContext);
+		compilerState->succeed = false;
+	}
 	switch (code) {
 		case 0:
 			if (compilerState->succeed == true) {
+				if (isCacheable) {
+					storeInParseCache(compilerState, key);
+				}
 				return ACCEPT;
 			}
 			else {
@@ -4,10 +4,13 @@
 #include "../../shared/CompilerState.h"
 #include "../../shared/Logger.h"
 
-/** Bison imported functions. */
+/** Bison imported functions (of a pure parser with a reentrant scanner). */
 
-int yylex(void);
-void yyerror(const char * string);
+union SemanticValue;
+struct YYLTYPE;
+
+int yylex(union SemanticValue * semanticValue, struct YYLTYPE * location, void * scanner);
+void yyerror(const struct YYLTYPE * location, void * scanner, CompilerState * compilerState, const char * string);
 
 /** Initialize module's internal state. */
 void initializeSyntacticAnalyzerModule();
@@ -23,14 +26,10 @@ typedef enum {
 } SyntacticAnalysisStatus;
 
 /**
- * Retrieves the current compiler state. The state must be accessed during the
- * parsing phase (i.e., during a call to the "parse" function). Outside of the
- * parse, the state is set to NULL.
- */
-CompilerState * currentCompilerState();
-
-/**
- * Executes the parsing phase of the compiler.
+ * Executes the parsing phase of the compiler. It's reentrant: every call uses
+ * its own scanner and parser instances, so many compilations can be parsed
+ * concurrently, as long as each one has its own state. A source file that is
+ * an AST file (see "FlatAbstractSyntaxTreeFile.h") is loaded instead.
  */
 SyntacticAnalysisStatus parse(CompilerState * compilerState);
 
@@ -0,0 +1,91 @@
+#include "Arena.h"
+
+/* MODULE INTERNAL STATE */
+
+// The strictest fundamental alignment on the supported platforms.
+static const size_t _alignment = 16;
+
+/* PRIVATE FUNCTIONS */
+
+static size_t _align(const size_t size);
+static ArenaChunk * _createChunk(ArenaChunk * previous, const size_t capacity);
+static char * _memory(ArenaChunk * chunk);
+
+/**
+ * Rounds a size up to the strictest fundamental alignment, so every block
+ * returned by the arena can hold any type.
+ */
+static size_t _align(const size_t size) {
+	return (size + _alignment - 1) & ~(_alignment - 1);
+}
+
+/**
+ * Allocates a new chunk in heap-memory, linked to the previous one.
+ */
+static ArenaChunk * _createChunk(ArenaChunk * previous, const size_t capacity) {
+	ArenaChunk * chunk = malloc(_align(sizeof(ArenaChunk)) + capacity);
+	chunk->previous = previous;
+	chunk->capacity = capacity;
+	chunk->used = 0;
+	return chunk;
+}
+
+/**
+ * The first usable (and aligned) byte of a chunk.
+ */
+static char * _memory(ArenaChunk * chunk) {
+	return (char *) chunk + _align(sizeof(ArenaChunk));
+}
+
+/* PUBLIC FUNCTIONS */
+
+Arena * createArena(const size_t chunkSize) {
+	Arena * arena = calloc(1, sizeof(Arena));
+	arena->chunkSize = _align(chunkSize);
+	arena->current = _createChunk(NULL, arena->chunkSize);
+	return arena;
+}
+
+void destroyArena(Arena * arena) {
+	if (arena != NULL) {
+		ArenaChunk * chunk = arena->current;
+		while (chunk != NULL) {
+			ArenaChunk * previous = chunk->previous;
+			free(chunk);
+			chunk = previous;
+		}
+		free(arena);
+	}
+}
+
+void resetArena(Arena * arena) {
+	ArenaChunk * chunk = arena->current;
+	while (chunk->previous != NULL) {
+		ArenaChunk * previous = chunk->previous;
+		free(chunk);
+		chunk = previous;
+	}
+	chunk->used = 0;
+	arena->current = chunk;
+}
+
+size_t allocatedInArena(const Arena * arena) {
+	size_t allocated = 0;
+	for (const ArenaChunk * chunk = arena->current; chunk != NULL; chunk = chunk->previous) {
+		allocated += chunk->used;
+	}
+	return allocated;
+}
+
+void * allocateInArena(Arena * arena, const size_t size) {
+	const size_t alignedSize = _align(size);
+	ArenaChunk * chunk = arena->current;
+	if (chunk->capacity - chunk->used < alignedSize) {
+		const size_t capacity = arena->chunkSize < alignedSize ? alignedSize : arena->chunkSize;
+		chunk = _createChunk(chunk, capacity);
+		arena->current = chunk;
+	}
+	void * block = _memory(chunk) + chunk->used;
+	chunk->used += alignedSize;
+	return memset(block, 0, alignedSize);
+}
@@ -0,0 +1,61 @@
+#ifndef ARENA_HEADER
+#define ARENA_HEADER
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A chunk of contiguous memory, owned by an arena. Chunks are linked from the
+ * newest to the oldest one, so they never move once allocated. The usable
+ * memory starts right after this header.
+ */
+typedef struct ArenaChunk ArenaChunk;
+
+struct ArenaChunk {
+	ArenaChunk * previous;
+	size_t capacity;
+	size_t used;
+};
+
+/**
+ * A region-based allocator. Every allocation is a pointer bump inside the
+ * current chunk, and all of them are released at once when the arena is
+ * destroyed. Pointers returned by the arena are stable for its entire
+ * lifetime.
+ */
+typedef struct {
+	ArenaChunk * current;
+	size_t chunkSize;
+} Arena;
+
+/**
+ * Creates a new empty arena. The chunk size is the default capacity of every
+ * chunk (bigger allocations get a dedicated chunk).
+ */
+Arena * createArena(const size_t chunkSize);
+
+/**
+ * Destroy an arena and every allocation made with it.
+ */
+void destroyArena(Arena * arena);
+
+/**
+ * Releases every allocation made with an arena at once, keeping only its
+ * oldest chunk for reuse.
+ */
+void resetArena(Arena * arena);
+
+/**
+ * The amount of bytes allocated in an arena since it was created or reset
+ * (including the alignment padding).
+ */
+size_t allocatedInArena(const Arena * arena);
+
+/**
+ * Allocates a zero-initialized block of memory inside the arena, suitably
+ * aligned for any type.
+ */
+void * allocateInArena(Arena * arena, const size_t size);
+
+#endif
@@ -0,0 +1,291 @@
+#include "AsynchronousLogger.h"
+
+/**
+ * Platform dependent threading support.
+ *
+ * @see https://man7.org/linux/man-pages/man7/pthreads.7.html
+ */
+#if defined (__TOS_WIN__) \
+	|| defined (__WIN32__) \
+	|| defined (__WINDOWS__) \
+	|| defined (_WIN16) \
+	|| defined (_WIN32) \
+	|| defined (_WIN64)
+#define ASYNCHRONOUS_LOGGING_IS_SUPPORTED 0
+#else
+#define ASYNCHRONOUS_LOGGING_IS_SUPPORTED 1
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/time.h>
+#endif
+
+#if ASYNCHRONOUS_LOGGING_IS_SUPPORTED
+
+// The size of a record, including the prefix and the final new-line.
+#define LOG_RECORD_SIZE 512
+
+/**
+ * A slot of the ring buffer. The sequence number tells its state: equal to
+ * the enqueue position when it's free, and to that position plus one when it
+ * holds a message ready to be written.
+ *
+ * @see https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+typedef struct {
+	size_t sequence;
+	FILE * stream;
+	unsigned int length;
+	char text[LOG_RECORD_SIZE];
+} LogRecord;
+
+/**
+ * The messages of a stream waiting to be written with a single system call.
+ */
+typedef struct {
+	FILE * stream;
+	size_t length;
+	char text[64 * 1024];
+} LogBatch;
+
+/* MODULE INTERNAL STATE */
+
+// The amount of records in the ring buffer (must be a power of 2).
+static const size_t _capacity = 4096;
+
+// The maximum time the writer sleeps before looking for new messages (and
+// the maximum latency of a message, if the process doesn't exit).
+static const long _idleNanoseconds = 1000 * 1000;
+
+static LogRecord * _records = NULL;
+static size_t _enqueuePosition = 0;
+static size_t _dequeuePosition = 0;
+static size_t _droppedMessages = 0;
+static OverflowPolicy _overflowPolicy = BLOCK_ON_OVERFLOW;
+
+static LogBatch _outputBatch;
+static LogBatch _errorBatch;
+
+static boolean _running = false;
+static boolean _sleeping = false;
+static boolean _stopping = false;
+static pthread_t _writerThread;
+static pthread_mutex_t _mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _condition = PTHREAD_COND_INITIALIZER;
+
+/* PRIVATE FUNCTIONS */
+
+static LogRecord * _acquireRecord(size_t * position);
+static void _appendToBatch(LogBatch * batch, const char * text, const size_t length);
+static size_t _drain(void);
+static void _flushBatch(LogBatch * batch);
+static void _reportDroppedMessages(void);
+static void _wakeUpWriter(void);
+static void * _writer(void * argument);
+
+/**
+ * Claims a free record of the ring buffer, and its enqueue position. If the
+ * buffer is full, it waits or returns NULL, depending on the overflow policy.
+ */
+static LogRecord * _acquireRecord(size_t * position) {
+	*position = __atomic_load_n(&_enqueuePosition, __ATOMIC_RELAXED);
+	for (;;) {
+		LogRecord * record = &_records[*position & (_capacity - 1)];
+		const size_t sequence = __atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE);
+		const long difference = (long) (sequence - *position);
+		if (difference == 0) {
+			if (__atomic_compare_exchange_n(&_enqueuePosition, position, *position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				return record;
+			}
+		}
+		else if (difference < 0) {
+			if (_overflowPolicy == DROP_ON_OVERFLOW) {
+				__atomic_fetch_add(&_droppedMessages, 1, __ATOMIC_RELAXED);
+				return NULL;
+			}
+			_wakeUpWriter();
+			sched_yield();
+			*position = __atomic_load_n(&_enqueuePosition, __ATOMIC_RELAXED);
+		}
+		else {
+			*position = __atomic_load_n(&_enqueuePosition, __ATOMIC_RELAXED);
+		}
+	}
+}
+
+/**
+ * Appends a message to a batch, writing the batch first if it's full.
+ */
+static void _appendToBatch(LogBatch * batch, const char * text, const size_t length) {
+	if (sizeof(batch->text) < batch->length + length) {
+		_flushBatch(batch);
+	}
+	memcpy(batch->text + batch->length, text, length);
+	batch->length += length;
+}
+
+/**
+ * Moves every ready record of the ring buffer into its batch, releasing the
+ * records to the producers. Returns the amount of records drained.
+ */
+static size_t _drain(void) {
+	size_t drained = 0;
+	for (;;) {
+		LogRecord * record = &_records[_dequeuePosition & (_capacity - 1)];
+		if (__atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE) != _dequeuePosition + 1) {
+			return drained;
+		}
+		_appendToBatch(record->stream == stderr ? &_errorBatch : &_outputBatch, record->text, record->length);
+		__atomic_store_n(&record->sequence, _dequeuePosition + _capacity, __ATOMIC_RELEASE);
+		++_dequeuePosition;
+		++drained;
+	}
+}
+
+/**
+ * Writes a batch to its stream.
+ */
+static void _flushBatch(LogBatch * batch) {
+	if (0 < batch->length) {
+		fwrite(batch->text, sizeof(char), batch->length, batch->stream);
+		fflush(batch->stream);
+		batch->length = 0;
+	}
+}
+
+/**
+ * Logs the amount of messages dropped since the last report, if any.
+ */
+static void _reportDroppedMessages(void) {
+	const size_t droppedMessages = __atomic_exchange_n(&_droppedMessages, 0, __ATOMIC_RELAXED);
+	if (0 < droppedMessages) {
+		char text[128];
+		const int length = snprintf(text, sizeof(text), "[WARN ][AsynchronousLogger] %zu messages were dropped (the buffer was full).\n", droppedMessages);
+		_appendToBatch(&_errorBatch, text, (size_t) length);
+	}
+}
+
+/**
+ * Signals the writer thread, only if it's sleeping.
+ */
+static void _wakeUpWriter(void) {
+	if (__atomic_load_n(&_sleeping, __ATOMIC_SEQ_CST)) {
+		pthread_mutex_lock(&_mutex);
+		pthread_cond_signal(&_condition);
+		pthread_mutex_unlock(&_mutex);
+	}
+}
+
+/**
+ * The background writer: drains the ring buffer into the batches, and writes
+ * a batch only when it's full, or when no message arrived for a while. It
+ * sleeps while there is nothing to write.
+ */
+static void * _writer(void * argument) {
+	for (;;) {
+		if (0 < _drain()) {
+			continue;
+		}
+		if (__atomic_load_n(&_stopping, __ATOMIC_ACQUIRE)) {
+			if (_drain() == 0) {
+				break;
+			}
+			continue;
+		}
+		pthread_mutex_lock(&_mutex);
+		__atomic_store_n(&_sleeping, true, __ATOMIC_SEQ_CST);
+		if (!__atomic_load_n(&_stopping, __ATOMIC_SEQ_CST)) {
+			struct timeval now;
+			gettimeofday(&now, NULL);
+			const long nanoseconds = 1000 * now.tv_usec + _idleNanoseconds;
+			struct timespec deadline = {
+				.tv_sec = now.tv_sec + nanoseconds / 1000000000,
+				.tv_nsec = nanoseconds % 1000000000
+			};
+			pthread_cond_timedwait(&_condition, &_mutex, &deadline);
+		}
+		__atomic_store_n(&_sleeping, false, __ATOMIC_SEQ_CST);
+		pthread_mutex_unlock(&_mutex);
+		if (_drain() == 0) {
+			_reportDroppedMessages();
+			_flushBatch(&_outputBatch);
+			_flushBatch(&_errorBatch);
+		}
+	}
+	_reportDroppedMessages();
+	_flushBatch(&_outputBatch);
+	_flushBatch(&_errorBatch);
+	return NULL;
+}
+
+#endif
+
+/* PUBLIC FUNCTIONS */
+
+const boolean startAsynchronousLogger(const OverflowPolicy overflowPolicy) {
+#if ASYNCHRONOUS_LOGGING_IS_SUPPORTED
+	if (_running) {
+		return true;
+	}
+	_records = calloc(_capacity, sizeof(LogRecord));
+	for (size_t k = 0; k < _capacity; ++k) {
+		_records[k].sequence = k;
+	}
+	_overflowPolicy = overflowPolicy;
+	_outputBatch.stream = stdout;
+	_errorBatch.stream = stderr;
+	if (pthread_create(&_writerThread, NULL, _writer, NULL) != 0) {
+		free(_records);
+		_records = NULL;
+		return false;
+	}
+	_running = true;
+	atexit(stopAsynchronousLogger);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void logAsynchronously(FILE * const stream, const char * const context, const char * const name, const char * const format, va_list arguments) {
+#if ASYNCHRONOUS_LOGGING_IS_SUPPORTED
+	size_t position;
+	LogRecord * record = _acquireRecord(&position);
+	if (record == NULL) {
+		return;
+	}
+	// Leaves room for the new-line, and truncates long messages.
+	const int available = LOG_RECORD_SIZE - 1;
+	int length = snprintf(record->text, available, "%s[%s] ", context, name);
+	if (length < available) {
+		length += vsnprintf(record->text + length, available - length, format, arguments);
+	}
+	if (available - 1 < length) {
+		length = available - 1;
+	}
+	record->text[length] = '\n';
+	record->length = 1 + length;
+	record->stream = stream;
+	__atomic_store_n(&record->sequence, position + 1, __ATOMIC_RELEASE);
+	// The writer wakes up by itself periodically, unless the buffer fills up.
+	if ((position & (_capacity / 2 - 1)) == 0) {
+		_wakeUpWriter();
+	}
+#endif
+}
+
+void stopAsynchronousLogger(void) {
+#if ASYNCHRONOUS_LOGGING_IS_SUPPORTED
+	if (!_running) {
+		return;
+	}
+	__atomic_store_n(&_stopping, true, __ATOMIC_SEQ_CST);
+	pthread_mutex_lock(&_mutex);
+	pthread_cond_signal(&_condition);
+	pthread_mutex_unlock(&_mutex);
+	pthread_join(_writerThread, NULL);
+	free(_records);
+	_records = NULL;
+	_running = false;
+#endif
+}
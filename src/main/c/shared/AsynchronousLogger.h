@@ -0,0 +1,39 @@
+#ifndef ASYNCHRONOUS_LOGGER_HEADER
+#define ASYNCHRONOUS_LOGGER_HEADER
+
+#include "Type.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * What to do when a message is logged but the ring buffer is full.
+ */
+typedef enum {
+	// Wait until the writer thread releases a record.
+	BLOCK_ON_OVERFLOW,
+
+	// Discard the message (the amount of discarded messages is reported).
+	DROP_ON_OVERFLOW
+} OverflowPolicy;
+
+/**
+ * Starts the background writer thread, and preallocates the ring buffer of
+ * records. Every pending message is flushed when the process exits. Returns
+ * false if the asynchronous mode is not available in this platform.
+ */
+const boolean startAsynchronousLogger(const OverflowPolicy overflowPolicy);
+
+/**
+ * Formats a message directly inside a record of the ring buffer (without
+ * heap-memory), and hands it to the writer thread. Messages longer than a
+ * record are truncated.
+ */
+void logAsynchronously(FILE * const stream, const char * const context, const char * const name, const char * const format, va_list arguments);
+
+/**
+ * Writes every pending message and stops the writer thread. Called on exit.
+ */
+void stopAsynchronousLogger(void);
+
+#endif
@@ -1,6 +1,10 @@
 #ifndef COMPILER_STATE_HEADER
 #define COMPILER_STATE_HEADER
 
+#include "Arena.h"
+#include "NodeTable.h"
+#include "StringTable.h"
+#include "SymbolTable.h"
 #include "Type.h"
 
 /**
@@ -11,6 +15,38 @@ typedef enum {
 	FAILED = 1
 } CompilationStatus;
 
+/**
+ * The state of a streaming compilation, in which every top-level instruction
+ * is handed to a consumer as soon as it's parsed, and released afterwards.
+ * Only the signatures of the functions and the global variables outlive it
+ * (i.e., the skeleton of the program), in memory of their own.
+ */
+typedef struct {
+	// Receives each top-level instruction and the context. The instruction
+	// and its subtree are valid only during the call.
+	void (*consume)(void * instruction, void * context);
+
+	// The context of the consumer.
+	void * context;
+
+	// The memory of the skeleton, its hash-consed global variables, and the
+	// interned identifiers of the whole program (i.e., the names of the
+	// symbol table, that outlive every released instruction).
+	Arena * arena;
+	NodeTable * nodeTable;
+	StringTable * stringTable;
+
+	// The last instruction of the skeleton, which points back to the first
+	// one (i.e., a circular list, as every list being built by the parser).
+	void * skeleton;
+
+	// The amount of streamed top-level instructions, of instructions kept in
+	// the skeleton, and of times the memory of the AST was released.
+	unsigned long long instructions;
+	unsigned int keptInstructions;
+	unsigned int releases;
+} StreamingState;
+
 /**
  * The global state of the compiler. Should transport every data structure
  * needed across the different phases of a compilation.
@@ -19,11 +55,40 @@ typedef struct {
 	// The root node of the AST.
 	void * abstractSyntaxtTree;
 
+	// The memory of every AST node and interned string of the compilation.
+	Arena * arena;
+
+	// The call graph of the program, and the summaries of its functions (see
+	// "CallGraph.h"), or NULL if it wasn't analyzed.
+	void * callGraph;
+
+	// The estimated costs of the functions of the program, and its hottest
+	// statements (see "CostAnalysis.h"), or NULL if it wasn't analyzed.
+	void * costAnalysis;
+
+	// The hash-consed (i.e., shared) immutable nodes of the AST.
+	NodeTable * nodeTable;
+
+	// The checks that every arithmetic operation needs at runtime, according to
+	// the analysis of the value ranges (see "RangeAnalysis.h"), or NULL if it
+	// wasn't analyzed.
+	void * rangeAnalysis;
+
 	// A flag that indicates the current state of the compilation so far.
 	boolean succeed;
 
-	// TODO: Add an stack to handle nested scopes.
-	// TODO: Add a symbol table.
+	// The path of the source file, or NULL to read the standard input.
+	const char * sourcePath;
+
+	// The interned identifiers and string literals of the program.
+	StringTable * stringTable;
+
+	// The state of a streaming compilation, or NULL if the whole AST is built.
+	StreamingState * streamingState;
+
+	// The identifiers declared in the scopes open while scanning.
+	SymbolTable * symbolTable;
+
 	// TODO: Add configuration.
 	// TODO: ...
 
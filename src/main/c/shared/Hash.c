@@ -0,0 +1,17 @@
+#include "Hash.h"
+
+/* PUBLIC FUNCTIONS */
+
+unsigned int hashBytes(const unsigned int seed, const void * bytes, const unsigned int size) {
+	const unsigned char * characters = bytes;
+	unsigned int hash = 2166136261u ^ seed;
+	for (unsigned int k = 0; k < size; ++k) {
+		hash ^= characters[k];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+unsigned int hashAddress(const void * address) {
+	return (unsigned int) (((uintptr_t) address >> 3) * 2654435761u);
+}
@@ -0,0 +1,21 @@
+#ifndef HASH_HEADER
+#define HASH_HEADER
+
+#include <stdint.h>
+
+/**
+ * The 32-bit FNV-1a hash of the specified bytes. The seed tells apart equal
+ * bytes of different kinds (use 0 if there's only one kind).
+ *
+ * @see http://www.isthe.com/chongo/tech/comp/fnv/
+ */
+unsigned int hashBytes(const unsigned int seed, const void * bytes, const unsigned int size);
+
+/**
+ * The hash of an address (Fibonacci hashing, without the alignment bits, that
+ * are always zero), for the tables of interned strings and hash-consed nodes,
+ * which are compared by address.
+ */
+unsigned int hashAddress(const void * address);
+
+#endif
@@ -1,26 +1,72 @@
 #include "Logger.h"
 
+/**
+ * Locks a stream while a whole message is written on it, so the messages of
+ * concurrent compilations don't interleave.
+ *
+ * @see https://man7.org/linux/man-pages/man3/flockfile.3.html
+ */
+#if defined (__TOS_WIN__) \
+	|| defined (__WIN32__) \
+	|| defined (__WINDOWS__) \
+	|| defined (_WIN16) \
+	|| defined (_WIN32) \
+	|| defined (_WIN64)
+#define lockStream(stream) _lock_file(stream)
+#define unlockStream(stream) _unlock_file(stream)
+#else
+#define lockStream(stream) flockfile(stream)
+#define unlockStream(stream) funlockfile(stream)
+#endif
+
+/* MODULE INTERNAL STATE */
+
+// True once the logging mode has been read from the environment.
+static boolean _configured = false;
+
+// True if every message is handed to the background writer.
+static boolean _asynchronous = false;
+
 /* PRIVATE FUNCTIONS */
 
+static void _configure(void);
+
 static void _log(const Logger * logger, const LoggingLevel loggingLevel, const char * const format, va_list arguments);
 static LoggingLevel _loggingLevelFromString(const char * loggingLevel);
 static void _logInStream(FILE * const stream, const char * const format, va_list arguments);
 static const char * _toContextString(const LoggingLevel loggingLevel);
 
 /**
- * Logs a new message at the specified level, using a format string.
+ * Selects the logging mode (and the overflow policy of the asynchronous
+ * mode) from the environment. Falls back to the synchronous mode if the
+ * asynchronous one is not available.
+ */
+static void _configure(void) {
+	if (strcmp(getStringOrDefault("LOGGING_MODE", "SYNCHRONOUS"), "ASYNCHRONOUS") == 0) {
+		const OverflowPolicy overflowPolicy = strcmp(getStringOrDefault("LOGGING_OVERFLOW_POLICY", "BLOCK"), "DROP") == 0
+			? DROP_ON_OVERFLOW
+			: BLOCK_ON_OVERFLOW;
+		_asynchronous = startAsynchronousLogger(overflowPolicy);
+	}
+	_configured = true;
+}
+
+/**
+ * Logs a new message at the specified level, using a format string. The
+ * prefix is written directly, so no intermediate format is allocated.
  */
 static void _log(const Logger * logger, const LoggingLevel loggingLevel, const char * const format, va_list arguments) {
 	if (logger->loggingLevel <= loggingLevel) {
-		const char * context = _toContextString(loggingLevel);
-		char * effectiveFormat = concatenate(6, context, "[", logger->name, "] ", format, "\n");
-		if (ERROR <= loggingLevel) {
-			_logInStream(stderr, effectiveFormat, arguments);
-		}
-		else {
-			_logInStream(stdout, effectiveFormat, arguments);
+		FILE * const stream = ERROR <= loggingLevel ? stderr : stdout;
+		if (_asynchronous) {
+			logAsynchronously(stream, _toContextString(loggingLevel), logger->name, format, arguments);
+			return;
 		}
-		free(effectiveFormat);
+		lockStream(stream);
+		fprintf(stream, "%s[%s] ", _toContextString(loggingLevel), logger->name);
+		_logInStream(stream, format, arguments);
+		fputc('\n', stream);
+		unlockStream(stream);
 	}
 }
 
@@ -69,6 +115,9 @@ static const char * _toContextString(const LoggingLevel loggingLevel) {
 /* PUBLIC FUNCTIONS */
 
 Logger * createLogger(char * name) {
+	if (!_configured) {
+		_configure();
+	}
 	Logger * logger = calloc(1, sizeof(Logger));
 	logger->loggingLevel = _loggingLevelFromString(getStringOrDefault("LOGGING_LEVEL", "INFORMATION"));
 	logger->name = calloc(1 + strlen(name), sizeof(char));
@@ -85,37 +134,9 @@ void destroyLogger(Logger * logger) {
 	}
 }
 
-void logCritical(const Logger * logger, const char * const format, ...) {
-	va_list arguments;
-	va_start(arguments, format);
-	_log(logger, CRITICAL, format, arguments);
-	va_end(arguments);
-}
-
-void logDebugging(const Logger * logger, const char * const format, ...) {
-	va_list arguments;
-	va_start(arguments, format);
-	_log(logger, DEBUGGING, format, arguments);
-	va_end(arguments);
-}
-
-void logError(const Logger * logger, const char * const format, ...) {
-	va_list arguments;
-	va_start(arguments, format);
-	_log(logger, ERROR, format, arguments);
-	va_end(arguments);
-}
-
-void logInformation(const Logger * logger, const char * const format, ...) {
-	va_list arguments;
-	va_start(arguments, format);
-	_log(logger, INFORMATION, format, arguments);
-	va_end(arguments);
-}
-
-void logWarning(const Logger * logger, const char * const format, ...) {
+void logAtLevel(const Logger * logger, const LoggingLevel loggingLevel, const char * const format, ...) {
 	va_list arguments;
 	va_start(arguments, format);
-	_log(logger, WARNING, format, arguments);
+	_log(logger, loggingLevel, format, arguments);
 	va_end(arguments);
 }
@@ -1,11 +1,14 @@
 #ifndef LOGGER_HEADER
 #define LOGGER_HEADER
 
+#include "AsynchronousLogger.h"
 #include "Environment.h"
 #include "String.h"
+#include "Type.h"
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /**
  * Platform dependent macros.
@@ -86,19 +89,54 @@ Logger * createLogger(char * name);
  */
 void destroyLogger(Logger * logger);
 
+/**
+ * Build-time switch: when DISCARD_DEBUGGING_LOGS is defined (see the CMake
+ * option with the same name), every log below INFORMATION level is removed
+ * from the binary, and the level checks become constant false.
+ */
+#ifdef DISCARD_DEBUGGING_LOGS
+#define DEBUGGING_LOGS_ARE_ENABLED false
+#else
+#define DEBUGGING_LOGS_ARE_ENABLED true
+#endif
+
+/**
+ * True if a message at the specified level would be visible. Check it before
+ * doing any expensive work that is only needed to build a log message.
+ */
+#define isLoggingEnabled(logger, level) \
+	((DEBUGGING_LOGS_ARE_ENABLED || INFORMATION <= (level)) && (logger)->loggingLevel <= (level))
+
+/**
+ * Logs at the specified level. The level must be checked first (i.e., the
+ * macros below are the preferred way to log).
+ */
+void logAtLevel(const Logger * logger, const LoggingLevel loggingLevel, const char * const format, ...);
+
+/**
+ * Logs at the specified level, but only if it's enabled, so the arguments
+ * aren't evaluated (nor formatted) otherwise.
+ */
+#define logIfEnabled(logger, level, ...) \
+	do { \
+		if (isLoggingEnabled(logger, level)) { \
+			logAtLevel(logger, level, __VA_ARGS__); \
+		} \
+	} while (false)
+
 /** Logs at CRITICAL level. */
-void logCritical(const Logger * logger, const char * const format, ...);
+#define logCritical(logger, ...) logIfEnabled(logger, CRITICAL, __VA_ARGS__)
 
 /** Logs at DEBUGGING level. */
-void logDebugging(const Logger * logger, const char * const format, ...);
+#define logDebugging(logger, ...) logIfEnabled(logger, DEBUGGING, __VA_ARGS__)
 
 /** Logs at ERROR level. */
-void logError(const Logger * logger, const char * const format, ...);
+#define logError(logger, ...) logIfEnabled(logger, ERROR, __VA_ARGS__)
 
 /** Logs at INFORMATION level. */
-void logInformation(const Logger * logger, const char * const format, ...);
+#define logInformation(logger, ...) logIfEnabled(logger, INFORMATION, __VA_ARGS__)
 
 /** Logs at WARNING level. */
-void logWarning(const Logger * logger, const char * const format, ...);
+#define logWarning(logger, ...) logIfEnabled(logger, WARNING, __VA_ARGS__)
 
 #endif
@@ -0,0 +1,90 @@
+#include "NodeTable.h"
+
+/* MODULE INTERNAL STATE */
+
+// The initial amount of slots (must be a power of 2).
+static const unsigned int _initialCapacity = 256;
+
+/* PRIVATE FUNCTIONS */
+
+static NodeTableEntry * _lookup(NodeTableEntry * entries, const unsigned int capacity, const unsigned int tag, const void * node, const unsigned int size, const unsigned int hash);
+static void _grow(NodeTable * nodeTable);
+
+/**
+ * Finds the slot of a node with linear probing: either the slot that already
+ * holds it, or the empty slot where it must be inserted.
+ */
+static NodeTableEntry * _lookup(NodeTableEntry * entries, const unsigned int capacity, const unsigned int tag, const void * node, const unsigned int size, const unsigned int hash) {
+	const unsigned int mask = capacity - 1;
+	for (unsigned int k = hash & mask; ; k = (k + 1) & mask) {
+		NodeTableEntry * entry = &entries[k];
+		if (entry->node == NULL) {
+			return entry;
+		}
+		if (entry->hash == hash && entry->tag == tag && entry->size == size && memcmp(entry->node, node, size) == 0) {
+			return entry;
+		}
+	}
+}
+
+/**
+ * Doubles the amount of slots and re-inserts every entry. The nodes remain in
+ * the arena, so their addresses don't change.
+ */
+static void _grow(NodeTable * nodeTable) {
+	const unsigned int capacity = 2 * nodeTable->capacity;
+	NodeTableEntry * entries = calloc(capacity, sizeof(NodeTableEntry));
+	for (unsigned int k = 0; k < nodeTable->capacity; ++k) {
+		NodeTableEntry * entry = &nodeTable->entries[k];
+		if (entry->node != NULL) {
+			*_lookup(entries, capacity, entry->tag, entry->node, entry->size, entry->hash) = *entry;
+		}
+	}
+	free(nodeTable->entries);
+	nodeTable->entries = entries;
+	nodeTable->capacity = capacity;
+}
+
+/* PUBLIC FUNCTIONS */
+
+NodeTable * createNodeTable(Arena * arena) {
+	NodeTable * nodeTable = calloc(1, sizeof(NodeTable));
+	nodeTable->arena = arena;
+	nodeTable->entries = calloc(_initialCapacity, sizeof(NodeTableEntry));
+	nodeTable->capacity = _initialCapacity;
+	nodeTable->size = 0;
+	nodeTable->requests = 0;
+	return nodeTable;
+}
+
+void clearNodeTable(NodeTable * nodeTable) {
+	memset(nodeTable->entries, 0, nodeTable->capacity * sizeof(NodeTableEntry));
+	nodeTable->size = 0;
+	nodeTable->requests = 0;
+}
+
+void destroyNodeTable(NodeTable * nodeTable) {
+	if (nodeTable != NULL) {
+		free(nodeTable->entries);
+		free(nodeTable);
+	}
+}
+
+const void * internNode(NodeTable * nodeTable, const unsigned int tag, const void * node, const unsigned int size) {
+	++nodeTable->requests;
+	const unsigned int hash = hashBytes(tag, node, size);
+	NodeTableEntry * entry = _lookup(nodeTable->entries, nodeTable->capacity, tag, node, size, hash);
+	if (entry->node != NULL) {
+		return entry->node;
+	}
+	void * copy = allocateInArena(nodeTable->arena, size);
+	memcpy(copy, node, size);
+	entry->node = copy;
+	entry->size = size;
+	entry->tag = tag;
+	entry->hash = hash;
+	if (4 * ++nodeTable->size > 3 * nodeTable->capacity) {
+		_grow(nodeTable);
+	}
+	return copy;
+}
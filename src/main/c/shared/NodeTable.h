@@ -0,0 +1,59 @@
+#ifndef NODE_TABLE_HEADER
+#define NODE_TABLE_HEADER
+
+#include "Arena.h"
+#include "Hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A slot of the node table. An empty slot has a NULL node.
+ */
+typedef struct {
+	const void * node;
+	unsigned int size;
+	unsigned int tag;
+	unsigned int hash;
+} NodeTableEntry;
+
+/**
+ * A hash-consing table: every distinct immutable node is stored exactly once
+ * (inside an arena, that the table doesn't own). Nodes are compared by their
+ * bytes, so their children must be hash-consed first; then two hash-consed
+ * nodes are structurally equal if and only if their pointers are equal. The
+ * tag distinguishes nodes of different types with the same bytes.
+ */
+typedef struct {
+	Arena * arena;
+	NodeTableEntry * entries;
+	unsigned int capacity;
+	unsigned int size;
+	unsigned int requests;
+} NodeTable;
+
+/**
+ * Creates a new empty node table, that stores its nodes in the specified
+ * arena.
+ */
+NodeTable * createNodeTable(Arena * arena);
+
+/**
+ * Removes every node from the table. Must be called when its arena is reset,
+ * because the nodes don't exist anymore.
+ */
+void clearNodeTable(NodeTable * nodeTable);
+
+/**
+ * Destroy a node table. The nodes are released with the arena.
+ */
+void destroyNodeTable(NodeTable * nodeTable);
+
+/**
+ * Returns the unique copy of a node, storing it in the table the first time
+ * it's seen. The candidate must be fully initialized, including its padding
+ * (e.g., with memset). The result lives as long as the table, and must not
+ * be modified.
+ */
+const void * internNode(NodeTable * nodeTable, const unsigned int tag, const void * node, const unsigned int size);
+
+#endif
@@ -0,0 +1,107 @@
+#include "SourceFile.h"
+
+/**
+ * Platform dependent memory-mapping support.
+ *
+ * @see https://man7.org/linux/man-pages/man2/mmap.2.html
+ */
+#if defined (__TOS_WIN__) \
+	|| defined (__WIN32__) \
+	|| defined (__WINDOWS__) \
+	|| defined (_WIN16) \
+	|| defined (_WIN32) \
+	|| defined (_WIN64)
+#define MAPPING_IS_SUPPORTED 0
+#else
+#define MAPPING_IS_SUPPORTED 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* PRIVATE FUNCTIONS */
+
+static char * _map(const char * path, size_t * size);
+
+/**
+ * Maps a regular file in memory, followed by 2 NUL bytes. Returns NULL if
+ * the file cannot (or should not) be mapped, in which case it must be read
+ * as a stream.
+ *
+ * An anonymous (zero-filled) region of the full size is reserved first, and
+ * then the file is mapped over it, so the trailing NUL bytes exist even when
+ * the file size is a multiple of the page size. The mapping is private and
+ * writable, because Flex writes a NUL byte after every lexeme.
+ */
+static char * _map(const char * path, size_t * size) {
+#if MAPPING_IS_SUPPORTED
+	const int descriptor = open(path, O_RDONLY);
+	if (descriptor < 0) {
+		return NULL;
+	}
+	struct stat status;
+	if (fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode) || status.st_size == 0) {
+		close(descriptor);
+		return NULL;
+	}
+	*size = (size_t) status.st_size;
+	char * content = mmap(NULL, *size + 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (content == MAP_FAILED) {
+		close(descriptor);
+		return NULL;
+	}
+	if (mmap(content, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, descriptor, 0) == MAP_FAILED) {
+		munmap(content, *size + 2);
+		close(descriptor);
+		return NULL;
+	}
+	madvise(content, *size, MADV_SEQUENTIAL);
+	close(descriptor);
+	return content;
+#else
+	return NULL;
+#endif
+}
+
+/* PUBLIC FUNCTIONS */
+
+SourceFile * openSourceFile(const char * path) {
+	if (path != NULL && strcmp(path, "-") == 0) {
+		path = NULL;
+	}
+	SourceFile * sourceFile = calloc(1, sizeof(SourceFile));
+	sourceFile->path = path;
+	if (path == NULL) {
+		sourceFile->stream = stdin;
+		return sourceFile;
+	}
+	sourceFile->content = _map(path, &sourceFile->size);
+	if (sourceFile->content == NULL) {
+		sourceFile->size = 0;
+		sourceFile->stream = fopen(path, "r");
+		if (sourceFile->stream == NULL) {
+			free(sourceFile);
+			return NULL;
+		}
+	}
+	return sourceFile;
+}
+
+void closeSourceFile(SourceFile * sourceFile) {
+	if (sourceFile != NULL) {
+#if MAPPING_IS_SUPPORTED
+		if (sourceFile->content != NULL) {
+			munmap(sourceFile->content, sourceFile->size + 2);
+		}
+#endif
+		if (sourceFile->stream != NULL && sourceFile->stream != stdin) {
+			fclose(sourceFile->stream);
+		}
+		free(sourceFile);
+	}
+}
+
+const boolean isMappedSourceFile(const SourceFile * sourceFile) {
+	return sourceFile->content != NULL;
+}
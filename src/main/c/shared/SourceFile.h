@@ -0,0 +1,46 @@
+#ifndef SOURCE_FILE_HEADER
+#define SOURCE_FILE_HEADER
+
+#include "Type.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * The input program of a compilation. A regular file is memory-mapped, so
+ * its content can be scanned in place (without copies or read syscalls), and
+ * it's followed by two NUL bytes, as required by Flex buffer-scanning API.
+ * Anything else (e.g., a pipe, or the standard input) is read as a stream.
+ */
+typedef struct {
+	// The path of the file, or NULL for the standard input.
+	const char * path;
+
+	// The mapped content, or NULL if the file must be read as a stream.
+	char * content;
+
+	// The size of the content, in bytes (without the trailing NUL bytes).
+	size_t size;
+
+	// The stream to read from, when the content is not mapped.
+	FILE * stream;
+} SourceFile;
+
+/**
+ * Opens the source file at the specified path (the standard input if the
+ * path is NULL or "-"). Returns NULL on failure, with "errno" set.
+ */
+SourceFile * openSourceFile(const char * path);
+
+/**
+ * Closes a source file, unmapping its content if needed.
+ */
+void closeSourceFile(SourceFile * sourceFile);
+
+/**
+ * True if the content of the source file is memory-mapped.
+ */
+const boolean isMappedSourceFile(const SourceFile * sourceFile);
+
+#endif
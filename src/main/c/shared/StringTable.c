@@ -0,0 +1,86 @@
+#include "StringTable.h"
+
+/* MODULE INTERNAL STATE */
+
+// The initial amount of slots (must be a power of 2).
+static const unsigned int _initialCapacity = 256;
+
+/* PRIVATE FUNCTIONS */
+
+static StringTableEntry * _lookup(StringTableEntry * entries, const unsigned int capacity, const char * characters, const unsigned int length, const unsigned int hash);
+static void _grow(StringTable * stringTable);
+
+/**
+ * Finds the slot of a string with linear probing: either the slot that
+ * already holds it, or the empty slot where it must be inserted.
+ */
+static StringTableEntry * _lookup(StringTableEntry * entries, const unsigned int capacity, const char * characters, const unsigned int length, const unsigned int hash) {
+	const unsigned int mask = capacity - 1;
+	for (unsigned int k = hash & mask; ; k = (k + 1) & mask) {
+		StringTableEntry * entry = &entries[k];
+		if (entry->string == NULL) {
+			return entry;
+		}
+		if (entry->hash == hash && entry->length == length && memcmp(entry->string, characters, length) == 0) {
+			return entry;
+		}
+	}
+}
+
+/**
+ * Doubles the amount of slots and re-inserts every entry. Only the index is
+ * rebuilt: the strings remain in the arena, so their handles don't change.
+ */
+static void _grow(StringTable * stringTable) {
+	const unsigned int capacity = 2 * stringTable->capacity;
+	StringTableEntry * entries = calloc(capacity, sizeof(StringTableEntry));
+	for (unsigned int k = 0; k < stringTable->capacity; ++k) {
+		StringTableEntry * entry = &stringTable->entries[k];
+		if (entry->string != NULL) {
+			*_lookup(entries, capacity, entry->string, entry->length, entry->hash) = *entry;
+		}
+	}
+	free(stringTable->entries);
+	stringTable->entries = entries;
+	stringTable->capacity = capacity;
+}
+
+/* PUBLIC FUNCTIONS */
+
+StringTable * createStringTable(Arena * arena) {
+	StringTable * stringTable = calloc(1, sizeof(StringTable));
+	stringTable->arena = arena;
+	stringTable->entries = calloc(_initialCapacity, sizeof(StringTableEntry));
+	stringTable->capacity = _initialCapacity;
+	stringTable->size = 0;
+	return stringTable;
+}
+
+void clearStringTable(StringTable * stringTable) {
+	memset(stringTable->entries, 0, stringTable->capacity * sizeof(StringTableEntry));
+	stringTable->size = 0;
+}
+
+void destroyStringTable(StringTable * stringTable) {
+	if (stringTable != NULL) {
+		free(stringTable->entries);
+		free(stringTable);
+	}
+}
+
+const char * intern(StringTable * stringTable, const char * characters, const unsigned int length) {
+	const unsigned int hash = hashBytes(0, characters, length);
+	StringTableEntry * entry = _lookup(stringTable->entries, stringTable->capacity, characters, length, hash);
+	if (entry->string != NULL) {
+		return entry->string;
+	}
+	char * string = allocateInArena(stringTable->arena, 1 + length);
+	memcpy(string, characters, length);
+	entry->string = string;
+	entry->length = length;
+	entry->hash = hash;
+	if (4 * ++stringTable->size > 3 * stringTable->capacity) {
+		_grow(stringTable);
+	}
+	return string;
+}
@@ -0,0 +1,56 @@
+#ifndef STRING_TABLE_HEADER
+#define STRING_TABLE_HEADER
+
+#include "Arena.h"
+#include "Hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A slot of the string table. An empty slot has a NULL string.
+ */
+typedef struct {
+	const char * string;
+	unsigned int length;
+	unsigned int hash;
+} StringTableEntry;
+
+/**
+ * An interning table: every distinct string is stored exactly once (inside an
+ * arena, that the table doesn't own), and it's indexed with an open-addressing
+ * hash table. The pointer
+ * returned when interning a string is its stable handle, so two interned
+ * strings are equal if and only if their pointers are equal.
+ */
+typedef struct {
+	Arena * arena;
+	StringTableEntry * entries;
+	unsigned int capacity;
+	unsigned int size;
+} StringTable;
+
+/**
+ * Creates a new empty string table, that stores its strings in the specified
+ * arena.
+ */
+StringTable * createStringTable(Arena * arena);
+
+/**
+ * Removes every string from the table. Must be called when its arena is
+ * reset, because the strings don't exist anymore.
+ */
+void clearStringTable(StringTable * stringTable);
+
+/**
+ * Destroy a string table. The interned strings are released with the arena.
+ */
+void destroyStringTable(StringTable * stringTable);
+
+/**
+ * Returns the unique NUL-terminated copy of the specified characters (which
+ * don't need to be NUL-terminated), storing it in the table the first time
+ * it's seen. The result lives as long as the table, and must not be freed.
+ */
+const char * intern(StringTable * stringTable, const char * characters, const unsigned int length);
+
+#endif
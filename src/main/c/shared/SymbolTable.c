@@ -0,0 +1,228 @@
+#include "SymbolTable.h"
+
+/* MODULE INTERNAL STATE */
+
+// The initial amount of slots (must be a power of 2), bindings, scopes,
+// frames and types of parameters.
+static const unsigned int _initialCapacity = 64;
+
+// The markers of the slots that don't index a binding.
+static const int _emptySlot = -1;
+static const int _deletedSlot = -2;
+
+/* PRIVATE FUNCTIONS */
+
+static unsigned int _allocateSlot(SymbolTable * symbolTable);
+static int * _lookup(const SymbolTable * symbolTable, const char * name);
+static void _openScope(SymbolTable * symbolTable, const boolean isFrame, const int function);
+static void _rehash(SymbolTable * symbolTable, const unsigned int capacity);
+
+/**
+ * Takes the first free slot of the innermost frame, growing the frame if
+ * every slot is in use.
+ */
+static unsigned int _allocateSlot(SymbolTable * symbolTable) {
+	SymbolFrame * frame = &symbolTable->frames[symbolTable->frameDepth - 1];
+	const unsigned int slot = frame->used++;
+	if (frame->size < frame->used) {
+		frame->size = frame->used;
+	}
+	return slot;
+}
+
+/**
+ * Finds the slot of a name with linear probing: either the slot that indexes
+ * its innermost binding, or the slot where it must be inserted (the first
+ * deleted one found, if any, so they are reused).
+ */
+static int * _lookup(const SymbolTable * symbolTable, const char * name) {
+	const unsigned int mask = symbolTable->slotCapacity - 1;
+	int * deleted = NULL;
+	for (unsigned int k = hashAddress(name) & mask; ; k = (k + 1) & mask) {
+		int * slot = &symbolTable->slots[k];
+		if (*slot == _emptySlot) {
+			return deleted == NULL ? slot : deleted;
+		}
+		if (*slot == _deletedSlot) {
+			if (deleted == NULL) {
+				deleted = slot;
+			}
+			continue;
+		}
+		if (symbolTable->symbols[*slot].name == name) {
+			return slot;
+		}
+	}
+}
+
+/**
+ * Opens a new innermost scope (and a new frame of a function, if requested),
+ * doubling the capacity of the stacks when they're full.
+ */
+static void _openScope(SymbolTable * symbolTable, const boolean isFrame, const int function) {
+	if (isFrame) {
+		if (symbolTable->frameDepth == symbolTable->frameCapacity) {
+			symbolTable->frameCapacity *= 2;
+			symbolTable->frames = realloc(symbolTable->frames, symbolTable->frameCapacity * sizeof(SymbolFrame));
+		}
+		SymbolFrame * frame = &symbolTable->frames[symbolTable->frameDepth++];
+		frame->used = 0;
+		frame->size = 0;
+		frame->function = function;
+	}
+	if (symbolTable->depth == symbolTable->scopeCapacity) {
+		symbolTable->scopeCapacity *= 2;
+		symbolTable->scopes = realloc(symbolTable->scopes, symbolTable->scopeCapacity * sizeof(SymbolScope));
+	}
+	SymbolScope * scope = &symbolTable->scopes[symbolTable->depth++];
+	scope->bindings = symbolTable->size;
+	scope->used = symbolTable->frames[symbolTable->frameDepth - 1].used;
+	scope->isFrame = isFrame;
+}
+
+/**
+ * Rebuilds the index with the specified amount of slots, dropping the deleted
+ * ones. The bindings are re-inserted from the outermost to the innermost, so
+ * each name ends up indexing its innermost binding.
+ */
+static void _rehash(SymbolTable * symbolTable, const unsigned int capacity) {
+	free(symbolTable->slots);
+	symbolTable->slots = malloc(capacity * sizeof(int));
+	memset(symbolTable->slots, 0xFF, capacity * sizeof(int));
+	symbolTable->slotCapacity = capacity;
+	symbolTable->usedSlots = 0;
+	for (unsigned int k = 0; k < symbolTable->size; ++k) {
+		const Symbol * symbol = &symbolTable->symbols[k];
+		int * slot = _lookup(symbolTable, symbol->name);
+		if (*slot == _emptySlot) {
+			++symbolTable->usedSlots;
+		}
+		*slot = (int) k;
+	}
+}
+
+/* PUBLIC FUNCTIONS */
+
+SymbolTable * createSymbolTable() {
+	SymbolTable * symbolTable = calloc(1, sizeof(SymbolTable));
+	symbolTable->symbols = malloc(_initialCapacity * sizeof(Symbol));
+	symbolTable->capacity = _initialCapacity;
+	symbolTable->scopes = malloc(_initialCapacity * sizeof(SymbolScope));
+	symbolTable->scopeCapacity = _initialCapacity;
+	symbolTable->frames = calloc(_initialCapacity, sizeof(SymbolFrame));
+	symbolTable->frames[0].function = -1;
+	symbolTable->frameDepth = 1;
+	symbolTable->frameCapacity = _initialCapacity;
+	symbolTable->signatures = malloc(_initialCapacity * sizeof(int));
+	symbolTable->signaturesCapacity = _initialCapacity;
+	_rehash(symbolTable, _initialCapacity);
+	return symbolTable;
+}
+
+void destroySymbolTable(SymbolTable * symbolTable) {
+	if (symbolTable != NULL) {
+		free(symbolTable->symbols);
+		free(symbolTable->scopes);
+		free(symbolTable->frames);
+		free(symbolTable->signatures);
+		free(symbolTable->slots);
+		free(symbolTable);
+	}
+}
+
+void pushScope(SymbolTable * symbolTable) {
+	_openScope(symbolTable, false, -1);
+}
+
+void pushFrame(SymbolTable * symbolTable, const Symbol * function) {
+	_openScope(symbolTable, true, function == NULL ? -1 : (int) (function - symbolTable->symbols));
+}
+
+unsigned int popScope(SymbolTable * symbolTable) {
+	if (symbolTable->depth == 0) {
+		return 0;
+	}
+	const SymbolScope * scope = &symbolTable->scopes[--symbolTable->depth];
+	while (scope->bindings < symbolTable->size) {
+		const Symbol * symbol = &symbolTable->symbols[--symbolTable->size];
+		int * slot = _lookup(symbolTable, symbol->name);
+		if (symbol->shadowed == _emptySlot) {
+			*slot = _deletedSlot;
+			--symbolTable->names;
+		}
+		else {
+			*slot = symbol->shadowed;
+		}
+		if (symbol->kind == FUNCTION_SYMBOL) {
+			symbolTable->signaturesSize = symbol->signature;
+		}
+	}
+	if (scope->isFrame) {
+		return symbolTable->frames[--symbolTable->frameDepth].size;
+	}
+	symbolTable->frames[symbolTable->frameDepth - 1].used = scope->used;
+	return 0;
+}
+
+const Symbol * bindSymbol(SymbolTable * symbolTable, const char * name, const SymbolKind kind, const int type) {
+	if (4 * (symbolTable->usedSlots + 1) > 3 * symbolTable->slotCapacity) {
+		// Grows only if most slots index a name, otherwise the deleted slots
+		// are just dropped.
+		const unsigned int capacity = symbolTable->slotCapacity;
+		_rehash(symbolTable, 2 * (symbolTable->names + 1) > capacity ? 2 * capacity : capacity);
+	}
+	int * slot = _lookup(symbolTable, name);
+	const unsigned int scope = symbolTable->depth == 0 ? 0 : symbolTable->scopes[symbolTable->depth - 1].bindings;
+	if (0 <= *slot && scope <= (unsigned int) *slot) {
+		return NULL;
+	}
+	if (symbolTable->size == symbolTable->capacity) {
+		symbolTable->capacity *= 2;
+		symbolTable->symbols = realloc(symbolTable->symbols, symbolTable->capacity * sizeof(Symbol));
+	}
+	Symbol * symbol = &symbolTable->symbols[symbolTable->size];
+	symbol->name = name;
+	symbol->kind = kind;
+	symbol->type = type;
+	symbol->shadowed = 0 <= *slot ? *slot : _emptySlot;
+	symbol->frame = symbolTable->frameDepth - 1;
+	symbol->slot = kind == VARIABLE_SYMBOL ? _allocateSlot(symbolTable) : 0;
+	symbol->signature = symbolTable->signaturesSize;
+	symbol->parameters = 0;
+	if (*slot == _emptySlot) {
+		++symbolTable->usedSlots;
+	}
+	if (*slot < 0) {
+		++symbolTable->names;
+	}
+	*slot = (int) symbolTable->size++;
+	return symbol;
+}
+
+const Symbol * bindParameter(SymbolTable * symbolTable, const char * name, const int type) {
+	const Symbol * parameter = bindSymbol(symbolTable, name, VARIABLE_SYMBOL, type);
+	const int function = symbolTable->frames[symbolTable->frameDepth - 1].function;
+	if (parameter != NULL && 0 <= function) {
+		if (symbolTable->signaturesSize == symbolTable->signaturesCapacity) {
+			symbolTable->signaturesCapacity *= 2;
+			symbolTable->signatures = realloc(symbolTable->signatures, symbolTable->signaturesCapacity * sizeof(int));
+		}
+		symbolTable->signatures[symbolTable->signaturesSize++] = type;
+		++symbolTable->symbols[function].parameters;
+	}
+	return parameter;
+}
+
+const Symbol * enclosingFunction(const SymbolTable * symbolTable) {
+	const int function = symbolTable->frames[symbolTable->frameDepth - 1].function;
+	return function < 0 ? NULL : &symbolTable->symbols[function];
+}
+
+const int * parameterTypes(const SymbolTable * symbolTable, const Symbol * function) {
+	return &symbolTable->signatures[function->signature];
+}
+
+const Symbol * lookupSymbol(const SymbolTable * symbolTable, const char * name) {
+	const int * slot = _lookup(symbolTable, name);
+	return *slot < 0 ? NULL : &symbolTable->symbols[*slot];
+}
@@ -0,0 +1,160 @@
+#ifndef SYMBOL_TABLE_HEADER
+#define SYMBOL_TABLE_HEADER
+
+#include "Hash.h"
+#include "Type.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * What an identifier is bound to.
+ */
+typedef enum {
+	VARIABLE_SYMBOL,
+	FUNCTION_SYMBOL
+} SymbolKind;
+
+/**
+ * A binding of an identifier in a scope. The name is an interned string (see
+ * "StringTable.h"), and the type is the type of a variable or the return type
+ * of a function (opaque for the table). The shadowed binding is an index, or
+ * -1 if there's none. A variable also has a slot in the frame where it's
+ * bound (the frames are numbered from the outermost one). A function also has
+ * the types of its parameters, stored by the table from the signature offset.
+ */
+typedef struct {
+	const char * name;
+	SymbolKind kind;
+	int type;
+	int shadowed;
+	unsigned int frame;
+	unsigned int slot;
+	unsigned int signature;
+	unsigned int parameters;
+} Symbol;
+
+/**
+ * An open scope: its first binding, the used slots of its frame when it was
+ * opened, and whether it opened that frame.
+ */
+typedef struct {
+	unsigned int bindings;
+	unsigned int used;
+	boolean isFrame;
+} SymbolScope;
+
+/**
+ * An open frame (i.e., the variables of a function): the used slots, the
+ * most slots ever used at once (i.e., the size of the frame), and the binding
+ * of its function (or -1, for the program).
+ */
+typedef struct {
+	unsigned int used;
+	unsigned int size;
+	int function;
+} SymbolFrame;
+
+/**
+ * A scoped symbol table. The bindings live in a stack, and each open scope
+ * remembers where its bindings begin, so opening a scope takes constant time
+ * and closing it only pops its own bindings. An open-addressing hash table
+ * indexes the innermost binding of every name, so a lookup takes constant
+ * time regardless of the depth of the scopes. A binding that shadows another
+ * one (of an outer scope) remembers it, and restores it when popped.
+ *
+ * Some scopes also open a frame. Each variable takes the first free slot of
+ * its frame, and its slot is freed when its scope is closed, so variables of
+ * disjoint scopes share slots, and the size of a frame is the most variables
+ * alive at once. The outermost frame is always open.
+ *
+ * The types of the parameters of the functions live in a stack too, since a
+ * function is always popped before the ones bound earlier.
+ *
+ * The names are interned strings, so they are hashed and compared by their
+ * handle, without reading their characters. Every name must come from the
+ * same string table, and outlive its bindings.
+ */
+typedef struct {
+	Symbol * symbols;
+	unsigned int size;
+	unsigned int capacity;
+	SymbolScope * scopes;
+	unsigned int depth;
+	unsigned int scopeCapacity;
+	SymbolFrame * frames;
+	unsigned int frameDepth;
+	unsigned int frameCapacity;
+	int * signatures;
+	unsigned int signaturesSize;
+	unsigned int signaturesCapacity;
+	int * slots;
+	unsigned int slotCapacity;
+	unsigned int usedSlots;
+	unsigned int names;
+} SymbolTable;
+
+/**
+ * Creates a new empty symbol table, without open scopes (its bindings are
+ * global until a scope is pushed), and only with the outermost frame.
+ */
+SymbolTable * createSymbolTable();
+
+/**
+ * Destroy a symbol table. The names belong to their string table.
+ */
+void destroySymbolTable(SymbolTable * symbolTable);
+
+/**
+ * Opens a new innermost scope.
+ */
+void pushScope(SymbolTable * symbolTable);
+
+/**
+ * Opens a new innermost scope, that also opens a new frame for the specified
+ * function (NULL for the program), which must be its last binding.
+ */
+void pushFrame(SymbolTable * symbolTable, const Symbol * function);
+
+/**
+ * Closes the innermost scope, removing its bindings (and restoring the ones
+ * they shadowed), and freeing their slots. If it opened a frame, the frame is
+ * closed too, and its size is returned (otherwise, 0). Does nothing if there
+ * are no open scopes.
+ */
+unsigned int popScope(SymbolTable * symbolTable);
+
+/**
+ * Binds an interned name in the innermost scope, and returns the binding (a variable
+ * takes a slot of the innermost frame). If the name is already bound in that
+ * scope, nothing is bound and NULL is returned, so a slot never changes its
+ * type. The result is only valid until the table is modified.
+ */
+const Symbol * bindSymbol(SymbolTable * symbolTable, const char * name, const SymbolKind kind, const int type);
+
+/**
+ * Binds a parameter of the function of the innermost frame, as a variable,
+ * and adds its type to the signature of the function. Returns NULL under the
+ * same conditions as "bindSymbol".
+ */
+const Symbol * bindParameter(SymbolTable * symbolTable, const char * name, const int type);
+
+/**
+ * The binding of the function of the innermost frame, or NULL if it's the
+ * frame of the program (or the outermost one). The result is only valid
+ * until the table is modified.
+ */
+const Symbol * enclosingFunction(const SymbolTable * symbolTable);
+
+/**
+ * The types of the parameters of a function (as many as its parameters), in
+ * order. The result is only valid until the table is modified.
+ */
+const int * parameterTypes(const SymbolTable * symbolTable, const Symbol * function);
+
+/**
+ * The innermost binding of an interned name, or NULL if it's unbound. The result is
+ * only valid until the table is modified.
+ */
+const Symbol * lookupSymbol(const SymbolTable * symbolTable, const char * name);
+
+#endif
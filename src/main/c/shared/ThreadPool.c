@@ -0,0 +1,181 @@
+#include "ThreadPool.h"
+
+/**
+ * Platform dependent threading support.
+ *
+ * @see https://man7.org/linux/man-pages/man7/pthreads.7.html
+ */
+#if defined (__TOS_WIN__) \
+	|| defined (__WIN32__) \
+	|| defined (__WINDOWS__) \
+	|| defined (_WIN16) \
+	|| defined (_WIN32) \
+	|| defined (_WIN64)
+#define THREADS_ARE_SUPPORTED 0
+#else
+#define THREADS_ARE_SUPPORTED 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/**
+ * A submitted task, and its argument.
+ */
+typedef struct {
+	Task task;
+	void * argument;
+} ThreadPoolTask;
+
+/**
+ * The tasks are kept in a growable circular queue, protected by a mutex. The
+ * workers wait for new tasks on one condition, and the owner waits for the
+ * completion of every task on another one.
+ */
+struct ThreadPool {
+	ThreadPoolTask * tasks;
+	unsigned int capacity;
+	unsigned int head;
+	unsigned int queued;
+	unsigned int pending;
+	unsigned int size;
+	boolean stopping;
+#if THREADS_ARE_SUPPORTED
+	pthread_t * workers;
+	pthread_mutex_t mutex;
+	pthread_cond_t available;
+	pthread_cond_t completed;
+#endif
+};
+
+/* PRIVATE FUNCTIONS */
+
+#if THREADS_ARE_SUPPORTED
+
+static void _enqueue(ThreadPool * threadPool, Task task, void * argument);
+static void * _work(void * argument);
+
+/**
+ * Appends a task to the queue, doubling its capacity if it's full. The mutex
+ * must be held.
+ */
+static void _enqueue(ThreadPool * threadPool, Task task, void * argument) {
+	if (threadPool->queued == threadPool->capacity) {
+		const unsigned int capacity = 2 * threadPool->capacity;
+		ThreadPoolTask * tasks = calloc(capacity, sizeof(ThreadPoolTask));
+		for (unsigned int k = 0; k < threadPool->queued; ++k) {
+			tasks[k] = threadPool->tasks[(threadPool->head + k) % threadPool->capacity];
+		}
+		free(threadPool->tasks);
+		threadPool->tasks = tasks;
+		threadPool->capacity = capacity;
+		threadPool->head = 0;
+	}
+	ThreadPoolTask * slot = &threadPool->tasks[(threadPool->head + threadPool->queued) % threadPool->capacity];
+	slot->task = task;
+	slot->argument = argument;
+	++threadPool->queued;
+	++threadPool->pending;
+}
+
+/**
+ * The loop of every worker: takes the next task, and executes it outside of
+ * the mutex, until the pool is stopped.
+ */
+static void * _work(void * argument) {
+	ThreadPool * threadPool = argument;
+	pthread_mutex_lock(&threadPool->mutex);
+	for (;;) {
+		while (threadPool->queued == 0 && !threadPool->stopping) {
+			pthread_cond_wait(&threadPool->available, &threadPool->mutex);
+		}
+		if (threadPool->queued == 0) {
+			break;
+		}
+		const ThreadPoolTask task = threadPool->tasks[threadPool->head];
+		threadPool->head = (threadPool->head + 1) % threadPool->capacity;
+		--threadPool->queued;
+		pthread_mutex_unlock(&threadPool->mutex);
+		task.task(task.argument);
+		pthread_mutex_lock(&threadPool->mutex);
+		if (--threadPool->pending == 0) {
+			pthread_cond_broadcast(&threadPool->completed);
+		}
+	}
+	pthread_mutex_unlock(&threadPool->mutex);
+	return NULL;
+}
+
+#endif
+
+/* PUBLIC FUNCTIONS */
+
+const unsigned int availableProcessors() {
+#if THREADS_ARE_SUPPORTED
+	const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+	return processors < 1 ? 1 : (unsigned int) processors;
+#else
+	return 1;
+#endif
+}
+
+ThreadPool * createThreadPool(const unsigned int size) {
+	ThreadPool * threadPool = calloc(1, sizeof(ThreadPool));
+#if THREADS_ARE_SUPPORTED
+	threadPool->capacity = 64;
+	threadPool->tasks = calloc(threadPool->capacity, sizeof(ThreadPoolTask));
+	pthread_mutex_init(&threadPool->mutex, NULL);
+	pthread_cond_init(&threadPool->available, NULL);
+	pthread_cond_init(&threadPool->completed, NULL);
+	threadPool->workers = calloc(size, sizeof(pthread_t));
+	for (unsigned int k = 0; k < size; ++k) {
+		if (pthread_create(&threadPool->workers[k], NULL, _work, threadPool) != 0) {
+			break;
+		}
+		++threadPool->size;
+	}
+#endif
+	return threadPool;
+}
+
+void destroyThreadPool(ThreadPool * threadPool) {
+	if (threadPool != NULL) {
+#if THREADS_ARE_SUPPORTED
+		pthread_mutex_lock(&threadPool->mutex);
+		threadPool->stopping = true;
+		pthread_cond_broadcast(&threadPool->available);
+		pthread_mutex_unlock(&threadPool->mutex);
+		for (unsigned int k = 0; k < threadPool->size; ++k) {
+			pthread_join(threadPool->workers[k], NULL);
+		}
+		pthread_cond_destroy(&threadPool->completed);
+		pthread_cond_destroy(&threadPool->available);
+		pthread_mutex_destroy(&threadPool->mutex);
+		free(threadPool->workers);
+		free(threadPool->tasks);
+#endif
+		free(threadPool);
+	}
+}
+
+void submitToThreadPool(ThreadPool * threadPool, Task task, void * argument) {
+#if THREADS_ARE_SUPPORTED
+	if (0 < threadPool->size) {
+		pthread_mutex_lock(&threadPool->mutex);
+		_enqueue(threadPool, task, argument);
+		pthread_cond_signal(&threadPool->available);
+		pthread_mutex_unlock(&threadPool->mutex);
+		return;
+	}
+#endif
+	task(argument);
+}
+
+void waitForThreadPool(ThreadPool * threadPool) {
+#if THREADS_ARE_SUPPORTED
+	pthread_mutex_lock(&threadPool->mutex);
+	while (0 < threadPool->pending) {
+		pthread_cond_wait(&threadPool->completed, &threadPool->mutex);
+	}
+	pthread_mutex_unlock(&threadPool->mutex);
+#endif
+}
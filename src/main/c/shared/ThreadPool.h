@@ -0,0 +1,44 @@
+#ifndef THREAD_POOL_HEADER
+#define THREAD_POOL_HEADER
+
+#include "Type.h"
+#include <stdlib.h>
+
+/**
+ * A unit of work executed by a thread pool.
+ */
+typedef void (*Task)(void * argument);
+
+/**
+ * A fixed set of worker threads that execute the submitted tasks, in order of
+ * submission. In platforms without threads, every task is executed as soon as
+ * it's submitted, in the calling thread.
+ */
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * The amount of processors available to this process (at least 1).
+ */
+const unsigned int availableProcessors();
+
+/**
+ * Creates a new thread pool, with the specified amount of workers.
+ */
+ThreadPool * createThreadPool(const unsigned int size);
+
+/**
+ * Destroy a thread pool, waiting for every submitted task first.
+ */
+void destroyThreadPool(ThreadPool * threadPool);
+
+/**
+ * Enqueues a task for execution in one of the workers.
+ */
+void submitToThreadPool(ThreadPool * threadPool, Task task, void * argument);
+
+/**
+ * Blocks until every submitted task has been executed.
+ */
+void waitForThreadPool(ThreadPool * threadPool);
+
+#endif